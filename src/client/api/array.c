@@ -213,6 +213,58 @@ daos_array_write(daos_handle_t oh, daos_handle_t th,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_array_read_strided(daos_handle_t oh, daos_handle_t th,
+			daos_array_iod_t *iod, unsigned int stride_nr,
+			daos_array_stride_t *strides, d_sg_list_t *sgl,
+			daos_event_t *ev)
+{
+	daos_array_io_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(dc_array_read, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->iod	= iod;
+	args->sgl	= sgl;
+	args->csums	= NULL;
+	args->stride_nr	= stride_nr;
+	args->strides	= strides;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_array_write_strided(daos_handle_t oh, daos_handle_t th,
+			 daos_array_iod_t *iod, unsigned int stride_nr,
+			 daos_array_stride_t *strides, d_sg_list_t *sgl,
+			 daos_event_t *ev)
+{
+	daos_array_io_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(dc_array_write, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->iod	= iod;
+	args->sgl	= sgl;
+	args->csums	= NULL;
+	args->stride_nr	= stride_nr;
+	args->strides	= strides;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_array_punch(daos_handle_t oh, daos_handle_t th,
 		 daos_array_iod_t *iod, daos_event_t *ev)
@@ -35,15 +35,30 @@
 #include <daos/event.h>
 #include <gurt/list.h>
 
-typedef struct daos_eq {
-	/* After event is completed, it will be moved to the eq_comp list */
-	d_list_t		eq_comp;
-	int			eq_n_comp;
+/**
+ * Completion shard of an event queue. Each shard has its own lock, scheduler
+ * and event lists, so that the threads launching, completing and polling the
+ * events of an EQ created by daos_eq_create_mt() contend on different locks.
+ * All the shards use the global CaRT context.
+ */
+struct daos_eq_shard {
+	/* protects the event lists of the shard */
+	pthread_mutex_t		es_lock;
+	unsigned int		es_lock_init:1,
+				es_sched_init:1;
+
+	/* After event is completed, it will be moved to the es_comp list */
+	d_list_t		es_comp;
+	int			es_n_comp;
 
 	/** Launched events will be added to the running list */
-	d_list_t		eq_running;
-	int			eq_n_running;
+	d_list_t		es_running;
+	int			es_n_running;
+
+	tse_sched_t		es_sched;
+};
 
+typedef struct daos_eq {
 	struct {
 		uint64_t	space[72];
 	}			eq_private;
@@ -81,6 +96,8 @@ struct daos_event_private {
 	struct daos_event_callback evx_callback;
 
 	tse_sched_t		*evx_sched;
+	/* index of the EQ shard the event is launched on */
+	unsigned int		evx_shard;
 };
 
 static inline struct daos_event_private *
@@ -102,13 +119,20 @@ struct daos_eq_private {
 	unsigned int		eqx_lock_init:1,
 				eqx_finalizing:1;
 
-	/* CRT context associated with this eq */
-	crt_context_t		eqx_ctx;
-
-	/* Scheduler associated with this EQ */
-	tse_sched_t		eqx_sched;
+	/* Completion shards, each with its scheduler */
+	struct daos_eq_shard	*eqx_shards;
+	unsigned int		eqx_shard_nr;
+	/* round-robin cursor to spread the events over the shards */
+	unsigned int		eqx_shard_next;
 };
 
+static inline struct daos_eq_shard *
+daos_eqx2shard(struct daos_eq_private *eqx, struct daos_event_private *evx)
+{
+	D_ASSERT(evx->evx_shard < eqx->eqx_shard_nr);
+	return &eqx->eqx_shards[evx->evx_shard];
+}
+
 static inline struct daos_eq_private *
 daos_eq2eqx(struct daos_eq *eq)
 {
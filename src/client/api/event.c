@@ -71,6 +71,13 @@ static crt_context_t daos_eq_ctx;
 static pthread_mutex_t daos_eq_lock = PTHREAD_MUTEX_INITIALIZER;
 static unsigned int eq_ref;
 
+/* Max number of shards of an EQ created by daos_eq_create_mt() */
+#define EQ_SHARD_MAX	64
+
+/* Sequence number of the polling thread, to pick its first shard */
+static __thread unsigned int	eq_poll_tid;
+static unsigned int		eq_poll_seq;
+
 /*
  * Pointer to global scheduler for events not part of an EQ. Events initialized
  * as part of an EQ will be tracked in that EQ scheduler.
@@ -171,16 +178,33 @@ static void
 daos_eq_free(struct d_hlink *hlink)
 {
 	struct daos_eq_private	*eqx;
+	struct daos_eq_shard	*shard;
 	struct daos_eq		*eq;
+	int			 i;
 
 	eqx = container_of(hlink, struct daos_eq_private, eqx_hlink);
 	eq = daos_eqx2eq(eqx);
-	D_ASSERT(d_list_empty(&eq->eq_running));
-	D_ASSERT(d_list_empty(&eq->eq_comp));
-	D_ASSERTF(eq->eq_n_comp == 0 && eq->eq_n_running == 0,
-		  "comp %d running %d\n", eq->eq_n_comp, eq->eq_n_running);
 	D_ASSERT(daos_hhash_link_empty(&eqx->eqx_hlink));
 
+	for (i = 0; i < eqx->eqx_shard_nr; i++) {
+		shard = &eqx->eqx_shards[i];
+		D_ASSERT(d_list_empty(&shard->es_running));
+		D_ASSERT(d_list_empty(&shard->es_comp));
+		D_ASSERTF(shard->es_n_comp == 0 && shard->es_n_running == 0,
+			  "comp %d running %d\n", shard->es_n_comp,
+			  shard->es_n_running);
+
+		/* only left by a failed daos_eq_alloc() */
+		if (shard->es_sched_init)
+			tse_sched_complete(&shard->es_sched, 0, true);
+
+		if (shard->es_lock_init)
+			D_MUTEX_DESTROY(&shard->es_lock);
+	}
+
+	if (eqx->eqx_shards != NULL)
+		D_FREE(eqx->eqx_shards);
+
 	if (eqx->eqx_lock_init)
 		D_MUTEX_DESTROY(&eqx->eqx_lock);
 
@@ -198,34 +222,58 @@ struct d_hlink_ops	eq_h_ops = {
 	.hop_free	= daos_eq_free,
 };
 
-static struct daos_eq *
-daos_eq_alloc(void)
+static int
+daos_eq_alloc(unsigned int shard_nr, struct daos_eq **eqp)
 {
 	struct daos_eq		*eq;
 	struct daos_eq_private	*eqx;
-	int			rc;
+	struct daos_eq_shard	*shard;
+	int			 i;
+	int			 rc;
 
 	D_ALLOC_PTR(eq);
 	if (eq == NULL)
-		return NULL;
-
-	D_INIT_LIST_HEAD(&eq->eq_running);
-	D_INIT_LIST_HEAD(&eq->eq_comp);
-	eq->eq_n_running = 0;
-	eq->eq_n_comp = 0;
+		return -DER_NOMEM;
 
 	eqx = daos_eq2eqx(eq);
+	daos_hhash_hlink_init(&eqx->eqx_hlink, &eq_h_ops);
 
 	rc = D_MUTEX_INIT(&eqx->eqx_lock, NULL);
 	if (rc != 0)
 		goto out;
 	eqx->eqx_lock_init = 1;
 
-	daos_hhash_hlink_init(&eqx->eqx_hlink, &eq_h_ops);
-	return eq;
+	D_ALLOC_ARRAY(eqx->eqx_shards, shard_nr);
+	if (eqx->eqx_shards == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	eqx->eqx_shard_nr = shard_nr;
+
+	for (i = 0; i < shard_nr; i++) {
+		shard = &eqx->eqx_shards[i];
+		D_INIT_LIST_HEAD(&shard->es_running);
+		D_INIT_LIST_HEAD(&shard->es_comp);
+	}
+
+	for (i = 0; i < shard_nr; i++) {
+		shard = &eqx->eqx_shards[i];
+
+		rc = D_MUTEX_INIT(&shard->es_lock, NULL);
+		if (rc != 0)
+			goto out;
+		shard->es_lock_init = 1;
+
+		/* all the shards use the global shared context */
+		rc = tse_sched_init(&shard->es_sched, NULL, daos_eq_ctx);
+		if (rc != 0)
+			goto out;
+		shard->es_sched_init = 1;
+	}
+
+	*eqp = eq;
+	return 0;
 out:
 	daos_eq_free(&eqx->eqx_hlink);
-	return NULL;
+	return rc;
 }
 
 static struct daos_eq_private *
@@ -265,23 +313,18 @@ daos_eq_handle(struct daos_eq_private *eqx, daos_handle_t *h)
 }
 
 static void
-daos_event_launch_locked(struct daos_eq_private *eqx,
+daos_event_launch_locked(struct daos_eq_shard *shard,
 			 struct daos_event_private *evx)
 {
-	struct daos_eq *eq = NULL;
-
-	if (eqx != NULL)
-		eq = daos_eqx2eq(eqx);
-
 	evx->evx_status = DAOS_EVS_RUNNING;
 	if (evx->evx_parent != NULL) {
 		evx->evx_parent->evx_nchild_running++;
 		return;
 	}
 
-	if (eq != NULL) {
-		d_list_add_tail(&evx->evx_link, &eq->eq_running);
-		eq->eq_n_running++;
+	if (shard != NULL) {
+		d_list_add_tail(&evx->evx_link, &shard->es_running);
+		shard->es_n_running++;
 	}
 }
 
@@ -341,16 +384,12 @@ daos_event_complete_cb(struct daos_event_private *evx, int rc)
 }
 
 static int
-daos_event_complete_locked(struct daos_eq_private *eqx,
+daos_event_complete_locked(struct daos_eq_shard *shard,
 			   struct daos_event_private *evx, int rc)
 {
 	struct daos_event_private	*parent_evx = evx->evx_parent;
-	struct daos_eq			*eq = NULL;
 	daos_event_t			*ev = daos_evx2ev(evx);
 
-	if (eqx != NULL)
-		eq = daos_eqx2eq(eqx);
-
 	evx->evx_status = DAOS_EVS_COMPLETED;
 	rc = daos_event_complete_cb(evx, rc);
 	ev->ev_error = rc;
@@ -393,12 +432,12 @@ daos_event_complete_locked(struct daos_eq_private *eqx,
 		evx = parent_evx;
 	}
 
-	if (eq != NULL) {
+	if (shard != NULL) {
 		D_ASSERT(!d_list_empty(&evx->evx_link));
-		d_list_move_tail(&evx->evx_link, &eq->eq_comp);
-		eq->eq_n_comp++;
-		D_ASSERT(eq->eq_n_running > 0);
-		eq->eq_n_running--;
+		d_list_move_tail(&evx->evx_link, &shard->es_comp);
+		shard->es_n_comp++;
+		D_ASSERT(shard->es_n_running > 0);
+		shard->es_n_running--;
 	}
 
 	return 0;
@@ -409,6 +448,7 @@ daos_event_launch(struct daos_event *ev)
 {
 	struct daos_event_private	*evx = daos_ev2evx(ev);
 	struct daos_eq_private		*eqx = NULL;
+	struct daos_eq_shard		*shard = NULL;
 	int				  rc = 0;
 
 	if (evx->evx_status != DAOS_EVS_READY) {
@@ -430,7 +470,8 @@ daos_event_launch(struct daos_event *ev)
 			return -DER_NONEXIST;
 		}
 
-		D_MUTEX_LOCK(&eqx->eqx_lock);
+		shard = daos_eqx2shard(eqx, evx);
+		D_MUTEX_LOCK(&shard->es_lock);
 		if (eqx->eqx_finalizing) {
 			D_ERROR("Event queue is in progress of finalizing\n");
 			rc = -DER_NONEXIST;
@@ -438,7 +479,7 @@ daos_event_launch(struct daos_event *ev)
 		}
 	}
 
-	daos_event_launch_locked(eqx, evx);
+	daos_event_launch_locked(shard, evx);
 
 	/*
 	 * If all child events completed before a barrier parent was launched,
@@ -447,11 +488,11 @@ daos_event_launch(struct daos_event *ev)
 	if (evx->is_barrier && evx->evx_nchild > 0 &&
 	    evx->evx_nchild == evx->evx_nchild_comp) {
 		D_ASSERT(evx->evx_nchild_running == 0);
-		daos_event_complete_locked(eqx, evx, rc);
+		daos_event_complete_locked(shard, evx, rc);
 	}
  out:
-	if (eqx != NULL)
-		D_MUTEX_UNLOCK(&eqx->eqx_lock);
+	if (shard != NULL)
+		D_MUTEX_UNLOCK(&shard->es_lock);
 
 	if (eqx != NULL)
 		daos_eq_putref(eqx);
@@ -483,21 +524,23 @@ daos_event_complete(struct daos_event *ev, int rc)
 {
 	struct daos_event_private	*evx = daos_ev2evx(ev);
 	struct daos_eq_private		*eqx = NULL;
+	struct daos_eq_shard		*shard = NULL;
 
 	if (!daos_handle_is_inval(evx->evx_eqh)) {
 		eqx = daos_eq_lookup(evx->evx_eqh);
 		D_ASSERT(eqx != NULL);
 
-		D_MUTEX_LOCK(&eqx->eqx_lock);
+		shard = daos_eqx2shard(eqx, evx);
+		D_MUTEX_LOCK(&shard->es_lock);
 	}
 
 	D_ASSERT(evx->evx_status == DAOS_EVS_RUNNING ||
 		 evx->evx_status == DAOS_EVS_ABORTED);
 
-	daos_event_complete_locked(eqx, evx, rc);
+	daos_event_complete_locked(shard, evx, rc);
 
-	if (eqx != NULL)
-		D_MUTEX_UNLOCK(&eqx->eqx_lock);
+	if (shard != NULL)
+		D_MUTEX_UNLOCK(&shard->es_lock);
 
 	if (eqx != NULL)
 		daos_eq_putref(eqx);
@@ -514,6 +557,7 @@ ev_progress_cb(void *arg)
 	struct ev_progress_arg		*epa = (struct ev_progress_arg  *)arg;
 	struct daos_event_private       *evx = epa->evx;
 	struct daos_eq_private		*eqx = epa->eqx;
+	struct daos_eq_shard		*shard;
 
 	tse_sched_progress(evx->evx_sched);
 
@@ -540,7 +584,8 @@ ev_progress_cb(void *arg)
 	}
 
 	/** Grab the lock so we don't race with eq_progress_cb. */
-	D_MUTEX_LOCK(&eqx->eqx_lock);
+	shard = daos_eqx2shard(eqx, evx);
+	D_MUTEX_LOCK(&shard->es_lock);
 
 	/*
 	 * if the EQ was finalized from under us, just update the event status
@@ -549,7 +594,7 @@ ev_progress_cb(void *arg)
 	if (eqx->eqx_finalizing) {
 		evx->evx_status = DAOS_EVS_READY;
 		D_ASSERT(d_list_empty(&evx->evx_link));
-		D_MUTEX_UNLOCK(&epa->eqx->eqx_lock);
+		D_MUTEX_UNLOCK(&shard->es_lock);
 		return 1;
 	}
 
@@ -559,16 +604,14 @@ ev_progress_cb(void *arg)
 	 */
 	if (evx->evx_status == DAOS_EVS_COMPLETED ||
 	    evx->evx_status == DAOS_EVS_ABORTED) {
-		struct daos_eq *eq = daos_eqx2eq(eqx);
-
 		evx->evx_status = DAOS_EVS_READY;
-		D_ASSERT(eq->eq_n_comp > 0);
-		eq->eq_n_comp--;
+		D_ASSERT(shard->es_n_comp > 0);
+		shard->es_n_comp--;
 		d_list_del_init(&evx->evx_link);
 	}
 
 	D_ASSERT(evx->evx_status == DAOS_EVS_READY);
-	D_MUTEX_UNLOCK(&eqx->eqx_lock);
+	D_MUTEX_UNLOCK(&shard->es_lock);
 
 	return 1;
 }
@@ -617,61 +660,70 @@ daos_event_test(struct daos_event *ev, int64_t timeout, bool *flag)
 }
 
 int
-daos_eq_create(daos_handle_t *eqh)
+daos_eq_create_mt(daos_handle_t *eqh, unsigned int nshards)
 {
 	struct daos_eq_private	*eqx;
 	struct daos_eq		*eq;
-	int			 rc = 0;
+	int			 rc;
 
 	/** not thread-safe, but best effort */
 	if (eq_ref == 0)
 		return -DER_UNINIT;
 
-	eq = daos_eq_alloc();
-	if (eq == NULL)
-		return -DER_NOMEM;
+	if (nshards == 0 || nshards > EQ_SHARD_MAX)
+		return -DER_INVAL;
+
+	rc = daos_eq_alloc(nshards, &eq);
+	if (rc != 0)
+		return rc;
 
 	eqx = daos_eq2eqx(eq);
 	daos_eq_insert(eqx);
-	eqx->eqx_ctx = daos_eq_ctx;
 	daos_eq_handle(eqx, eqh);
 
-	rc = tse_sched_init(&eqx->eqx_sched, NULL, daos_eq_ctx);
-
 	daos_eq_putref(eqx);
-	return rc;
+	return 0;
+}
+
+int
+daos_eq_create(daos_handle_t *eqh)
+{
+	return daos_eq_create_mt(eqh, 1);
 }
 
 struct eq_progress_arg {
 	struct daos_eq_private	 *eqx;
+	/* the shard harvested first, to spread the polling threads */
+	unsigned int		  home;
 	unsigned int		  n_events;
 	struct daos_event	**events;
 	int			  wait_running;
 	int			  count;
 };
 
-static int
-eq_progress_cb(void *arg)
+/**
+ * Move the completed events of @shard to the output array, as many as it
+ * has room for. The caller holds the shard lock, so the whole batch is
+ * harvested with a single lock acquisition.
+ */
+static void
+eq_shard_harvest(struct eq_progress_arg *epa, struct daos_eq_shard *shard)
 {
-	struct eq_progress_arg		*epa = (struct eq_progress_arg  *)arg;
 	struct daos_event		*ev;
-	struct daos_eq			*eq;
 	struct daos_event_private	*evx;
 	struct daos_event_private	*tmp;
 
-	eq = daos_eqx2eq(epa->eqx);
-
-	tse_sched_progress(&epa->eqx->eqx_sched);
+	d_list_for_each_entry_safe(evx, tmp, &shard->es_comp, evx_link) {
+		D_ASSERT(shard->es_n_comp > 0);
 
-	D_MUTEX_LOCK(&epa->eqx->eqx_lock);
-	d_list_for_each_entry_safe(evx, tmp, &eq->eq_comp, evx_link) {
-		D_ASSERT(eq->eq_n_comp > 0);
+		if (epa->count == epa->n_events)
+			break;
 
 		/** don't poll out a parent if it has inflight events */
 		if (evx->evx_nchild_running > 0)
 			continue;
 
-		eq->eq_n_comp--;
+		shard->es_n_comp--;
 
 		d_list_del_init(&evx->evx_link);
 		D_ASSERT(evx->evx_status == DAOS_EVS_COMPLETED ||
@@ -682,32 +734,50 @@ eq_progress_cb(void *arg)
 			ev = daos_evx2ev(evx);
 			epa->events[epa->count++] = ev;
 		}
+	}
+}
 
-		D_ASSERT(epa->count <= epa->n_events);
-		if (epa->count == epa->n_events)
-			break;
+/**
+ * Progress the schedulers of all the shards and harvest their completions,
+ * starting from the home shard of the polling thread. The threads polling the
+ * EQ all block in crt_progress() on the shared context, any of them harvests
+ * the events of any shard.
+ */
+static int
+eq_progress_cb(void *arg)
+{
+	struct eq_progress_arg	*epa = (struct eq_progress_arg  *)arg;
+	struct daos_eq_private	*eqx = epa->eqx;
+	struct daos_eq_shard	*shard;
+	bool			 finalizing = false;
+	bool			 running = false;
+	unsigned int		 i;
+
+	for (i = 0; i < eqx->eqx_shard_nr; i++) {
+		shard = &eqx->eqx_shards[(epa->home + i) % eqx->eqx_shard_nr];
+		tse_sched_progress(&shard->es_sched);
+
+		D_MUTEX_LOCK(&shard->es_lock);
+		eq_shard_harvest(epa, shard);
+		if (!d_list_empty(&shard->es_running))
+			running = true;
+		finalizing = eqx->eqx_finalizing;
+		D_MUTEX_UNLOCK(&shard->es_lock);
 	}
 
 	/* exit once there are completion events */
-	if (epa->count > 0) {
-		D_MUTEX_UNLOCK(&epa->eqx->eqx_lock);
+	if (epa->count > 0)
 		return 1;
-	}
 
-	/* no completion event, eq::eq_comp is empty */
-	if (epa->eqx->eqx_finalizing) { /* no new event is coming */
-		D_ASSERT(d_list_empty(&eq->eq_running));
-		D_MUTEX_UNLOCK(&epa->eqx->eqx_lock);
+	/* no completion event, shard::es_comp is empty */
+	if (finalizing) { /* no new event is coming */
+		D_ASSERT(!running);
 		return -DER_NONEXIST;
 	}
 
 	/* wait only if there are running events? */
-	if (epa->wait_running && d_list_empty(&eq->eq_running)) {
-		D_MUTEX_UNLOCK(&epa->eqx->eqx_lock);
+	if (epa->wait_running && !running)
 		return 1;
-	}
-
-	D_MUTEX_UNLOCK(&epa->eqx->eqx_lock);
 
 	/** continue waiting */
 	return 0;
@@ -728,13 +798,17 @@ daos_eq_poll(daos_handle_t eqh, int wait_running, int64_t timeout,
 	if (epa.eqx == NULL)
 		return -DER_NONEXIST;
 
+	if (eq_poll_tid == 0)
+		eq_poll_tid = __atomic_add_fetch(&eq_poll_seq, 1,
+						 __ATOMIC_RELAXED);
+	epa.home	= eq_poll_tid % epa.eqx->eqx_shard_nr;
 	epa.n_events	= n_events;
 	epa.events	= events;
 	epa.wait_running = wait_running;
 	epa.count	= 0;
 
 	/* pass the timeout to crt_progress() with a conditional callback */
-	rc = crt_progress(epa.eqx->eqx_ctx, timeout, eq_progress_cb, &epa);
+	rc = crt_progress(daos_eq_ctx, timeout, eq_progress_cb, &epa);
 
 	/* drop ref grabbed in daos_eq_lookup() */
 	daos_eq_putref(epa.eqx);
@@ -752,48 +826,54 @@ daos_eq_query(daos_handle_t eqh, daos_eq_query_t query,
 	      unsigned int n_events, struct daos_event **events)
 {
 	struct daos_eq_private		*eqx;
-	struct daos_eq			*eq;
+	struct daos_eq_shard		*shard;
 	struct daos_event_private	*evx;
 	struct daos_event		*ev;
 	int				 count;
+	int				 i;
 
 	eqx = daos_eq_lookup(eqh);
 	if (eqx == NULL)
 		return -DER_NONEXIST;
 
-	eq = daos_eqx2eq(eqx);
-
 	count = 0;
-	D_MUTEX_LOCK(&eqx->eqx_lock);
+	for (i = 0; i < eqx->eqx_shard_nr; i++) {
+		shard = &eqx->eqx_shards[i];
+		D_MUTEX_LOCK(&shard->es_lock);
 
-	if (n_events == 0 || events == NULL) {
-		if ((query & DAOS_EQR_COMPLETED) != 0)
-			count += eq->eq_n_comp;
+		if (n_events == 0 || events == NULL) {
+			if ((query & DAOS_EQR_COMPLETED) != 0)
+				count += shard->es_n_comp;
 
-		if ((query & DAOS_EQR_WAITING) != 0)
-			count += eq->eq_n_running;
-		goto out;
-	}
+			if ((query & DAOS_EQR_WAITING) != 0)
+				count += shard->es_n_running;
+			goto next;
+		}
 
-	if ((query & DAOS_EQR_COMPLETED) != 0) {
-		d_list_for_each_entry(evx, &eq->eq_comp, evx_link) {
-			ev = daos_evx2ev(evx);
-			events[count++] = ev;
-			if (count == n_events)
-				goto out;
+		if ((query & DAOS_EQR_COMPLETED) != 0) {
+			d_list_for_each_entry(evx, &shard->es_comp, evx_link) {
+				ev = daos_evx2ev(evx);
+				events[count++] = ev;
+				if (count == n_events)
+					goto next;
+			}
 		}
-	}
 
-	if ((query & DAOS_EQR_WAITING) != 0) {
-		d_list_for_each_entry(evx, &eq->eq_running, evx_link) {
-			ev = daos_evx2ev(evx);
-			events[count++] = ev;
-			if (count == n_events)
-				goto out;
+		if ((query & DAOS_EQR_WAITING) != 0) {
+			d_list_for_each_entry(evx, &shard->es_running,
+					      evx_link) {
+				ev = daos_evx2ev(evx);
+				events[count++] = ev;
+				if (count == n_events)
+					goto next;
+			}
 		}
+next:
+		D_MUTEX_UNLOCK(&shard->es_lock);
+		if (events != NULL && n_events != 0 && count == n_events)
+			break;
 	}
-out:
-	D_MUTEX_UNLOCK(&eqx->eqx_lock);
+
 	daos_eq_putref(eqx);
 	return count;
 }
@@ -816,7 +896,7 @@ daos_event_abort_one(struct daos_event_private *evx)
 }
 
 static void
-daos_event_abort_locked(struct daos_eq_private *eqx,
+daos_event_abort_locked(struct daos_eq_shard *shard,
 			struct daos_event_private *evx)
 {
 	struct daos_event_private *child;
@@ -830,13 +910,11 @@ daos_event_abort_locked(struct daos_eq_private *eqx,
 
 	/* if aborted event is not a child event, move it to the
 	 * head of launched list */
-	if (evx->evx_parent == NULL && eqx != NULL) {
-		struct daos_eq *eq = daos_eqx2eq(eqx);
-
+	if (evx->evx_parent == NULL && shard != NULL) {
 		d_list_del(&evx->evx_link);
-		d_list_add(&evx->evx_link, &eq->eq_comp);
-		eq->eq_n_running--;
-		eq->eq_n_comp++;
+		d_list_add(&evx->evx_link, &shard->es_comp);
+		shard->es_n_running--;
+		shard->es_n_comp++;
 	}
 }
 
@@ -844,10 +922,11 @@ int
 daos_eq_destroy(daos_handle_t eqh, int flags)
 {
 	struct daos_eq_private		*eqx;
-	struct daos_eq			*eq;
+	struct daos_eq_shard		*shard;
 	struct daos_event_private	*evx;
 	struct daos_event_private	*tmp;
 	int				 rc = 0;
+	int				 i;
 
 	eqx = daos_eq_lookup(eqh);
 	if (eqx == NULL) {
@@ -855,45 +934,58 @@ daos_eq_destroy(daos_handle_t eqh, int flags)
 		return -DER_NONEXIST;
 	}
 
+	/* all the shards are locked, in order, while the EQ is checked */
 	D_MUTEX_LOCK(&eqx->eqx_lock);
+	for (i = 0; i < eqx->eqx_shard_nr; i++)
+		D_MUTEX_LOCK(&eqx->eqx_shards[i].es_lock);
+
 	if (eqx->eqx_finalizing) {
 		D_ERROR("eqx_finalizing.\n");
 		rc = -DER_NONEXIST;
 		goto out;
 	}
 
-	eq = daos_eqx2eq(eqx);
-
 	/* If it is not force destroyed, then we need check if
 	 * there are still events linked here */
-	if (((flags & DAOS_EQ_DESTROY_FORCE) == 0) &&
-	    (!d_list_empty(&eq->eq_running) ||
-	     !d_list_empty(&eq->eq_comp))) {
-		rc = -DER_BUSY;
-		goto out;
+	for (i = 0; (flags & DAOS_EQ_DESTROY_FORCE) == 0 &&
+		    i < eqx->eqx_shard_nr; i++) {
+		shard = &eqx->eqx_shards[i];
+		if (!d_list_empty(&shard->es_running) ||
+		    !d_list_empty(&shard->es_comp)) {
+			rc = -DER_BUSY;
+			goto out;
+		}
 	}
 
 	/* prevent other threads to launch new event */
 	eqx->eqx_finalizing = 1;
 
-	/* abort all launched events */
-	d_list_for_each_entry_safe(evx, tmp, &eq->eq_running, evx_link) {
-		D_ASSERT(evx->evx_parent == NULL);
-		daos_event_abort_locked(eqx, evx);
-	}
+	for (i = 0; i < eqx->eqx_shard_nr; i++) {
+		shard = &eqx->eqx_shards[i];
 
-	D_ASSERT(d_list_empty(&eq->eq_running));
+		/* abort all launched events */
+		d_list_for_each_entry_safe(evx, tmp, &shard->es_running,
+					   evx_link) {
+			D_ASSERT(evx->evx_parent == NULL);
+			daos_event_abort_locked(shard, evx);
+		}
 
-	d_list_for_each_entry_safe(evx, tmp, &eq->eq_comp, evx_link) {
-		d_list_del(&evx->evx_link);
-		D_ASSERT(eq->eq_n_comp > 0);
-		eq->eq_n_comp--;
-	}
-	eqx->eqx_ctx = NULL;
+		D_ASSERT(d_list_empty(&shard->es_running));
 
-	tse_sched_complete(&eqx->eqx_sched, rc, true);
+		d_list_for_each_entry_safe(evx, tmp, &shard->es_comp,
+					   evx_link) {
+			d_list_del(&evx->evx_link);
+			D_ASSERT(shard->es_n_comp > 0);
+			shard->es_n_comp--;
+		}
+
+		tse_sched_complete(&shard->es_sched, rc, true);
+		shard->es_sched_init = 0;
+	}
 
 out:
+	for (i = eqx->eqx_shard_nr - 1; i >= 0; i--)
+		D_MUTEX_UNLOCK(&eqx->eqx_shards[i].es_lock);
 	D_MUTEX_UNLOCK(&eqx->eqx_lock);
 	if (rc == 0)
 		daos_eq_delete(eqx);
@@ -971,6 +1063,7 @@ daos_event_init(struct daos_event *ev, daos_handle_t eqh,
 	struct daos_event_private	*evx = daos_ev2evx(ev);
 	struct daos_event_private	*parent_evx;
 	struct daos_eq_private		*eqx;
+	struct daos_eq_shard		*shard;
 	int				rc = 0;
 
 	D_CASSERT(sizeof(ev->ev_private) >= sizeof(*evx));
@@ -1004,6 +1097,7 @@ daos_event_init(struct daos_event *ev, daos_handle_t eqh,
 		evx->evx_eqh	= parent_evx->evx_eqh;
 		evx->evx_ctx	= parent_evx->evx_ctx;
 		evx->evx_sched	= parent_evx->evx_sched;
+		evx->evx_shard	= parent_evx->evx_shard;
 		evx->evx_parent	= parent_evx;
 		parent_evx->evx_nchild++;
 	} else if (!daos_handle_is_inval(eqh)) {
@@ -1014,9 +1108,15 @@ daos_event_init(struct daos_event *ev, daos_handle_t eqh,
 			D_ERROR("Invalid EQ handle %"PRIx64"\n", eqh.cookie);
 			return -DER_NONEXIST;
 		}
-		/* inherit transport context from event queue */
-		evx->evx_ctx = eqx->eqx_ctx;
-		evx->evx_sched = &eqx->eqx_sched;
+		/* spread the events over the shards of the event queue */
+		evx->evx_shard = __atomic_fetch_add(&eqx->eqx_shard_next, 1,
+						    __ATOMIC_RELAXED) %
+				 eqx->eqx_shard_nr;
+		shard = daos_eqx2shard(eqx, evx);
+
+		/* the transport context is shared, the scheduler is not */
+		evx->evx_ctx = daos_eq_ctx;
+		evx->evx_sched = &shard->es_sched;
 		daos_eq_putref(eqx);
 	} else {
 		evx->evx_ctx = daos_eq_ctx;
@@ -1036,14 +1136,14 @@ daos_event_fini(struct daos_event *ev)
 {
 	struct daos_event_private	*evx = daos_ev2evx(ev);
 	struct daos_eq_private		*eqx = NULL;
-	struct daos_eq			*eq = NULL;
+	struct daos_eq_shard		*shard = NULL;
 	int				 rc = 0;
 
 	if (!daos_handle_is_inval(evx->evx_eqh)) {
 		eqx = daos_eq_lookup(evx->evx_eqh);
 		if (eqx == NULL)
 			return -DER_NONEXIST;
-		eq = daos_eqx2eq(eqx);
+		shard = daos_eqx2shard(eqx, evx);
 	}
 
 	/* If there are child events */
@@ -1097,18 +1197,18 @@ daos_event_fini(struct daos_event *ev)
 	/* Remove from the evx_link */
 	if (!d_list_empty(&evx->evx_link)) {
 		d_list_del(&evx->evx_link);
-		if (evx->evx_status == DAOS_EVS_RUNNING && eq != NULL) {
-			eq->eq_n_running--;
+		if (evx->evx_status == DAOS_EVS_RUNNING && shard != NULL) {
+			shard->es_n_running--;
 		} else if (evx->evx_status == DAOS_EVS_COMPLETED &&
-			   eq != NULL) {
-			D_ASSERTF(eq->eq_n_comp > 0, "eq %p\n", eq);
-			eq->eq_n_comp--;
+			   shard != NULL) {
+			D_ASSERTF(shard->es_n_comp > 0, "eq %p\n", eqx);
+			shard->es_n_comp--;
 		}
 	}
 
 	evx->evx_ctx = NULL;
 out:
-	if (eq != NULL)
+	if (eqx != NULL)
 		daos_eq_putref(eqx);
 	return rc;
 }
@@ -1143,6 +1243,7 @@ daos_event_abort(struct daos_event *ev)
 {
 	struct daos_event_private	*evx = daos_ev2evx(ev);
 	struct daos_eq_private		*eqx = NULL;
+	struct daos_eq_shard		*shard = NULL;
 
 	if (!daos_handle_is_inval(evx->evx_eqh)) {
 		eqx = daos_eq_lookup(evx->evx_eqh);
@@ -1151,13 +1252,14 @@ daos_event_abort(struct daos_event *ev)
 				evx->evx_eqh.cookie);
 			return -DER_NONEXIST;
 		}
-		D_MUTEX_LOCK(&eqx->eqx_lock);
+		shard = daos_eqx2shard(eqx, evx);
+		D_MUTEX_LOCK(&shard->es_lock);
 	}
 
-	daos_event_abort_locked(eqx, evx);
+	daos_event_abort_locked(shard, evx);
 
 	if (eqx != NULL) {
-		D_MUTEX_UNLOCK(&eqx->eqx_lock);
+		D_MUTEX_UNLOCK(&shard->es_lock);
 		daos_eq_putref(eqx);
 	}
 
@@ -112,6 +112,8 @@ const struct daos_task_api dc_funcs[] = {
 	{dc_obj_list_akey, sizeof(daos_obj_list_akey_t)},
 	{dc_obj_list_rec, sizeof(daos_obj_list_recx_t)},
 	{dc_obj_list_obj, sizeof(daos_obj_list_obj_t)},
+	{dc_obj_update_multi, sizeof(daos_obj_multi_rw_t)},
+	{dc_obj_fetch_multi, sizeof(daos_obj_multi_rw_t)},
 
 	/** Array */
 	{dc_array_create, sizeof(daos_array_create_t)},
@@ -129,6 +131,9 @@ const struct daos_task_api dc_funcs[] = {
 	{dc_kv_put, sizeof(daos_kv_put_t)},
 	{dc_kv_remove, sizeof(daos_kv_remove_t)},
 	{dc_kv_list, sizeof(daos_kv_list_t)},
+	{dc_kv_put_multi, sizeof(daos_kv_multi_t)},
+	{dc_kv_get_multi, sizeof(daos_kv_multi_t)},
+	{dc_kv_scan, sizeof(daos_kv_list_t)},
 };
 
 /**
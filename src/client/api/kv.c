@@ -119,3 +119,76 @@ daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 
 	return dc_task_schedule(task, true);
 }
+
+int
+daos_kv_scan(daos_handle_t oh, daos_handle_t th, daos_kv_filter_t *filter,
+	     uint32_t *nr, daos_key_desc_t *kds, d_sg_list_t *sgl,
+	     daos_anchor_t *anchor, daos_event_t *ev)
+{
+	daos_kv_list_t	*args;
+	tse_task_t	*task;
+	int		rc;
+
+	rc = dc_task_create(dc_kv_scan, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->nr	= nr;
+	args->kds	= kds;
+	args->sgl	= sgl;
+	args->anchor	= anchor;
+	args->filter	= filter;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		  const char **keys, const daos_size_t *sizes, void **bufs,
+		  daos_event_t *ev)
+{
+	daos_kv_multi_t	*args;
+	tse_task_t	*task;
+	int		rc;
+
+	rc = dc_task_create(dc_kv_put_multi, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->nr	= nr;
+	args->keys	= keys;
+	args->sizes	= (daos_size_t *)sizes;
+	args->bufs	= bufs;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_kv_get_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		  const char **keys, daos_size_t *sizes, void **bufs,
+		  daos_event_t *ev)
+{
+	daos_kv_multi_t	*args;
+	tse_task_t	*task;
+	int		rc;
+
+	rc = dc_task_create(dc_kv_get_multi, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->nr	= nr;
+	args->keys	= keys;
+	args->sizes	= sizes;
+	args->bufs	= bufs;
+
+	return dc_task_schedule(task, true);
+}
@@ -195,6 +195,34 @@ daos_obj_update(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_obj_fetch_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		     daos_dkey_io_t *ios, daos_event_t *ev)
+{
+	tse_task_t	*task;
+	int		rc;
+
+	rc = dc_obj_fetch_multi_task_create(oh, th, nr, ios, ev, NULL, &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_obj_update_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		      daos_dkey_io_t *ios, daos_event_t *ev)
+{
+	tse_task_t	*task;
+	int		rc;
+
+	rc = dc_obj_update_multi_task_create(oh, th, nr, ios, ev, NULL, &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_obj_list_dkey(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 		   daos_key_desc_t *kds, d_sg_list_t *sgl,
@@ -245,6 +273,26 @@ daos_obj_list_recx(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_obj_enum_open(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
+		   uint32_t flags, daos_handle_t *eh)
+{
+	return dc_obj_enum_open(oh, th, dkey, flags, eh);
+}
+
+int
+daos_obj_enum_next(daos_handle_t eh, uint32_t *nr, daos_key_desc_t *kds,
+		   d_sg_list_t *sgl)
+{
+	return dc_obj_enum_next(eh, nr, kds, sgl);
+}
+
+int
+daos_obj_enum_close(daos_handle_t eh)
+{
+	return dc_obj_enum_close(eh);
+}
+
 /* Use to query the object layout */
 int
 daos_obj_layout_get(daos_handle_t coh, daos_obj_id_t oid,
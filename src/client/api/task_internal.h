@@ -94,6 +94,7 @@ struct daos_task_args {
 		struct daos_obj_fetch_shard obj_fetch_shard;
 		daos_obj_fetch_t	obj_fetch;
 		daos_obj_update_t	obj_update;
+		daos_obj_multi_rw_t	obj_multi_rw;
 		daos_obj_list_dkey_t	obj_list_dkey;
 		daos_obj_list_akey_t	obj_list_akey;
 		daos_obj_list_recx_t	obj_list_recx;
@@ -113,6 +114,7 @@ struct daos_task_args {
 		daos_kv_put_t		kv_put;
 		daos_kv_remove_t	kv_remove;
 		daos_kv_list_t		kv_list;
+		daos_kv_multi_t		kv_multi;
 	}		 ta_u;
 	daos_event_t	*ta_ev;
 };
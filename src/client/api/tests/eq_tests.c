@@ -980,6 +980,128 @@ out_free:
 	return rc;
 }
 
+#define EQT_MT_THREADS		4
+#define EQT_MT_BATCH		64
+#define EQT_MT_ROUNDS		2000
+
+struct eq_mt_arg {
+	daos_handle_t		eqh;
+	pthread_t		thread;
+	int			rc;
+};
+
+/**
+ * Launch and complete a batch of events, then poll the EQ until all of them
+ * are harvested, by this thread or by another one sharing the EQ.
+ */
+static void *
+eq_mt_thread(void *data)
+{
+	struct eq_mt_arg	*arg = data;
+	struct daos_event	*events;
+	struct daos_event	*comp[EQT_MT_BATCH];
+	int			 done;
+	int			 rc = 0;
+	int			 i;
+	int			 j;
+
+	events = calloc(EQT_MT_BATCH, sizeof(*events));
+	if (events == NULL) {
+		arg->rc = -DER_NOMEM;
+		return NULL;
+	}
+
+	for (i = 0; i < EQT_MT_BATCH; i++) {
+		rc = daos_event_init(&events[i], arg->eqh, NULL);
+		if (rc != 0)
+			goto out;
+	}
+
+	for (i = 0; i < EQT_MT_ROUNDS; i++) {
+		for (j = 0; j < EQT_MT_BATCH; j++) {
+			rc = daos_event_launch(&events[j]);
+			if (rc != 0)
+				goto out;
+			daos_event_complete(&events[j], 0);
+		}
+
+		do {
+			rc = daos_eq_poll(arg->eqh, 0, DAOS_EQ_NOWAIT,
+					  EQT_MT_BATCH, comp);
+			if (rc < 0)
+				goto out;
+
+			for (j = 0, done = 0; j < EQT_MT_BATCH; j++) {
+				if (daos_ev2evx(&events[j])->evx_status ==
+				    DAOS_EVS_READY)
+					done++;
+			}
+		} while (done < EQT_MT_BATCH);
+	}
+	rc = 0;
+out:
+	for (i = 0; i < EQT_MT_BATCH; i++)
+		daos_event_fini(&events[i]);
+	free(events);
+	arg->rc = rc;
+	return NULL;
+}
+
+static int
+eq_mt_run(unsigned int nshards)
+{
+	struct eq_mt_arg	args[EQT_MT_THREADS];
+	daos_handle_t		eqh;
+	int			rc;
+	int			i;
+
+	rc = daos_eq_create_mt(&eqh, nshards);
+	if (rc != 0) {
+		print_error("Failed to create EQ with %u shards: %d\n",
+			    nshards, rc);
+		return rc;
+	}
+
+	for (i = 0; i < EQT_MT_THREADS; i++) {
+		args[i].eqh = eqh;
+		args[i].rc = 0;
+		rc = pthread_create(&args[i].thread, NULL, eq_mt_thread,
+				    &args[i]);
+		if (rc != 0) {
+			print_error("Failed to create thread: %d\n", rc);
+			break;
+		}
+	}
+
+	while (--i >= 0) {
+		pthread_join(args[i].thread, NULL);
+		if (rc == 0)
+			rc = args[i].rc;
+	}
+
+	if (rc != 0)
+		print_error("%d threads on %u shard(s) failed: %d\n",
+			    EQT_MT_THREADS, nshards, rc);
+
+	daos_eq_destroy(eqh, DAOS_EQ_DESTROY_FORCE);
+	return rc;
+}
+
+static int
+eq_test_8()
+{
+	int	rc;
+
+	DAOS_TEST_ENTRY("8", "Multi-threaded EQ");
+
+	rc = eq_mt_run(1);
+	if (rc == 0)
+		rc = eq_mt_run(EQT_MT_THREADS);
+
+	DAOS_TEST_EXIT(rc);
+	return rc;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -1057,6 +1179,12 @@ main(int argc, char **argv)
 		test_fail++;
 	}
 
+	rc = eq_test_8();
+	if (rc != 0) {
+		print_error("EQ TEST 8 failed: %d\n", rc);
+		test_fail++;
+	}
+
 	if (test_fail)
 		print_error("ERROR, %d test(s) failed\n", test_fail);
 	else
@@ -28,6 +28,7 @@
 #define D_LOGFAC	DD_FAC(array)
 
 #include <daos.h>
+#include <daos/common.h>
 #include <daos/tse.h>
 #include <daos/object.h>
 #include <daos/container.h>
@@ -40,6 +41,15 @@
 #define ARRAY_MD_KEY	"daos_array_metadata"
 #define CELL_SIZE	"daos_array_cell_size"
 #define CHUNK_SIZE	"daos_array_chunk_size"
+/** default number of dkey I/Os in flight for one array I/O */
+#define ARRAY_IO_DEPTH	16
+/**
+ * Default max number of dkey I/Os batched by a slot into one multi-dkey I/O,
+ * and max number of bytes of such a batch. The arrays with chunks larger
+ * than half of the batch size always send one dkey per I/O.
+ */
+#define ARRAY_IO_BATCH		32
+#define ARRAY_IO_BATCH_SIZE	(1UL << 20)
 
 struct dc_array {
 	/** link chain in the global handle hash table */
@@ -56,6 +66,23 @@ struct dc_array {
 	daos_obj_id_t		oid;
 	/** object handle access mode */
 	unsigned int		mode;
+	/** max number of dkey I/Os in flight per array I/O, 0 for no limit */
+	unsigned int		io_depth;
+	/** max number of dkeys sent by one I/O, 0 or 1 to disable batching */
+	unsigned int		io_batch;
+	/**
+	 * Client cache of the array size. With DAOS_OO_EXCL no other handle
+	 * modifies the array, so the size is kept up to date by the writes,
+	 * punches and set_size of this handle. The size at the epoch of a
+	 * read-only transaction (e.g. a snapshot) never changes.
+	 */
+	pthread_mutex_t		size_lock;
+	bool			size_valid;
+	daos_size_t		size;
+	/** bumped by each modification, a stale query must not be cached */
+	uint64_t		size_gen;
+	daos_epoch_t		snap_epoch;
+	daos_size_t		snap_size;
 };
 
 struct md_params {
@@ -77,6 +104,19 @@ struct io_params {
 	bool			user_sgl_used;
 	daos_size_t		cell_size;
 	tse_task_t		*task;
+	/** allocated iod_recxs and sg_iovs, reused by the next dkey I/O */
+	daos_size_t		recx_cap;
+	daos_size_t		iov_cap;
+	/** number of records of the dkey I/O */
+	daos_size_t		records;
+	/**
+	 * The following dkeys batched with this one into a single multi-dkey
+	 * I/O, and the dkey I/O array of the batch. Only used by the slots.
+	 */
+	struct io_params	*batch;
+	unsigned int		batch_nr;
+	daos_dkey_io_t		*dios;
+	struct io_stream	*stream;
 	struct io_params	*next;
 };
 
@@ -87,6 +127,7 @@ array_free(struct d_hlink *hlink)
 
 	array = container_of(hlink, struct dc_array, hlink);
 	D_ASSERT(daos_hhash_link_empty(&array->hlink));
+	pthread_mutex_destroy(&array->size_lock);
 	D_FREE(array);
 }
 
@@ -103,7 +144,20 @@ array_alloc(void)
 	if (array == NULL)
 		return NULL;
 
+	if (pthread_mutex_init(&array->size_lock, NULL) != 0) {
+		D_FREE(array);
+		return NULL;
+	}
+
 	daos_hhash_hlink_init(&array->hlink, &array_h_ops);
+	/**
+	 * The same for all the handles of the process, DAOS_ARRAY_IO_DEPTH
+	 * overrides the default, 0 issues all the dkey I/Os at once.
+	 */
+	array->io_depth = ARRAY_IO_DEPTH;
+	d_getenv_int("DAOS_ARRAY_IO_DEPTH", &array->io_depth);
+	array->io_batch = ARRAY_IO_BATCH;
+	d_getenv_int("DAOS_ARRAY_IO_BATCH", &array->io_batch);
 	return array;
 }
 
@@ -134,6 +188,94 @@ array_hdl2ptr(daos_handle_t oh)
 	return container_of(hlink, struct dc_array, hlink);
 }
 
+/*
+ * Look up the cached size of @array as seen by the transaction @th. Return
+ * false on a miss, @gen then returns the generation to store the size with.
+ */
+static bool
+array_size_lookup(struct dc_array *array, daos_handle_t th,
+		  daos_size_t *size, uint64_t *gen)
+{
+	daos_epoch_t	epoch = 0;
+	bool		hit = false;
+
+	if (!daos_handle_is_inval(th) && dc_tx_rdonly_epoch(th, &epoch) != 0)
+		return false;
+
+	D_MUTEX_LOCK(&array->size_lock);
+	if (epoch != 0) {
+		hit = (array->snap_epoch == epoch);
+		if (hit)
+			*size = array->snap_size;
+	} else if (array->mode & DAOS_OO_EXCL) {
+		hit = array->size_valid;
+		if (hit)
+			*size = array->size;
+	}
+	*gen = array->size_gen;
+	D_MUTEX_UNLOCK(&array->size_lock);
+
+	return hit;
+}
+
+/* Cache the size returned by a query issued at generation @gen. */
+static void
+array_size_store(struct dc_array *array, daos_handle_t th, uint64_t gen,
+		 daos_size_t size)
+{
+	daos_epoch_t	epoch = 0;
+
+	if (!daos_handle_is_inval(th) && dc_tx_rdonly_epoch(th, &epoch) != 0)
+		return;
+
+	D_MUTEX_LOCK(&array->size_lock);
+	if (epoch != 0) {
+		array->snap_epoch = epoch;
+		array->snap_size = size;
+	} else if ((array->mode & DAOS_OO_EXCL) && array->size_gen == gen) {
+		array->size = size;
+		array->size_valid = true;
+	}
+	D_MUTEX_UNLOCK(&array->size_lock);
+}
+
+/*
+ * Update the cached size after a modification of the array in @th completed
+ * with @rc. The size becomes @size if @exact, otherwise it is extended up to
+ * @size. Failed modifications, and those done in a transaction that may not
+ * be committed yet, drop the cached size.
+ */
+static void
+array_size_update(struct dc_array *array, daos_handle_t th, int rc,
+		  daos_size_t size, bool exact)
+{
+	if (!(array->mode & DAOS_OO_EXCL))
+		return;
+
+	D_MUTEX_LOCK(&array->size_lock);
+	array->size_gen++;
+	if (rc != 0 || !daos_handle_is_inval(th))
+		array->size_valid = false;
+	else if (exact)
+		array->size_valid = true;
+	if (array->size_valid && (exact || size > array->size))
+		array->size = size;
+	D_MUTEX_UNLOCK(&array->size_lock);
+}
+
+/* Drop the cached size, e.g. after a punch that may have shrunk the array. */
+static void
+array_size_invalidate(struct dc_array *array)
+{
+	if (!(array->mode & DAOS_OO_EXCL))
+		return;
+
+	D_MUTEX_LOCK(&array->size_lock);
+	array->size_gen++;
+	array->size_valid = false;
+	D_MUTEX_UNLOCK(&array->size_lock);
+}
+
 static void
 array_hdl_link(struct dc_array *array)
 {
@@ -182,6 +324,8 @@ free_io_params_cb(tse_task_t *task, void *data)
 			D_FREE(current->sgl.sg_iovs);
 			current->sgl.sg_iovs = NULL;
 		}
+		if (current->dios)
+			D_FREE(current->dios);
 
 		io_list = current->next;
 		D_FREE(current);
@@ -959,7 +1103,8 @@ dc_array_get_attr(daos_handle_t oh, daos_size_t *chunk_size,
 }
 
 static bool
-io_extent_same(daos_array_iod_t *iod, d_sg_list_t *sgl,
+io_extent_same(daos_array_iod_t *iod, unsigned int stride_nr,
+	       daos_array_stride_t *strides, d_sg_list_t *sgl,
 	       daos_size_t cell_size)
 {
 	daos_size_t rgs_len;
@@ -972,24 +1117,106 @@ io_extent_same(daos_array_iod_t *iod, d_sg_list_t *sgl,
 	D_DEBUG(DB_IO, "Array IOD nr = %zu\n", iod->arr_nr);
 
 	for (u = 0 ; u < iod->arr_nr ; u++) {
+		if (rgs_len + iod->arr_rgs[u].rg_len < rgs_len)
+			goto overflow;
 		rgs_len += iod->arr_rgs[u].rg_len;
 		D_DEBUG(DB_IO, "%zu: length %zu, index %d\n",
 			u, iod->arr_rgs[u].rg_len,
 			(int)iod->arr_rgs[u].rg_idx);
 	}
 
+	/** the ranges are accessed at every position of the pattern */
+	for (u = 0 ; u < stride_nr ; u++) {
+		if (strides[u].as_count != 0 &&
+		    rgs_len > UINT64_MAX / strides[u].as_count)
+			goto overflow;
+		rgs_len *= strides[u].as_count;
+		D_DEBUG(DB_IO, "stride %zu: count %zu, stride %zu\n",
+			u, strides[u].as_count, strides[u].as_stride);
+	}
+	if (cell_size != 0 && rgs_len > UINT64_MAX / cell_size)
+		goto overflow;
+
 	D_DEBUG(DB_IO, "------------------------------------\n");
 	D_DEBUG(DB_IO, "USER SGL -----------------------\n");
 	D_DEBUG(DB_IO, "sg_nr = %u\n", sgl->sg_nr);
 
 	sgl_len = 0;
 	for (u = 0 ; u < sgl->sg_nr; u++) {
+		if (sgl_len + sgl->sg_iovs[u].iov_len < sgl_len)
+			goto overflow;
 		sgl_len += sgl->sg_iovs[u].iov_len;
 		D_DEBUG(DB_IO, "%zu: length %zu, Buf %p\n", u,
 			sgl->sg_iovs[u].iov_len, sgl->sg_iovs[u].iov_buf);
 	}
 
 	return (rgs_len * cell_size == sgl_len);
+
+overflow:
+	D_ERROR("Size of the ranges or of the sgl overflows\n");
+	return false;
+}
+
+/*
+ * Check that the positions of the strided pattern do not overlap: in each
+ * dimension, a repetition starts after the end of the previous one, so the
+ * stride covers the span of the ranges and of the faster dimensions. The end
+ * of the accessed extent must also fit in the array index space.
+ */
+static int
+io_pattern_check(daos_array_iod_t *iod, unsigned int stride_nr,
+		 daos_array_stride_t *strides)
+{
+	daos_off_t	lo = UINT64_MAX;
+	daos_off_t	hi = 0;
+	daos_size_t	span;
+	daos_size_t	ext;
+	daos_size_t	u;
+	unsigned int	d;
+
+	for (u = 0; u < iod->arr_nr; u++) {
+		daos_range_t	*rg = &iod->arr_rgs[u];
+
+		if (rg->rg_len == 0)
+			continue;
+		if (rg->rg_idx + rg->rg_len < rg->rg_idx) {
+			D_ERROR("Range "DF_U64"/"DF_U64" overflows\n",
+				rg->rg_idx, rg->rg_len);
+			return -DER_INVAL;
+		}
+		lo = min(lo, rg->rg_idx);
+		hi = max(hi, rg->rg_idx + rg->rg_len);
+	}
+	/** nothing is accessed */
+	if (hi == 0)
+		return 0;
+	for (d = 0; d < stride_nr; d++)
+		if (strides[d].as_count == 0)
+			return 0;
+
+	span = hi - lo;
+	for (d = 0; d < stride_nr; d++) {
+		if (strides[d].as_count == 1)
+			continue;
+		if (strides[d].as_stride < span) {
+			D_ERROR("Stride %u of "DF_U64" overlaps a span of "
+				DF_U64" records\n", d, strides[d].as_stride,
+				span);
+			return -DER_INVAL;
+		}
+		if (strides[d].as_count - 1 > UINT64_MAX / strides[d].as_stride)
+			goto overflow;
+		ext = (strides[d].as_count - 1) * strides[d].as_stride;
+		if (hi + ext < hi)
+			goto overflow;
+		hi += ext;
+		span += ext;
+	}
+	return 0;
+
+overflow:
+	D_ERROR("Strided pattern overflows the array\n");
+	return -DER_INVAL;
 }
 
 /*
@@ -1024,7 +1251,7 @@ compute_dkey(struct dc_array *array, daos_off_t array_idx,
 static int
 create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 	   daos_size_t num_records, daos_off_t *sgl_off, daos_size_t *sgl_i,
-	   d_sg_list_t *sgl)
+	   d_sg_list_t *sgl, daos_size_t *iov_cap)
 {
 	daos_size_t	k;
 	daos_size_t	rem_records;
@@ -1034,22 +1261,28 @@ create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 	cur_i = *sgl_i;
 	cur_off = *sgl_off;
 	sgl->sg_nr = k = 0;
-	sgl->sg_iovs = NULL;
 	rem_records = num_records;
 
 	/*
 	 * Keep iterating through the user sgl till we populate our sgl to
-	 * satisfy the number of records to read/write from the KV object
+	 * satisfy the number of records to read/write from the KV object.
+	 * The iovs allocated for a previous dkey are reused.
 	 */
 	do {
 		D_ASSERT(user_sgl->sg_nr > cur_i);
 
 		sgl->sg_nr++;
-		sgl->sg_iovs = (d_iov_t *)realloc
-			(sgl->sg_iovs, sizeof(d_iov_t) * sgl->sg_nr);
-		if (sgl->sg_iovs == NULL) {
-			D_ERROR("Failed memory allocation\n");
-			return -DER_NOMEM;
+		if (sgl->sg_nr > *iov_cap) {
+			d_iov_t		*iovs;
+			daos_size_t	cap = max(*iov_cap * 2, 4);
+
+			iovs = realloc(sgl->sg_iovs, sizeof(d_iov_t) * cap);
+			if (iovs == NULL) {
+				D_ERROR("Failed memory allocation\n");
+				return -DER_NOMEM;
+			}
+			sgl->sg_iovs = iovs;
+			*iov_cap = cap;
 		}
 
 		sgl->sg_iovs[k].iov_buf = user_sgl->sg_iovs[cur_i].iov_buf +
@@ -1080,306 +1313,635 @@ create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 	return 0;
 }
 
+/*
+ * State of one array read/write/punch. The dkey I/Os are issued as a stream:
+ * at most io_depth of them are in flight, and each one that completes builds
+ * and issues the next dkey I/O from its own slot, so the iod and sgl arrays
+ * of a slot are reused across the dkeys. The dkey I/Os may complete in
+ * several threads progressing the scheduler at once, the position in the
+ * ranges, err and the slot list are protected by lock.
+ */
+struct io_stream {
+	pthread_mutex_t		lock;
+	struct dc_array		*array;
+	daos_handle_t		th;
+	daos_array_iod_t	*rg_iod;
+	d_sg_list_t		*user_sgl;
+	daos_opc_t		op_type;
+	/** the array I/O task, it depends on all the dkey I/Os */
+	tse_task_t		*task;
+	/** optional strided pattern the ranges are repeated with */
+	unsigned int		stride_nr;
+	daos_array_stride_t	*strides;
+	/** current position in the pattern and its offset in records */
+	daos_size_t		pos[DAOS_ARRAY_STRIDE_MAX];
+	daos_off_t		pos_off;
+	/** current position in the array ranges and in the user sgl */
+	daos_size_t		u;
+	daos_size_t		records;
+	daos_off_t		array_idx;
+	daos_off_t		cur_off;
+	daos_size_t		cur_i;
+	/** all the ranges have been consumed */
+	bool			done;
+	/** failure to issue a dkey I/O, no more I/O is issued after it */
+	int			err;
+	/** end of the written extent, to update the cached array size */
+	daos_size_t		end;
+	/** the slots, freed with the stream */
+	struct io_params	*head;
+};
+
 static int
-dc_array_io(daos_handle_t array_oh, daos_handle_t th,
-	    daos_array_iod_t *rg_iod, d_sg_list_t *user_sgl,
-	    daos_opc_t op_type, tse_task_t *task)
+free_io_stream_cb(tse_task_t *task, void *data)
 {
-	struct dc_array *array = NULL;
-	daos_handle_t	oh;
-	daos_off_t	cur_off; /* offset into user buf to track current pos */
-	daos_size_t	cur_i; /* index into user sgl to track current pos */
-	daos_size_t	records; /* Number of records to access in cur range */
-	daos_off_t	array_idx; /* object array index of current range */
-	daos_size_t	u; /* index in the array range rg_iod->arr_nr*/
-	daos_size_t	num_records;
-	daos_off_t	record_i;
-	daos_csum_buf_t	null_csum;
-	struct io_params *head, *current = NULL;
-	daos_size_t	num_ios;
-	d_list_t	io_task_list;
-	int		rc;
+	struct io_stream	*ios = *((struct io_stream **)data);
+	int			rc = ios->err;
 
-	if (rg_iod == NULL) {
-		D_ERROR("NULL iod passed\n");
-		D_GOTO(err_task, rc = -DER_INVAL);
+	if (ios->op_type == DAOS_OPC_ARRAY_WRITE)
+		array_size_update(ios->array, ios->th,
+				  rc ? rc : task->dt_result, ios->end, false);
+	else if (ios->op_type == DAOS_OPC_ARRAY_PUNCH)
+		array_size_invalidate(ios->array);
+
+	free_io_params_cb(task, &ios->head);
+	array_decref(ios->array);
+	pthread_mutex_destroy(&ios->lock);
+	D_FREE(ios);
+
+	return rc;
+}
+
+/*
+ * Move the stream to its next range: the next one of the iod, or the first
+ * one at the next position of the strided pattern once all the ranges are
+ * done at the current position. This is how the pattern is expanded, one
+ * range at a time, as the dkey I/Os are built.
+ *
+ * Return false if there is no range left.
+ */
+static bool
+io_stream_next_range(struct io_stream *ios)
+{
+	daos_array_iod_t	*rg_iod = ios->rg_iod;
+	unsigned int		d;
+
+	D_ASSERT(!ios->done);
+	if (++ios->u == rg_iod->arr_nr) {
+		for (d = 0; d < ios->stride_nr; d++) {
+			ios->pos_off += ios->strides[d].as_stride;
+			if (++ios->pos[d] < ios->strides[d].as_count)
+				break;
+			ios->pos_off -= ios->pos[d] * ios->strides[d].as_stride;
+			ios->pos[d] = 0;
+		}
+		/** the last position of the pattern was done */
+		if (d == ios->stride_nr) {
+			ios->done = true;
+			ios->records = 0;
+			return false;
+		}
+		ios->u = 0;
 	}
 
-	array = array_hdl2ptr(array_oh);
-	if (array == NULL)
-		D_GOTO(err_task, rc = -DER_NO_HDL);
+	ios->records = rg_iod->arr_rgs[ios->u].rg_len;
+	ios->array_idx = rg_iod->arr_rgs[ios->u].rg_idx + ios->pos_off;
+	return true;
+}
 
-	if (op_type == DAOS_OPC_ARRAY_PUNCH) {
-		D_ASSERT(user_sgl == NULL);
-	} else if (user_sgl == NULL) {
-		D_ERROR("NULL scatter-gather list passed\n");
-		D_GOTO(err_task, rc = -DER_INVAL);
-	} else if (!io_extent_same(rg_iod, user_sgl, array->cell_size)) {
-		D_ERROR("Unequal extents of memory and array descriptors\n");
-		D_GOTO(err_task, rc = -DER_INVAL);
+/*
+ * Build the iod and the sgl of the next dkey I/O of the stream in @params.
+ * Consecutive ranges that belong to the same dkey are combined. If the user
+ * gives ranges that are not increasing in offset, they probably won't be
+ * combined unless the separating ranges also belong to the same dkey.
+ *
+ * Return 1 if a dkey I/O is ready, 0 if all the ranges are done.
+ */
+static int
+io_stream_next(struct io_stream *ios, struct io_params *params)
+{
+	struct dc_array		*array = ios->array;
+	daos_array_iod_t	*rg_iod = ios->rg_iod;
+	daos_iod_t		*iod = &params->iod;
+	daos_size_t		dkey_records;
+	daos_size_t		num_records;
+	daos_off_t		record_i;
+	daos_size_t		i; /* index for iod recx */
+	int			rc;
+
+	/** In some cases, users can pass an empty range, so skip it. */
+	while (!ios->done && ios->records == 0)
+		io_stream_next_range(ios);
+	if (ios->done)
+		return 0;
+
+	rc = compute_dkey(array, ios->array_idx, &num_records, &record_i,
+			  &params->dkey_val);
+	if (rc != 0) {
+		D_ERROR("Failed to compute dkey\n");
+		return rc;
 	}
 
-	oh = array->daos_oh;
+	D_DEBUG(DB_IO, "DKEY IOD "DF_U64" -------------------------\n",
+		params->dkey_val);
+	D_DEBUG(DB_IO, "idx = %d\t num_records = %zu\t record_i = %d\n",
+		(int)ios->array_idx, num_records, (int)record_i);
+	d_iov_set(&params->dkey, &params->dkey_val, sizeof(uint64_t));
 
-	cur_off = 0;
-	cur_i = 0;
-	u = 0;
-	num_ios = 0;
-	records = rg_iod->arr_rgs[0].rg_len;
-	array_idx = rg_iod->arr_rgs[0].rg_idx;
-	dcb_set_null(&null_csum);
+	/* set descriptor for KV object, the recxs are kept from the last one */
+	d_iov_set(&iod->iod_name, &params->akey_str, 1);
+	dcb_set_null(&iod->iod_kcsum);
+	iod->iod_nr = 0;
+	iod->iod_csums = NULL;
+	iod->iod_eprs = NULL;
+	iod->iod_type = DAOS_IOD_ARRAY;
+	if (ios->op_type == DAOS_OPC_ARRAY_PUNCH)
+		iod->iod_size = 0;
+	else
+		iod->iod_size = array->cell_size;
+
+	i = 0;
+	dkey_records = 0;
 
-	head = NULL;
-	D_INIT_LIST_HEAD(&io_task_list);
 	/*
-	 * Loop over every range, but at the same time combine consecutive
-	 * ranges that belong to the same dkey. If the user gives ranges that
-	 * are not increasing in offset, they probably won't be combined unless
-	 * the separating ranges also belong to the same dkey.
+	 * Create the IO descriptor for this dkey. If the entire range
+	 * fits in the dkey, continue to the next range to see if we can
+	 * combine it fully or partially in the current dkey IOD.
 	 */
+	do {
+		daos_off_t	old_array_idx;
+
+		iod->iod_nr++;
 
-	while (u < rg_iod->arr_nr) {
-		daos_iod_t	*iod;
-		d_sg_list_t	*sgl;
-		daos_key_t	*dkey;
-		daos_size_t	dkey_records;
-		tse_task_t	*io_task = NULL;
-		struct io_params *params;
-		daos_size_t	i; /* index for iod recx */
-
-		/** In some cases, users can pass an empty range, so skip it. */
-		if (rg_iod->arr_rgs[u].rg_len == 0) {
-			u++;
-			if (u < rg_iod->arr_nr) {
-				records = rg_iod->arr_rgs[u].rg_len;
-				array_idx = rg_iod->arr_rgs[u].rg_idx;
+		/** add another element to recxs */
+		if (iod->iod_nr > params->recx_cap) {
+			daos_recx_t	*recxs;
+			daos_size_t	cap = max(params->recx_cap * 2, 4);
+
+			recxs = realloc(iod->iod_recxs,
+					sizeof(daos_recx_t) * cap);
+			if (recxs == NULL) {
+				D_ERROR("Failed memory allocation\n");
+				return -DER_NOMEM;
 			}
-			continue;
+			iod->iod_recxs = recxs;
+			params->recx_cap = cap;
 		}
 
-		/** allocate params for this dkey io */
-		D_ALLOC_PTR(params);
-		if (params == NULL) {
-			D_ERROR("Failed memory allocation\n");
-			D_GOTO(err_task, rc = -DER_NOMEM);
+		/** set the record access for this range */
+		iod->iod_recxs[i].rx_idx = record_i;
+		iod->iod_recxs[i].rx_nr = (num_records > ios->records) ?
+			ios->records : num_records;
+
+		D_DEBUG(DB_IO, "%zu: index = "DF_U64", size = %zu\n",
+			ios->u, iod->iod_recxs[i].rx_idx,
+			iod->iod_recxs[i].rx_nr);
+
+		/*
+		 * if the current range is bigger than what the dkey can
+		 * hold, update the array index and number of records in
+		 * the current range and break to issue the I/O on the
+		 * current dkey.
+		 */
+		if (ios->records > num_records) {
+			ios->array_idx += num_records;
+			ios->records -= num_records;
+			dkey_records += num_records;
+			break;
 		}
 
+		/** bump the index for the iods */
+		i++;
+		dkey_records += ios->records;
+		old_array_idx = ios->array_idx;
+
+		/** if there are no more ranges to write, then break */
+		if (!io_stream_next_range(ios))
+			break;
+
 		/*
-		 * since we probably have multiple dkey ios, put them in linked
-		 * list to free later.
+		 * Boundary case where number of records align with the
+		 * end boundary of the dkey. break after we have
+		 * advanced to the next range in the array iod.
 		 */
-		if (num_ios == 0) {
-			head = params;
-			current = head;
-			tse_task_register_comp_cb(task, free_io_params_cb,
-						  &head, sizeof(head));
+		if (ios->records == num_records)
+			break;
+
+		/** process the next range in the cur dkey */
+		if (ios->array_idx < old_array_idx + num_records &&
+		    ios->array_idx >= ((old_array_idx + num_records) -
+				       array->chunk_size)) {
+			uint64_t dkey_val_tmp;
+
+			/*
+			 * verify that the dkey is the same as the one
+			 * we are working on given the array index, and
+			 * also compute the number of records left in
+			 * the dkey and the record indexin the dkey.
+			 */
+			rc = compute_dkey(array, ios->array_idx,
+					  &num_records, &record_i,
+					  &dkey_val_tmp);
+			if (rc != 0) {
+				D_ERROR("Failed to compute dkey\n");
+				return rc;
+			}
+
+			D_ASSERT(dkey_val_tmp == params->dkey_val);
 		} else {
-			D_ASSERT(current);
-			current->next = params;
-			current = params;
+			break;
 		}
+	} while (1);
 
-		iod = &params->iod;
-		sgl = &params->sgl;
-		dkey = &params->dkey;
-		params->akey_str = '0';
-		params->user_sgl_used = false;
+	D_DEBUG(DB_IO, "END DKEY IOD "DF_U64" ---------------------\n",
+		params->dkey_val);
+	params->records = dkey_records;
 
-		num_ios++;
+	/*
+	 * if the user sgl maps directly to the array range, no need to
+	 * partition it.
+	 */
+	if ((ios->op_type == DAOS_OPC_ARRAY_PUNCH) ||
+	    (1 == rg_iod->arr_nr && 0 == ios->stride_nr &&
+	     1 == ios->user_sgl->sg_nr &&
+	     dkey_records == rg_iod->arr_rgs[0].rg_len)) {
+		params->user_sgl_used = true;
+		return 1;
+	}
 
-		rc = compute_dkey(array, array_idx, &num_records, &record_i,
-				  &params->dkey_val);
-		if (rc != 0) {
-			D_ERROR("Failed to compute dkey\n");
-			D_GOTO(err_task, rc);
+	/** create an sgl from the user sgl for the current IOD */
+	params->user_sgl_used = false;
+	rc = create_sgl(ios->user_sgl, array->cell_size, dkey_records,
+			&ios->cur_off, &ios->cur_i, &params->sgl,
+			&params->iov_cap);
+	if (rc != 0) {
+		D_ERROR("Failed to create sgl\n");
+		return rc;
+	}
+
+	return 1;
+}
+
+/*
+ * Build the next I/O of the slot @params: the next dkey I/O of the stream,
+ * followed by as many of the next dkey I/Os as can be batched with it in a
+ * single multi-dkey I/O. Only the arrays with small chunks are batched, up to
+ * ARRAY_IO_BATCH_SIZE bytes per I/O, the large chunks are still spread over
+ * the slots.
+ *
+ * Return 1 if an I/O is ready, 0 if all the ranges are done.
+ */
+static int
+io_stream_fill(struct io_stream *ios, struct io_params *params)
+{
+	struct dc_array		*array = ios->array;
+	struct io_params	**prev = &params->batch;
+	struct io_params	*bp;
+	daos_size_t		chunk_bytes;
+	daos_size_t		bytes;
+	int			rc;
+
+	params->batch_nr = 0;
+	rc = io_stream_next(ios, params);
+	if (rc <= 0)
+		return rc;
+
+	params->batch_nr = 1;
+	/** a dkey I/O is at most one chunk */
+	chunk_bytes = array->chunk_size * array->cell_size;
+	bytes = params->records * array->cell_size;
+	while (params->batch_nr < array->io_batch && !ios->done &&
+	       bytes + chunk_bytes <= ARRAY_IO_BATCH_SIZE) {
+		/** the batch entries are reused by the next I/Os of the slot */
+		bp = *prev;
+		if (bp == NULL) {
+			D_ALLOC_PTR(bp);
+			if (bp == NULL)
+				return -DER_NOMEM;
+			bp->next = ios->head;
+			ios->head = bp;
+			bp->stream = ios;
+			bp->akey_str = '0';
+			*prev = bp;
 		}
 
-		D_DEBUG(DB_IO, "DKEY IOD "DF_U64" -------------------------\n",
-			params->dkey_val);
-		D_DEBUG(DB_IO, "idx = %d\t num_records = %zu\t record_i = %d\n",
-			(int)array_idx, num_records, (int)record_i);
-		d_iov_set(dkey, &params->dkey_val, sizeof(uint64_t));
-
-		/* set descriptor for KV object */
-		d_iov_set(&iod->iod_name, &params->akey_str, 1);
-		iod->iod_kcsum = null_csum;
-		iod->iod_nr = 0;
-		iod->iod_csums = NULL;
-		iod->iod_eprs = NULL;
-		iod->iod_recxs = NULL;
-		iod->iod_type = DAOS_IOD_ARRAY;
-		if (op_type == DAOS_OPC_ARRAY_PUNCH)
-			iod->iod_size = 0;
-		else
-			iod->iod_size = array->cell_size;
-
-		i = 0;
-		dkey_records = 0;
+		/** the records are consumed, the entry must be sent */
+		rc = io_stream_next(ios, bp);
+		if (rc < 0)
+			return rc;
+		if (rc == 0)
+			break;
 
-		/*
-		 * Create the IO descriptor for this dkey. If the entire range
-		 * fits in the dkey, continue to the next range to see if we can
-		 * combine it fully or partially in the current dkey IOD.
-		 */
-		do {
-			daos_off_t	old_array_idx;
+		params->batch_nr++;
+		bytes += bp->records * array->cell_size;
+		prev = &bp->batch;
+	}
 
-			iod->iod_nr++;
+	return 1;
+}
 
-			/** add another element to recxs */
-			iod->iod_recxs = (daos_recx_t *)realloc
-				(iod->iod_recxs, sizeof(daos_recx_t) *
-				 iod->iod_nr);
-			if (iod->iod_recxs == NULL) {
-				D_ERROR("Failed memory allocation\n");
-				D_GOTO(err_task, rc = -DER_NOMEM);
-			}
+static int io_stream_issue(struct io_stream *ios, struct io_params *params);
 
-			/** set the record access for this range */
-			iod->iod_recxs[i].rx_idx = record_i;
-			iod->iod_recxs[i].rx_nr = (num_records > records) ?
-				records : num_records;
+/*
+ * Completion of a dkey I/O: reuse its slot for the next dkey of the stream.
+ * The new I/O is added as a dependency of the array task before this one is
+ * accounted as done, so the array task completes only after the last one.
+ */
+static int
+io_params_next_cb(tse_task_t *task, void *data)
+{
+	struct io_params	*params = *((struct io_params **)data);
+	struct io_stream	*ios = params->stream;
+	int			rc = task->dt_result;
 
-			D_DEBUG(DB_IO, "%zu: index = "DF_U64", size = %zu\n",
-				u, iod->iod_recxs[i].rx_idx,
-				iod->iod_recxs[i].rx_nr);
+	/** a failure is propagated to the array task, do not issue more */
+	if (rc != 0)
+		return rc;
 
-			/*
-			 * if the current range is bigger than what the dkey can
-			 * hold, update the array index and number of records in
-			 * the current range and break to issue the I/O on the
-			 * current dkey.
-			 */
-			if (records > num_records) {
-				array_idx += num_records;
-				records -= num_records;
-				dkey_records += num_records;
-				break;
-			}
+	D_MUTEX_LOCK(&ios->lock);
+	if (ios->err != 0) {
+		D_MUTEX_UNLOCK(&ios->lock);
+		return 0;
+	}
+	rc = io_stream_fill(ios, params);
+	if (rc < 0)
+		ios->err = rc;
+	D_MUTEX_UNLOCK(&ios->lock);
+	if (rc <= 0)
+		return 0;
+
+	/** the slot is only used by this I/O, issue it unlocked */
+	rc = io_stream_issue(ios, params);
+	if (rc < 0) {
+		D_MUTEX_LOCK(&ios->lock);
+		ios->err = rc;
+		D_MUTEX_UNLOCK(&ios->lock);
+	}
+	return 0;
+}
 
-			/** bump the index for the iods */
-			u++;
-			i++;
-			dkey_records += records;
+/* create the multi-dkey I/O task of the batch of the slot @params */
+static int
+io_stream_issue_multi(struct io_stream *ios, struct io_params *params,
+		      tse_task_t **io_task)
+{
+	daos_obj_multi_rw_t	*io_arg;
+	struct io_params	*bp;
+	daos_dkey_io_t		*dio;
+	daos_opc_t		opc;
+	unsigned int		i;
+	int			rc;
 
-			/** if there are no more ranges to write, then break */
-			if (rg_iod->arr_nr <= u)
-				break;
+	if (params->dios == NULL) {
+		D_ALLOC_ARRAY(params->dios, ios->array->io_batch);
+		if (params->dios == NULL)
+			return -DER_NOMEM;
+	}
 
-			old_array_idx = array_idx;
-			records = rg_iod->arr_rgs[u].rg_len;
-			array_idx = rg_iod->arr_rgs[u].rg_idx;
+	for (i = 0, bp = params; i < params->batch_nr; i++, bp = bp->batch) {
+		dio = &params->dios[i];
+		dio->dio_dkey	= &bp->dkey;
+		dio->dio_nr	= 1;
+		dio->dio_iods	= &bp->iod;
+		dio->dio_sgls	= bp->user_sgl_used ? ios->user_sgl : &bp->sgl;
+	}
 
-			/*
-			 * Boundary case where number of records align with the
-			 * end boundary of the dkey. break after we have
-			 * advanced to the next range in the array iod.
-			 */
-			if (records == num_records)
-				break;
+	opc = ios->op_type == DAOS_OPC_ARRAY_READ ?
+	      DAOS_OPC_OBJ_FETCH_MULTI : DAOS_OPC_OBJ_UPDATE_MULTI;
+	rc = daos_task_create(opc, tse_task2sched(ios->task), 0, NULL,
+			      io_task);
+	if (rc != 0) {
+		D_ERROR("I/O of %u dkeys from "DF_U64" failed (%d)\n",
+			params->batch_nr, params->dkey_val, rc);
+		return rc;
+	}
 
-			/** process the next range in the cur dkey */
-			if (array_idx < old_array_idx + num_records &&
-			    array_idx >= ((old_array_idx + num_records) -
-					  array->chunk_size)) {
-				uint64_t dkey_val_tmp;
-
-				/*
-				 * verify that the dkey is the same as the one
-				 * we are working on given the array index, and
-				 * also compute the number of records left in
-				 * the dkey and the record indexin the dkey.
-				 */
-				rc = compute_dkey(array, array_idx,
-						  &num_records, &record_i,
-						  &dkey_val_tmp);
-				if (rc != 0) {
-					D_ERROR("Failed to compute dkey\n");
-					D_GOTO(err_task, rc);
-				}
-
-				D_ASSERT(dkey_val_tmp == params->dkey_val);
-			} else {
-				break;
-			}
-		} while (1);
+	io_arg = daos_task_get_args(*io_task);
+	io_arg->oh	= ios->array->daos_oh;
+	io_arg->th	= ios->th;
+	io_arg->nr	= params->batch_nr;
+	io_arg->ios	= params->dios;
+	return 0;
+}
 
-		D_DEBUG(DB_IO, "END DKEY IOD "DF_U64" ---------------------\n",
-			params->dkey_val);
+/* issue the dkey I/O prepared in @params to DAOS */
+static int
+io_stream_issue(struct io_stream *ios, struct io_params *params)
+{
+	tse_task_t	*task = ios->task;
+	tse_task_t	*io_task = NULL;
+	d_sg_list_t	*sgl;
+	int		rc;
 
-		/*
-		 * if the user sgl maps directly to the array range, no need to
-		 * partition it.
-		 */
-		if ((op_type == DAOS_OPC_ARRAY_PUNCH) ||
-		    (1 == rg_iod->arr_nr && 1 == user_sgl->sg_nr &&
-		     dkey_records == rg_iod->arr_rgs[0].rg_len)) {
-			sgl = user_sgl;
-			params->user_sgl_used = true;
+	sgl = params->user_sgl_used ? ios->user_sgl : &params->sgl;
+
+	if (params->batch_nr > 1) {
+		rc = io_stream_issue_multi(ios, params, &io_task);
+		if (rc != 0)
+			return rc;
+	} else if (ios->op_type == DAOS_OPC_ARRAY_READ) {
+		daos_obj_fetch_t *io_arg;
+
+		rc = daos_task_create(DAOS_OPC_OBJ_FETCH,
+				      tse_task2sched(task), 0, NULL, &io_task);
+		if (rc != 0) {
+			D_ERROR("Fetch dkey "DF_U64" failed (%d)\n",
+				params->dkey_val, rc);
+			return rc;
 		}
-		/** create an sgl from the user sgl for the current IOD */
-		else {
-			/* set sgl for current dkey */
-			rc = create_sgl(user_sgl, array->cell_size,
-					dkey_records, &cur_off, &cur_i, sgl);
-			if (rc != 0) {
-				D_ERROR("Failed to create sgl\n");
-				D_GOTO(err_task, rc);
-			}
+		io_arg = daos_task_get_args(io_task);
+		io_arg->oh	= ios->array->daos_oh;
+		io_arg->th	= ios->th;
+		io_arg->dkey	= &params->dkey;
+		io_arg->nr	= 1;
+		io_arg->iods	= &params->iod;
+		io_arg->sgls	= sgl;
+		io_arg->maps	= NULL;
+	} else if (ios->op_type == DAOS_OPC_ARRAY_WRITE ||
+		   ios->op_type == DAOS_OPC_ARRAY_PUNCH) {
+		daos_obj_update_t *io_arg;
+
+		rc = daos_task_create(DAOS_OPC_OBJ_UPDATE,
+				      tse_task2sched(task), 0, NULL, &io_task);
+		if (rc != 0) {
+			D_ERROR("Update dkey "DF_U64" failed (%d)\n",
+				params->dkey_val, rc);
+			return rc;
 		}
+		io_arg = daos_task_get_args(io_task);
+		io_arg->oh	= ios->array->daos_oh;
+		io_arg->th	= ios->th;
+		io_arg->dkey	= &params->dkey;
+		io_arg->nr	= 1;
+		io_arg->iods	= &params->iod;
+		io_arg->sgls	= sgl;
+	} else {
+		D_ASSERTF(0, "Invalid array operation.\n");
+	}
 
-		/* issue IO to DAOS */
-		if (op_type == DAOS_OPC_ARRAY_READ) {
-			daos_obj_fetch_t *io_arg;
+	rc = tse_task_register_comp_cb(io_task, io_params_next_cb, &params,
+				       sizeof(params));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
 
-			rc = daos_task_create(DAOS_OPC_OBJ_FETCH,
-					      tse_task2sched(task),
-					      0, NULL, &io_task);
-			if (rc != 0) {
-				D_ERROR("Fetch dkey "DF_U64" failed (%d)\n",
-					params->dkey_val, rc);
-				D_GOTO(err_task, rc);
-			}
-			io_arg = daos_task_get_args(io_task);
-			io_arg->oh	= oh;
-			io_arg->th	= th;
-			io_arg->dkey	= dkey;
-			io_arg->nr	= 1;
-			io_arg->iods	= iod;
-			io_arg->sgls	= sgl;
-			io_arg->maps	= NULL;
-		} else if (op_type == DAOS_OPC_ARRAY_WRITE ||
-			   op_type == DAOS_OPC_ARRAY_PUNCH) {
-			daos_obj_update_t *io_arg;
-
-			rc = daos_task_create(DAOS_OPC_OBJ_UPDATE,
-					      tse_task2sched(task),
-					      0, NULL, &io_task);
-			if (rc != 0) {
-				D_ERROR("Update dkey "DF_U64" failed (%d)\n",
-					params->dkey_val, rc);
-				D_GOTO(err_task, rc);
-			}
-			io_arg = daos_task_get_args(io_task);
-			io_arg->oh	= oh;
-			io_arg->th	= th;
-			io_arg->dkey	= dkey;
-			io_arg->nr	= 1;
-			io_arg->iods	= iod;
-			io_arg->sgls	= sgl;
-		} else {
-			D_ASSERTF(0, "Invalid array operation.\n");
-		}
+	rc = tse_task_register_deps(task, 1, &io_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
 
-		tse_task_register_deps(task, 1, &io_task);
-		tse_task_list_add(io_task, &io_task_list);
-	} /* end while */
+	return tse_task_schedule(io_task, false);
+
+err_task:
+	tse_task_complete(io_task, rc);
+	return rc;
+}
+
+/* Return the end of the extent accessed by the ranges and the pattern. */
+static daos_size_t
+io_extent_end(daos_array_iod_t *rg_iod, unsigned int stride_nr,
+	      daos_array_stride_t *strides)
+{
+	daos_size_t	end = 0;
+	daos_size_t	i;
+	unsigned int	d;
+
+	for (i = 0; i < rg_iod->arr_nr; i++) {
+		if (rg_iod->arr_rgs[i].rg_len == 0)
+			continue;
+		end = max(end, rg_iod->arr_rgs[i].rg_idx +
+			  rg_iod->arr_rgs[i].rg_len);
+	}
+	if (end == 0)
+		return 0;
+
+	/** the last position of the pattern has the highest offset */
+	for (d = 0; d < stride_nr; d++)
+		end += (strides[d].as_count - 1) * strides[d].as_stride;
+
+	return end;
+}
+
+static int
+dc_array_io(daos_handle_t array_oh, daos_handle_t th,
+	    daos_array_iod_t *rg_iod, unsigned int stride_nr,
+	    daos_array_stride_t *strides, d_sg_list_t *user_sgl,
+	    daos_opc_t op_type, tse_task_t *task)
+{
+	struct dc_array		*array = NULL;
+	struct io_stream	*ios;
+	struct io_params	*params;
+	unsigned int		num_ios;
+	unsigned int		d;
+	int			rc;
+
+	if (rg_iod == NULL) {
+		D_ERROR("NULL iod passed\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	if (stride_nr > DAOS_ARRAY_STRIDE_MAX ||
+	    (stride_nr > 0 && strides == NULL)) {
+		D_ERROR("Invalid strided pattern, %u dimensions\n",
+			stride_nr);
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	rc = io_pattern_check(rg_iod, stride_nr, strides);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	array = array_hdl2ptr(array_oh);
+	if (array == NULL)
+		D_GOTO(err_task, rc = -DER_NO_HDL);
+
+	if (op_type == DAOS_OPC_ARRAY_PUNCH) {
+		D_ASSERT(user_sgl == NULL);
+	} else if (user_sgl == NULL) {
+		D_ERROR("NULL scatter-gather list passed\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	} else if (!io_extent_same(rg_iod, stride_nr, strides, user_sgl,
+				   array->cell_size)) {
+		D_ERROR("Unequal extents of memory and array descriptors\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	D_ALLOC_PTR(ios);
+	if (ios == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+	if (pthread_mutex_init(&ios->lock, NULL) != 0) {
+		D_FREE(ios);
+		D_GOTO(err_task, rc = -DER_NOMEM);
+	}
+
+	/** the stream holds the array reference until the task completes */
+	ios->array = array;
+	ios->th = th;
+	ios->rg_iod = rg_iod;
+	ios->user_sgl = user_sgl;
+	ios->op_type = op_type;
+	ios->task = task;
+	ios->stride_nr = stride_nr;
+	ios->strides = strides;
+	ios->done = (rg_iod->arr_nr == 0);
+	for (d = 0; d < stride_nr; d++) {
+		/** a pattern with no repetition in a dimension is empty */
+		if (strides[d].as_count == 0)
+			ios->done = true;
+	}
+	if (!ios->done) {
+		ios->records = rg_iod->arr_rgs[0].rg_len;
+		ios->array_idx = rg_iod->arr_rgs[0].rg_idx;
+		if (op_type == DAOS_OPC_ARRAY_WRITE)
+			ios->end = io_extent_end(rg_iod, stride_nr, strides);
+	}
+
+	rc = tse_task_register_comp_cb(task, free_io_stream_cb, &ios,
+				       sizeof(ios));
+	if (rc != 0) {
+		pthread_mutex_destroy(&ios->lock);
+		D_FREE(ios);
+		D_GOTO(err_task, rc);
+	}
+	array = NULL;
+
+	/*
+	 * Start up to io_depth dkey I/Os, the following ones are issued as
+	 * those complete, possibly while this loop still fills the stream.
+	 */
+	for (num_ios = 0; ios->array->io_depth == 0 ||
+	     num_ios < ios->array->io_depth; num_ios++) {
+		D_ALLOC_PTR(params);
+		if (params == NULL)
+			D_GOTO(err_stream, rc = -DER_NOMEM);
+
+		params->stream = ios;
+		params->akey_str = '0';
+
+		D_MUTEX_LOCK(&ios->lock);
+		params->next = ios->head;
+		ios->head = params;
+		rc = ios->err != 0 ? 0 : io_stream_fill(ios, params);
+		D_MUTEX_UNLOCK(&ios->lock);
+		if (rc < 0)
+			D_GOTO(err_stream, rc);
+		if (rc == 0)
+			break;
+
+		rc = io_stream_issue(ios, params);
+		if (rc != 0)
+			D_GOTO(err_stream, rc);
+	}
 
-	tse_task_list_sched(&io_task_list, false);
-	array_decref(array);
 	tse_sched_progress(tse_task2sched(task));
 	return 0;
 
+err_stream:
+	/** let the dkey I/Os already in flight finish, then fail the task */
+	if (num_ios > 0) {
+		D_MUTEX_LOCK(&ios->lock);
+		ios->err = rc;
+		D_MUTEX_UNLOCK(&ios->lock);
+		return 0;
+	}
 err_task:
 	if (array)
 		array_decref(array);
@@ -1392,8 +1954,8 @@ dc_array_read(tse_task_t *task)
 {
 	daos_array_io_t *args = daos_task_get_args(task);
 
-	return dc_array_io(args->oh, args->th, args->iod, args->sgl,
-			   DAOS_OPC_ARRAY_READ, task);
+	return dc_array_io(args->oh, args->th, args->iod, args->stride_nr,
+			   args->strides, args->sgl, DAOS_OPC_ARRAY_READ, task);
 }
 
 int
@@ -1401,8 +1963,9 @@ dc_array_write(tse_task_t *task)
 {
 	daos_array_io_t *args = daos_task_get_args(task);
 
-	return dc_array_io(args->oh, args->th, args->iod, args->sgl,
-			   DAOS_OPC_ARRAY_WRITE, task);
+	return dc_array_io(args->oh, args->th, args->iod, args->stride_nr,
+			   args->strides, args->sgl, DAOS_OPC_ARRAY_WRITE,
+			   task);
 }
 
 int
@@ -1410,7 +1973,7 @@ dc_array_punch(tse_task_t *task)
 {
 	daos_array_io_t *args = daos_task_get_args(task);
 
-	return dc_array_io(args->oh, args->th, args->iod, NULL,
+	return dc_array_io(args->oh, args->th, args->iod, 0, NULL, NULL,
 			   DAOS_OPC_ARRAY_PUNCH, task);
 }
 
@@ -1427,6 +1990,9 @@ struct key_query_props {
 	daos_recx_t		recx;
 	daos_size_t		*size;
 	tse_task_t		*ptask;
+	daos_handle_t		th;
+	/** generation of the cached size when the query was issued */
+	uint64_t		gen;
 };
 
 static int
@@ -1454,14 +2020,14 @@ get_array_size_cb(tse_task_t *task, void *data)
 	D_DEBUG(DB_IO, "Key Query: dkey %zu, IDX %"PRIu64", NR %"PRIu64"\n",
 		props->dkey_val, props->recx.rx_idx, props->recx.rx_nr);
 
-	if (props->dkey_val == 0) {
+	if (props->dkey_val == 0)
 		*props->size = 0;
-		return rc;
-	}
-
-	*props->size = props->array->chunk_size * (props->dkey_val - 1) +
-		props->recx.rx_idx + props->recx.rx_nr;
+	else
+		*props->size = props->array->chunk_size *
+			(props->dkey_val - 1) + props->recx.rx_idx +
+			props->recx.rx_nr;
 
+	array_size_store(props->array, props->th, props->gen, *props->size);
 	return rc;
 }
 
@@ -1474,12 +2040,20 @@ dc_array_get_size(tse_task_t *task)
 	struct key_query_props	*kqp = NULL;
 	tse_task_t		*query_task = NULL;
 	daos_handle_t		oh;
+	uint64_t		gen;
 	int			rc;
 
 	array = array_hdl2ptr(args->oh);
 	if (array == NULL)
 		D_GOTO(err_task, rc = -DER_NO_HDL);
 
+	/** no round trip if the size is known by this handle */
+	if (array_size_lookup(array, args->th, args->size, &gen)) {
+		array_decref(array);
+		tse_task_complete(task, 0);
+		return 0;
+	}
+
 	oh = array->daos_oh;
 
 	D_ALLOC_PTR(kqp);
@@ -1495,6 +2069,8 @@ dc_array_get_size(tse_task_t *task)
 	kqp->ptask	= task;
 	kqp->size	= args->size;
 	kqp->array	= array;
+	kqp->th		= args->th;
+	kqp->gen	= gen;
 
 	rc = daos_task_create(DAOS_OPC_OBJ_QUERY_KEY, tse_task2sched(task),
 			      0, NULL, &query_task);
@@ -1560,6 +2136,7 @@ struct set_size_props {
 	daos_size_t	chunk_size;
 	daos_off_t	record_i;
 	tse_task_t	*ptask;
+	daos_handle_t	th;
 };
 
 static int
@@ -1567,6 +2144,9 @@ free_set_size_cb(tse_task_t *task, void *data)
 {
 	struct set_size_props *props = *((struct set_size_props **)data);
 
+	if (props->array)
+		array_size_update(props->array, props->th, task->dt_result,
+				  props->size, true);
 	if (props->val)
 		D_FREE(props->val);
 	if (props->array)
@@ -2103,6 +2683,7 @@ dc_array_set_size(tse_task_t *task)
 	set_size_props->nr = ENUM_DESC_NR;
 	set_size_props->size = args->size;
 	set_size_props->ptask = task;
+	set_size_props->th = args->th;
 	set_size_props->val = NULL;
 	if (args->size == 0)
 		set_size_props->update_dkey = false;
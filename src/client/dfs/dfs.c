@@ -60,7 +60,7 @@
 #define DFS_DEFAULT_OBJ_CLASS	OC_SX
 
 /** Number of A-keys for attributes in any object entry */
-#define INODE_AKEYS	7
+#define INODE_AKEYS	8
 /** A-key name of mode_t value */
 #define MODE_NAME	"mode"
 /** A-key name of object ID value */
@@ -73,8 +73,38 @@
 #define MTIME_NAME	"mtime"
 /** A-key name of last change time */
 #define CTIME_NAME	"ctime"
+/** A-key name of the size of a file inlined in its entry */
+#define ISIZE_NAME	"isize"
 /** A-key name of symlink value */
 #define SYML_NAME	"syml"
+/** A-key name of the data of a file inlined in its entry */
+#define DATA_NAME	"data"
+
+/** Upper bound of the read-ahead unit, a smaller chunk size is used as is */
+#define DFS_RA_MAX_SIZE		(1024 * 1024)
+/** Number of sequential reads in a row that start the read-ahead */
+#define DFS_RA_TRIGGER		2
+/** Upper bound of the read-ahead units per file */
+#define DFS_RA_MAX_DEPTH	64
+/** Upper bound of the write-back buffer, a smaller chunk size is used as is */
+#define DFS_WB_MAX_SIZE		(4 * 1024 * 1024)
+/** Number of write-back buffers per file, one filled while others flush */
+#define DFS_WB_BUF_NR		2
+/** Buffered data older than this (in ns) is flushed by the next write */
+#define DFS_WB_FLUSH_INTV	NSEC_PER_SEC
+/** Number of buckets of the dentry cache hash table (2^DFS_DC_BITS) */
+#define DFS_DC_BITS		10
+/** Upper bound of the dentry cache entries, the LRU ones are dropped */
+#define DFS_DC_MAX_NR		(16 * 1024)
+
+/** Upper bound of the data of a regular file inlined in its entry */
+#define DFS_INLINE_MAX		4096
+/** Entry locks of the inlined files, see dfs_inl_lock() */
+#define DFS_INL_LOCKS		64
+
+/** Entries listed per batch and punches in flight of a recursive removal */
+#define DFS_RM_BATCH		128
+#define DFS_RM_INFLIGHT		64
 
 /** Parameters for dkey enumeration */
 #define ENUM_DESC_NR    10
@@ -104,6 +134,12 @@ struct dfs_obj {
 	char			name[DFS_MAX_PATH + 1];
 	/** Symlink value if object is a symbolic link */
 	char			*value;
+	/** read-ahead state of a regular file, allocated on the first read */
+	struct dfs_ra		*ra;
+	/** write-back buffer of a regular file, allocated on the first write */
+	struct dfs_wb		*wb;
+	/** data of a file inlined in its entry, kept once migrated */
+	struct dfs_inl		*inl;
 };
 
 /** dfs struct that is instantiated for a mounted DFS namespace */
@@ -133,6 +169,22 @@ struct dfs {
 	/** Optional Prefix to account for when resolving an absolute path */
 	char			*prefix;
 	daos_size_t		prefix_len;
+	/** Number of read-ahead units per file, 0 disables read-ahead */
+	unsigned int		ra_depth;
+	/** Whether small writes are buffered in the write-back buffers */
+	bool			wb_enabled;
+	/** write-back buffers of the open files, protected by lock */
+	d_list_t		wb_list;
+	/** last time wb_list was scanned for the aged buffers */
+	uint64_t		wb_scan;
+	/** lifetime of the dentry cache entries in ns, 0 disables the cache */
+	uint64_t		dc_timeout;
+	/** dentry cache, see lookup_entry() */
+	struct dfs_dcache	*dc;
+	/** new files keep their data in their entry up to this size */
+	unsigned int		inline_size;
+	/** entry locks of the inlined files, see dfs_inl_lock() */
+	pthread_mutex_t		inl_locks[DFS_INL_LOCKS];
 };
 
 struct dfs_entry {
@@ -150,6 +202,10 @@ struct dfs_entry {
 	time_t		mtime;
 	/* Time of last status change */
 	time_t		ctime;
+	/** File size if the file data is inlined in the entry */
+	daos_size_t	isize;
+	/** Whether the file data is inlined in the entry, see DATA_NAME */
+	bool		inl;
 };
 
 #if 0
@@ -272,26 +328,15 @@ oid_gen(dfs_t *dfs, uint16_t oclass, bool file, daos_obj_id_t *oid)
 	return 0;
 }
 
-static int
-fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
-	    bool fetch_sym, bool *exists, struct dfs_entry *entry)
+/**
+ * Set the a-key names and the sg iovs to fetch the inode a-keys of @entry, up
+ * to the size of an inlined file. Returns the number of a-keys set, the size
+ * a-key is the last one.
+ */
+static unsigned int
+set_entry_akeys(struct dfs_entry *entry, daos_iod_t *iods, d_iov_t *sg_iovs)
 {
-	d_sg_list_t	sgls[INODE_AKEYS];
-	d_iov_t		sg_iovs[INODE_AKEYS];
-	daos_iod_t	iods[INODE_AKEYS];
-	char		*value = NULL;
-	daos_key_t	dkey;
-	unsigned int	akeys_nr, i;
-	int		rc;
-
-	D_ASSERT(name);
-
-	/** TODO - not supported yet */
-	if (strcmp(name, ".") == 0)
-		D_ASSERT(0);
-
-	d_iov_set(&dkey, (void *)name, strlen(name));
-	i = 0;
+	unsigned int	i = 0;
 
 	/** Set Akey for MODE */
 	d_iov_set(&sg_iovs[i], &entry->mode, sizeof(mode_t));
@@ -323,19 +368,22 @@ fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 	d_iov_set(&iods[i].iod_name, CTIME_NAME, strlen(CTIME_NAME));
 	i++;
 
-	if (fetch_sym) {
-		value = malloc(PATH_MAX);
-		if (value == NULL)
-			return ENOMEM;
-		/** Set Akey for Symlink Value, will be empty if no symlink */
-		d_iov_set(&sg_iovs[i], value, PATH_MAX);
-		d_iov_set(&iods[i].iod_name, SYML_NAME, strlen(SYML_NAME));
-		i++;
-	}
+	/** Set Akey for the size of an inlined file, empty if not inlined */
+	d_iov_set(&sg_iovs[i], &entry->isize, sizeof(daos_size_t));
+	d_iov_set(&iods[i].iod_name, ISIZE_NAME, strlen(ISIZE_NAME));
+	i++;
 
-	akeys_nr = i;
+	return i;
+}
 
-	for (i = 0; i < akeys_nr; i++) {
+/** Set the single value iods and the sgls of the @nr a-keys to fetch */
+static void
+set_fetch_iods(daos_iod_t *iods, d_sg_list_t *sgls, d_iov_t *sg_iovs,
+	       unsigned int nr)
+{
+	unsigned int	i;
+
+	for (i = 0; i < nr; i++) {
 		sgls[i].sg_nr		= 1;
 		sgls[i].sg_nr_out	= 0;
 		sgls[i].sg_iovs		= &sg_iovs[i];
@@ -348,6 +396,56 @@ fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 		iods[i].iod_csums	= NULL;
 		iods[i].iod_type	= DAOS_IOD_SINGLE;
 	}
+}
+
+/**
+ * Fetch the entry @name, and in the same RPC the data of the file if it is
+ * inlined in the entry and @data is not NULL. @data must have room for
+ * DFS_INLINE_MAX bytes, its length is set to the size of the inlined data.
+ */
+static int
+fetch_entry_data(daos_handle_t oh, daos_handle_t th, const char *name,
+		 bool fetch_sym, d_iov_t *data, bool *exists,
+		 struct dfs_entry *entry)
+{
+	d_sg_list_t	sgls[INODE_AKEYS + 1];
+	d_iov_t		sg_iovs[INODE_AKEYS + 1];
+	daos_iod_t	iods[INODE_AKEYS + 1];
+	char		*value = NULL;
+	daos_key_t	dkey;
+	unsigned int	akeys_nr, isize_idx, data_idx, i;
+	int		rc;
+
+	D_ASSERT(name);
+
+	/** TODO - not supported yet */
+	if (strcmp(name, ".") == 0)
+		D_ASSERT(0);
+
+	d_iov_set(&dkey, (void *)name, strlen(name));
+	i = set_entry_akeys(entry, iods, sg_iovs);
+	isize_idx = i - 1;
+
+	if (fetch_sym) {
+		value = malloc(PATH_MAX);
+		if (value == NULL)
+			return ENOMEM;
+		/** Set Akey for Symlink Value, will be empty if no symlink */
+		d_iov_set(&sg_iovs[i], value, PATH_MAX);
+		d_iov_set(&iods[i].iod_name, SYML_NAME, strlen(SYML_NAME));
+		i++;
+	}
+
+	data_idx = i;
+	if (data) {
+		/** Set Akey for the inlined file data */
+		d_iov_set(&sg_iovs[i], data->iov_buf, DFS_INLINE_MAX);
+		d_iov_set(&iods[i].iod_name, DATA_NAME, strlen(DATA_NAME));
+		i++;
+	}
+
+	akeys_nr = i;
+	set_fetch_iods(iods, sgls, sg_iovs, akeys_nr);
 
 	rc = daos_obj_fetch(oh, th, &dkey, akeys_nr, iods, sgls, NULL, NULL);
 	if (rc) {
@@ -366,6 +464,12 @@ fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 		}
 	}
 
+	entry->inl = iods[isize_idx].iod_size != 0;
+	if (!entry->inl)
+		entry->isize = 0;
+	if (data)
+		data->iov_len = entry->inl ? iods[data_idx].iod_size : 0;
+
 	if (iods[0].iod_size == 0)
 		*exists = false;
 	else
@@ -377,6 +481,13 @@ out:
 	return rc;
 }
 
+static inline int
+fetch_entry(daos_handle_t oh, daos_handle_t th, const char *name,
+	    bool fetch_sym, bool *exists, struct dfs_entry *entry)
+{
+	return fetch_entry_data(oh, th, name, fetch_sym, NULL, exists, entry);
+}
+
 static int
 remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
 	     const char *name, struct dfs_entry entry)
@@ -384,7 +495,8 @@ remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
 	daos_key_t	dkey;
 	int		rc;
 
-	if (!S_ISLNK(entry.mode)) {
+	/** the array of an inlined file is empty */
+	if (!S_ISLNK(entry.mode) && !entry.inl) {
 		daos_handle_t oh;
 
 		rc = daos_obj_open(dfs->coh, entry.oid, DAOS_OO_RW, &oh, NULL);
@@ -407,13 +519,17 @@ remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
 	return daos_der2errno(rc);
 }
 
+/**
+ * Insert the entry @name, with the @data of the file if it is inlined. The
+ * length of @data is the size of the file, @data is ignored if it is empty.
+ */
 static int
-insert_entry(daos_handle_t oh, daos_handle_t th, const char *name,
-	     struct dfs_entry entry)
+insert_entry_data(daos_handle_t oh, daos_handle_t th, const char *name,
+		  struct dfs_entry entry, d_iov_t *data)
 {
-	d_sg_list_t	sgls[INODE_AKEYS];
-	d_iov_t		sg_iovs[INODE_AKEYS];
-	daos_iod_t	iods[INODE_AKEYS];
+	d_sg_list_t	sgls[INODE_AKEYS + 1];
+	d_iov_t		sg_iovs[INODE_AKEYS + 1];
+	daos_iod_t	iods[INODE_AKEYS + 1];
 	daos_key_t	dkey;
 	unsigned int	akeys_nr, i;
 	int		rc;
@@ -460,6 +576,23 @@ insert_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 	iods[i].iod_size = sizeof(time_t);
 	i++;
 
+	/** Add the size and the data of the file if inlined */
+	if (entry.inl) {
+		d_iov_set(&sg_iovs[i], &entry.isize, sizeof(daos_size_t));
+		d_iov_set(&iods[i].iod_name, ISIZE_NAME, strlen(ISIZE_NAME));
+		iods[i].iod_size = sizeof(daos_size_t);
+		i++;
+
+		if (data && data->iov_len) {
+			D_ASSERT(data->iov_len == entry.isize);
+			d_iov_set(&sg_iovs[i], data->iov_buf, data->iov_len);
+			d_iov_set(&iods[i].iod_name, DATA_NAME,
+				  strlen(DATA_NAME));
+			iods[i].iod_size = data->iov_len;
+			i++;
+		}
+	}
+
 	/** Add symlink value if Symlink */
 	if (S_ISLNK(entry.mode)) {
 		d_iov_set(&sg_iovs[i], entry.value, strlen(entry.value) + 1);
@@ -492,6 +625,13 @@ insert_entry(daos_handle_t oh, daos_handle_t th, const char *name,
 	return 0;
 }
 
+static inline int
+insert_entry(daos_handle_t oh, daos_handle_t th, const char *name,
+	     struct dfs_entry entry)
+{
+	return insert_entry_data(oh, th, name, entry, NULL);
+}
+
 static int
 get_num_entries(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 		bool check_empty)
@@ -521,20 +661,1232 @@ get_num_entries(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 		if (number == 0)
 			continue;
 
-		key_nr += number;
+		key_nr += number;
+
+		/** if we just want to check if entries exist, break now */
+		if (check_empty)
+			break;
+	}
+
+	*nr = key_nr;
+	return 0;
+}
+
+/** Cached entry of a directory, positive or negative */
+struct dfs_dentry {
+	/** link in the hash bucket */
+	d_list_t		dd_link;
+	/** link in the LRU list */
+	d_list_t		dd_lru;
+	/** the directory the entry belongs to */
+	daos_obj_id_t		dd_parent;
+	/** the entry is dropped on lookup after this time (in ns) */
+	uint64_t		dd_expire;
+	/** false for a negative entry, the name does not exist */
+	bool			dd_exists;
+	/** the entry as returned by fetch_entry(), including the symlink */
+	struct dfs_entry	dd_entry;
+	char			dd_name[DFS_MAX_PATH + 1];
+};
+
+struct dfs_dcache {
+	pthread_mutex_t		dc_lock;
+	/** least recently used entry first */
+	d_list_t		dc_lru;
+	unsigned int		dc_nr;
+	/** bumped by every eviction, see dfs_dc_insert() */
+	uint64_t		dc_gen;
+	d_list_t		dc_buckets[1 << DFS_DC_BITS];
+};
+
+static int
+dfs_dc_init(dfs_t *dfs)
+{
+	struct dfs_dcache	*dc;
+	int			i;
+	int			rc;
+
+	D_ALLOC_PTR(dc);
+	if (dc == NULL)
+		return ENOMEM;
+
+	rc = D_MUTEX_INIT(&dc->dc_lock, NULL);
+	if (rc) {
+		D_FREE(dc);
+		return daos_der2errno(rc);
+	}
+
+	D_INIT_LIST_HEAD(&dc->dc_lru);
+	for (i = 0; i < (1 << DFS_DC_BITS); i++)
+		D_INIT_LIST_HEAD(&dc->dc_buckets[i]);
+
+	dfs->dc = dc;
+	return 0;
+}
+
+/** Called with dc_lock held */
+static void
+dfs_dc_free(struct dfs_dcache *dc, struct dfs_dentry *dd)
+{
+	d_list_del(&dd->dd_link);
+	d_list_del(&dd->dd_lru);
+	dc->dc_nr--;
+	if (dd->dd_entry.value)
+		D_FREE(dd->dd_entry.value);
+	D_FREE(dd);
+}
+
+static void
+dfs_dc_fini(dfs_t *dfs)
+{
+	struct dfs_dcache	*dc = dfs->dc;
+	struct dfs_dentry	*dd;
+	struct dfs_dentry	*tmp;
+
+	if (dc == NULL)
+		return;
+
+	d_list_for_each_entry_safe(dd, tmp, &dc->dc_lru, dd_lru)
+		dfs_dc_free(dc, dd);
+
+	D_MUTEX_DESTROY(&dc->dc_lock);
+	D_FREE(dc);
+	dfs->dc = NULL;
+}
+
+/** Find the entry @name of @parent, called with dc_lock held */
+static struct dfs_dentry *
+dfs_dc_find(struct dfs_dcache *dc, daos_obj_id_t parent, const char *name,
+	    d_list_t **bucket)
+{
+	struct dfs_dentry	*dd;
+	uint64_t		hash;
+
+	hash = d_hash_murmur64((const unsigned char *)name, strlen(name),
+			       (unsigned int)parent.lo) ^ parent.hi;
+	*bucket = &dc->dc_buckets[hash & ((1 << DFS_DC_BITS) - 1)];
+
+	d_list_for_each_entry(dd, *bucket, dd_link) {
+		if (dd->dd_parent.lo == parent.lo &&
+		    dd->dd_parent.hi == parent.hi &&
+		    strcmp(dd->dd_name, name) == 0)
+			return dd;
+	}
+	return NULL;
+}
+
+/**
+ * Look up the entry @name of @parent in the cache. On a hit, the symlink value
+ * of @entry is a copy that the caller has to free, as for fetch_entry().
+ */
+static bool
+dfs_dc_lookup(dfs_t *dfs, daos_obj_id_t parent, const char *name,
+	      bool *exists, struct dfs_entry *entry)
+{
+	struct dfs_dcache	*dc = dfs->dc;
+	struct dfs_dentry	*dd;
+	d_list_t		*bucket;
+	char			*value = NULL;
+	bool			hit = false;
+
+	D_MUTEX_LOCK(&dc->dc_lock);
+	dd = dfs_dc_find(dc, parent, name, &bucket);
+	if (dd == NULL)
+		goto out;
+
+	if (daos_get_ntime() >= dd->dd_expire) {
+		dfs_dc_free(dc, dd);
+		goto out;
+	}
+
+	if (dd->dd_entry.value) {
+		D_STRNDUP(value, dd->dd_entry.value, PATH_MAX - 1);
+		if (value == NULL)
+			goto out;
+	}
+
+	*exists = dd->dd_exists;
+	*entry = dd->dd_entry;
+	entry->value = value;
+	d_list_move_tail(&dd->dd_lru, &dc->dc_lru);
+	hit = true;
+out:
+	D_MUTEX_UNLOCK(&dc->dc_lock);
+	return hit;
+}
+
+/** eviction generation to pass to dfs_dc_insert(), sampled before a fetch */
+static uint64_t
+dfs_dc_gen(dfs_t *dfs)
+{
+	struct dfs_dcache	*dc = dfs->dc;
+	uint64_t		gen;
+
+	D_MUTEX_LOCK(&dc->dc_lock);
+	gen = dc->dc_gen;
+	D_MUTEX_UNLOCK(&dc->dc_lock);
+	return gen;
+}
+
+/**
+ * Cache the entry fetched after @gen was sampled. It is not inserted if any
+ * entry has been evicted since, as the fetch may have raced with a local
+ * change of the name, e.g. a negative entry with a concurrent create.
+ */
+static void
+dfs_dc_insert(dfs_t *dfs, daos_obj_id_t parent, const char *name,
+	      bool exists, struct dfs_entry *entry, uint64_t gen)
+{
+	struct dfs_dcache	*dc = dfs->dc;
+	struct dfs_dentry	*dd;
+	struct dfs_dentry	*old;
+	d_list_t		*bucket;
+
+	if (strlen(name) > DFS_MAX_PATH)
+		return;
+
+	D_ALLOC_PTR(dd);
+	if (dd == NULL)
+		return;
+
+	if (exists) {
+		dd->dd_entry = *entry;
+		dd->dd_entry.value = NULL;
+		if (S_ISLNK(entry->mode) && entry->value) {
+			D_STRNDUP(dd->dd_entry.value, entry->value,
+				  PATH_MAX - 1);
+			if (dd->dd_entry.value == NULL) {
+				D_FREE(dd);
+				return;
+			}
+		}
+	}
+	dd->dd_exists = exists;
+	oid_cp(&dd->dd_parent, parent);
+	strcpy(dd->dd_name, name);
+	dd->dd_expire = daos_get_ntime() + dfs->dc_timeout;
+
+	D_MUTEX_LOCK(&dc->dc_lock);
+	if (dc->dc_gen != gen) {
+		D_MUTEX_UNLOCK(&dc->dc_lock);
+		if (dd->dd_entry.value)
+			D_FREE(dd->dd_entry.value);
+		D_FREE(dd);
+		return;
+	}
+
+	old = dfs_dc_find(dc, parent, name, &bucket);
+	if (old)
+		dfs_dc_free(dc, old);
+	else if (dc->dc_nr >= DFS_DC_MAX_NR)
+		dfs_dc_free(dc, d_list_entry(dc->dc_lru.next,
+					     struct dfs_dentry, dd_lru));
+
+	d_list_add(&dd->dd_link, bucket);
+	d_list_add_tail(&dd->dd_lru, &dc->dc_lru);
+	dc->dc_nr++;
+	D_MUTEX_UNLOCK(&dc->dc_lock);
+}
+
+/** Drop the entry @name of @parent after it has been changed locally */
+static void
+dfs_dc_evict(dfs_t *dfs, daos_obj_id_t parent, const char *name)
+{
+	struct dfs_dcache	*dc = dfs->dc;
+	struct dfs_dentry	*dd;
+	d_list_t		*bucket;
+
+	if (dc == NULL)
+		return;
+
+	D_MUTEX_LOCK(&dc->dc_lock);
+	dc->dc_gen++;
+	dd = dfs_dc_find(dc, parent, name, &bucket);
+	if (dd)
+		dfs_dc_free(dc, dd);
+	D_MUTEX_UNLOCK(&dc->dc_lock);
+}
+
+/**
+ * fetch_entry() of the entry @name in the directory @parent, opened as @oh,
+ * through the dentry cache. The symlink value is always fetched so that the
+ * cached entry is complete. Entries, including the negative ones, are cached
+ * for dc_timeout and are not coherent with the changes done by other clients
+ * in the meantime.
+ */
+static int
+lookup_entry(dfs_t *dfs, daos_handle_t oh, daos_obj_id_t parent,
+	     const char *name, bool *exists, struct dfs_entry *entry)
+{
+	uint64_t	gen = 0;
+	int		rc;
+
+	if (dfs->dc) {
+		if (dfs_dc_lookup(dfs, parent, name, exists, entry))
+			return 0;
+		gen = dfs_dc_gen(dfs);
+	}
+
+	rc = fetch_entry(oh, DAOS_TX_NONE, name, true, exists, entry);
+	if (rc == 0 && dfs->dc)
+		dfs_dc_insert(dfs, parent, name, *exists, entry, gen);
+
+	return rc;
+}
+
+/** One write-back buffer, flushed asynchronously */
+struct dfs_wb_buf {
+	daos_event_t		wf_ev;
+	daos_array_iod_t	wf_iod;
+	daos_range_t		wf_rg;
+	d_sg_list_t		wf_sgl;
+	d_iov_t			wf_iov;
+	char			*wf_data;
+	/** read-ahead state of the file, paused until the flush completes */
+	struct dfs_ra		*wf_ra;
+	bool			wf_inflight;
+};
+
+static void dfs_ra_write_begin(struct dfs_ra *ra, daos_off_t off,
+			       daos_size_t len);
+static void dfs_ra_write_end(struct dfs_ra *ra, daos_off_t off,
+			     daos_size_t len);
+
+/**
+ * Per file write-back state. Contiguous writes within one aligned region of
+ * wb_size bytes are coalesced into the current buffer, which is flushed when
+ * the region is full, on a non-contiguous write, or before the file is read,
+ * queried or modified by other means.
+ */
+struct dfs_wb {
+	pthread_mutex_t		wb_lock;
+	/** link on dfs::wb_list */
+	d_list_t		wb_link;
+	/** held by the handle and by dfs_wb_sync_oid, protected by dfs::lock */
+	int			wb_ref;
+	dfs_t			*wb_dfs;
+	dfs_obj_t		*wb_obj;
+	daos_size_t		wb_size;
+	/** file offset and length of the buffered data */
+	daos_off_t		wb_off;
+	daos_size_t		wb_len;
+	/** time the first byte was buffered */
+	uint64_t		wb_time;
+	/** DER error of an asynchronous flush, reported by the next call */
+	int			wb_err;
+	/** buffer being filled */
+	unsigned int		wb_cur;
+	struct dfs_wb_buf	wb_bufs[DFS_WB_BUF_NR];
+};
+
+static struct dfs_wb *
+dfs_wb_get(dfs_t *dfs, dfs_obj_t *obj)
+{
+	struct dfs_wb	*wb;
+	daos_size_t	 cell_size;
+	daos_size_t	 chunk_size;
+	int		 rc;
+
+	if (obj->wb != NULL)
+		return obj->wb;
+
+	rc = daos_array_get_attr(obj->oh, &chunk_size, &cell_size);
+	if (rc)
+		return NULL;
+
+	D_MUTEX_LOCK(&dfs->lock);
+	wb = obj->wb;
+	if (wb != NULL)
+		goto out;
+
+	D_ALLOC_PTR(wb);
+	if (wb == NULL)
+		goto out;
+	if (D_MUTEX_INIT(&wb->wb_lock, NULL) != 0) {
+		D_FREE(wb);
+		wb = NULL;
+		goto out;
+	}
+	wb->wb_ref = 1;
+	wb->wb_dfs = dfs;
+	wb->wb_obj = obj;
+	wb->wb_size = min(chunk_size, DFS_WB_MAX_SIZE);
+	d_list_add_tail(&wb->wb_link, &dfs->wb_list);
+	obj->wb = wb;
+out:
+	D_MUTEX_UNLOCK(&dfs->lock);
+	return wb;
+}
+
+/** wait for the in-flight flush of @buf, called with wb_lock held */
+static void
+dfs_wb_buf_wait(struct dfs_wb *wb, struct dfs_wb_buf *buf)
+{
+	bool	flag = false;
+	int	rc;
+
+	if (!buf->wf_inflight)
+		return;
+
+	while (!flag) {
+		rc = daos_event_test(&buf->wf_ev, DAOS_EQ_WAIT, &flag);
+		if (rc) {
+			D_ERROR("daos_event_test() failed (%d)\n", rc);
+			break;
+		}
+	}
+	if (flag)
+		rc = buf->wf_ev.ev_error;
+	if (rc && wb->wb_err == 0)
+		wb->wb_err = rc;
+
+	daos_event_fini(&buf->wf_ev);
+	buf->wf_inflight = false;
+	dfs_ra_write_end(buf->wf_ra, buf->wf_rg.rg_idx, buf->wf_rg.rg_len);
+	buf->wf_ra = NULL;
+}
+
+/**
+ * Send the buffered data, and wait for all the flushes if @wait is true.
+ * Returns the error of any failed flush not reported yet.
+ */
+static int
+dfs_wb_flush(struct dfs_wb *wb, bool wait)
+{
+	struct dfs_wb_buf	*buf;
+	int			 i;
+	int			 rc;
+
+	if (wb->wb_len > 0) {
+		buf = &wb->wb_bufs[wb->wb_cur];
+		/** the flushes of the same range must not be reordered */
+		for (i = 0; i < DFS_WB_BUF_NR; i++) {
+			struct dfs_wb_buf *prev = &wb->wb_bufs[i];
+
+			if (prev->wf_inflight &&
+			    prev->wf_rg.rg_idx < wb->wb_off + wb->wb_len &&
+			    wb->wb_off < prev->wf_rg.rg_idx +
+					 prev->wf_rg.rg_len)
+				dfs_wb_buf_wait(wb, prev);
+		}
+
+		buf->wf_rg.rg_idx = wb->wb_off;
+		buf->wf_rg.rg_len = wb->wb_len;
+		buf->wf_iod.arr_nr = 1;
+		buf->wf_iod.arr_rgs = &buf->wf_rg;
+		d_iov_set(&buf->wf_iov, buf->wf_data, wb->wb_len);
+		buf->wf_sgl.sg_nr = 1;
+		buf->wf_sgl.sg_nr_out = 0;
+		buf->wf_sgl.sg_iovs = &buf->wf_iov;
+
+		D_DEBUG(DB_TRACE, "Flush write-back buffer: Off %"PRIu64
+			", Len %zu\n", wb->wb_off, wb->wb_len);
+		/**
+		 * A read-ahead state created later only issues units from a
+		 * read, which first waits for this flush in dfs_wb_sync_oid().
+		 */
+		buf->wf_ra = wb->wb_obj->ra;
+		dfs_ra_write_begin(buf->wf_ra, wb->wb_off, wb->wb_len);
+		rc = daos_event_init(&buf->wf_ev, DAOS_HDL_INVAL, NULL);
+		if (rc == 0) {
+			rc = daos_array_write(wb->wb_obj->oh, DAOS_TX_NONE,
+					      &buf->wf_iod, &buf->wf_sgl, NULL,
+					      &buf->wf_ev);
+			if (rc)
+				daos_event_fini(&buf->wf_ev);
+			else
+				buf->wf_inflight = true;
+		}
+		if (rc) {
+			dfs_ra_write_end(buf->wf_ra, wb->wb_off, wb->wb_len);
+			buf->wf_ra = NULL;
+		}
+		if (rc && wb->wb_err == 0)
+			wb->wb_err = rc;
+
+		wb->wb_len = 0;
+		wb->wb_cur = (wb->wb_cur + 1) % DFS_WB_BUF_NR;
+	}
+
+	if (wait) {
+		for (i = 0; i < DFS_WB_BUF_NR; i++)
+			dfs_wb_buf_wait(wb, &wb->wb_bufs[i]);
+	}
+
+	rc = wb->wb_err;
+	wb->wb_err = 0;
+	return rc;
+}
+
+/** drop a reference of @wb, and free it with the last one */
+static void
+dfs_wb_put(struct dfs_wb *wb)
+{
+	int	ref;
+	int	i;
+
+	D_MUTEX_LOCK(&wb->wb_dfs->lock);
+	ref = --wb->wb_ref;
+	D_MUTEX_UNLOCK(&wb->wb_dfs->lock);
+	if (ref > 0)
+		return;
+
+	for (i = 0; i < DFS_WB_BUF_NR; i++) {
+		if (wb->wb_bufs[i].wf_data != NULL)
+			D_FREE(wb->wb_bufs[i].wf_data);
+	}
+	D_MUTEX_DESTROY(&wb->wb_lock);
+	D_FREE(wb);
+}
+
+/**
+ * Pin the write-back states of all the open handles of the file @oid, or of
+ * all the files if @oid is NULL. Called with dfs::lock held, the states are
+ * then flushed with it released, so that the other files are not blocked by
+ * the flush, and unpinned with dfs_wb_put().
+ */
+static int
+dfs_wb_pin(dfs_t *dfs, daos_obj_id_t *oid, struct dfs_wb ***wbsp, int *nrp)
+{
+	struct dfs_wb	*wb;
+	struct dfs_wb	**wbs;
+	int		 nr = 0;
+
+	*wbsp = NULL;
+	*nrp = 0;
+
+	d_list_for_each_entry(wb, &dfs->wb_list, wb_link) {
+		if (oid == NULL || (wb->wb_obj->oid.lo == oid->lo &&
+				    wb->wb_obj->oid.hi == oid->hi))
+			nr++;
+	}
+	if (nr == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(wbs, nr);
+	if (wbs == NULL)
+		return -DER_NOMEM;
+
+	nr = 0;
+	d_list_for_each_entry(wb, &dfs->wb_list, wb_link) {
+		if (oid != NULL && (wb->wb_obj->oid.lo != oid->lo ||
+				    wb->wb_obj->oid.hi != oid->hi))
+			continue;
+		wb->wb_ref++;
+		wbs[nr++] = wb;
+	}
+
+	*wbsp = wbs;
+	*nrp = nr;
+	return 0;
+}
+
+/**
+ * Flush and wait for the buffered data of all the open handles of the file
+ * @oid, or of all the files if @oid is NULL, so that it is visible to the
+ * following reads and queries.
+ */
+static int
+dfs_wb_sync(dfs_t *dfs, daos_obj_id_t *oid)
+{
+	struct dfs_wb	**wbs;
+	int		 nr;
+	int		 i;
+	int		 rc;
+	int		 ret;
+
+	if (!dfs->wb_enabled)
+		return 0;
+
+	D_MUTEX_LOCK(&dfs->lock);
+	rc = dfs_wb_pin(dfs, oid, &wbs, &nr);
+	D_MUTEX_UNLOCK(&dfs->lock);
+
+	for (i = 0; i < nr; i++) {
+		D_MUTEX_LOCK(&wbs[i]->wb_lock);
+		ret = dfs_wb_flush(wbs[i], true);
+		D_MUTEX_UNLOCK(&wbs[i]->wb_lock);
+		if (rc == 0)
+			rc = ret;
+		dfs_wb_put(wbs[i]);
+	}
+	if (wbs != NULL)
+		D_FREE(wbs);
+
+	return daos_der2errno(rc);
+}
+
+static int
+dfs_wb_sync_oid(dfs_t *dfs, daos_obj_id_t oid)
+{
+	return dfs_wb_sync(dfs, &oid);
+}
+
+/** flush the buffers not written for DFS_WB_FLUSH_INTV, without waiting */
+static void
+dfs_wb_flush_aged(dfs_t *dfs)
+{
+	struct dfs_wb	*wb;
+	struct dfs_wb	**wbs;
+	uint64_t	 now = daos_get_ntime();
+	int		 nr;
+	int		 i;
+	int		 rc;
+
+	/** checked again under the lock, most writes do not take it */
+	if (now - dfs->wb_scan < DFS_WB_FLUSH_INTV)
+		return;
+
+	D_MUTEX_LOCK(&dfs->lock);
+	if (now - dfs->wb_scan < DFS_WB_FLUSH_INTV) {
+		D_MUTEX_UNLOCK(&dfs->lock);
+		return;
+	}
+	dfs->wb_scan = now;
+	rc = dfs_wb_pin(dfs, NULL, &wbs, &nr);
+	D_MUTEX_UNLOCK(&dfs->lock);
+	if (rc)
+		return;
+
+	for (i = 0; i < nr; i++) {
+		wb = wbs[i];
+		/** skip the busy ones, they will be checked next time */
+		if (pthread_mutex_trylock(&wb->wb_lock) == 0) {
+			/** keep the error for the next call on the file */
+			if (wb->wb_len > 0 &&
+			    now - wb->wb_time >= DFS_WB_FLUSH_INTV)
+				wb->wb_err = dfs_wb_flush(wb, false);
+			D_MUTEX_UNLOCK(&wb->wb_lock);
+		}
+		dfs_wb_put(wb);
+	}
+	if (wbs != NULL)
+		D_FREE(wbs);
+}
+
+/**
+ * Buffer the write in the write-back buffer of the file. Returns false if the
+ * write cannot be buffered, the caller then writes the data to the array
+ * after all the buffered data has been flushed. @rc is the error of any
+ * previous asynchronous flush, in that case nothing is buffered.
+ */
+static bool
+dfs_wb_write(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
+	     daos_size_t len, int *rc)
+{
+	struct dfs_wb		*wb;
+	struct dfs_wb_buf	*buf;
+	daos_off_t		 region;
+	bool			 buffered = false;
+	int			 i;
+
+	dfs_wb_flush_aged(dfs);
+
+	wb = dfs_wb_get(dfs, obj);
+	if (wb == NULL)
+		return false;
+
+	D_MUTEX_LOCK(&wb->wb_lock);
+	region = off - off % wb->wb_size;
+
+	/** only the writes within one region are buffered */
+	if (off + len > region + wb->wb_size || len == wb->wb_size) {
+		*rc = dfs_wb_flush(wb, true);
+		buffered = (*rc != 0);
+		goto out;
+	}
+
+	/** not contiguous to the buffered data */
+	if (wb->wb_len > 0 && off != wb->wb_off + wb->wb_len) {
+		*rc = dfs_wb_flush(wb, false);
+		if (*rc)
+			D_GOTO(out, buffered = true);
+	}
+
+	buf = &wb->wb_bufs[wb->wb_cur];
+	if (wb->wb_len == 0) {
+		dfs_wb_buf_wait(wb, buf);
+		if (wb->wb_err) {
+			*rc = wb->wb_err;
+			wb->wb_err = 0;
+			D_GOTO(out, buffered = true);
+		}
+		if (buf->wf_data == NULL) {
+			D_ALLOC(buf->wf_data, wb->wb_size);
+			if (buf->wf_data == NULL) {
+				*rc = dfs_wb_flush(wb, true);
+				D_GOTO(out, buffered = (*rc != 0));
+			}
+		}
+		wb->wb_off = off;
+		wb->wb_time = daos_get_ntime();
+	}
+
+	for (i = 0; i < sgl->sg_nr; i++) {
+		memcpy(buf->wf_data + wb->wb_len, sgl->sg_iovs[i].iov_buf,
+		       sgl->sg_iovs[i].iov_len);
+		wb->wb_len += sgl->sg_iovs[i].iov_len;
+	}
+	*rc = 0;
+	buffered = true;
+
+	/** the region is full */
+	if ((wb->wb_off + wb->wb_len) % wb->wb_size == 0)
+		*rc = dfs_wb_flush(wb, false);
+out:
+	D_MUTEX_UNLOCK(&wb->wb_lock);
+	if (*rc)
+		*rc = daos_der2errno(*rc);
+	return buffered;
+}
+
+/** flush the buffered data and free the write-back state of @obj */
+static int
+dfs_wb_fini(dfs_obj_t *obj)
+{
+	struct dfs_wb	*wb = obj->wb;
+	int		 rc;
+
+	if (wb == NULL)
+		return 0;
+
+	D_MUTEX_LOCK(&wb->wb_dfs->lock);
+	d_list_del(&wb->wb_link);
+	D_MUTEX_UNLOCK(&wb->wb_dfs->lock);
+
+	/** a concurrent dfs_wb_sync_oid may still hold it */
+	D_MUTEX_LOCK(&wb->wb_lock);
+	rc = dfs_wb_flush(wb, true);
+	D_MUTEX_UNLOCK(&wb->wb_lock);
+	dfs_wb_put(wb);
+	obj->wb = NULL;
+
+	return daos_der2errno(rc);
+}
+
+/**
+ * Data of a regular file inlined in its entry. The entry then has an ISIZE_NAME
+ * a-key with the file size and a DATA_NAME a-key with the data, and the array
+ * object of the file is empty. Only the files created by a mount with
+ * inline_size set are inlined, they are migrated to their array once they grow
+ * beyond it. The entry is fetched again by every call, only the first read
+ * after the open uses the data fetched with the entry. The modifications are
+ * read-modify-writes of the whole entry, see dfs_inl_rmw_begin().
+ *
+ * The handle keeps its dfs_inl until it is released, di_migrated is set once
+ * the file has been moved to its array. It is only accessed with the entry lock
+ * of the file held, see dfs_inl_lock().
+ */
+struct dfs_inl {
+	dfs_t			*di_dfs;
+	/** file size */
+	daos_size_t		di_size;
+	/** di_data holds the data fetched by the open, for the first read */
+	bool			di_cached;
+	/** the file has been moved to its array, the entry has no data */
+	bool			di_migrated;
+	char			di_data[DFS_INLINE_MAX];
+};
+
+static struct dfs_inl *
+dfs_inl_alloc(dfs_t *dfs, daos_size_t size, bool cached)
+{
+	struct dfs_inl	*inl;
+
+	D_ALLOC_PTR(inl);
+	if (inl == NULL)
+		return NULL;
+
+	inl->di_dfs = dfs;
+	inl->di_size = size;
+	inl->di_cached = cached;
+	return inl;
+}
+
+/**
+ * Entry lock of the inlined file @obj, hashed on its parent and name. It guards
+ * obj->inl and serializes the read-modify-writes of the entry by all the
+ * handles of the file in the mount.
+ */
+static pthread_mutex_t *
+dfs_inl_lock(dfs_obj_t *obj)
+{
+	uint64_t	hash;
+
+	hash = d_hash_murmur64((const unsigned char *)obj->name,
+			       strlen(obj->name),
+			       (unsigned int)obj->parent_oid.lo) ^
+	       obj->parent_oid.hi;
+	return &obj->inl->di_dfs->inl_locks[hash % DFS_INL_LOCKS];
+}
+
+static void
+dfs_inl_iods(daos_iod_t *iods, d_sg_list_t *sgls, d_iov_t *sg_iovs, int nr)
+{
+	int i;
+
+	for (i = 0; i < nr; i++) {
+		sgls[i].sg_nr		= 1;
+		sgls[i].sg_nr_out	= 0;
+		sgls[i].sg_iovs		= &sg_iovs[i];
+
+		dcb_set_null(&iods[i].iod_kcsum);
+		iods[i].iod_nr		= 1;
+		iods[i].iod_recxs	= NULL;
+		iods[i].iod_eprs	= NULL;
+		iods[i].iod_csums	= NULL;
+		iods[i].iod_type	= DAOS_IOD_SINGLE;
+	}
+}
+
+/**
+ * Fetch the size and the data of the inlined file @obj at the epoch of @th. If
+ * the file has been migrated to its array meanwhile, di_migrated is set.
+ */
+static int
+dfs_inl_fetch(dfs_obj_t *obj, daos_handle_t th)
+{
+	struct dfs_inl	*inl = obj->inl;
+	d_sg_list_t	sgls[2];
+	d_iov_t		sg_iovs[2];
+	daos_iod_t	iods[2];
+	daos_key_t	dkey;
+	daos_handle_t	oh;
+	daos_size_t	size;
+	int		rc;
+
+	inl->di_cached = false;
+	rc = daos_obj_open(inl->di_dfs->coh, obj->parent_oid, DAOS_OO_RO, &oh,
+			   NULL);
+	if (rc)
+		return daos_der2errno(rc);
+
+	d_iov_set(&dkey, obj->name, strlen(obj->name));
+	d_iov_set(&sg_iovs[0], &size, sizeof(size));
+	d_iov_set(&iods[0].iod_name, ISIZE_NAME, strlen(ISIZE_NAME));
+	iods[0].iod_size = DAOS_REC_ANY;
+	d_iov_set(&sg_iovs[1], inl->di_data, DFS_INLINE_MAX);
+	d_iov_set(&iods[1].iod_name, DATA_NAME, strlen(DATA_NAME));
+	iods[1].iod_size = DAOS_REC_ANY;
+	dfs_inl_iods(iods, sgls, sg_iovs, 2);
+
+	rc = daos_obj_fetch(oh, th, &dkey, 2, iods, sgls, NULL, NULL);
+	daos_obj_close(oh, NULL);
+	if (rc) {
+		D_ERROR("Failed to fetch inlined file %s (%d)\n", obj->name,
+			rc);
+		return daos_der2errno(rc);
+	}
+
+	if (iods[0].iod_size == 0) {
+		inl->di_migrated = true;
+		return 0;
+	}
+
+	inl->di_size = size;
+	return 0;
+}
+
+/**
+ * Write the size and data of the inlined file @obj held by the handle to its
+ * entry, at the epoch of @th.
+ */
+static int
+dfs_inl_update(dfs_obj_t *obj, daos_handle_t th)
+{
+	struct dfs_inl	*inl = obj->inl;
+	d_sg_list_t	sgls[2];
+	d_iov_t		sg_iovs[2];
+	daos_iod_t	iods[2];
+	daos_key_t	dkey;
+	daos_handle_t	oh;
+	int		nr = 1;
+	int		rc;
+
+	rc = daos_obj_open(inl->di_dfs->coh, obj->parent_oid, DAOS_OO_RW, &oh,
+			   NULL);
+	if (rc)
+		return daos_der2errno(rc);
+
+	d_iov_set(&dkey, obj->name, strlen(obj->name));
+	d_iov_set(&sg_iovs[0], &inl->di_size, sizeof(daos_size_t));
+	d_iov_set(&iods[0].iod_name, ISIZE_NAME, strlen(ISIZE_NAME));
+	iods[0].iod_size = sizeof(daos_size_t);
+	/** the data beyond the file size is ignored, no need to punch it */
+	if (inl->di_size > 0) {
+		d_iov_set(&sg_iovs[1], inl->di_data, inl->di_size);
+		d_iov_set(&iods[1].iod_name, DATA_NAME, strlen(DATA_NAME));
+		iods[1].iod_size = inl->di_size;
+		nr++;
+	}
+	dfs_inl_iods(iods, sgls, sg_iovs, nr);
+
+	rc = daos_obj_update(oh, th, &dkey, nr, iods, sgls, NULL);
+	daos_obj_close(oh, NULL);
+	dfs_dc_evict(inl->di_dfs, obj->parent_oid, obj->name);
+	if (rc) {
+		D_ERROR("Failed to update inlined file %s (%d)\n", obj->name,
+			rc);
+		return daos_der2errno(rc);
+	}
+
+	return 0;
+}
+
+/**
+ * Start a read-modify-write of the inlined file @obj: open a transaction and
+ * fetch the entry at its epoch. A migration of the file punches the inline
+ * a-keys at a later epoch than the fetch that still found them, so the update
+ * done at the same epoch is hidden and never brings them back. The transaction
+ * is closed if the file has already been migrated.
+ */
+static int
+dfs_inl_rmw_begin(dfs_obj_t *obj, daos_handle_t *th)
+{
+	int	rc;
+
+	rc = daos_tx_open(obj->inl->di_dfs->coh, th, NULL);
+	if (rc)
+		return daos_der2errno(rc);
+
+	rc = dfs_inl_fetch(obj, *th);
+	if (rc || obj->inl->di_migrated)
+		daos_tx_close(*th, NULL);
+	return rc;
+}
+
+/**
+ * Write the entry modified since dfs_inl_rmw_begin() and commit the
+ * transaction. The entry lock only covers the handles of this mount, the
+ * commit fails with -DER_RESTART if the entry was updated by another client
+ * since the fetch. EAGAIN is then returned and the caller starts over from
+ * dfs_inl_rmw_begin(). A committed update may still be hidden by a migration,
+ * the entry is fetched again to check it and di_migrated is set if so, the
+ * caller then does the operation again on the array.
+ */
+static int
+dfs_inl_rmw_end(dfs_obj_t *obj, daos_handle_t th)
+{
+	int	rc;
+
+	rc = dfs_inl_update(obj, th);
+	if (rc) {
+		daos_tx_abort(th, NULL);
+		daos_tx_close(th, NULL);
+		return rc;
+	}
+
+	rc = daos_tx_commit(th, NULL);
+	daos_tx_close(th, NULL);
+	if (rc == -DER_RESTART) {
+		D_DEBUG(DB_TRACE, "Inlined file %s updated meanwhile, retry\n",
+			obj->name);
+		return EAGAIN;
+	}
+	if (rc) {
+		D_ERROR("Failed to commit inlined file %s (%d)\n", obj->name,
+			rc);
+		return daos_der2errno(rc);
+	}
+
+	return dfs_inl_fetch(obj, DAOS_TX_NONE);
+}
+
+/**
+ * Move the data of the inlined file @obj to its array object, then remove it
+ * from the entry and set di_migrated. Called with the entry lock held.
+ */
+static int
+dfs_inl_move(dfs_obj_t *obj)
+{
+	struct dfs_inl	*inl = obj->inl;
+	daos_key_t	akeys[2];
+	daos_key_t	dkey;
+	daos_handle_t	oh;
+	int		rc;
+
+	if (inl->di_migrated)
+		return 0;
+
+	rc = dfs_inl_fetch(obj, DAOS_TX_NONE);
+	if (rc || inl->di_migrated)
+		return rc;
+
+	if (inl->di_size > 0) {
+		daos_array_iod_t	iod;
+		daos_range_t		rg;
+		d_sg_list_t		sgl;
+		d_iov_t			iov;
+
+		d_iov_set(&iov, inl->di_data, inl->di_size);
+		sgl.sg_nr = 1;
+		sgl.sg_nr_out = 0;
+		sgl.sg_iovs = &iov;
+		rg.rg_idx = 0;
+		rg.rg_len = inl->di_size;
+		iod.arr_nr = 1;
+		iod.arr_rgs = &rg;
+
+		rc = daos_array_write(obj->oh, DAOS_TX_NONE, &iod, &sgl, NULL,
+				      NULL);
+		if (rc) {
+			D_ERROR("daos_array_write() failed (%d)\n", rc);
+			return daos_der2errno(rc);
+		}
+	}
+
+	rc = daos_obj_open(inl->di_dfs->coh, obj->parent_oid, DAOS_OO_RW, &oh,
+			   NULL);
+	if (rc)
+		return daos_der2errno(rc);
+
+	d_iov_set(&dkey, obj->name, strlen(obj->name));
+	d_iov_set(&akeys[0], ISIZE_NAME, strlen(ISIZE_NAME));
+	d_iov_set(&akeys[1], DATA_NAME, strlen(DATA_NAME));
+	rc = daos_obj_punch_akeys(oh, DAOS_TX_NONE, &dkey, 2, akeys, NULL);
+	daos_obj_close(oh, NULL);
+	dfs_dc_evict(inl->di_dfs, obj->parent_oid, obj->name);
+	if (rc) {
+		D_ERROR("Failed to migrate inlined file %s (%d)\n", obj->name,
+			rc);
+		return daos_der2errno(rc);
+	}
+
+	D_DEBUG(DB_TRACE, "Migrated %s ("DF_U64" bytes) to its array\n",
+		obj->name, inl->di_size);
+	inl->di_migrated = true;
+	return 0;
+}
+
+/** Resize the inlined file @obj to @size, called with the entry lock held */
+static int
+dfs_inl_resize(dfs_obj_t *obj, daos_size_t size)
+{
+	struct dfs_inl	*inl = obj->inl;
+	daos_handle_t	th;
+	int		rc;
+
+	if (size > inl->di_dfs->inline_size)
+		return dfs_inl_move(obj);
+
+	do {
+		rc = dfs_inl_rmw_begin(obj, &th);
+		if (rc || inl->di_migrated)
+			return rc;
+
+		if (size > inl->di_size)
+			memset(inl->di_data + inl->di_size, 0,
+			       size - inl->di_size);
+		inl->di_size = size;
+		rc = dfs_inl_rmw_end(obj, th);
+	} while (rc == EAGAIN);
+
+	return rc;
+}
+
+/** Move the data of the inlined file @obj to its array, if not done yet */
+static int
+dfs_inl_migrate(dfs_obj_t *obj)
+{
+	pthread_mutex_t	*lock = dfs_inl_lock(obj);
+	int		rc;
+
+	D_MUTEX_LOCK(lock);
+	rc = dfs_inl_move(obj);
+	D_MUTEX_UNLOCK(lock);
+	return rc;
+}
+
+/**
+ * Resize the inlined file @obj to @size, the file is migrated to its array
+ * instead if @size is over the inline size of the mount. @inlined is cleared
+ * if the file is no longer inlined, the caller then resizes the array.
+ */
+static int
+dfs_inl_set_size(dfs_obj_t *obj, daos_size_t size, bool *inlined)
+{
+	pthread_mutex_t	*lock = dfs_inl_lock(obj);
+	int		rc = 0;
+
+	D_MUTEX_LOCK(lock);
+	if (!obj->inl->di_migrated)
+		rc = dfs_inl_resize(obj, size);
+	*inlined = !obj->inl->di_migrated;
+	D_MUTEX_UNLOCK(lock);
+	return rc;
+}
+
+/** Query the size of the inlined file @obj, see dfs_inl_set_size() */
+static int
+dfs_inl_get_size(dfs_obj_t *obj, daos_size_t *size, bool *inlined)
+{
+	pthread_mutex_t	*lock = dfs_inl_lock(obj);
+	int		rc = 0;
+
+	D_MUTEX_LOCK(lock);
+	if (!obj->inl->di_migrated)
+		rc = dfs_inl_fetch(obj, DAOS_TX_NONE);
+	*inlined = !obj->inl->di_migrated;
+	if (rc == 0 && *inlined)
+		*size = obj->inl->di_size;
+	D_MUTEX_UNLOCK(lock);
+	return rc;
+}
+
+/** Copy the range of the inlined file @obj at @off into @sgl */
+static int
+dfs_inl_read(dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
+	     daos_size_t *read_size, bool *inlined)
+{
+	struct dfs_inl	*inl = obj->inl;
+	pthread_mutex_t	*lock = dfs_inl_lock(obj);
+	daos_size_t	copied = 0;
+	daos_size_t	nob;
+	int		i;
+	int		rc = 0;
+
+	D_MUTEX_LOCK(lock);
+	if (inl->di_migrated)
+		D_GOTO(out, rc);
+
+	if (!inl->di_cached) {
+		rc = dfs_inl_fetch(obj, DAOS_TX_NONE);
+		if (rc || inl->di_migrated)
+			D_GOTO(out, rc);
+	}
+	inl->di_cached = false;
+
+	for (i = 0; i < sgl->sg_nr && off + copied < inl->di_size; i++) {
+		nob = min(sgl->sg_iovs[i].iov_len,
+			  inl->di_size - off - copied);
+		memcpy(sgl->sg_iovs[i].iov_buf, inl->di_data + off + copied,
+		       nob);
+		copied += nob;
+	}
+	*read_size = copied;
+out:
+	*inlined = !inl->di_migrated;
+	D_MUTEX_UNLOCK(lock);
+	return rc;
+}
+
+/**
+ * Write @sgl at @off in the inlined file @obj, the file is migrated to its
+ * array instead if the write goes beyond the inline size of the mount.
+ */
+static int
+dfs_inl_write(dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
+	      daos_size_t len, bool *inlined)
+{
+	struct dfs_inl	*inl = obj->inl;
+	pthread_mutex_t	*lock = dfs_inl_lock(obj);
+	daos_handle_t	th;
+	daos_size_t	copied;
+	int		i;
+	int		rc = 0;
+
+	D_MUTEX_LOCK(lock);
+	if (off + len > inl->di_dfs->inline_size) {
+		rc = dfs_inl_move(obj);
+		D_GOTO(out, rc);
+	}
+
+	while (!inl->di_migrated) {
+		rc = dfs_inl_rmw_begin(obj, &th);
+		if (rc || inl->di_migrated)
+			break;
+
+		if (off > inl->di_size)
+			memset(inl->di_data + inl->di_size, 0,
+			       off - inl->di_size);
+		for (i = 0, copied = 0; i < sgl->sg_nr; i++) {
+			memcpy(inl->di_data + off + copied,
+			       sgl->sg_iovs[i].iov_buf,
+			       sgl->sg_iovs[i].iov_len);
+			copied += sgl->sg_iovs[i].iov_len;
+		}
+		inl->di_size = max(inl->di_size, off + len);
+		rc = dfs_inl_rmw_end(obj, th);
+		if (rc != EAGAIN)
+			break;
+	}
+out:
+	*inlined = !inl->di_migrated;
+	D_MUTEX_UNLOCK(lock);
+	return rc;
+}
+
+/** dfs_punch() of the inlined file @obj, see dfs_inl_set_size() */
+static int
+dfs_inl_punch(dfs_obj_t *obj, daos_off_t off, daos_size_t len, bool *inlined)
+{
+	struct dfs_inl	*inl = obj->inl;
+	pthread_mutex_t	*lock = dfs_inl_lock(obj);
+	daos_handle_t	th;
+	int		rc = 0;
+
+	D_MUTEX_LOCK(lock);
+	while (!inl->di_migrated) {
+		rc = dfs_inl_rmw_begin(obj, &th);
+		if (rc || inl->di_migrated)
+			break;
+
+		if (len != DFS_MAX_FSIZE && inl->di_size == off) {
+			daos_tx_close(th, NULL);
+			break;
+		}
+
+		/** truncate or extend to @off */
+		if (len == DFS_MAX_FSIZE || inl->di_size <= off + len) {
+			daos_tx_close(th, NULL);
+			rc = dfs_inl_resize(obj, off);
+			break;
+		}
+
+		memset(inl->di_data + off, 0, len);
+		rc = dfs_inl_rmw_end(obj, th);
+		if (rc != EAGAIN)
+			break;
+	}
+	*inlined = !inl->di_migrated;
+	D_MUTEX_UNLOCK(lock);
+	return rc;
+}
+
+/** Query the size of the file of @entry from its array object */
+static int
+get_file_size(dfs_t *dfs, struct dfs_entry *entry, daos_size_t *size)
+{
+	daos_handle_t	file_oh;
+	int		rc;
+
+	rc = daos_array_open_with_attr(dfs->coh, entry->oid, DAOS_TX_NONE,
+		DAOS_OO_RO, 1, entry->chunk_size ? entry->chunk_size :
+		dfs->attr.da_chunk_size, &file_oh, NULL);
+	if (rc) {
+		D_ERROR("daos_array_open_with_attr() failed (%d)\n", rc);
+		return daos_der2errno(rc);
+	}
 
-		/** if we just want to check if entries exist, break now */
-		if (check_empty)
-			break;
+	rc = dfs_wb_sync_oid(dfs, entry->oid);
+	if (rc) {
+		daos_array_close(file_oh, NULL);
+		return rc;
 	}
 
-	*nr = key_nr;
-	return 0;
+	rc = daos_array_get_size(file_oh, DAOS_TX_NONE, size, NULL);
+	if (rc) {
+		daos_array_close(file_oh, NULL);
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_array_close(file_oh, NULL);
+	return daos_der2errno(rc);
 }
 
 static int
-entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
-	   struct stat *stbuf)
+entry_stat(dfs_t *dfs, daos_handle_t oh, daos_obj_id_t parent,
+	   const char *name, struct stat *stbuf)
 {
 	struct dfs_entry	entry = {0};
 	bool			exists;
@@ -544,7 +1896,7 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
 	memset(stbuf, 0, sizeof(struct stat));
 
 	/* Check if parent has the entry */
-	rc = fetch_entry(oh, th, name, true, &exists, &entry);
+	rc = lookup_entry(dfs, oh, parent, name, &exists, &entry);
 	if (rc)
 		return rc;
 
@@ -556,28 +1908,15 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
 		size = sizeof(entry);
 		break;
 	case S_IFREG:
-	{
-		daos_handle_t	file_oh;
-
-		rc = daos_array_open_with_attr(dfs->coh, entry.oid, th,
-			DAOS_OO_RO, 1, entry.chunk_size ? entry.chunk_size :
-			dfs->attr.da_chunk_size, &file_oh, NULL);
-		if (rc) {
-			D_ERROR("daos_array_open_with_attr() failed (%d)\n",
-				rc);
-			return daos_der2errno(rc);
-		}
-
-		rc = daos_array_get_size(file_oh, th, &size, NULL);
-		if (rc) {
-			daos_array_close(file_oh, NULL);
-			return daos_der2errno(rc);
+		/** the size of an inlined file is in its entry */
+		if (entry.inl) {
+			size = entry.isize;
+		} else {
+			rc = get_file_size(dfs, &entry, &size);
+			if (rc)
+				return rc;
 		}
 
-		rc = daos_array_close(file_oh, NULL);
-		if (rc)
-			return daos_der2errno(rc);
-
 		/*
 		 * TODO - this is not accurate since it does not account for
 		 * sparse files or file metadata or xattributes.
@@ -586,7 +1925,6 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
 		stbuf->st_blksize = entry.chunk_size ? entry.chunk_size :
 			dfs->attr.da_chunk_size;
 		break;
-	}
 	case S_IFLNK:
 		size = strlen(entry.value) + 1;
 		D_FREE(entry.value);
@@ -666,26 +2004,35 @@ open_file(dfs_t *dfs, daos_handle_t th, dfs_obj_t *parent, int flags,
 	  daos_oclass_id_t cid, daos_size_t chunk_size, dfs_obj_t *file)
 {
 	struct dfs_entry	entry = {0};
+	struct dfs_inl		*inl;
+	d_iov_t			data;
 	bool			exists;
 	int			daos_mode;
 	int			rc;
 
+	/** the data of an inlined file is fetched with its entry */
+	inl = dfs_inl_alloc(dfs, 0, true);
+	if (inl == NULL)
+		return ENOMEM;
+	d_iov_set(&data, inl->di_data, DFS_INLINE_MAX);
+
 	/* Check if parent has the filename entry */
-	rc = fetch_entry(parent->oh, th, file->name, false, &exists, &entry);
+	rc = fetch_entry_data(parent->oh, th, file->name, false, &data,
+			      &exists, &entry);
 	if (rc) {
 		D_ERROR("fetch_entry %s failed %d.\n", file->name, rc);
-		return rc;
+		D_GOTO(out, rc);
 	}
 
 	if (flags & O_CREAT) {
 		if (exists) {
 			if (flags & O_EXCL)
-				return EEXIST;
+				D_GOTO(out, rc = EEXIST);
 
 			if (S_ISDIR(entry.mode)) {
 				D_DEBUG(DB_TRACE, "can't overwrite dir %s with "
 					"non-directory\n", file->name);
-				return EINVAL;
+				D_GOTO(out, rc = EINVAL);
 			}
 
 			goto open_file;
@@ -694,7 +2041,7 @@ open_file(dfs_t *dfs, daos_handle_t th, dfs_obj_t *parent, int flags,
 		/** Get new OID for the file */
 		rc = oid_gen(dfs, cid, true, &file->oid);
 		if (rc != 0)
-			return rc;
+			D_GOTO(out, rc);
 		oid_cp(&entry.oid, file->oid);
 
 		/** Open the array object for the file */
@@ -704,7 +2051,7 @@ open_file(dfs_t *dfs, daos_handle_t th, dfs_obj_t *parent, int flags,
 		if (rc != 0) {
 			D_ERROR("daos_array_open_with_attr() failed (%d)\n",
 				rc);
-			return daos_der2errno(rc);
+			D_GOTO(out, rc = daos_der2errno(rc));
 		}
 
 		/** Create and insert entry in parent dir object. */
@@ -712,21 +2059,28 @@ open_file(dfs_t *dfs, daos_handle_t th, dfs_obj_t *parent, int flags,
 		entry.atime = entry.mtime = entry.ctime = time(NULL);
 		if (chunk_size)
 			entry.chunk_size = chunk_size;
+		/** the new file is inlined, and empty, if enabled */
+		entry.inl = dfs->inline_size > 0;
+		entry.isize = 0;
 
 		rc = insert_entry(parent->oh, th, file->name, entry);
 		if (rc != 0) {
-			daos_obj_close(file->oh, NULL);
+			daos_array_close(file->oh, NULL);
 			D_ERROR("Inserting file entry %s failed (%d)\n",
 				file->name, rc);
-			return rc;
+			D_GOTO(out, rc);
 		}
 
-		return rc;
+		if (entry.inl) {
+			file->inl = inl;
+			inl = NULL;
+		}
+		D_GOTO(out, rc);
 	}
 
 	/** Open the byte array */
 	if (!exists)
-		return ENOENT;
+		D_GOTO(out, rc = ENOENT);
 
 open_file:
 	if (!S_ISREG(entry.mode)) {
@@ -734,18 +2088,18 @@ open_file:
 			D_ASSERT(S_ISLNK(entry.mode));
 			D_FREE(entry.value);
 		}
-		return EINVAL;
+		D_GOTO(out, rc = EINVAL);
 	}
 
 	daos_mode = get_daos_obj_mode(flags);
 	if (daos_mode == -1)
-		return EINVAL;
+		D_GOTO(out, rc = EINVAL);
 
 	rc = check_access(dfs, geteuid(), getegid(), entry.mode,
 			  (daos_mode == DAOS_OO_RO) ? R_OK : R_OK | W_OK);
 	if (rc) {
 		D_ERROR("check_access failed %d\n", rc);
-		return rc;
+		D_GOTO(out, rc);
 	}
 
 	file->mode = entry.mode;
@@ -754,12 +2108,21 @@ open_file:
 			dfs->attr.da_chunk_size, &file->oh, NULL);
 	if (rc != 0) {
 		D_ERROR("daos_array_open_with_attr() failed (%d)\n", rc);
-		return daos_der2errno(rc);
+		D_GOTO(out, rc = daos_der2errno(rc));
 	}
 
 	oid_cp(&file->oid, entry.oid);
 
-	return 0;
+	if (entry.inl) {
+		inl->di_size = entry.isize;
+		inl->di_cached = data.iov_len >= entry.isize;
+		file->inl = inl;
+		inl = NULL;
+	}
+
+out:
+	D_FREE(inl);
+	return rc;
 }
 
 /*
@@ -1135,7 +2498,9 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 	daos_pool_info_t	pool_info = {};
 	daos_prop_t		*prop;
 	struct daos_prop_entry	*entry;
+	unsigned int		dc_timeout = 0;
 	int			amode, obj_mode;
+	int			i;
 	int			rc;
 
 	amode = (flags & O_ACCMODE);
@@ -1170,11 +2535,30 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 	dfs->poh = poh;
 	dfs->coh = coh;
 	dfs->amode = amode;
+	d_getenv_int("DFS_READ_AHEAD", &dfs->ra_depth);
+	dfs->ra_depth = min(dfs->ra_depth, DFS_RA_MAX_DEPTH);
+	d_getenv_bool("DFS_WRITE_BACK", &dfs->wb_enabled);
+	D_INIT_LIST_HEAD(&dfs->wb_list);
+	d_getenv_int("DFS_DENTRY_CACHE", &dc_timeout);
+	dfs->dc_timeout = (uint64_t)dc_timeout * NSEC_PER_SEC;
+	d_getenv_int("DFS_INLINE_SIZE", &dfs->inline_size);
+	dfs->inline_size = min(dfs->inline_size, DFS_INLINE_MAX);
 
 	rc = D_MUTEX_INIT(&dfs->lock, NULL);
 	if (rc != 0)
 		return daos_der2errno(rc);
 
+	for (i = 0; i < DFS_INL_LOCKS; i++) {
+		rc = D_MUTEX_INIT(&dfs->inl_locks[i], NULL);
+		if (rc != 0) {
+			while (i-- > 0)
+				D_MUTEX_DESTROY(&dfs->inl_locks[i]);
+			D_MUTEX_DESTROY(&dfs->lock);
+			D_FREE(dfs);
+			return daos_der2errno(rc);
+		}
+	}
+
 	prop = daos_prop_alloc(0);
 	if (prop == NULL) {
 		D_ERROR("Failed to allocate prop.");
@@ -1243,6 +2627,12 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 			dfs->oid.hi = 0;
 	}
 
+	if (dfs->dc_timeout) {
+		rc = dfs_dc_init(dfs);
+		if (rc)
+			D_GOTO(err_root, rc);
+	}
+
 	dfs->mounted = true;
 	*_dfs = dfs;
 
@@ -1259,6 +2649,8 @@ err_dfs:
 int
 dfs_umount(dfs_t *dfs)
 {
+	int	i;
+
 	if (dfs == NULL || !dfs->mounted)
 		return EINVAL;
 
@@ -1268,6 +2660,9 @@ dfs_umount(dfs_t *dfs)
 	if (dfs->prefix)
 		D_FREE(dfs->prefix);
 
+	dfs_dc_fini(dfs);
+	for (i = 0; i < DFS_INL_LOCKS; i++)
+		D_MUTEX_DESTROY(&dfs->inl_locks[i]);
 	D_MUTEX_DESTROY(&dfs->lock);
 	D_FREE(dfs);
 
@@ -1300,148 +2695,522 @@ dfs_set_prefix(dfs_t *dfs, const char *prefix)
 	return 0;
 }
 
-int
-dfs_get_file_oh(dfs_obj_t *obj, daos_handle_t *oh)
-{
-	if (obj == NULL || !S_ISREG(obj->mode))
-		return EINVAL;
-	if (oh == NULL)
-		return EINVAL;
+int
+dfs_get_file_oh(dfs_obj_t *obj, daos_handle_t *oh)
+{
+	int rc;
+
+	if (obj == NULL || !S_ISREG(obj->mode))
+		return EINVAL;
+	if (oh == NULL)
+		return EINVAL;
+
+	/** the array is accessed directly, it must hold the data */
+	if (obj->inl) {
+		rc = dfs_inl_migrate(obj);
+		if (rc)
+			return rc;
+	}
+
+	oh->cookie = obj->oh.cookie;
+	return 0;
+}
+
+int
+dfs_get_chunk_size(dfs_obj_t *obj, daos_size_t *chunk_size)
+{
+	daos_size_t	cell_size;
+	int		rc;
+
+	if (obj == NULL || !S_ISREG(obj->mode))
+		return EINVAL;
+	if (chunk_size == NULL)
+		return EINVAL;
+
+	rc = daos_array_get_attr(obj->oh, chunk_size, &cell_size);
+	if (rc)
+		return daos_der2errno(rc);
+
+	D_ASSERT(cell_size == 1);
+	return 0;
+}
+
+int
+dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
+{
+	dfs_obj_t		new_dir;
+	daos_handle_t		th = DAOS_TX_NONE;
+	struct dfs_entry	entry = {0};
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dfs->amode != O_RDWR)
+		return EPERM;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+
+	rc = check_name(name);
+	if (rc)
+		return rc;
+
+	rc = check_access(dfs, geteuid(), getegid(), parent->mode, W_OK | X_OK);
+	if (rc)
+		return rc;
+
+	strncpy(new_dir.name, name, DFS_MAX_PATH);
+	new_dir.name[DFS_MAX_PATH] = '\0';
+	rc = create_dir(dfs, th, (parent ? parent->oh : DAOS_HDL_INVAL), 0,
+			&new_dir);
+	if (rc)
+		D_GOTO(out, rc);
+
+	entry.oid = new_dir.oid;
+	entry.mode = S_IFDIR | mode;
+	entry.atime = entry.mtime = entry.ctime = time(NULL);
+	entry.chunk_size = 0;
+
+	rc = insert_entry(parent->oh, th, name, entry);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	daos_obj_close(new_dir.oh, NULL);
+	dfs_dc_evict(dfs, parent->oid, name);
+
+out:
+	return rc;
+}
+
+/**
+ * Callback of dfs_plus_iterate(). The symlink value of @entry is not set, it
+ * is looked up by the callback if needed.
+ */
+typedef int (*dfs_plus_cb_t)(dfs_t *dfs, dfs_obj_t *dir, const char *name,
+			     struct dfs_entry *entry, void *arg);
+
+/** Fetch of the inode a-keys of one entry listed by dfs_plus_iterate() */
+struct dfs_plus_entry {
+	daos_event_t		pe_ev;
+	char			pe_name[DFS_MAX_PATH + 1];
+	daos_key_t		pe_dkey;
+	daos_iod_t		pe_iods[INODE_AKEYS];
+	d_sg_list_t		pe_sgls[INODE_AKEYS];
+	d_iov_t			pe_iovs[INODE_AKEYS];
+	struct dfs_entry	pe_entry;
+	bool			pe_inflight;
+};
+
+/** wait for the fetch of @pe if it is in flight */
+static int
+dfs_plus_wait(struct dfs_plus_entry *pe)
+{
+	bool	flag = false;
+	int	rc = 0;
+
+	if (!pe->pe_inflight)
+		return 0;
+
+	while (!flag) {
+		rc = daos_event_test(&pe->pe_ev, DAOS_EQ_WAIT, &flag);
+		if (rc) {
+			D_ERROR("daos_event_test() failed (%d)\n", rc);
+			break;
+		}
+	}
+	if (flag)
+		rc = pe->pe_ev.ev_error;
+
+	daos_event_fini(&pe->pe_ev);
+	pe->pe_inflight = false;
+	return rc;
+}
+
+/**
+ * Fetch the inode a-keys of the @num listed entries. The fetches are all
+ * issued before waiting for any of them, so that the batch costs about one
+ * round trip.
+ */
+static int
+dfs_plus_fetch(dfs_obj_t *dir, struct dfs_plus_entry *pes, uint32_t num,
+	       unsigned int akeys_nr)
+{
+	struct dfs_plus_entry	*pe;
+	uint32_t		i;
+	int			rc = 0;
+	int			ret;
+
+	for (i = 0; i < num; i++) {
+		pe = &pes[i];
+		rc = daos_event_init(&pe->pe_ev, DAOS_HDL_INVAL, NULL);
+		if (rc)
+			break;
+
+		rc = daos_obj_fetch(dir->oh, DAOS_TX_NONE, &pe->pe_dkey,
+				    akeys_nr, pe->pe_iods, pe->pe_sgls, NULL,
+				    &pe->pe_ev);
+		if (rc) {
+			daos_event_fini(&pe->pe_ev);
+			break;
+		}
+		pe->pe_inflight = true;
+	}
+
+	for (i = 0; i < num; i++) {
+		ret = dfs_plus_wait(&pes[i]);
+		if (rc == 0)
+			rc = ret;
+	}
+	return rc;
+}
+
+/**
+ * Report the fetched entry @pe to @cb if it exists. The symlink value is not
+ * fetched with the other a-keys, the callbacks that need it look it up.
+ */
+static int
+dfs_plus_fill(dfs_t *dfs, dfs_obj_t *dir, struct dfs_plus_entry *pe,
+	      unsigned int akeys_nr, dfs_plus_cb_t cb, void *arg,
+	      uint32_t *entries)
+{
+	struct dfs_entry	*entry = &pe->pe_entry;
+	int			rc;
+
+	/** the entry was removed after it was listed */
+	if (pe->pe_iods[0].iod_size == 0)
+		return 0;
+
+	entry->inl = pe->pe_iods[akeys_nr - 1].iod_size != 0;
+	if (!entry->inl)
+		entry->isize = 0;
+
+	rc = cb(dfs, dir, pe->pe_name, entry, arg);
+	if (rc == 0)
+		(*entries)++;
+	return rc;
+}
+
+/**
+ * Move @anchor from @start past the first @skip entries, using @sgl as the
+ * name buffer, so that the next listing starts with the entry that follows.
+ */
+static int
+dfs_plus_rewind(dfs_obj_t *obj, daos_anchor_t *start, uint32_t skip,
+		daos_key_desc_t *kds, d_sg_list_t *sgl, daos_anchor_t *anchor)
+{
+	d_iov_t		*iov = &sgl->sg_iovs[0];
+	uint32_t	num;
+	int		rc;
+
+	*anchor = *start;
+	while (skip > 0 && !daos_anchor_is_eof(anchor)) {
+		num = skip;
+		iov->iov_len = iov->iov_buf_len;
+		sgl->sg_nr_out = 0;
+		rc = daos_obj_list_dkey(obj->oh, DAOS_TX_NONE, &num, kds, sgl,
+					anchor, NULL);
+		if (rc)
+			return daos_der2errno(rc);
+		skip -= min(num, skip);
+	}
+	return 0;
+}
+
+/**
+ * List the entries of the directory @obj by batches of up to @nr names and
+ * @size bytes of names, and report each of them to @cb with its inode. The
+ * inodes of a batch are fetched concurrently, instead of a lookup per entry
+ * after the listing. Returns once at least one entry was reported or the end
+ * of the directory is reached. @anchor is the d-key anchor of dfs_iterate().
+ * If @cb fails, @anchor is left at the failed entry, which is then the first
+ * one listed by the next call.
+ */
+static int
+dfs_plus_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
+		 uint32_t *nr, size_t size, dfs_plus_cb_t cb, void *arg)
+{
+	struct dfs_plus_entry	*pes = NULL;
+	daos_key_desc_t		*kds = NULL;
+	char			*buf = NULL;
+	size_t			buf_size;
+	unsigned int		akeys_nr = 0;
+	uint32_t		entries = 0;
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	int			rc = 0;
+	int			ret;
+
+	buf_size = min(size, (size_t)*nr * DFS_MAX_PATH);
+	D_ALLOC_ARRAY(pes, *nr);
+	D_ALLOC_ARRAY(kds, *nr);
+	D_ALLOC(buf, buf_size);
+	if (pes == NULL || kds == NULL || buf == NULL)
+		D_GOTO(out, rc = ENOMEM);
+
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &iov;
+
+	while (entries == 0 && !daos_anchor_is_eof(anchor)) {
+		daos_anchor_t	start = *anchor;
+		uint32_t	num = *nr;
+		char		*ptr = buf;
+		uint32_t	i;
+
+		d_iov_set(&iov, buf, buf_size);
+		sgl.sg_nr_out = 0;
+
+		rc = daos_obj_list_dkey(obj->oh, DAOS_TX_NONE, &num, kds,
+					&sgl, anchor, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
+		if (num == 0)
+			continue;
+
+		for (i = 0; i < num; ptr += kds[i].kd_key_len, i++) {
+			struct dfs_plus_entry *pe = &pes[i];
+
+			memset(pe, 0, sizeof(*pe));
+			memcpy(pe->pe_name, ptr,
+			       min(kds[i].kd_key_len, DFS_MAX_PATH));
+			d_iov_set(&pe->pe_dkey, pe->pe_name,
+				  min(kds[i].kd_key_len, DFS_MAX_PATH));
+			akeys_nr = set_entry_akeys(&pe->pe_entry, pe->pe_iods,
+						   pe->pe_iovs);
+			set_fetch_iods(pe->pe_iods, pe->pe_sgls, pe->pe_iovs,
+				       akeys_nr);
+		}
+
+		rc = dfs_plus_fetch(obj, pes, num, akeys_nr);
+		if (rc) {
+			D_ERROR("Failed to fetch %u entries (%d)\n", num, rc);
+			*anchor = start;
+			D_GOTO(out, rc = daos_der2errno(rc));
+		}
+
+		for (i = 0; i < num; i++) {
+			rc = dfs_plus_fill(dfs, obj, &pes[i], akeys_nr, cb, arg,
+					   &entries);
+			if (rc == 0)
+				continue;
+
+			ret = dfs_plus_rewind(obj, &start, i, kds, &sgl,
+					      anchor);
+			if (ret)
+				D_ERROR("Failed to reposition the anchor "
+					"(%d)\n", ret);
+			D_GOTO(out, rc);
+		}
+	}
+
+out:
+	*nr = entries;
+	D_FREE(buf);
+	D_FREE(kds);
+	D_FREE(pes);
+	return rc;
+}
+
+/** Object punch of a recursive removal */
+struct dfs_rm_op {
+	daos_event_t		ro_ev;
+	daos_handle_t		ro_oh;
+	d_list_t		ro_link;
+};
 
-	oh->cookie = obj->oh.cookie;
-	return 0;
-}
+/**
+ * Recursive removal of a directory tree. The objects of the tree are punched
+ * in parallel, up to DFS_RM_INFLIGHT at a time.
+ */
+struct dfs_rm {
+	daos_handle_t		rm_eq;
+	struct dfs_rm_op	rm_ops[DFS_RM_INFLIGHT];
+	/** idle punch slots */
+	d_list_t		rm_free;
+	unsigned int		rm_inflight;
+	/** first punch error */
+	int			rm_err;
+	/** number of objects punched */
+	uint64_t		rm_punched;
+};
 
-int
-dfs_get_chunk_size(dfs_obj_t *obj, daos_size_t *chunk_size)
+/** Reap the completed punches, wait for at least one if @wait is true */
+static int
+dfs_rm_reap(struct dfs_rm *rm, bool wait)
 {
-	daos_size_t	cell_size;
-	int		rc;
-
-	if (obj == NULL || !S_ISREG(obj->mode))
-		return EINVAL;
-	if (chunk_size == NULL)
-		return EINVAL;
+	struct daos_event	*evs[DFS_RM_INFLIGHT];
+	struct dfs_rm_op	*op;
+	int			i;
+	int			rc;
 
-	rc = daos_array_get_attr(obj->oh, chunk_size, &cell_size);
-	if (rc)
+	rc = daos_eq_poll(rm->rm_eq, 0, wait ? DAOS_EQ_WAIT : DAOS_EQ_NOWAIT,
+			  DFS_RM_INFLIGHT, evs);
+	if (rc < 0) {
+		D_ERROR("daos_eq_poll() failed (%d)\n", rc);
 		return daos_der2errno(rc);
+	}
 
-	D_ASSERT(cell_size == 1);
+	for (i = 0; i < rc; i++) {
+		op = container_of(evs[i], struct dfs_rm_op, ro_ev);
+		if (evs[i]->ev_error && rm->rm_err == 0)
+			rm->rm_err = daos_der2errno(evs[i]->ev_error);
+		daos_obj_close(op->ro_oh, NULL);
+		d_list_add(&op->ro_link, &rm->rm_free);
+		rm->rm_inflight--;
+		rm->rm_punched++;
+	}
 	return 0;
 }
 
-int
-dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
+/** Punch the object @oid as a whole, without waiting for the completion */
+static int
+dfs_rm_punch(dfs_t *dfs, struct dfs_rm *rm, daos_obj_id_t oid)
 {
-	dfs_obj_t		new_dir;
-	daos_handle_t		th = DAOS_TX_NONE;
-	struct dfs_entry	entry = {0};
+	struct dfs_rm_op	*op;
 	int			rc;
 
-	if (dfs == NULL || !dfs->mounted)
-		return EINVAL;
-	if (dfs->amode != O_RDWR)
-		return EPERM;
-	if (parent == NULL)
-		parent = &dfs->root;
-	else if (!S_ISDIR(parent->mode))
-		return ENOTDIR;
+	while (d_list_empty(&rm->rm_free)) {
+		rc = dfs_rm_reap(rm, true);
+		if (rc)
+			return rc;
+	}
+	if (rm->rm_err)
+		return rm->rm_err;
 
-	rc = check_name(name);
+	op = d_list_entry(rm->rm_free.next, struct dfs_rm_op, ro_link);
+	rc = daos_obj_open(dfs->coh, oid, DAOS_OO_RW, &op->ro_oh, NULL);
 	if (rc)
-		return rc;
+		return daos_der2errno(rc);
 
-	rc = check_access(dfs, geteuid(), getegid(), parent->mode, W_OK | X_OK);
-	if (rc)
-		return rc;
+	rc = daos_obj_punch(op->ro_oh, DAOS_TX_NONE, &op->ro_ev);
+	if (rc) {
+		daos_obj_close(op->ro_oh, NULL);
+		return daos_der2errno(rc);
+	}
 
-	strncpy(new_dir.name, name, DFS_MAX_PATH);
-	new_dir.name[DFS_MAX_PATH] = '\0';
-	rc = create_dir(dfs, th, (parent ? parent->oh : DAOS_HDL_INVAL), 0,
-			&new_dir);
-	if (rc)
-		D_GOTO(out, rc);
+	d_list_del(&op->ro_link);
+	rm->rm_inflight++;
+	return 0;
+}
 
-	entry.oid = new_dir.oid;
-	entry.mode = S_IFDIR | mode;
-	entry.atime = entry.mtime = entry.ctime = time(NULL);
-	entry.chunk_size = 0;
+static int dfs_rm_dir(dfs_t *dfs, struct dfs_rm *rm, daos_obj_id_t oid);
 
-	rc = insert_entry(parent->oh, th, name, entry);
-	if (rc != 0)
-		D_GOTO(out, rc);
+static int
+dfs_rm_entry_cb(dfs_t *dfs, dfs_obj_t *dir, const char *name,
+		struct dfs_entry *entry, void *arg)
+{
+	struct dfs_rm	*rm = arg;
+	int		rc = 0;
 
-	daos_obj_close(new_dir.oh, NULL);
+	dfs_dc_evict(dfs, dir->oid, name);
 
-out:
+	/**
+	 * The entries are not removed one by one from the directory, the
+	 * directory object is punched as a whole once it is empty.
+	 */
+	switch (entry->mode & S_IFMT) {
+	case S_IFDIR:
+		rc = dfs_rm_dir(dfs, rm, entry->oid);
+		if (rc == 0)
+			rc = dfs_rm_punch(dfs, rm, entry->oid);
+		break;
+	case S_IFREG:
+		/** the array of an inlined file is empty */
+		if (!entry->inl)
+			rc = dfs_rm_punch(dfs, rm, entry->oid);
+		break;
+	default:
+		/** symlinks have no object, their value is not needed */
+		break;
+	}
 	return rc;
 }
 
+/** Punch the objects of all the entries of the directory @oid */
 static int
-remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
+dfs_rm_dir(dfs_t *dfs, struct dfs_rm *rm, daos_obj_id_t oid)
 {
-	daos_handle_t	oh;
-	daos_key_desc_t	kds[ENUM_DESC_NR];
+	dfs_obj_t	dir = {0};
 	daos_anchor_t	anchor = {0};
-	d_iov_t	iov;
-	char		enum_buf[ENUM_DESC_BUF] = {0};
-	d_sg_list_t	sgl;
 	int		rc;
 
-	D_ASSERT(S_ISDIR(entry.mode));
-
-	rc = daos_obj_open(dfs->coh, entry.oid, DAOS_OO_RW, &oh, NULL);
+	rc = daos_obj_open(dfs->coh, oid, DAOS_OO_RO, &dir.oh, NULL);
 	if (rc)
 		return daos_der2errno(rc);
-
-	sgl.sg_nr = 1;
-	sgl.sg_nr_out = 0;
-	d_iov_set(&iov, enum_buf, ENUM_DESC_BUF);
-	sgl.sg_iovs = &iov;
+	oid_cp(&dir.oid, oid);
+	dir.mode = S_IFDIR;
 
 	while (!daos_anchor_is_eof(&anchor)) {
-		uint32_t	number = ENUM_DESC_NR;
-		uint32_t	i;
-		char		*ptr;
+		uint32_t nr = DFS_RM_BATCH;
 
-		rc = daos_obj_list_dkey(oh, th, &number, kds, &sgl, &anchor,
-					NULL);
+		rc = dfs_plus_iterate(dfs, &dir, &anchor, &nr,
+				      DFS_RM_BATCH * DFS_MAX_PATH,
+				      dfs_rm_entry_cb, rm);
 		if (rc)
-			D_GOTO(out, rc = daos_der2errno(rc));
+			break;
+	}
 
-		if (number == 0)
-			continue;
+	daos_obj_close(dir.oh, NULL);
+	return rc;
+}
 
-		for (ptr = enum_buf, i = 0; i < number; i++) {
-			struct dfs_entry child_entry = {0};
-			char entry_name[DFS_MAX_PATH + 1];
-			bool exists;
+/**
+ * Remove the whole tree under the directory @entry. The entries are listed
+ * in large batches with their inode, and the objects of the files and of the
+ * sub-directories are punched in parallel. The directory itself is left to
+ * the caller.
+ */
+static int
+remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
+{
+	struct dfs_rm	*rm;
+	int		i;
+	int		rc;
 
-			snprintf(entry_name, kds[i].kd_key_len + 1, "%s", ptr);
-			ptr += kds[i].kd_key_len;
+	D_ASSERT(S_ISDIR(entry.mode));
+	/** the punches are not transactional */
+	D_ASSERT(daos_handle_is_inval(th));
 
-			rc = fetch_entry(oh, th, entry_name, false,
-					 &exists, &child_entry);
-			if (rc)
-				D_GOTO(out, rc);
+	D_ALLOC_PTR(rm);
+	if (rm == NULL)
+		return ENOMEM;
 
-			D_ASSERT(exists);
+	rc = daos_eq_create(&rm->rm_eq);
+	if (rc) {
+		D_FREE(rm);
+		return daos_der2errno(rc);
+	}
 
-			if (S_ISDIR(child_entry.mode)) {
-				rc = remove_dir_contents(dfs, th, child_entry);
-				if (rc)
-					D_GOTO(out, rc);
-			}
+	D_INIT_LIST_HEAD(&rm->rm_free);
+	for (i = 0; i < DFS_RM_INFLIGHT; i++) {
+		rc = daos_event_init(&rm->rm_ops[i].ro_ev, rm->rm_eq, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
+		d_list_add(&rm->rm_ops[i].ro_link, &rm->rm_free);
+	}
 
-			rc = remove_entry(dfs, th, oh, entry_name, child_entry);
-			if (rc)
-				D_GOTO(out, rc);
-		}
+	rc = dfs_rm_dir(dfs, rm, entry.oid);
+
+	while (rm->rm_inflight > 0) {
+		if (dfs_rm_reap(rm, true))
+			break;
 	}
+	if (rc == 0)
+		rc = rm->rm_err;
 
+	D_DEBUG(DB_TRACE, "Removed "DF_OID": "DF_U64" objects punched, %d\n",
+		DP_OID(entry.oid), rm->rm_punched, rc);
 out:
-	daos_obj_close(oh, NULL);
+	/** the events that were initialized are on the free list */
+	while (!d_list_empty(&rm->rm_free)) {
+		struct dfs_rm_op *op;
+
+		op = d_list_entry(rm->rm_free.next, struct dfs_rm_op, ro_link);
+		d_list_del(&op->ro_link);
+		daos_event_fini(&op->ro_ev);
+	}
+	daos_eq_destroy(rm->rm_eq, DAOS_EQ_DESTROY_FORCE);
+	D_FREE(rm);
 	return rc;
 }
 
@@ -1509,6 +3278,7 @@ dfs_remove(dfs_t *dfs, dfs_obj_t *parent, const char *name, bool force,
 	}
 
 	rc = remove_entry(dfs, th, parent->oh, name, entry);
+	dfs_dc_evict(dfs, parent->oid, name);
 	if (rc)
 		D_GOTO(out, rc);
 
@@ -1590,8 +3360,8 @@ dfs_lookup_loop:
 			return rc;
 
 		entry.chunk_size = 0;
-		rc = fetch_entry(parent.oh, DAOS_TX_NONE, token, true,
-				 &exists, &entry);
+		rc = lookup_entry(dfs, parent.oh, parent.oid, token, &exists,
+				  &entry);
 		if (rc)
 			D_GOTO(err_obj, rc);
 
@@ -1627,7 +3397,20 @@ dfs_lookup_loop:
 				D_GOTO(err_obj, rc = daos_der2errno(rc));
 			}
 
-			if (stbuf) {
+			if (entry.inl) {
+				obj->inl = dfs_inl_alloc(dfs, entry.isize,
+							 false);
+				if (obj->inl == NULL) {
+					daos_array_close(obj->oh, NULL);
+					D_GOTO(err_obj, rc = ENOMEM);
+				}
+				if (stbuf) {
+					stbuf->st_size = entry.isize;
+					stbuf->st_blocks =
+						(stbuf->st_size + (1 << 9) - 1)
+						>> 9;
+				}
+			} else if (stbuf) {
 				daos_size_t size;
 
 				rc = daos_array_get_size(obj->oh, DAOS_TX_NONE,
@@ -1664,6 +3447,8 @@ dfs_lookup_loop:
 				}
 
 				parent.oh = sym->oh;
+				parent.mode = sym->mode;
+				oid_cp(&parent.oid, sym->oid);
 				D_FREE(sym);
 				D_FREE(entry.value);
 				obj->value = NULL;
@@ -1880,42 +3665,18 @@ out:
 	return rc;
 }
 
-int
-dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
-	       dfs_obj_t **_obj, mode_t *mode, struct stat *stbuf)
+/**
+ * Open the object of the existing entry @name of @parent, already fetched in
+ * @entry. The symlink value of @entry is taken over by the object. @stbuf is
+ * optional, the file size is only queried when it is requested.
+ */
+static int
+open_entry(dfs_t *dfs, dfs_obj_t *parent, const char *name,
+	   struct dfs_entry *entry, int daos_mode, dfs_obj_t **_obj,
+	   struct stat *stbuf)
 {
-	dfs_obj_t		*obj;
-	struct dfs_entry	entry = {0};
-	bool			exists;
-	int			daos_mode;
-	int			rc = 0;
-
-	if (dfs == NULL || !dfs->mounted)
-		return EINVAL;
-	if (_obj == NULL)
-		return EINVAL;
-	if (parent == NULL)
-		parent = &dfs->root;
-	else if (!S_ISDIR(parent->mode))
-		return ENOTDIR;
-
-	rc = check_name(name);
-	if (rc)
-		return rc;
-	rc = check_access(dfs, geteuid(), getegid(), parent->mode, X_OK);
-	if (rc)
-		return rc;
-	daos_mode = get_daos_obj_mode(flags);
-	if (daos_mode == -1)
-		return EINVAL;
-
-	rc = fetch_entry(parent->oh, DAOS_TX_NONE, name, true, &exists,
-			 &entry);
-	if (rc)
-		return rc;
-
-	if (!exists)
-		return ENOENT;
+	dfs_obj_t	*obj;
+	int		rc = 0;
 
 	if (stbuf)
 		memset(stbuf, 0, sizeof(struct stat));
@@ -1927,14 +3688,14 @@ dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 	strncpy(obj->name, name, DFS_MAX_PATH);
 	obj->name[DFS_MAX_PATH] = '\0';
 	oid_cp(&obj->parent_oid, parent->oid);
-	oid_cp(&obj->oid, entry.oid);
-	obj->mode = entry.mode;
+	oid_cp(&obj->oid, entry->oid);
+	obj->mode = entry->mode;
 
 	/** if entry is a file, open the array object and return */
-	if (S_ISREG(entry.mode)) {
-		rc = daos_array_open_with_attr(dfs->coh, entry.oid,
-			DAOS_TX_NONE, daos_mode, 1, entry.chunk_size ?
-			entry.chunk_size : dfs->attr.da_chunk_size, &obj->oh,
+	if (S_ISREG(entry->mode)) {
+		rc = daos_array_open_with_attr(dfs->coh, entry->oid,
+			DAOS_TX_NONE, daos_mode, 1, entry->chunk_size ?
+			entry->chunk_size : dfs->attr.da_chunk_size, &obj->oh,
 			NULL);
 		if (rc != 0) {
 			D_ERROR("daos_array_open_with_attr() Failed (%d)\n",
@@ -1942,10 +3703,28 @@ dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 			D_GOTO(err_obj, rc = daos_der2errno(rc));
 		}
 
-		/** we need the file size if stat struct is needed */
-		if (stbuf) {
+		/** the data of an inlined file is fetched on first use */
+		if (entry->inl) {
+			obj->inl = dfs_inl_alloc(dfs, entry->isize, false);
+			if (obj->inl == NULL) {
+				daos_array_close(obj->oh, NULL);
+				D_GOTO(err_obj, rc = ENOMEM);
+			}
+			if (stbuf) {
+				stbuf->st_size = entry->isize;
+				stbuf->st_blocks =
+					(stbuf->st_size + (1 << 9) - 1) >> 9;
+			}
+		} else if (stbuf) {
+			/** we need the file size if stat struct is needed */
 			daos_size_t size;
 
+			rc = dfs_wb_sync_oid(dfs, entry->oid);
+			if (rc) {
+				daos_array_close(obj->oh, NULL);
+				D_GOTO(err_obj, rc);
+			}
+
 			rc = daos_array_get_size(obj->oh, DAOS_TX_NONE, &size,
 						 NULL);
 			if (rc) {
@@ -1957,43 +3736,145 @@ dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 			stbuf->st_size = size;
 			stbuf->st_blocks = (stbuf->st_size + (1 << 9) - 1) >> 9;
 		}
-	} else if (S_ISLNK(entry.mode)) {
-		obj->value = entry.value;
+	} else if (S_ISLNK(entry->mode)) {
+		obj->value = entry->value;
 		if (stbuf)
-			stbuf->st_size = strlen(entry.value) + 1;
-	} else if (S_ISDIR(entry.mode)) {
-		rc = daos_obj_open(dfs->coh, entry.oid, daos_mode, &obj->oh,
+			stbuf->st_size = strlen(entry->value) + 1;
+	} else if (S_ISDIR(entry->mode)) {
+		rc = daos_obj_open(dfs->coh, entry->oid, daos_mode, &obj->oh,
 				   NULL);
 		if (rc) {
 			D_ERROR("daos_obj_open() Failed (%d)\n", rc);
 			D_GOTO(err_obj, rc = daos_der2errno(rc));
 		}
 		if (stbuf)
-			stbuf->st_size = sizeof(entry);
+			stbuf->st_size = sizeof(*entry);
 	} else {
 		D_ERROR("Invalid entry type (not a dir, file, symlink).\n");
 		D_GOTO(err_obj, rc = EINVAL);
 	}
 
-	if (mode)
-		*mode = obj->mode;
+	if (stbuf) {
+		stbuf->st_nlink = 1;
+		stbuf->st_mode = obj->mode;
+		stbuf->st_uid = dfs->uid;
+		stbuf->st_gid = dfs->gid;
+		stbuf->st_atim.tv_sec = entry->atime;
+		stbuf->st_mtim.tv_sec = entry->mtime;
+		stbuf->st_ctim.tv_sec = entry->ctime;
+	}
+
+	*_obj = obj;
+	return 0;
+err_obj:
+	D_FREE(obj);
+	return rc;
+}
+
+int
+dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
+	       dfs_obj_t **_obj, mode_t *mode, struct stat *stbuf)
+{
+	struct dfs_entry	entry = {0};
+	bool			exists;
+	int			daos_mode;
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (_obj == NULL)
+		return EINVAL;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+
+	rc = check_name(name);
+	if (rc)
+		return rc;
+	rc = check_access(dfs, geteuid(), getegid(), parent->mode, X_OK);
+	if (rc)
+		return rc;
+	daos_mode = get_daos_obj_mode(flags);
+	if (daos_mode == -1)
+		return EINVAL;
+
+	rc = lookup_entry(dfs, parent->oh, parent->oid, name, &exists, &entry);
+	if (rc)
+		return rc;
+
+	if (!exists)
+		return ENOENT;
+
+	rc = open_entry(dfs, parent, name, &entry, daos_mode, _obj, stbuf);
+	if (rc)
+		return rc;
+
+	if (mode)
+		*mode = entry.mode;
+	return 0;
+}
+
+
+struct dfs_plus_args {
+	dfs_filler_plus_cb_t	op;
+	void			*udata;
+};
+
+static int
+dfs_plus_open_cb(dfs_t *dfs, dfs_obj_t *dir, const char *name,
+		 struct dfs_entry *entry, void *arg)
+{
+	struct dfs_plus_args	*args = arg;
+	struct dfs_entry	link = {0};
+	dfs_obj_t		*obj;
+	struct stat		stbuf;
+	bool			exists;
+	int			rc;
+
+	/** the symlink is opened with its value */
+	if (S_ISLNK(entry->mode)) {
+		rc = lookup_entry(dfs, dir->oh, dir->oid, name, &exists,
+				  &link);
+		if (rc || !exists)
+			return rc;
+		entry = &link;
+	}
 
-	if (stbuf) {
-		stbuf->st_nlink = 1;
-		stbuf->st_mode = obj->mode;
-		stbuf->st_uid = dfs->uid;
-		stbuf->st_gid = dfs->gid;
-		stbuf->st_atim.tv_sec = entry.atime;
-		stbuf->st_mtim.tv_sec = entry.mtime;
-		stbuf->st_ctim.tv_sec = entry.ctime;
+	rc = open_entry(dfs, dir, name, entry, DAOS_OO_RO, &obj, &stbuf);
+	if (rc) {
+		D_FREE(entry->value);
+		return rc;
 	}
 
-	*_obj = obj;
+	return args->op(dfs, dir, name, obj, &stbuf, args->udata);
+}
 
-	return rc;
-err_obj:
-	D_FREE(obj);
-	return rc;
+int
+dfs_readdirplus(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
+		uint32_t *nr, size_t size, dfs_filler_plus_cb_t op,
+		void *udata)
+{
+	struct dfs_plus_args	args;
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (obj == NULL || !S_ISDIR(obj->mode))
+		return ENOTDIR;
+	if (size == 0 || *nr == 0)
+		return 0;
+	if (anchor == NULL || op == NULL)
+		return EINVAL;
+
+	rc = check_access(dfs, geteuid(), getegid(), obj->mode, R_OK);
+	if (rc)
+		return rc;
+
+	args.op = op;
+	args.udata = udata;
+	return dfs_plus_iterate(dfs, obj, anchor, nr, size, dfs_plus_open_cb,
+				&args);
 }
 
 int
@@ -2062,6 +3943,10 @@ dfs_open(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 		D_GOTO(out, rc = EINVAL);
 	}
 
+	/** drop a negative entry of the name if it has been created */
+	if (flags & O_CREAT)
+		dfs_dc_evict(dfs, parent->oid, name);
+
 	*_obj = obj;
 
 	return rc;
@@ -2117,6 +4002,15 @@ dfs_dup(dfs_t *dfs, dfs_obj_t *obj, int flags, dfs_obj_t **_new_obj)
 					     &new_obj->oh);
 		if (rc)
 			D_GOTO(err, rc = daos_der2errno(rc));
+
+		/** the data, or the migration, is fetched on first use */
+		if (obj->inl) {
+			new_obj->inl = dfs_inl_alloc(dfs, 0, false);
+			if (new_obj->inl == NULL) {
+				daos_array_close(new_obj->oh, NULL);
+				D_GOTO(err, rc = ENOMEM);
+			}
+		}
 		break;
 	}
 	case S_IFLNK:
@@ -2140,9 +4034,476 @@ err:
 	return rc;
 }
 
+enum {
+	DFS_RA_EMPTY,
+	DFS_RA_INFLIGHT,
+	DFS_RA_READY,
+};
+
+/** One read-ahead unit, filled asynchronously */
+struct dfs_ra_slot {
+	daos_event_t		rs_ev;
+	daos_array_iod_t	rs_iod;
+	daos_range_t		rs_rg;
+	d_sg_list_t		rs_sgl;
+	d_iov_t			rs_iov;
+	/** file offset of the unit */
+	daos_off_t		rs_off;
+	/** valid bytes of the unit, less than the unit size at EOF */
+	daos_size_t		rs_len;
+	int			rs_state;
+	/** a thread is waiting for the event with ra_lock released */
+	bool			rs_waited;
+	/** written while in flight, the data is dropped on completion */
+	bool			rs_stale;
+};
+
+/** Per file read-ahead cache, unit N is held by slot (N % ra_nr) */
+struct dfs_ra {
+	pthread_mutex_t		ra_lock;
+	/** signaled when a waited unit completes */
+	pthread_cond_t		ra_cond;
+	/** expected offset of the next sequential read */
+	daos_off_t		ra_next;
+	/** number of sequential reads in a row */
+	unsigned int		ra_seq;
+	unsigned int		ra_nr;
+	/** writes in flight through the handle, no unit is issued meanwhile */
+	unsigned int		ra_writers;
+	/** size of the read-ahead unit, aligned to the chunk size */
+	daos_size_t		ra_unit;
+	/** file size the units are clamped to */
+	daos_size_t		ra_file_size;
+	/** ra_nr * ra_unit bytes, allocated when the read-ahead starts */
+	char			*ra_buf;
+	struct dfs_ra_slot	*ra_slots;
+};
+
+static struct dfs_ra *
+dfs_ra_get(dfs_t *dfs, dfs_obj_t *obj)
+{
+	struct dfs_ra	*ra;
+
+	if (obj->ra != NULL)
+		return obj->ra;
+
+	D_MUTEX_LOCK(&dfs->lock);
+	ra = obj->ra;
+	if (ra != NULL)
+		goto out;
+
+	D_ALLOC_PTR(ra);
+	if (ra == NULL)
+		goto out;
+	if (D_MUTEX_INIT(&ra->ra_lock, NULL) != 0) {
+		D_FREE(ra);
+		ra = NULL;
+		goto out;
+	}
+	if (pthread_cond_init(&ra->ra_cond, NULL) != 0) {
+		D_MUTEX_DESTROY(&ra->ra_lock);
+		D_FREE(ra);
+		ra = NULL;
+		goto out;
+	}
+	ra->ra_nr = dfs->ra_depth;
+	obj->ra = ra;
+out:
+	D_MUTEX_UNLOCK(&dfs->lock);
+	return ra;
+}
+
+/** finish the completed unit of @slot, returns 0 if it holds valid data */
+static int
+dfs_ra_slot_done(struct dfs_ra_slot *slot, int rc)
+{
+	daos_event_fini(&slot->rs_ev);
+	if (rc == 0 && slot->rs_stale)
+		rc = -DER_STALE;
+	slot->rs_state = rc ? DFS_RA_EMPTY : DFS_RA_READY;
+	slot->rs_stale = false;
+	return rc;
+}
+
+/** complete the in-flight unit of @slot if it is done, without waiting */
+static void
+dfs_ra_slot_poll(struct dfs_ra_slot *slot)
+{
+	bool	flag = false;
+	int	rc;
+
+	if (slot->rs_state != DFS_RA_INFLIGHT || slot->rs_waited)
+		return;
+
+	rc = daos_event_test(&slot->rs_ev, DAOS_EQ_NOWAIT, &flag);
+	if (rc == 0 && flag)
+		dfs_ra_slot_done(slot, slot->rs_ev.ev_error);
+}
+
+/**
+ * Wait for the in-flight unit of @slot, the slot is empty on failure. Called
+ * with ra_lock held, which is released while waiting. Only one thread tests
+ * the event of a slot, the others wait for it on ra_cond.
+ */
+static int
+dfs_ra_slot_wait(struct dfs_ra *ra, struct dfs_ra_slot *slot)
+{
+	bool	flag = false;
+	int	rc = 0;
+
+	while (slot->rs_state == DFS_RA_INFLIGHT && slot->rs_waited)
+		pthread_cond_wait(&ra->ra_cond, &ra->ra_lock);
+	if (slot->rs_state != DFS_RA_INFLIGHT)
+		return slot->rs_state == DFS_RA_READY ? 0 : -DER_NONEXIST;
+
+	slot->rs_waited = true;
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+	while (!flag) {
+		rc = daos_event_test(&slot->rs_ev, DAOS_EQ_WAIT, &flag);
+		if (rc) {
+			D_ERROR("daos_event_test() failed (%d)\n", rc);
+			break;
+		}
+	}
+	if (flag)
+		rc = slot->rs_ev.ev_error;
+	D_MUTEX_LOCK(&ra->ra_lock);
+
+	rc = dfs_ra_slot_done(slot, rc);
+	slot->rs_waited = false;
+	pthread_cond_broadcast(&ra->ra_cond);
+	return rc;
+}
+
+static void
+dfs_ra_slot_issue(dfs_obj_t *obj, struct dfs_ra *ra, unsigned int idx,
+		  daos_off_t off)
+{
+	struct dfs_ra_slot	*slot = &ra->ra_slots[idx];
+	int			 rc;
+
+	rc = daos_event_init(&slot->rs_ev, DAOS_HDL_INVAL, NULL);
+	if (rc)
+		return;
+
+	slot->rs_off = off;
+	slot->rs_len = min(ra->ra_unit, ra->ra_file_size - off);
+	slot->rs_stale = false;
+	slot->rs_rg.rg_idx = off;
+	slot->rs_rg.rg_len = slot->rs_len;
+	slot->rs_iod.arr_nr = 1;
+	slot->rs_iod.arr_rgs = &slot->rs_rg;
+	d_iov_set(&slot->rs_iov, ra->ra_buf + idx * ra->ra_unit,
+		  slot->rs_len);
+	slot->rs_sgl.sg_nr = 1;
+	slot->rs_sgl.sg_nr_out = 0;
+	slot->rs_sgl.sg_iovs = &slot->rs_iov;
+
+	rc = daos_array_read(obj->oh, DAOS_TX_NONE, &slot->rs_iod,
+			     &slot->rs_sgl, NULL, &slot->rs_ev);
+	if (rc) {
+		daos_event_fini(&slot->rs_ev);
+		slot->rs_state = DFS_RA_EMPTY;
+		return;
+	}
+	slot->rs_state = DFS_RA_INFLIGHT;
+}
+
+/**
+ * Drop the cached units overlapping [off, off + len), called with ra_lock
+ * held. The in-flight ones are dropped when they complete.
+ */
+static void
+dfs_ra_drop(struct dfs_ra *ra, daos_off_t off, daos_size_t len)
+{
+	struct dfs_ra_slot	*slot;
+	int			 i;
+
+	if (ra->ra_slots == NULL)
+		return;
+
+	for (i = 0; i < ra->ra_nr; i++) {
+		slot = &ra->ra_slots[i];
+		if (slot->rs_state == DFS_RA_EMPTY ||
+		    slot->rs_off >= off + len ||
+		    slot->rs_off + ra->ra_unit <= off)
+			continue;
+		if (slot->rs_state == DFS_RA_INFLIGHT)
+			slot->rs_stale = true;
+		else
+			slot->rs_state = DFS_RA_EMPTY;
+	}
+}
+
+static int
+dfs_ra_start(dfs_obj_t *obj, struct dfs_ra *ra)
+{
+	daos_size_t	chunk_size;
+	int		rc;
+
+	rc = dfs_get_chunk_size(obj, &chunk_size);
+	if (rc)
+		return rc;
+
+	ra->ra_unit = min(chunk_size, DFS_RA_MAX_SIZE);
+	D_ALLOC(ra->ra_buf, ra->ra_unit * ra->ra_nr);
+	if (ra->ra_buf == NULL)
+		return ENOMEM;
+
+	D_ALLOC_ARRAY(ra->ra_slots, ra->ra_nr);
+	if (ra->ra_slots == NULL) {
+		D_FREE(ra->ra_buf);
+		return ENOMEM;
+	}
+
+	D_DEBUG(DB_TRACE, "Start read-ahead of %u x %zu bytes\n", ra->ra_nr,
+		ra->ra_unit);
+	return 0;
+}
+
+/**
+ * Issue the units that are not cached yet in the window starting at @off.
+ * The slots still busy with an older unit are skipped, they are refilled by
+ * a later read once completed.
+ */
+static void
+dfs_ra_advance(dfs_obj_t *obj, struct dfs_ra *ra, daos_off_t off)
+{
+	struct dfs_ra_slot	*slot;
+	daos_off_t		 unit_off;
+	uint64_t		 unit;
+	unsigned int		 idx;
+	int			 i;
+
+	if (ra->ra_writers > 0)
+		return;
+
+	unit = off / ra->ra_unit;
+	for (i = 0; i < ra->ra_nr; i++, unit++) {
+		unit_off = unit * ra->ra_unit;
+		if (unit_off >= ra->ra_file_size)
+			break;
+
+		idx = unit % ra->ra_nr;
+		slot = &ra->ra_slots[idx];
+		/** a partial unit is read again if the file has grown */
+		if (slot->rs_state != DFS_RA_EMPTY && !slot->rs_stale &&
+		    slot->rs_off == unit_off &&
+		    slot->rs_len == min(ra->ra_unit,
+					ra->ra_file_size - unit_off))
+			continue;
+
+		dfs_ra_slot_poll(slot);
+		if (slot->rs_state == DFS_RA_INFLIGHT)
+			continue;
+		dfs_ra_slot_issue(obj, ra, idx, unit_off);
+	}
+}
+
+/**
+ * Copy [off, off + len) from the cached units into @sgl. Returns false if any
+ * part of the range is not cached, the caller then reads from the array.
+ */
+static bool
+dfs_ra_copy(struct dfs_ra *ra, d_sg_list_t *sgl, daos_off_t off,
+	    daos_size_t len, daos_size_t *read_size)
+{
+	struct dfs_ra_slot	*slot;
+	daos_size_t		 file_size = ra->ra_file_size;
+	daos_off_t		 pos;
+	daos_off_t		 end;
+	daos_size_t		 copied = 0;
+	daos_size_t		 iov_off = 0;
+	daos_size_t		 nob;
+	int			 i = 0;
+
+	end = min(off + len, file_size);
+
+	/** check that the whole range is cached before copying */
+retry:
+	for (pos = off; pos < end; pos = slot->rs_off + slot->rs_len) {
+		slot = &ra->ra_slots[(pos / ra->ra_unit) % ra->ra_nr];
+		if (slot->rs_state == DFS_RA_EMPTY ||
+		    slot->rs_off != pos - pos % ra->ra_unit ||
+		    pos >= slot->rs_off + slot->rs_len)
+			return false;
+		if (slot->rs_state != DFS_RA_INFLIGHT)
+			continue;
+
+		/** ra_lock is released meanwhile, check everything again */
+		if (dfs_ra_slot_wait(ra, slot) != 0 ||
+		    ra->ra_file_size != file_size)
+			return false;
+		goto retry;
+	}
+
+	for (pos = off; pos < end; pos += nob) {
+		d_iov_t	*iov = &sgl->sg_iovs[i];
+		char	*src;
+
+		slot = &ra->ra_slots[(pos / ra->ra_unit) % ra->ra_nr];
+		src = (char *)slot->rs_iov.iov_buf + (pos - slot->rs_off);
+		nob = min(end - pos, slot->rs_off + slot->rs_len - pos);
+		nob = min(nob, iov->iov_len - iov_off);
+		memcpy((char *)iov->iov_buf + iov_off, src, nob);
+		copied += nob;
+		iov_off += nob;
+		if (iov_off == iov->iov_len) {
+			i++;
+			iov_off = 0;
+		}
+	}
+
+	*read_size = copied;
+	return true;
+}
+
+/**
+ * Serve the read from the read-ahead cache of the file if possible. The
+ * read-ahead starts after DFS_RA_TRIGGER sequential reads, it then keeps the
+ * following ra_nr units of the file in flight or cached.
+ */
+static bool
+dfs_ra_read(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
+	    daos_size_t len, daos_size_t *read_size)
+{
+	struct dfs_ra	*ra;
+	bool		 served = false;
+	int		 rc;
+
+	ra = dfs_ra_get(dfs, obj);
+	if (ra == NULL)
+		return false;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+	if (off == ra->ra_next)
+		ra->ra_seq++;
+	else
+		ra->ra_seq = 0;
+	ra->ra_next = off + len;
+
+	if (ra->ra_buf == NULL) {
+		if (ra->ra_seq < DFS_RA_TRIGGER)
+			goto out;
+		if (dfs_ra_start(obj, ra) != 0)
+			goto out;
+	}
+
+	/** the file may have grown since the window was set up */
+	if (off + len > ra->ra_file_size) {
+		rc = daos_array_get_size(obj->oh, DAOS_TX_NONE,
+					 &ra->ra_file_size, NULL);
+		if (rc) {
+			ra->ra_file_size = 0;
+			goto out;
+		}
+		if (off >= ra->ra_file_size) {
+			*read_size = 0;
+			D_GOTO(out, served = true);
+		}
+	}
+
+	if (ra->ra_seq >= DFS_RA_TRIGGER)
+		dfs_ra_advance(obj, ra, off);
+
+	served = dfs_ra_copy(ra, sgl, off, len, read_size);
+out:
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+	return served;
+}
+
+/** drop all the cached data before the file is resized through @obj */
+static void
+dfs_ra_invalidate(dfs_obj_t *obj)
+{
+	struct dfs_ra	*ra = obj->ra;
+
+	if (ra == NULL)
+		return;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+	dfs_ra_drop(ra, 0, DFS_MAX_FSIZE);
+	/** the size is queried again on the next read */
+	ra->ra_file_size = 0;
+	ra->ra_seq = 0;
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+}
+
+/**
+ * Called before [off, off + len) of the file is written. The cached units of
+ * the range are dropped, and no unit is issued until dfs_ra_write_end(), so
+ * that a read-ahead racing with the write cannot cache the old data.
+ */
+static void
+dfs_ra_write_begin(struct dfs_ra *ra, daos_off_t off, daos_size_t len)
+{
+	if (ra == NULL)
+		return;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+	dfs_ra_drop(ra, off, len);
+	ra->ra_writers++;
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+}
+
+/** called once the write started by dfs_ra_write_begin() has completed */
+static void
+dfs_ra_write_end(struct dfs_ra *ra, daos_off_t off, daos_size_t len)
+{
+	if (ra == NULL)
+		return;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+	/** units issued before the write may have been refilled meanwhile */
+	dfs_ra_drop(ra, off, len);
+	D_ASSERT(ra->ra_writers > 0);
+	ra->ra_writers--;
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+}
+
+struct dfs_ra_write_arg {
+	struct dfs_ra		*ra;
+	daos_off_t		 off;
+	daos_size_t		 len;
+};
+
+static int
+dfs_ra_write_cb(tse_task_t *task, void *data)
+{
+	struct dfs_ra_write_arg	*arg = data;
+
+	dfs_ra_write_end(arg->ra, arg->off, arg->len);
+	return 0;
+}
+
+static void
+dfs_ra_fini(dfs_obj_t *obj)
+{
+	struct dfs_ra	*ra = obj->ra;
+	int		 i;
+
+	if (ra == NULL)
+		return;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+	for (i = 0; ra->ra_slots != NULL && i < ra->ra_nr; i++)
+		dfs_ra_slot_wait(ra, &ra->ra_slots[i]);
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+
+	if (ra->ra_slots != NULL)
+		D_FREE(ra->ra_slots);
+	if (ra->ra_buf != NULL)
+		D_FREE(ra->ra_buf);
+	pthread_cond_destroy(&ra->ra_cond);
+	D_MUTEX_DESTROY(&ra->ra_lock);
+	D_FREE(ra);
+	obj->ra = NULL;
+}
+
 int
 dfs_release(dfs_obj_t *obj)
 {
+	int wb_rc = 0;
 	int rc = 0;
 
 	if (obj == NULL)
@@ -2150,9 +4511,13 @@ dfs_release(dfs_obj_t *obj)
 
 	if (S_ISDIR(obj->mode))
 		rc = daos_obj_close(obj->oh, NULL);
-	else if (S_ISREG(obj->mode))
+	else if (S_ISREG(obj->mode)) {
+		/** the handle is released even if the buffered data is lost */
+		wb_rc = dfs_wb_fini(obj);
+		dfs_ra_fini(obj);
+		D_FREE(obj->inl);
 		rc = daos_array_close(obj->oh, NULL);
-	else if (S_ISLNK(obj->mode))
+	} else if (S_ISLNK(obj->mode))
 		D_FREE(obj->value);
 	else
 		D_ASSERT(0);
@@ -2163,7 +4528,9 @@ dfs_release(dfs_obj_t *obj)
 	}
 
 	D_FREE(obj);
-	return 0;
+	if (wb_rc)
+		D_ERROR("Failed to flush the write-back buffer (%d)\n", wb_rc);
+	return wb_rc;
 }
 
 struct dfs_read_params {
@@ -2296,6 +4663,7 @@ dfs_read(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
 	struct dfs_read_params	*args;
 	tse_task_t		*task;
 	daos_size_t		buf_size;
+	bool			inlined;
 	int			i, rc;
 
 	if (dfs == NULL || !dfs->mounted)
@@ -2317,6 +4685,33 @@ dfs_read(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
 
 	D_DEBUG(DB_TRACE, "DFS Read: Off %"PRIu64", Len %zu\n", off, buf_size);
 
+	if (obj->inl) {
+		rc = dfs_inl_read(obj, sgl, off, read_size, &inlined);
+		if (rc)
+			return rc;
+		/** still inlined, the read is served from the entry */
+		if (inlined) {
+			if (ev) {
+				daos_event_launch(ev);
+				daos_event_complete(ev, 0);
+			}
+			return 0;
+		}
+	}
+
+	rc = dfs_wb_sync_oid(dfs, obj->oid);
+	if (rc)
+		return rc;
+
+	if (dfs->ra_depth > 0 &&
+	    dfs_ra_read(dfs, obj, sgl, off, buf_size, read_size)) {
+		if (ev) {
+			daos_event_launch(ev);
+			daos_event_complete(ev, 0);
+		}
+		return 0;
+	}
+
 	rc = dc_task_create(dfs_read_int, NULL, ev, &task);
 	if (rc)
 		return rc;
@@ -2336,9 +4731,13 @@ int
 dfs_write(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
 	  daos_event_t *ev)
 {
+	struct dfs_ra_write_arg	ra_arg;
+	daos_array_io_t		*args;
+	tse_task_t		*task;
 	daos_array_iod_t	iod;
 	daos_range_t		rg;
 	daos_size_t		buf_size;
+	bool			inlined;
 	int			i;
 	int			rc;
 
@@ -2368,7 +4767,59 @@ dfs_write(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
 
 	D_DEBUG(DB_TRACE, "DFS Write: Off %"PRIu64", Len %zu\n", off, buf_size);
 
-	rc = daos_array_write(obj->oh, DAOS_TX_NONE, &iod, sgl, NULL, ev);
+	if (obj->inl) {
+		rc = dfs_inl_write(obj, sgl, off, buf_size, &inlined);
+		if (rc)
+			return rc;
+		/** still inlined, the entry has been updated */
+		if (inlined) {
+			if (ev) {
+				daos_event_launch(ev);
+				daos_event_complete(ev, 0);
+			}
+			return 0;
+		}
+	}
+
+	/** a read-ahead started meanwhile must not miss the write */
+	ra_arg.ra = dfs->ra_depth > 0 ? dfs_ra_get(dfs, obj) : NULL;
+	dfs_ra_write_begin(ra_arg.ra, off, buf_size);
+	ra_arg.off = off;
+	ra_arg.len = buf_size;
+
+	if (dfs->wb_enabled &&
+	    dfs_wb_write(dfs, obj, sgl, off, buf_size, &rc)) {
+		dfs_ra_write_end(ra_arg.ra, off, buf_size);
+		if (rc == 0 && ev) {
+			daos_event_launch(ev);
+			daos_event_complete(ev, 0);
+		}
+		return rc;
+	}
+
+	rc = dc_task_create(dc_array_write, NULL, ev, &task);
+	if (rc) {
+		dfs_ra_write_end(ra_arg.ra, off, buf_size);
+		return daos_der2errno(rc);
+	}
+
+	args = dc_task_get_args(task);
+	args->oh	= obj->oh;
+	args->th	= DAOS_TX_NONE;
+	args->iod	= &iod;
+	args->sgl	= sgl;
+	args->csums	= NULL;
+
+	/** the read-ahead is resumed once the data has been written */
+	rc = dc_task_reg_comp_cb(task, dfs_ra_write_cb, &ra_arg,
+				 sizeof(ra_arg));
+	if (rc) {
+		dc_task_decref(task);
+		dfs_ra_write_end(ra_arg.ra, off, buf_size);
+		return daos_der2errno(rc);
+	}
+
+	rc = dc_task_schedule(task, true);
 	if (rc)
 		D_ERROR("daos_array_write() failed (%d)\n", rc);
 
@@ -2394,6 +4845,7 @@ int
 dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, struct stat *stbuf)
 {
 	daos_handle_t	oh;
+	daos_obj_id_t	poid;
 	int		rc;
 
 	if (dfs == NULL || !dfs->mounted)
@@ -2415,14 +4867,16 @@ dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, struct stat *stbuf)
 		}
 		name = parent->name;
 		oh = dfs->super_oh;
+		oid_cp(&poid, parent->parent_oid);
 	} else {
 		rc = check_name(name);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		oid_cp(&poid, parent->oid);
 	}
 
-	return entry_stat(dfs, DAOS_TX_NONE, oh, name, stbuf);
+	return entry_stat(dfs, oh, poid, name, stbuf);
 }
 
 int
@@ -2441,7 +4895,7 @@ dfs_ostat(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf)
 	if (rc)
 		return daos_der2errno(rc);
 
-	rc = entry_stat(dfs, DAOS_TX_NONE, oh, obj->name, stbuf);
+	rc = entry_stat(dfs, oh, obj->parent_oid, obj->name, stbuf);
 	if (rc)
 		D_GOTO(out, rc);
 
@@ -2454,6 +4908,7 @@ int
 dfs_access(dfs_t *dfs, dfs_obj_t *parent, const char *name, int mask)
 {
 	daos_handle_t		oh;
+	daos_obj_id_t		poid;
 	bool			exists;
 	struct dfs_entry	entry = {0};
 	int			rc;
@@ -2474,15 +4929,17 @@ dfs_access(dfs_t *dfs, dfs_obj_t *parent, const char *name, int mask)
 		}
 		name = parent->name;
 		oh = dfs->super_oh;
+		oid_cp(&poid, parent->parent_oid);
 	} else {
 		rc = check_name(name);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		oid_cp(&poid, parent->oid);
 	}
 
 	/* Check if parent has the entry */
-	rc = fetch_entry(oh, DAOS_TX_NONE, name, true, &exists, &entry);
+	rc = lookup_entry(dfs, oh, poid, name, &exists, &entry);
 	if (rc)
 		return rc;
 
@@ -2522,6 +4979,7 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 {
 	uid_t			euid;
 	daos_handle_t		oh;
+	daos_obj_id_t		poid;
 	daos_handle_t		th = DAOS_TX_NONE;
 	bool			exists;
 	struct dfs_entry	entry = {0};
@@ -2547,11 +5005,13 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 		}
 		name = parent->name;
 		oh = dfs->super_oh;
+		oid_cp(&poid, parent->parent_oid);
 	} else {
 		rc = check_name(name);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		oid_cp(&poid, parent->oid);
 	}
 
 	euid = geteuid();
@@ -2590,6 +5050,7 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 
 		rc = daos_obj_open(dfs->coh, sym->parent_oid, DAOS_OO_RW,
 				   &oh, NULL);
+		oid_cp(&poid, sym->parent_oid);
 		dfs_release(sym);
 		if (rc)
 			return daos_der2errno(rc);
@@ -2615,6 +5076,7 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 	sgl.sg_iovs	= &sg_iov;
 
 	rc = daos_obj_update(oh, th, &dkey, 1, &iod, &sgl, NULL);
+	dfs_dc_evict(dfs, poid, name);
 	if (rc) {
 		D_ERROR("Failed to update mode (rc = %d)\n", rc);
 		D_GOTO(out, rc = daos_der2errno(rc));
@@ -2634,6 +5096,7 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 	uid_t			euid;
 	daos_key_t		dkey;
 	daos_handle_t           oh;
+	bool			inlined = false;
 	int			rc;
 	d_sg_list_t		sgls[3];
 	d_iov_t			sg_iovs[3];
@@ -2703,7 +5166,18 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 		D_GOTO(out_obj, rc = EINVAL);
 	}
 
-	if (set_size) {
+	if (set_size && obj->inl) {
+		rc = dfs_inl_set_size(obj, stbuf->st_size, &inlined);
+		if (rc)
+			D_GOTO(out_obj, rc);
+	}
+
+	/** the size of a file that is still inlined is already set */
+	if (set_size && !inlined) {
+		dfs_ra_invalidate(obj);
+		rc = dfs_wb_sync_oid(dfs, obj->oid);
+		if (rc)
+			D_GOTO(out_obj, rc);
 		rc = daos_array_set_size(obj->oh, th, stbuf->st_size, NULL);
 		if (rc)
 			D_GOTO(out_obj, rc = daos_der2errno(rc));
@@ -2728,13 +5202,14 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 	}
 
 	rc = daos_obj_update(oh, th, &dkey, akeys_nr, iods, sgls, NULL);
+	dfs_dc_evict(dfs, obj->parent_oid, obj->name);
 	if (rc) {
 		D_ERROR("Failed to update attr (rc = %d)\n", rc);
 		D_GOTO(out_obj, rc = daos_der2errno(rc));
 	}
 
 out_stat:
-	rc = entry_stat(dfs, th, oh, obj->name, stbuf);
+	rc = entry_stat(dfs, oh, obj->parent_oid, obj->name, stbuf);
 
 out_obj:
 	daos_obj_close(oh, NULL);
@@ -2745,7 +5220,8 @@ out_obj:
 int
 dfs_get_size(dfs_t *dfs, dfs_obj_t *obj, daos_size_t *size)
 {
-	int rc;
+	bool	inlined;
+	int	rc;
 
 	if (dfs == NULL || !dfs->mounted)
 		return EINVAL;
@@ -2756,6 +5232,16 @@ dfs_get_size(dfs_t *dfs, dfs_obj_t *obj, daos_size_t *size)
 	if (rc)
 		return rc;
 
+	if (obj->inl) {
+		rc = dfs_inl_get_size(obj, size, &inlined);
+		if (rc || inlined)
+			return rc;
+	}
+
+	rc = dfs_wb_sync_oid(dfs, obj->oid);
+	if (rc)
+		return rc;
+
 	return daos_array_get_size(obj->oh, DAOS_TX_NONE, size, NULL);
 }
 
@@ -2765,6 +5251,7 @@ dfs_punch(dfs_t *dfs, dfs_obj_t *obj, daos_off_t offset, daos_size_t len)
 	daos_size_t		size;
 	daos_array_iod_t	iod;
 	daos_range_t		rg;
+	bool			inlined;
 	int			rc;
 
 	if (dfs == NULL || !dfs->mounted)
@@ -2778,6 +5265,17 @@ dfs_punch(dfs_t *dfs, dfs_obj_t *obj, daos_off_t offset, daos_size_t len)
 	if (rc)
 		return rc;
 
+	if (obj->inl) {
+		rc = dfs_inl_punch(obj, offset, len, &inlined);
+		if (rc || inlined)
+			return rc;
+	}
+
+	dfs_ra_invalidate(obj);
+	rc = dfs_wb_sync_oid(dfs, obj->oid);
+	if (rc)
+		return rc;
+
 	/** simple truncate */
 	if (len == DFS_MAX_FSIZE) {
 		rc = daos_array_set_size(obj->oh, DAOS_TX_NONE, offset, NULL);
@@ -2862,6 +5360,8 @@ dfs_move(dfs_t *dfs, dfs_obj_t *parent, char *name, dfs_obj_t *new_parent,
 {
 	struct dfs_entry	entry = {0}, new_entry = {0};
 	daos_handle_t		th = DAOS_TX_NONE;
+	char			*buf = NULL;
+	d_iov_t			data;
 	bool			exists;
 	daos_key_t		dkey;
 	int			rc;
@@ -2899,13 +5399,21 @@ dfs_move(dfs_t *dfs, dfs_obj_t *parent, char *name, dfs_obj_t *new_parent,
 	if (rc)
 		return rc;
 
-	rc = fetch_entry(parent->oh, th, name, true, &exists, &entry);
+	/** the data of an inlined file moves with its entry */
+	D_ALLOC(buf, DFS_INLINE_MAX);
+	if (buf == NULL)
+		D_GOTO(out, rc = ENOMEM);
+	d_iov_set(&data, buf, DFS_INLINE_MAX);
+
+	rc = fetch_entry_data(parent->oh, th, name, true, &data, &exists,
+			      &entry);
 	if (rc) {
 		D_ERROR("Failed to fetch entry %s (%d)\n", name, rc);
 		D_GOTO(out, rc);
 	}
 	if (exists == false)
 		D_GOTO(out, rc);
+	data.iov_len = entry.isize;
 
 	rc = fetch_entry(new_parent->oh, th, new_name, true, &exists,
 			 &new_entry);
@@ -2982,7 +5490,7 @@ dfs_move(dfs_t *dfs, dfs_obj_t *parent, char *name, dfs_obj_t *new_parent,
 
 	entry.atime = entry.mtime = entry.ctime = time(NULL);
 	/** insert old entry in new parent object */
-	rc = insert_entry(new_parent->oh, th, new_name, entry);
+	rc = insert_entry_data(new_parent->oh, th, new_name, entry, &data);
 	if (rc) {
 		D_ERROR("Inserting entry %s failed (%d)\n", new_name, rc);
 		D_GOTO(out, rc);
@@ -2997,6 +5505,11 @@ dfs_move(dfs_t *dfs, dfs_obj_t *parent, char *name, dfs_obj_t *new_parent,
 	}
 
 out:
+	dfs_dc_evict(dfs, parent->oid, name);
+	dfs_dc_evict(dfs, new_parent->oid, new_name);
+	/** a symlink is renamed within its parent, see above */
+	if (S_ISLNK(entry.mode))
+		dfs_dc_evict(dfs, parent->oid, new_name);
 	if (entry.value) {
 		D_ASSERT(S_ISLNK(entry.mode));
 		D_FREE(entry.value);
@@ -3005,6 +5518,7 @@ out:
 		D_ASSERT(S_ISLNK(new_entry.mode));
 		D_FREE(new_entry.value);
 	}
+	D_FREE(buf);
 	return rc;
 }
 
@@ -3014,6 +5528,8 @@ dfs_exchange(dfs_t *dfs, dfs_obj_t *parent1, char *name1, dfs_obj_t *parent2,
 {
 	struct dfs_entry	entry1 = {0}, entry2 = {0};
 	daos_handle_t		th = DAOS_TX_NONE;
+	char			*buf = NULL;
+	d_iov_t			data1, data2;
 	bool			exists;
 	daos_key_t		dkey;
 	int			rc;
@@ -3046,15 +5562,25 @@ dfs_exchange(dfs_t *dfs, dfs_obj_t *parent1, char *name1, dfs_obj_t *parent2,
 	if (rc)
 		return rc;
 
-	rc = fetch_entry(parent1->oh, th, name1, true, &exists, &entry1);
+	/** the data of the inlined files moves with their entries */
+	D_ALLOC(buf, 2 * DFS_INLINE_MAX);
+	if (buf == NULL)
+		D_GOTO(out, rc = ENOMEM);
+	d_iov_set(&data1, buf, DFS_INLINE_MAX);
+	d_iov_set(&data2, buf + DFS_INLINE_MAX, DFS_INLINE_MAX);
+
+	rc = fetch_entry_data(parent1->oh, th, name1, true, &data1, &exists,
+			      &entry1);
 	if (rc) {
 		D_ERROR("Failed to fetch entry %s (%d)\n", name1, rc);
 		D_GOTO(out, rc);
 	}
 	if (exists == false)
 		D_GOTO(out, rc = EINVAL);
+	data1.iov_len = entry1.isize;
 
-	rc = fetch_entry(parent2->oh, th, name2, true, &exists, &entry2);
+	rc = fetch_entry_data(parent2->oh, th, name2, true, &data2, &exists,
+			      &entry2);
 	if (rc) {
 		D_ERROR("Failed to fetch entry %s (%d)\n", name2, rc);
 		D_GOTO(out, rc);
@@ -3062,6 +5588,7 @@ dfs_exchange(dfs_t *dfs, dfs_obj_t *parent1, char *name1, dfs_obj_t *parent2,
 
 	if (exists == false)
 		D_GOTO(out, rc = EINVAL);
+	data2.iov_len = entry2.isize;
 
 	/** remove the first entry from parent1 (just the dkey) */
 	d_iov_set(&dkey, (void *)name1, strlen(name1));
@@ -3081,7 +5608,7 @@ dfs_exchange(dfs_t *dfs, dfs_obj_t *parent1, char *name1, dfs_obj_t *parent2,
 
 	entry1.atime = entry1.mtime = entry1.ctime = time(NULL);
 	/** insert entry1 in parent2 object */
-	rc = insert_entry(parent2->oh, th, name1, entry1);
+	rc = insert_entry_data(parent2->oh, th, name1, entry1, &data1);
 	if (rc) {
 		D_ERROR("Inserting entry %s failed (%d)\n", name1, rc);
 		D_GOTO(out, rc);
@@ -3089,13 +5616,17 @@ dfs_exchange(dfs_t *dfs, dfs_obj_t *parent1, char *name1, dfs_obj_t *parent2,
 
 	entry2.atime = entry2.mtime = entry2.ctime = time(NULL);
 	/** insert entry2 in parent1 object */
-	rc = insert_entry(parent1->oh, th, name2, entry2);
+	rc = insert_entry_data(parent1->oh, th, name2, entry2, &data2);
 	if (rc) {
 		D_ERROR("Inserting entry %s failed (%d)\n", name2, rc);
 		D_GOTO(out, rc);
 	}
 
 out:
+	dfs_dc_evict(dfs, parent1->oid, name1);
+	dfs_dc_evict(dfs, parent1->oid, name2);
+	dfs_dc_evict(dfs, parent2->oid, name1);
+	dfs_dc_evict(dfs, parent2->oid, name2);
 	if (entry1.value) {
 		D_ASSERT(S_ISLNK(entry1.mode));
 		D_FREE(entry1.value);
@@ -3104,20 +5635,26 @@ out:
 		D_ASSERT(S_ISLNK(entry2.mode));
 		D_FREE(entry2.value);
 	}
+	D_FREE(buf);
 	return rc;
 }
 
 int
 dfs_sync(dfs_t *dfs)
 {
+	int	rc;
+
 	if (dfs == NULL || !dfs->mounted)
 		return EINVAL;
 	if (dfs->amode != O_RDWR)
 		return EPERM;
 
+	/** Write the buffered data of all the open files */
+	rc = dfs_wb_sync(dfs, NULL);
+
 	/** Take a snapshot here and allow rollover to that when supported. */
 
-	return 0;
+	return rc;
 }
 
 static char *
@@ -24,6 +24,7 @@
 #ifndef __DFUSE_H__
 #define __DFUSE_H__
 
+#include <semaphore.h>
 #include <fuse3/fuse.h>
 #include <fuse3/fuse_lowlevel.h>
 
@@ -36,6 +37,7 @@
 
 #include "dfuse_common.h"
 #include "dfuse.h"
+#include "dfuse_da.h"
 
 struct dfuse_info {
 	struct fuse_session		*di_session;
@@ -65,6 +67,42 @@ struct dfuse_projection_info {
 	struct d_hash_table		dpi_iet;
 	struct d_hash_table		dpi_irt;
 	ATOMIC uint64_t			dpi_ino_next;
+	/** Descriptor allocator for the asynchronous read/write requests */
+	struct dfuse_da			dpi_da;
+	struct dfuse_da_type		*dpi_event_da;
+	/** Event queue for asynchronous I/O, polled by dpi_thread */
+	daos_handle_t			dpi_eq;
+	pthread_t			dpi_thread;
+	/** Posted once for every event launched on dpi_eq */
+	sem_t				dpi_sem;
+	bool				dpi_shutdown;
+};
+
+/**
+ * Asynchronous read or write request.
+ *
+ * The DFS call is issued by the FUSE thread with de_ev on dpi_eq, then the
+ * progress thread polls the event, replies to FUSE from de_complete_cb and
+ * releases the descriptor.
+ *
+ * Descriptors and their dpi_max_read byte buffers are recycled through the
+ * dpi_event_da descriptor allocator rather than being allocated and freed
+ * for every request.
+ */
+struct dfuse_event {
+	struct dfuse_projection_info	*de_handle;
+	fuse_req_t			de_req;
+	struct dfuse_obj_hdl		*de_oh;
+	void				(*de_complete_cb)(struct dfuse_event *);
+	daos_event_t			de_ev;
+	bool				de_ev_init;
+	void				*de_buf;
+	size_t				de_buf_size;
+	/** Bytes read, or to write */
+	daos_size_t			de_len;
+	d_iov_t				de_iov;
+	d_sg_list_t			de_sgl;
+	d_list_t			de_list;
 };
 
 /*
@@ -107,6 +145,8 @@ struct dfuse_obj_hdl {
 	off_t		doh_cur_off;
 	/** current idx to process in doh_start_off */
 	uint32_t	doh_idx;
+	/** the entries cached in doh_buf are in the readdirplus format */
+	bool		doh_plus;
 };
 
 struct dfuse_inode_ops {
@@ -125,7 +165,8 @@ struct dfuse_inode_ops {
 	void (*releasedir)(fuse_req_t req, struct dfuse_inode_entry *inode,
 			   struct fuse_file_info *fi);
 	void (*readdir)(fuse_req_t req, struct dfuse_inode_entry *inode,
-			size_t size, off_t offset, struct fuse_file_info *fi);
+			size_t size, off_t offset, bool plus,
+			struct fuse_file_info *fi);
 	void (*rename)(fuse_req_t req, struct dfuse_inode_entry *parent_inode,
 		       const char *name,
 		       struct dfuse_inode_entry *newparent_inode,
@@ -307,6 +348,18 @@ struct fuse_lowlevel_ops *dfuse_get_fuse_ops();
 	} while (0)
 
 
+#define DFUSE_REPLY_DATA(handle, req, bufv)				\
+	do {								\
+		int __rc;						\
+		DFUSE_TRA_DEBUG(handle, "Returning data(%#zx)",		\
+				fuse_buf_size(bufv));			\
+		__rc = fuse_reply_data(req, bufv, 0);			\
+		if (__rc != 0)						\
+			DFUSE_TRA_ERROR(handle,				\
+					"fuse_reply_data returned %d:%s", \
+					__rc, strerror(-__rc));		\
+	} while (0)
+
 #define DFUSE_REPLY_WRITE(handle, req, bytes)				\
 	do {								\
 		int __rc;						\
@@ -500,14 +553,14 @@ dfuse_cb_unlink(fuse_req_t, struct dfuse_inode_entry *,
 
 void
 dfuse_cb_readdir(fuse_req_t, struct dfuse_inode_entry *, size_t, off_t,
-		 struct fuse_file_info *);
+		 bool, struct fuse_file_info *);
 
 void
 dfuse_cb_rename(fuse_req_t, struct dfuse_inode_entry *, const char *,
 		struct dfuse_inode_entry *, const char *, unsigned int);
 
 void
-dfuse_cb_write(fuse_req_t, fuse_ino_t, const char *, size_t, off_t,
+dfuse_cb_write(fuse_req_t, fuse_ino_t, struct fuse_bufvec *, off_t,
 	       struct fuse_file_info *);
 
 void
@@ -545,6 +598,10 @@ dfuse_reply_entry(struct dfuse_projection_info *fs_handle,
 		  struct fuse_file_info *fi_out,
 		  fuse_req_t req);
 
+struct dfuse_inode_entry *
+dfuse_inode_insert(struct dfuse_projection_info *fs_handle,
+		   struct dfuse_inode_entry *ie);
+
 /* dfuse_cont.c */
 void
 dfuse_cont_lookup(fuse_req_t req, struct dfuse_inode_entry *parent,
@@ -150,6 +150,173 @@ static d_hash_table_ops_t ir_hops = {
 
 };
 
+/* Read/write event descriptor operations */
+
+/* Maximum number of idle descriptors kept for reuse */
+#define DFUSE_EVENT_MAX_FREE 16
+
+static void
+dfuse_event_init(void *arg, void *handle)
+{
+	struct dfuse_event		*ev = arg;
+	struct dfuse_projection_info	*fs_handle = handle;
+
+	ev->de_handle = fs_handle;
+	ev->de_buf_size = fs_handle->dpi_max_read;
+	ev->de_sgl.sg_nr = 1;
+	ev->de_sgl.sg_iovs = &ev->de_iov;
+}
+
+/* The event and the buffer are set up here rather than in init() so that the
+ * descriptor is dropped, and the setup retried later on, if it fails.
+ * Events can be relaunched once polled so this is only done once.
+ */
+static bool
+dfuse_event_reset(void *arg)
+{
+	struct dfuse_event	*ev = arg;
+	int			rc;
+
+	if (!ev->de_ev_init) {
+		rc = daos_event_init(&ev->de_ev, ev->de_handle->dpi_eq, NULL);
+		if (rc != -DER_SUCCESS)
+			return false;
+		ev->de_ev_init = true;
+	}
+
+	if (!ev->de_buf)
+		D_ALLOC(ev->de_buf, ev->de_buf_size);
+
+	return ev->de_buf != NULL;
+}
+
+static void
+dfuse_event_release(void *arg)
+{
+	struct dfuse_event	*ev = arg;
+
+	if (ev->de_ev_init)
+		daos_event_fini(&ev->de_ev);
+	D_FREE(ev->de_buf);
+}
+
+static struct dfuse_da_reg dfuse_event_reg = {
+	.init		= dfuse_event_init,
+	.reset		= dfuse_event_reset,
+	.release	= dfuse_event_release,
+	POOL_TYPE_INIT(dfuse_event, de_list)
+	.max_free_desc	= DFUSE_EVENT_MAX_FREE,
+};
+
+/* Number of events to poll for in one go */
+#define DFUSE_POLL_EVENTS 16
+
+/* Progress thread, completes the events launched on dpi_eq and replies to
+ * FUSE for them.  Every launched event is followed by a post of dpi_sem so
+ * the thread sleeps when there is no I/O in flight.
+ */
+static void *
+dfuse_progress_thread(void *arg)
+{
+	struct dfuse_projection_info	*fs_handle = arg;
+	struct daos_event		*evs[DFUSE_POLL_EVENTS];
+	struct dfuse_event		*ev;
+	int				rc;
+	int				i;
+
+	while (1) {
+		rc = sem_wait(&fs_handle->dpi_sem);
+		if (rc != 0) {
+			if (errno == EINTR)
+				continue;
+			DFUSE_TRA_ERROR(fs_handle, "sem_wait failed %d %s",
+					errno, strerror(errno));
+			return NULL;
+		}
+
+		/* Only wait if there is something in flight, so that the
+		 * post from dfuse_progress_stop() returns zero events.
+		 */
+		rc = daos_eq_poll(fs_handle->dpi_eq, 1, DAOS_EQ_WAIT,
+				  DFUSE_POLL_EVENTS, evs);
+		if (rc < 0) {
+			DFUSE_TRA_ERROR(fs_handle, "Error from eq_poll %d",
+					rc);
+			return NULL;
+		}
+
+		if (rc == 0 && fs_handle->dpi_shutdown)
+			return NULL;
+
+		for (i = 0; i < rc; i++) {
+			ev = container_of(evs[i], struct dfuse_event, de_ev);
+			ev->de_complete_cb(ev);
+			dfuse_da_release(fs_handle->dpi_event_da, ev);
+		}
+
+		/* One post has been consumed already, consume the ones for
+		 * the other events, they are always posted after the launch
+		 * so this does not block for long.
+		 */
+		for (i = 1; i < rc; i++) {
+			while (sem_wait(&fs_handle->dpi_sem) != 0 &&
+			       errno == EINTR)
+				;
+		}
+
+		if (rc > 0)
+			dfuse_da_restock(fs_handle->dpi_event_da);
+	}
+	return NULL;
+}
+
+/* Create the event queue and start the progress thread */
+static int
+dfuse_progress_start(struct dfuse_projection_info *fs_handle)
+{
+	int rc;
+
+	rc = daos_eq_create(&fs_handle->dpi_eq);
+	if (rc != -DER_SUCCESS)
+		return rc;
+
+	rc = sem_init(&fs_handle->dpi_sem, 0, 0);
+	if (rc != 0) {
+		daos_eq_destroy(fs_handle->dpi_eq, 0);
+		return daos_errno2der(errno);
+	}
+
+	rc = pthread_create(&fs_handle->dpi_thread, NULL,
+			    dfuse_progress_thread, fs_handle);
+	if (rc != 0) {
+		sem_destroy(&fs_handle->dpi_sem);
+		daos_eq_destroy(fs_handle->dpi_eq, 0);
+		return daos_errno2der(rc);
+	}
+
+	return -DER_SUCCESS;
+}
+
+/* Wait for the I/O in flight, then stop the progress thread.  The event
+ * descriptors have to be released before the event queue is destroyed.
+ */
+static void
+dfuse_progress_stop(struct dfuse_projection_info *fs_handle)
+{
+	int rc;
+
+	fs_handle->dpi_shutdown = true;
+	sem_post(&fs_handle->dpi_sem);
+	pthread_join(fs_handle->dpi_thread, NULL);
+
+	dfuse_da_destroy(&fs_handle->dpi_da);
+
+	rc = daos_eq_destroy(fs_handle->dpi_eq, 0);
+	if (rc != -DER_SUCCESS)
+		DFUSE_TRA_WARNING(fs_handle, "Failed to destroy EQ %d", rc);
+	sem_destroy(&fs_handle->dpi_sem);
+}
+
 int
 dfuse_start(struct dfuse_info *dfuse_info, struct dfuse_dfs *dfs)
 {
@@ -157,6 +324,7 @@ dfuse_start(struct dfuse_info *dfuse_info, struct dfuse_dfs *dfs)
 	struct fuse_args		args = {0};
 	struct fuse_lowlevel_ops	*fuse_ops = NULL;
 	struct dfuse_inode_entry	*ie = NULL;
+	bool				progress = false;
 	int				rc;
 
 	D_ALLOC_PTR(fs_handle);
@@ -184,6 +352,20 @@ dfuse_start(struct dfuse_info *dfuse_info, struct dfuse_dfs *dfs)
 
 	atomic_fetch_add(&fs_handle->dpi_ino_next, 2);
 
+	rc = dfuse_da_init(&fs_handle->dpi_da, fs_handle);
+	if (rc != -DER_SUCCESS)
+		D_GOTO(err, 0);
+
+	rc = dfuse_progress_start(fs_handle);
+	if (rc != -DER_SUCCESS)
+		D_GOTO(err, 0);
+	progress = true;
+
+	fs_handle->dpi_event_da = dfuse_da_register(&fs_handle->dpi_da,
+						    &dfuse_event_reg);
+	if (!fs_handle->dpi_event_da)
+		D_GOTO(err, 0);
+
 	args.argc = 4;
 
 	args.allocated = 1;
@@ -256,6 +438,10 @@ err:
 	DFUSE_TRA_ERROR(fs_handle, "Failed");
 	D_FREE(fuse_ops);
 	D_FREE(ie);
+	if (progress)
+		dfuse_progress_stop(fs_handle);
+	else
+		dfuse_da_destroy(&fs_handle->dpi_da);
 	D_FREE(fs_handle);
 	return -DER_INVAL;
 }
@@ -372,5 +558,7 @@ dfuse_destroy_fuse(struct dfuse_projection_info *fs_handle)
 		rcp = EINVAL;
 	}
 
+	dfuse_progress_stop(fs_handle);
+
 	return rcp;
 }
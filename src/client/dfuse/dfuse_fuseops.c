@@ -89,6 +89,19 @@ dfuse_fuse_init(void *arg, struct fuse_conn_info *conn)
 
 	dfuse_show_flags(fs_handle, conn->capable);
 
+	/* Let libfuse use splice for both directions where it can, read
+	 * replies are spliced to the kernel from the request buffer and write
+	 * requests are spliced from the kernel into it.
+	 */
+	conn->want |= conn->capable & (FUSE_CAP_SPLICE_READ |
+				       FUSE_CAP_SPLICE_WRITE);
+
+	/* List the directories with their attributes, the kernel switches
+	 * back to plain readdir when the entries are not looked up after.
+	 */
+	conn->want |= conn->capable & (FUSE_CAP_READDIRPLUS |
+				       FUSE_CAP_READDIRPLUS_AUTO);
+
 	/* This does not work as ioctl.c assumes fi->fh is a file handle */
 	conn->want &= ~FUSE_CAP_IOCTL_DIR;
 
@@ -362,8 +375,8 @@ err:
  * all entries.
  */
 static void
-df_ll_readdir(fuse_req_t req, fuse_ino_t ino, size_t size, off_t offset,
-	      struct fuse_file_info *fi)
+df_ll_readdir_common(fuse_req_t req, fuse_ino_t ino, size_t size,
+		     off_t offset, bool plus, struct fuse_file_info *fi)
 {
 	struct dfuse_projection_info	*fs_handle = fuse_req_userdata(req);
 	struct dfuse_inode_entry	*inode;
@@ -381,7 +394,7 @@ df_ll_readdir(fuse_req_t req, fuse_ino_t ino, size_t size, off_t offset,
 	if (!inode->ie_dfs->dfs_ops->readdir) {
 		D_GOTO(decref, rc = ENOTSUP);
 	}
-	inode->ie_dfs->dfs_ops->readdir(req, inode, size, offset, fi);
+	inode->ie_dfs->dfs_ops->readdir(req, inode, size, offset, plus, fi);
 
 	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
 	return;
@@ -391,6 +404,20 @@ err:
 	DFUSE_REPLY_ERR_RAW(fs_handle, req, rc);
 }
 
+static void
+df_ll_readdir(fuse_req_t req, fuse_ino_t ino, size_t size, off_t offset,
+	      struct fuse_file_info *fi)
+{
+	df_ll_readdir_common(req, ino, size, offset, false, fi);
+}
+
+static void
+df_ll_readdirplus(fuse_req_t req, fuse_ino_t ino, size_t size, off_t offset,
+		  struct fuse_file_info *fi)
+{
+	df_ll_readdir_common(req, ino, size, offset, true, fi);
+}
+
 void
 df_ll_symlink(fuse_req_t req, const char *link, fuse_ino_t parent,
 	      const char *name)
@@ -647,6 +674,7 @@ struct fuse_lowlevel_ops
 	fuse_ops->unlink	= df_ll_unlink;
 	fuse_ops->rmdir		= df_ll_unlink;
 	fuse_ops->readdir	= df_ll_readdir;
+	fuse_ops->readdirplus	= df_ll_readdirplus;
 	fuse_ops->create	= df_ll_create;
 	fuse_ops->rename	= df_ll_rename;
 	fuse_ops->symlink	= df_ll_symlink;
@@ -671,7 +699,7 @@ struct fuse_lowlevel_ops
 	 */
 	fuse_ops->open		= dfuse_cb_open;
 	fuse_ops->release	= dfuse_cb_release;
-	fuse_ops->write		= dfuse_cb_write;
+	fuse_ops->write_buf	= dfuse_cb_write;
 	fuse_ops->read		= dfuse_cb_read;
 	fuse_ops->readlink	= dfuse_cb_readlink;
 	fuse_ops->ioctl		= dfuse_cb_ioctl;
@@ -873,6 +873,28 @@ dfuse_mmap(void *address, size_t length, int prot, int flags, int fd,
 	return __real_mmap(address, length, prot, flags, fd, offset);
 }
 
+DFUSE_PUBLIC int
+dfuse_ftruncate(int fd, off_t length)
+{
+	struct fd_entry *entry;
+	int rc;
+
+	rc = vector_get(&fd_table, fd, &entry);
+	if (rc != 0)
+		goto do_real_ftruncate;
+
+	DFUSE_LOG_INFO("ftruncate(fd=%d, length=%zd) intercepted, bypass=%s",
+		       fd, length, bypass_status[entry->fd_status]);
+
+	/* The truncate is done by dfuse, drop the cached size */
+	entry->fd_size_valid = false;
+
+	vector_decref(&fd_table, entry);
+
+do_real_ftruncate:
+	return __real_ftruncate(fd, length);
+}
+
 DFUSE_PUBLIC int
 dfuse_fsync(int fd)
 {
@@ -35,19 +35,30 @@ read_bulk(char *buff, size_t len, off_t position,
 	daos_size_t		array_size;
 	daos_size_t		max_read;
 	daos_range_t		rg;
+	daos_event_t		ev;
 	d_iov_t			iov = {};
 	d_sg_list_t		sgl = {};
+	bool			check_size;
+	bool			flag = false;
 	int rc;
+	int ret;
 
 	DFUSE_TRA_INFO(entry, "%#zx-%#zx ", position, position + len - 1);
 
-	rc = daos_array_get_size(entry->fd_aoh, DAOS_TX_NONE, &array_size,
-				 NULL);
-	if (rc) {
-		D_ERROR("daos_array_get_size() failed (%d)\n", rc);
-		*errcode = daos_der2errno(rc);
-		return -1;
+	/* Only query the size first if the read goes past the cached one. */
+	check_size = entry->fd_size_valid && position + len <= entry->fd_size;
+	if (!check_size) {
+		rc = daos_array_get_size(entry->fd_aoh, DAOS_TX_NONE,
+					 &array_size, NULL);
+		if (rc) {
+			D_ERROR("daos_array_get_size() failed (%d)\n", rc);
+			*errcode = daos_der2errno(rc);
+			return -1;
+		}
+		entry->fd_size = array_size;
+		entry->fd_size_valid = true;
 	}
+	array_size = entry->fd_size;
 
 	if (position >= array_size)
 		return 0;
@@ -57,6 +68,27 @@ read_bulk(char *buff, size_t len, off_t position,
 	if (max_read < len)
 		len = max_read;
 
+	/* The file may have been shrunk through another fd or by another
+	 * process since the size was cached.  Query the size along with the
+	 * read rather than before it, so that reads within the file still
+	 * only wait for one round trip, and return a short read if it has.
+	 */
+	if (check_size) {
+		rc = daos_event_init(&ev, DAOS_HDL_INVAL, NULL);
+		if (rc) {
+			*errcode = daos_der2errno(rc);
+			return -1;
+		}
+		rc = daos_array_get_size(entry->fd_aoh, DAOS_TX_NONE,
+					 &array_size, &ev);
+		if (rc) {
+			D_ERROR("daos_array_get_size() failed (%d)\n", rc);
+			daos_event_fini(&ev);
+			*errcode = daos_der2errno(rc);
+			return -1;
+		}
+	}
+
 	sgl.sg_nr = 1;
 	d_iov_set(&iov, (void *)buff, len);
 	sgl.sg_iovs = &iov;
@@ -68,12 +100,36 @@ read_bulk(char *buff, size_t len, off_t position,
 
 	rc = daos_array_read(entry->fd_aoh, DAOS_TX_NONE, &iod, &sgl, NULL,
 			     NULL);
+
+	if (check_size) {
+		while (!flag) {
+			ret = daos_event_test(&ev, DAOS_EQ_WAIT, &flag);
+			if (ret)
+				break;
+		}
+		if (flag)
+			ret = ev.ev_error;
+		daos_event_fini(&ev);
+		if (rc == 0 && ret) {
+			D_ERROR("daos_array_get_size() failed (%d)\n", ret);
+			rc = ret;
+		}
+	}
+
 	if (rc) {
 		DFUSE_TRA_INFO(entry, "daos_array_read() failed %d", rc);
 		*errcode = daos_der2errno(rc);
 		return -1;
 	}
 
+	if (check_size) {
+		entry->fd_size = array_size;
+		if (position >= array_size)
+			return 0;
+		if (array_size - position < len)
+			len = array_size - position;
+	}
+
 	return len;
 }
 
@@ -56,6 +56,9 @@ ioil_do_writex(const char *buff, size_t len, off_t position,
 		return -1;
 	}
 
+	if (entry->fd_size_valid && position + len > entry->fd_size)
+		entry->fd_size = position + len;
+
 	return len;
 }
 
@@ -52,6 +52,7 @@
 	ACTION(off_t,   lseek,     (int, off_t, int))                         \
 	ACTION(ssize_t, preadv,    (int, const struct iovec *, int, off_t))   \
 	ACTION(ssize_t, pwritev,   (int, const struct iovec *, int, off_t))   \
+	ACTION(int,     ftruncate, (int, off_t))                              \
 	ACTION(void *,  mmap,      (void *, size_t, int, int, int, off_t))
 
 #define FOREACH_SINGLE_INTERCEPT(ACTION)                                      \
@@ -123,6 +124,12 @@ struct fd_entry {
 	off_t		fd_pos;
 	int		fd_flags;
 	int		fd_status;
+	/* Cached file size, only valid if fd_size_valid is set.  It is grown
+	 * by local writes, queried before the reads that go past it and along
+	 * with the other reads.
+	 */
+	daos_size_t	fd_size;
+	bool		fd_size_valid;
 };
 
 ssize_t
@@ -38,6 +38,7 @@ DFUSE_PUBLIC ssize_t dfuse_pwrite(int, const void *, size_t, off_t);
 DFUSE_PUBLIC off_t dfuse_lseek(int, off_t, int);
 DFUSE_PUBLIC ssize_t dfuse_preadv(int, const struct iovec *, int, off_t);
 DFUSE_PUBLIC ssize_t dfuse_pwritev(int, const struct iovec *, int, off_t);
+DFUSE_PUBLIC int dfuse_ftruncate(int, off_t);
 DFUSE_PUBLIC void *dfuse_mmap(void *, size_t, int, int, int, off_t);
 DFUSE_PUBLIC int dfuse_close(int);
 DFUSE_PUBLIC ssize_t dfuse_read(int, void *, size_t);
@@ -32,10 +32,19 @@ static void
 handle_il_ioctl(struct dfuse_obj_hdl *oh, fuse_req_t req)
 {
 	struct dfuse_il_reply	il_reply = {0};
+	daos_handle_t		aoh;
 	int			rc;
 
 	DFUSE_TRA_INFO(oh, "Requested");
 
+	/**
+	 * The library accesses the array of the file directly, the data of a
+	 * file inlined in its entry is moved there first.
+	 */
+	rc = dfs_get_file_oh(oh->doh_obj, &aoh);
+	if (rc)
+		D_GOTO(err, rc);
+
 	rc = dfs_obj2id(oh->doh_ie->ie_obj, &il_reply.fir_oid);
 	if (rc)
 		D_GOTO(err, rc);
@@ -24,6 +24,51 @@
 #include "dfuse_common.h"
 #include "dfuse.h"
 
+/**
+ * Insert @ie, which holds one reference, into the inode table. If the inode
+ * is already known, the reference is moved to the existing entry which is
+ * returned, and @ie is closed.
+ */
+struct dfuse_inode_entry *
+dfuse_inode_insert(struct dfuse_projection_info *fs_handle,
+		   struct dfuse_inode_entry *ie)
+{
+	struct dfuse_inode_entry	*inode;
+	d_list_t			*rlink;
+	int				rc;
+
+	DFUSE_TRA_INFO(ie, "Inserting inode %lu", ie->ie_stat.st_ino);
+
+	rlink = d_hash_rec_find_insert(&fs_handle->dpi_iet,
+				       &ie->ie_stat.st_ino,
+				       sizeof(ie->ie_stat.st_ino),
+				       &ie->ie_htl);
+
+	if (rlink == &ie->ie_htl)
+		return ie;
+
+	inode = container_of(rlink, struct dfuse_inode_entry, ie_htl);
+
+	/* The lookup has resulted in an existing file, so reuse that
+	 * entry, drop the inode in the lookup descriptor and do not
+	 * keep a reference on the parent.
+	 */
+
+	/* Update the existing object with the new name/parent */
+	rc = dfs_update_parent(inode->ie_obj, ie->ie_obj, ie->ie_name);
+	if (rc != -DER_SUCCESS)
+		DFUSE_TRA_ERROR(inode, "dfs_update_parent() failed %d", rc);
+
+	inode->ie_parent = ie->ie_parent;
+	strncpy(inode->ie_name, ie->ie_name, NAME_MAX+1);
+
+	atomic_fetch_sub(&ie->ie_ref, 1);
+	ie->ie_parent = 0;
+
+	ie_close(fs_handle, ie);
+	return inode;
+}
+
 void
 dfuse_reply_entry(struct dfuse_projection_info *fs_handle,
 		  struct dfuse_inode_entry *ie,
@@ -31,7 +76,6 @@ dfuse_reply_entry(struct dfuse_projection_info *fs_handle,
 		  fuse_req_t req)
 {
 	struct fuse_entry_param	entry = {0};
-	d_list_t		*rlink;
 	daos_obj_id_t		oid;
 	int			rc;
 
@@ -51,37 +95,8 @@ dfuse_reply_entry(struct dfuse_projection_info *fs_handle,
 	entry.attr = ie->ie_stat;
 	entry.generation = 1;
 	entry.ino = entry.attr.st_ino;
-	DFUSE_TRA_INFO(ie, "Inserting inode %lu", entry.ino);
-
-	rlink = d_hash_rec_find_insert(&fs_handle->dpi_iet,
-				       &ie->ie_stat.st_ino,
-				       sizeof(ie->ie_stat.st_ino),
-				       &ie->ie_htl);
 
-	if (rlink != &ie->ie_htl) {
-		struct dfuse_inode_entry *inode;
-
-		inode = container_of(rlink, struct dfuse_inode_entry, ie_htl);
-
-		/* The lookup has resulted in an existing file, so reuse that
-		 * entry, drop the inode in the lookup descriptor and do not
-		 * keep a reference on the parent.
-		 */
-
-		/* Update the existing object with the new name/parent */
-		rc = dfs_update_parent(inode->ie_obj, ie->ie_obj, ie->ie_name);
-		if (rc != -DER_SUCCESS)
-			DFUSE_TRA_ERROR(inode, "dfs_update_parent() failed %d",
-					rc);
-
-		inode->ie_parent = ie->ie_parent;
-		strncpy(inode->ie_name, ie->ie_name, NAME_MAX+1);
-
-		atomic_fetch_sub(&ie->ie_ref, 1);
-		ie->ie_parent = 0;
-
-		ie_close(fs_handle, ie);
-	}
+	dfuse_inode_insert(fs_handle, ie);
 
 	if (fi_out)
 		DFUSE_REPLY_CREATE(req, entry, fi_out);
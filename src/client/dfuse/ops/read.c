@@ -24,31 +24,62 @@
 #include "dfuse_common.h"
 #include "dfuse.h"
 
+static void
+dfuse_cb_read_complete(struct dfuse_event *ev)
+{
+	struct fuse_bufvec	bufv = FUSE_BUFVEC_INIT(ev->de_len);
+
+	if (ev->de_ev.ev_error != 0) {
+		DFUSE_REPLY_ERR_RAW(ev->de_oh, ev->de_req,
+				    daos_der2errno(ev->de_ev.ev_error));
+		return;
+	}
+
+	/* Reply straight from the buffer, libfuse splices it to the kernel
+	 * if FUSE_CAP_SPLICE_WRITE was negotiated.
+	 */
+	bufv.buf[0].mem = ev->de_buf;
+	DFUSE_REPLY_DATA(ev->de_oh, ev->de_req, &bufv);
+}
+
 void
 dfuse_cb_read(fuse_req_t req, fuse_ino_t ino, size_t len, off_t position,
 	      struct fuse_file_info *fi)
 {
+	struct dfuse_projection_info	*fs_handle = fuse_req_userdata(req);
 	struct dfuse_obj_hdl		*oh = (struct dfuse_obj_hdl *)fi->fh;
-	d_iov_t				iov = {};
-	d_sg_list_t			sgl = {};
-	daos_size_t			size;
-	void				*buff;
+	struct dfuse_event		*ev;
 	int				rc;
 
-	D_ALLOC(buff, len);
-	if (!buff) {
-		DFUSE_REPLY_ERR_RAW(NULL, req, ENOMEM);
+	ev = dfuse_da_acquire(fs_handle->dpi_event_da);
+	if (!ev) {
+		DFUSE_REPLY_ERR_RAW(oh, req, ENOMEM);
 		return;
 	}
 
-	sgl.sg_nr = 1;
-	d_iov_set(&iov, (void *)buff, len);
-	sgl.sg_iovs = &iov;
+	/* The kernel does not ask for more than max_read */
+	if (len > ev->de_buf_size)
+		D_GOTO(err, rc = EINVAL);
+
+	ev->de_req = req;
+	ev->de_oh = oh;
+	ev->de_complete_cb = dfuse_cb_read_complete;
+	d_iov_set(&ev->de_iov, ev->de_buf, len);
+
+	rc = dfs_read(oh->doh_dfs, oh->doh_obj, &ev->de_sgl, position,
+		      &ev->de_len, &ev->de_ev);
+	if (rc)
+		D_GOTO(err, rc);
+
+	/* The reply is sent from the progress thread */
+	sem_post(&fs_handle->dpi_sem);
+	return;
 
-	rc = dfs_read(oh->doh_dfs, oh->doh_obj, &sgl, position, &size, NULL);
-	if (rc == 0)
-		DFUSE_REPLY_BUF(oh, req, buff, size);
-	else
-		DFUSE_REPLY_ERR_RAW(oh, req, rc);
-	D_FREE(buff);
+err:
+	DFUSE_REPLY_ERR_RAW(oh, req, rc);
+	dfuse_da_release(fs_handle->dpi_event_da, ev);
+	/* Only the progress thread restocks otherwise, which does not run
+	 * for a descriptor that was never launched.
+	 */
+	dfuse_da_restock(fs_handle->dpi_event_da);
 }
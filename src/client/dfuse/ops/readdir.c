@@ -34,40 +34,32 @@ struct iterate_data {
 	size_t				fuse_size;
 	size_t				b_off;
 	uint8_t				stop;
+	/** the entries are added in the readdirplus format */
+	bool				plus;
 };
 
-int
-filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *_udata)
+static size_t
+add_direntry(struct iterate_data *udata, char *buf, size_t bufsize,
+	     const char *name, struct fuse_entry_param *entry, off_t off)
 {
-	struct iterate_data	*udata = (struct iterate_data *)_udata;
-	struct dfuse_projection_info *fs_handle = fuse_req_userdata(udata->req);
-	struct dfuse_obj_hdl	*oh = udata->oh;
-	dfs_obj_t		*obj;
-	daos_obj_id_t		oid;
-	struct stat		stbuf = {0};
-	int			ns = 0;
-	int			rc;
+	if (udata->plus)
+		return fuse_add_direntry_plus(udata->req, buf, bufsize, name,
+					      entry, off);
 
-	/*
-	 * MSC - from fuse fuse_add_direntry: "From the 'stbuf' argument the
-	 * st_ino field and bits 12-15 of the st_mode field are used. The other
-	 * fields are ignored." So we only need to lookup the entry for the
-	 * mode.
-	 */
-
-	rc = dfs_lookup_rel(dfs, dir, name, O_RDONLY, &obj, &stbuf.st_mode,
-			    NULL);
-	if (rc)
-		return rc;
-
-	rc = dfs_obj2id(obj, &oid);
-	if (rc)
-		D_GOTO(out, rc);
+	return fuse_add_direntry(udata->req, buf, bufsize, name, &entry->attr,
+				 off);
+}
 
-	rc = dfuse_lookup_inode(fs_handle, udata->inode->ie_dfs, &oid,
-				&stbuf.st_ino);
-	if (rc)
-		D_GOTO(out, rc);
+/*
+ * Add the entry to the fuse buffer of the current readdir call, or to the OH
+ * buffer for the next calls once the fuse buffer is full.
+ */
+static int
+filler_add(struct iterate_data *udata, const char name[],
+	   struct fuse_entry_param *entry)
+{
+	struct dfuse_obj_hdl	*oh = udata->oh;
+	size_t			ns;
 
 	/*
 	 * If we are still within the fuse size limit (less than 4k - we have
@@ -75,15 +67,15 @@ filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *_udata)
 	 */
 	if (oh->doh_cur_off == 0) {
 		/** try to add the entry within the 4k size limit. */
-		ns = fuse_add_direntry(udata->req, oh->doh_buf + udata->b_off,
-				       udata->fuse_size - udata->b_off, name,
-				       &stbuf, oh->doh_fuse_off + 1);
+		ns = add_direntry(udata, oh->doh_buf + udata->b_off,
+				  udata->fuse_size - udata->b_off, name, entry,
+				  oh->doh_fuse_off + 1);
 
 		/** if entry fits, increment the stream and fuse buf offset. */
 		if (ns <= udata->fuse_size - udata->b_off) {
 			udata->b_off += ns;
 			oh->doh_fuse_off++;
-			D_GOTO(out, rc = 0);
+			return 0;
 		}
 
 		/*
@@ -97,9 +89,9 @@ filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *_udata)
 		oh->doh_cur_off = udata->b_off;
 		oh->doh_dir_off[oh->doh_idx] = oh->doh_fuse_off;
 
-		ns = fuse_add_direntry(udata->req, oh->doh_buf + udata->b_off,
-				       udata->size - udata->b_off, name, &stbuf,
-				       oh->doh_dir_off[oh->doh_idx] + 1);
+		ns = add_direntry(udata, oh->doh_buf + udata->b_off,
+				  udata->size - udata->b_off, name, entry,
+				  oh->doh_dir_off[oh->doh_idx] + 1);
 
 		/** Entry should fit now */
 		D_ASSERT(ns <= udata->size - udata->b_off);
@@ -108,7 +100,7 @@ filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *_udata)
 
 		/** no need to issue futher dfs_iterate() calls. */
 		udata->stop = 1;
-		D_GOTO(out, rc = 0);
+		return 0;
 	}
 
 insert:
@@ -116,9 +108,9 @@ insert:
 	 * At this point, we are already adding to the buffer within the large
 	 * size limitation where it will be consumed in future readdir calls.
 	 */
-	ns = fuse_add_direntry(udata->req, oh->doh_buf + oh->doh_cur_off,
-			       udata->size - oh->doh_cur_off, name, &stbuf,
-			       oh->doh_dir_off[oh->doh_idx] + 1);
+	ns = add_direntry(udata, oh->doh_buf + oh->doh_cur_off,
+			  udata->size - oh->doh_cur_off, name, entry,
+			  oh->doh_dir_off[oh->doh_idx] + 1);
 	/*
 	 * In the case where the OH handle does not fit, we still need to add
 	 * the entry since DFS already enumerated it. So, realloc to fit the
@@ -128,7 +120,7 @@ insert:
 		udata->size = udata->size * 2;
 		oh->doh_buf = realloc(oh->doh_buf, udata->size);
 		if (oh->doh_buf == NULL)
-			D_GOTO(out, rc = -ENOMEM);
+			return -ENOMEM;
 		goto insert;
 	}
 
@@ -150,15 +142,119 @@ insert:
 	}
 	oh->doh_dir_off[oh->doh_idx]++;
 
+	return 0;
+}
+
+int
+filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *_udata)
+{
+	struct iterate_data	*udata = (struct iterate_data *)_udata;
+	struct dfuse_projection_info *fs_handle = fuse_req_userdata(udata->req);
+	struct fuse_entry_param	entry = {0};
+	dfs_obj_t		*obj;
+	daos_obj_id_t		oid;
+	int			rc;
+
+	/*
+	 * MSC - from fuse fuse_add_direntry: "From the 'stbuf' argument the
+	 * st_ino field and bits 12-15 of the st_mode field are used. The other
+	 * fields are ignored." So we only need to lookup the entry for the
+	 * mode.
+	 */
+
+	rc = dfs_lookup_rel(dfs, dir, name, O_RDONLY, &obj, &entry.attr.st_mode,
+			    NULL);
+	if (rc)
+		return rc;
+
+	rc = dfs_obj2id(obj, &oid);
+	if (rc)
+		D_GOTO(out, rc);
+
+	rc = dfuse_lookup_inode(fs_handle, udata->inode->ie_dfs, &oid,
+				&entry.attr.st_ino);
+	if (rc)
+		D_GOTO(out, rc);
+
+	rc = filler_add(udata, name, &entry);
+
 out:
 	dfs_release(obj);
 	/* we return the negative errno back to DFS */
 	return rc;
 }
 
+static int
+filler_plus_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], dfs_obj_t *obj,
+	       struct stat *stbuf, void *_udata)
+{
+	struct iterate_data	*udata = (struct iterate_data *)_udata;
+	struct dfuse_projection_info *fs_handle = fuse_req_userdata(udata->req);
+	struct dfuse_obj_hdl	*oh = udata->oh;
+	struct fuse_entry_param	entry = {0};
+	struct dfuse_inode_entry *ie;
+	daos_obj_id_t		oid;
+	int			rc;
+
+	/*
+	 * The OH buffer holds at most READDIR_BLOCKS blocks, so stop before
+	 * the entry that would start one more.  dfs_readdirplus() leaves the
+	 * anchor on it, and it is listed again by the next call.
+	 */
+	if (oh->doh_cur_off != 0 && oh->doh_idx == READDIR_BLOCKS - 1 &&
+	    oh->doh_cur_off - oh->doh_start_off[oh->doh_idx] +
+	    add_direntry(udata, NULL, 0, name, &entry, 0) > udata->fuse_size)
+		D_GOTO(release, rc = E2BIG);
+
+	rc = dfs_obj2id(obj, &oid);
+	if (rc)
+		D_GOTO(release, rc);
+
+	rc = dfuse_lookup_inode(fs_handle, udata->inode->ie_dfs, &oid,
+				&stbuf->st_ino);
+	if (rc)
+		D_GOTO(release, rc);
+
+	entry.attr = *stbuf;
+
+	/*
+	 * The kernel takes a lookup reference on every entry of the reply that
+	 * has a node id, so an inode is only created for the entries that are
+	 * returned by this call. The entries kept in the OH buffer are added
+	 * without one, the kernel looks them up if needed.
+	 */
+	if (oh->doh_cur_off != 0 ||
+	    add_direntry(udata, NULL, 0, name, &entry, 0) >
+	    udata->fuse_size - udata->b_off)
+		D_GOTO(release, rc = filler_add(udata, name, &entry));
+
+	D_ALLOC_PTR(ie);
+	if (!ie)
+		D_GOTO(release, rc = -ENOMEM);
+
+	ie->ie_obj = obj;
+	ie->ie_stat = *stbuf;
+	ie->ie_parent = udata->inode->ie_stat.st_ino;
+	ie->ie_dfs = udata->inode->ie_dfs;
+	strncpy(ie->ie_name, name, NAME_MAX);
+	ie->ie_name[NAME_MAX] = '\0';
+	atomic_fetch_add(&ie->ie_ref, 1);
+
+	dfuse_inode_insert(fs_handle, ie);
+
+	entry.ino = entry.attr.st_ino;
+	entry.generation = 1;
+	return filler_add(udata, name, &entry);
+
+release:
+	dfs_release(obj);
+	return rc;
+}
+
 void
 dfuse_cb_readdir(fuse_req_t req, struct dfuse_inode_entry *inode,
-		 size_t size, off_t offset, struct fuse_file_info *fi)
+		 size_t size, off_t offset, bool plus,
+		 struct fuse_file_info *fi)
 {
 	struct dfuse_obj_hdl	*oh = (struct dfuse_obj_hdl *)fi->fh;
 	uint32_t		nr = LOOP_COUNT;
@@ -188,13 +284,16 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_inode_entry *inode,
 		oh->doh_fuse_off = 0;
 		oh->doh_cur_off = 0;
 		oh->doh_idx = 0;
-	} else if (offset != oh->doh_fuse_off) {
+	} else if (offset != oh->doh_fuse_off ||
+		   (oh->doh_cur_off && oh->doh_plus != plus)) {
 		uint32_t num, keys;
 
 		/*
 		 * otherwise we are starting at an earlier offset where we left
 		 * off on last readdir, so restart by first enumerating that
-		 * many entries. This is the telldir/seekdir use case.
+		 * many entries. This is the telldir/seekdir use case. It is
+		 * also the case if the entries cached on the OH are not in
+		 * the format of this call, readdir or readdirplus.
 		 */
 
 		memset(&oh->doh_anchor, 0, sizeof(oh->doh_anchor));
@@ -271,13 +370,24 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_inode_entry *inode,
 	udata.inode = inode;
 	udata.oh = oh;
 	udata.stop = 0;
+	udata.plus = plus;
+	oh->doh_plus = plus;
 
 	while (!daos_anchor_is_eof(&oh->doh_anchor)) {
 		/** should not be here if we exceeded the fuse 4k buf size */
 		D_ASSERT(oh->doh_cur_off == 0);
 
-		rc = dfs_iterate(oh->doh_dfs, oh->doh_obj, &oh->doh_anchor, &nr,
-				 buf_size - udata.b_off, filler_cb, &udata);
+		nr = LOOP_COUNT;
+		if (plus)
+			rc = dfs_readdirplus(oh->doh_dfs, oh->doh_obj,
+					     &oh->doh_anchor, &nr,
+					     buf_size - udata.b_off,
+					     filler_plus_cb, &udata);
+		else
+			rc = dfs_iterate(oh->doh_dfs, oh->doh_obj,
+					 &oh->doh_anchor, &nr,
+					 buf_size - udata.b_off, filler_cb,
+					 &udata);
 
 		/** if entry does not fit in buffer, just return */
 		if (rc == E2BIG)
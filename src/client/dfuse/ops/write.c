@@ -24,22 +24,66 @@
 #include "dfuse_common.h"
 #include "dfuse.h"
 
+static void
+dfuse_cb_write_complete(struct dfuse_event *ev)
+{
+	if (ev->de_ev.ev_error == 0)
+		DFUSE_REPLY_WRITE(ev->de_oh, ev->de_req, ev->de_len);
+	else
+		DFUSE_REPLY_ERR_RAW(ev->de_oh, ev->de_req,
+				    daos_der2errno(ev->de_ev.ev_error));
+}
+
 void
-dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, const char *buff, size_t len,
+dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv,
 	       off_t position, struct fuse_file_info *fi)
 {
+	struct dfuse_projection_info	*fs_handle = fuse_req_userdata(req);
 	struct dfuse_obj_hdl		*oh = (struct dfuse_obj_hdl *)fi->fh;
-	d_iov_t				iov = {};
-	d_sg_list_t			sgl = {};
+	struct fuse_bufvec		dst = FUSE_BUFVEC_INIT(0);
+	struct dfuse_event		*ev;
+	size_t				len = fuse_buf_size(bufv);
+	ssize_t				copied;
 	int				rc;
 
-	sgl.sg_nr = 1;
-	d_iov_set(&iov, (void *)buff, len);
-	sgl.sg_iovs = &iov;
+	ev = dfuse_da_acquire(fs_handle->dpi_event_da);
+	if (!ev) {
+		DFUSE_REPLY_ERR_RAW(oh, req, ENOMEM);
+		return;
+	}
 
-	rc = dfs_write(oh->doh_dfs, oh->doh_obj, &sgl, position, NULL);
-	if (rc == 0)
-		DFUSE_REPLY_WRITE(oh, req, len);
-	else
-		DFUSE_REPLY_ERR_RAW(oh, req, rc);
+	if (len > ev->de_buf_size)
+		D_GOTO(err, rc = EINVAL);
+
+	/* libfuse reuses its buffer once this function returns so the data
+	 * has to be moved to the descriptor.  The request is received by
+	 * splice where possible so this is the only copy.
+	 */
+	dst.buf[0].mem = ev->de_buf;
+	dst.buf[0].size = len;
+	copied = fuse_buf_copy(&dst, bufv, 0);
+	if (copied < 0)
+		D_GOTO(err, rc = -copied);
+	if ((size_t)copied != len)
+		D_GOTO(err, rc = EIO);
+
+	ev->de_req = req;
+	ev->de_oh = oh;
+	ev->de_complete_cb = dfuse_cb_write_complete;
+	ev->de_len = len;
+	d_iov_set(&ev->de_iov, ev->de_buf, len);
+
+	rc = dfs_write(oh->doh_dfs, oh->doh_obj, &ev->de_sgl, position,
+		       &ev->de_ev);
+	if (rc)
+		D_GOTO(err, rc);
+
+	/* The reply is sent from the progress thread */
+	sem_post(&fs_handle->dpi_sem);
+	return;
+
+err:
+	DFUSE_REPLY_ERR_RAW(oh, req, rc);
+	dfuse_da_release(fs_handle->dpi_event_da, ev);
+	dfuse_da_restock(fs_handle->dpi_event_da);
 }
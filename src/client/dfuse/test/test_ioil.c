@@ -426,6 +426,66 @@ skip_mmap:
 	CU_ASSERT_EQUAL(status, DFUSE_IO_EXTERNAL);
 }
 
+/* Check that the file size cached by the fd follows the changes made
+ * through the fd itself, another fd and ftruncate.
+ */
+static void do_size_cache_test(const char *fname)
+{
+	char buf[BUF_SIZE];
+	size_t file_size = BUF_SIZE * 64;
+	ssize_t bytes;
+	int fd;
+	int fd2;
+	int i;
+	int rc;
+
+	fd = open(fname, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	CU_ASSERT_NOT_EQUAL_FATAL(fd, -1);
+
+	memset(buf, 'c', BUF_SIZE);
+	for (i = 0; i < file_size / BUF_SIZE; i++) {
+		bytes = pwrite(fd, buf, BUF_SIZE, i * BUF_SIZE);
+		CU_ASSERT_EQUAL(bytes, BUF_SIZE);
+	}
+
+	/* Reads within the file are served with the cached size */
+	for (i = 0; i < 64; i++) {
+		bytes = pread(fd, buf, BUF_SIZE, i * BUF_SIZE);
+		CU_ASSERT_EQUAL(bytes, BUF_SIZE);
+	}
+	bytes = pread(fd, buf, BUF_SIZE, file_size - BUF_SIZE / 2);
+	CU_ASSERT_EQUAL(bytes, BUF_SIZE / 2);
+
+	/* Extending the file through the fd grows the cached size */
+	bytes = pwrite(fd, buf, BUF_SIZE, file_size);
+	CU_ASSERT_EQUAL(bytes, BUF_SIZE);
+	bytes = pread(fd, buf, BUF_SIZE, file_size);
+	CU_ASSERT_EQUAL(bytes, BUF_SIZE);
+
+	/* A shrink through another fd gives a short read, not zeroes */
+	fd2 = open(fname, O_RDWR);
+	CU_ASSERT_NOT_EQUAL_FATAL(fd2, -1);
+	rc = ftruncate(fd2, BUF_SIZE * 2 + BUF_SIZE / 2);
+	CU_ASSERT_EQUAL(rc, 0);
+	rc = close(fd2);
+	CU_ASSERT_EQUAL(rc, 0);
+	bytes = pread(fd, buf, BUF_SIZE, BUF_SIZE * 2);
+	CU_ASSERT_EQUAL(bytes, BUF_SIZE / 2);
+	bytes = pread(fd, buf, BUF_SIZE, BUF_SIZE * 4);
+	CU_ASSERT_EQUAL(bytes, 0);
+
+	/* Truncating it through the fd drops the cached size */
+	rc = ftruncate64(fd, BUF_SIZE);
+	CU_ASSERT_EQUAL(rc, 0);
+	bytes = pread(fd, buf, BUF_SIZE, BUF_SIZE / 2);
+	CU_ASSERT_EQUAL(bytes, BUF_SIZE / 2);
+	bytes = pread(fd, buf, BUF_SIZE, BUF_SIZE * 2);
+	CU_ASSERT_EQUAL(bytes, 0);
+
+	rc = close(fd);
+	CU_ASSERT_EQUAL(rc, 0);
+}
+
 /* Simple sanity test to ensure low-level POSIX APIs work */
 void sanity(void)
 {
@@ -446,6 +506,7 @@ void sanity(void)
 	do_read_tests(buf, len);
 	do_misc_tests(buf, len);
 	do_large_io_test(buf, len);
+	do_size_cache_test(buf);
 	free(buf);
 }
 
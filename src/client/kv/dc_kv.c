@@ -42,6 +42,27 @@ struct io_params {
 	d_sg_list_t		sgl;
 };
 
+/* Init the dkey and the iod of a key of @len bytes, for now akey = dkey. */
+static void
+kv_params_init_len(struct io_params *params, const char *key, size_t len,
+		   daos_size_t size)
+{
+	d_iov_set(&params->dkey, (void *)key, len);
+	d_iov_set(&params->iod.iod_name, (void *)key, len);
+	params->iod.iod_nr	= 1;
+	params->iod.iod_recxs	= NULL;
+	params->iod.iod_eprs	= NULL;
+	params->iod.iod_csums	= NULL;
+	params->iod.iod_size	= size;
+	params->iod.iod_type	= DAOS_IOD_SINGLE;
+}
+
+static void
+kv_params_init(struct io_params *params, const char *key, daos_size_t size)
+{
+	kv_params_init_len(params, key, strlen(key), size);
+}
+
 static int
 free_io_params_cb(tse_task_t *task, void *data)
 {
@@ -77,18 +98,7 @@ dc_kv_put(tse_task_t *task)
 		return -DER_NOMEM;
 	}
 
-	/** init dkey */
-	d_iov_set(&params->dkey, (void *)args->key, strlen(args->key));
-
-	/** init iod. For now set akey = dkey */
-	d_iov_set(&params->iod.iod_name, (void *)args->key,
-		     strlen(args->key));
-	params->iod.iod_nr	= 1;
-	params->iod.iod_recxs	= NULL;
-	params->iod.iod_eprs	= NULL;
-	params->iod.iod_csums	= NULL;
-	params->iod.iod_size	= args->buf_size;
-	params->iod.iod_type	= DAOS_IOD_SINGLE;
+	kv_params_init(params, args->key, args->buf_size);
 
 	/** init sgl */
 	params->sgl.sg_nr = 1;
@@ -159,18 +169,7 @@ dc_kv_get(tse_task_t *task)
 		return -DER_NOMEM;
 	}
 
-	/** init dkey */
-	d_iov_set(&params->dkey, (void *)args->key, strlen(args->key));
-
-	/** init iod. For now set akey = dkey */
-	d_iov_set(&params->iod.iod_name, (void *)args->key,
-		     strlen(args->key));
-	params->iod.iod_nr	= 1;
-	params->iod.iod_recxs	= NULL;
-	params->iod.iod_eprs	= NULL;
-	params->iod.iod_csums	= NULL;
-	params->iod.iod_size	= *buf_size;
-	params->iod.iod_type	= DAOS_IOD_SINGLE;
+	kv_params_init(params, args->key, *buf_size);
 
 	/** init sgl */
 	if (buf && *buf_size) {
@@ -300,6 +299,7 @@ dc_kv_list(tse_task_t *task)
 	list_args->sgl		= args->sgl;
 	list_args->kds		= args->kds;
 	list_args->dkey_anchor	= args->anchor;
+	list_args->filter	= args->filter;
 
 	rc = tse_task_register_deps(task, 1, &list_task);
 	if (rc != 0)
@@ -319,3 +319,584 @@ err_task:
 	tse_task_complete(task, rc);
 	return rc;
 }
+
+/*
+ * State of a KV scan with the values. The servers only filter the keys, the
+ * values of the listed keys are then fetched by one multi-dkey fetch into
+ * buffers of up to DAOS_KV_SCAN_INLINE_MAX bytes, and packed with the keys
+ * into the user buffers.
+ */
+struct kv_scan {
+	daos_kv_list_t		*args;
+	tse_task_t		*task;
+	/** keys listed, their descriptors and their names */
+	uint32_t		nr;
+	daos_key_desc_t		*kds;
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	/** value fetch of each key, in a buffer of @cap bytes */
+	struct io_params	*params;
+	daos_dkey_io_t		*ios;
+	char			*vals;
+	daos_size_t		cap;
+	/** bytes of the user buffers left for the values */
+	daos_size_t		room;
+	/** value fetches that failed as a value had grown */
+	int			retry;
+	/** failure to issue a fetch */
+	int			err;
+};
+
+/* Number of value fetches retried before only the sizes are returned */
+#define KV_SCAN_RETRY_MAX	3
+
+static void
+kv_scan_free(struct kv_scan *ks)
+{
+	if (ks->vals)
+		D_FREE(ks->vals);
+	if (ks->ios)
+		D_FREE(ks->ios);
+	if (ks->params)
+		D_FREE(ks->params);
+	if (ks->iov.iov_buf)
+		D_FREE(ks->iov.iov_buf);
+	if (ks->kds)
+		D_FREE(ks->kds);
+	D_FREE(ks);
+}
+
+static int
+kv_scan_free_cb(tse_task_t *task, void *data)
+{
+	struct kv_scan	*ks = *((struct kv_scan **)data);
+	int		rc = ks->err;
+
+	kv_scan_free(ks);
+	return rc;
+}
+
+/*
+ * Issue a multi-dkey fetch of the keys with a value buffer, or of all the
+ * keys without buffers if @sizes, to get the sizes of their values.
+ */
+static int
+kv_scan_fetch(struct kv_scan *ks, bool sizes, tse_task_cb_t cb)
+{
+	daos_obj_multi_rw_t	*io_args;
+	struct io_params	*params;
+	tse_task_t		*io_task;
+	uint32_t		nr = 0;
+	uint32_t		i;
+	int			rc;
+
+	for (i = 0; i < ks->nr; i++) {
+		params = &ks->params[i];
+		if (!sizes && params->sgl.sg_nr == 0)
+			continue;
+
+		params->iod.iod_size = DAOS_REC_ANY;
+		params->iov.iov_len = 0;
+		params->sgl.sg_nr_out = 0;
+		ks->ios[nr].dio_dkey = &params->dkey;
+		ks->ios[nr].dio_nr = 1;
+		ks->ios[nr].dio_iods = &params->iod;
+		ks->ios[nr].dio_sgls = sizes ? NULL : &params->sgl;
+		nr++;
+	}
+
+	rc = daos_task_create(DAOS_OPC_OBJ_FETCH_MULTI,
+			      tse_task2sched(ks->task), 0, NULL, &io_task);
+	if (rc != 0)
+		return rc;
+
+	io_args = daos_task_get_args(io_task);
+	io_args->oh	= ks->args->oh;
+	io_args->th	= ks->args->th;
+	io_args->nr	= nr;
+	io_args->ios	= ks->ios;
+
+	rc = tse_task_register_comp_cb(io_task, cb, &ks, sizeof(ks));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_register_deps(ks->task, 1, &io_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	return tse_task_schedule(io_task, false);
+
+err_task:
+	tse_task_complete(io_task, rc);
+	return rc;
+}
+
+/* Copy @len bytes of @buf at the end of the data of @sgl */
+static void
+kv_sgl_append(d_sg_list_t *sgl, const char *buf, daos_size_t len)
+{
+	d_iov_t		*iov;
+	daos_size_t	nob;
+
+	while (len > 0 && sgl->sg_nr_out < sgl->sg_nr) {
+		iov = &sgl->sg_iovs[sgl->sg_nr_out];
+		nob = min(len, iov->iov_buf_len - iov->iov_len);
+		memcpy((char *)iov->iov_buf + iov->iov_len, buf, nob);
+		iov->iov_len += nob;
+		buf += nob;
+		len -= nob;
+		if (iov->iov_len == iov->iov_buf_len)
+			sgl->sg_nr_out++;
+	}
+}
+
+/*
+ * Pack each listed key and its value into the user buffers, in order while
+ * the values fit. A key without a value was removed after it was listed and
+ * is skipped.
+ */
+static void
+kv_scan_pack(struct kv_scan *ks)
+{
+	daos_kv_list_t		*args = ks->args;
+	struct io_params	*params;
+	daos_key_desc_t		*kd;
+	daos_size_t		room = ks->room;
+	daos_size_t		size;
+	char			*ptr = ks->iov.iov_buf;
+	uint32_t		nr = 0;
+	uint32_t		i;
+
+	for (i = 0; i < args->sgl->sg_nr; i++)
+		args->sgl->sg_iovs[i].iov_len = 0;
+	args->sgl->sg_nr_out = 0;
+
+	for (i = 0; i < ks->nr; ptr += ks->kds[i].kd_key_len, i++) {
+		params = &ks->params[i];
+		size = params->iod.iod_size;
+		if (size == 0)
+			continue;
+
+		args->kds[2 * nr] = ks->kds[i];
+		kv_sgl_append(args->sgl, ptr, ks->kds[i].kd_key_len);
+
+		kd = &args->kds[2 * nr + 1];
+		kd->kd_key_len = size;
+		kd->kd_csum_len = 0;
+		kd->kd_val_type = DAOS_IOD_NONE;
+		if (params->sgl.sg_nr == 1 && size <= room) {
+			kd->kd_val_type = DAOS_IOD_SINGLE;
+			kv_sgl_append(args->sgl, params->iov.iov_buf, size);
+			room -= size;
+		}
+		nr++;
+	}
+
+	if (args->sgl->sg_nr_out < args->sgl->sg_nr &&
+	    args->sgl->sg_iovs[args->sgl->sg_nr_out].iov_len > 0)
+		args->sgl->sg_nr_out++;
+	*args->nr = 2 * nr;
+}
+
+static int kv_scan_size_cb(tse_task_t *task, void *data);
+
+/*
+ * The values are fetched. A value larger than its buffer fails the fetch of
+ * all the keys of its RPC with -DER_REC2BIG, which does not tell which key it
+ * was, so the sizes of all the values are fetched, then only the values that
+ * fit again.
+ */
+static int
+kv_scan_data_cb(tse_task_t *task, void *data)
+{
+	struct kv_scan	*ks = *((struct kv_scan **)data);
+	int		rc;
+
+	if (task->dt_result == 0) {
+		kv_scan_pack(ks);
+		return 0;
+	}
+	if (task->dt_result != -DER_REC2BIG)
+		return 0;
+
+	D_DEBUG(DB_IO, "value larger than %zu bytes, retry %d\n", ks->cap,
+		ks->retry);
+	task->dt_result = 0;
+	ks->retry++;
+	rc = kv_scan_fetch(ks, true, kv_scan_size_cb);
+	if (rc != 0)
+		ks->err = rc;
+	return 0;
+}
+
+/*
+ * The sizes of the values are known, fetch the values that fit in their
+ * buffer and in the user buffer after all the keys. Once the values kept
+ * growing for KV_SCAN_RETRY_MAX fetches, only their sizes are returned.
+ */
+static int
+kv_scan_size_cb(tse_task_t *task, void *data)
+{
+	struct kv_scan		*ks = *((struct kv_scan **)data);
+	struct io_params	*params;
+	daos_size_t		room = ks->room;
+	daos_size_t		size;
+	bool			fetch = false;
+	uint32_t		i;
+	int			rc;
+
+	if (task->dt_result != 0)
+		return 0;
+
+	for (i = 0; i < ks->nr; i++) {
+		params = &ks->params[i];
+		size = params->iod.iod_size;
+		params->sgl.sg_nr = 0;
+		if (size > 0 && size <= ks->cap && size <= room &&
+		    ks->retry <= KV_SCAN_RETRY_MAX) {
+			params->sgl.sg_nr = 1;
+			room -= size;
+			fetch = true;
+		}
+	}
+	if (!fetch) {
+		kv_scan_pack(ks);
+		return 0;
+	}
+
+	rc = kv_scan_fetch(ks, false, kv_scan_data_cb);
+	if (rc != 0)
+		ks->err = rc;
+	return 0;
+}
+
+/*
+ * Fetch the values of the listed keys into buffers as large as a value that
+ * can be returned, or only their sizes if there is no room for values.
+ */
+static int
+kv_scan_list_cb(tse_task_t *task, void *data)
+{
+	struct kv_scan		*ks = *((struct kv_scan **)data);
+	struct io_params	*params;
+	char			*ptr = ks->iov.iov_buf;
+	uint32_t		i;
+	int			rc;
+
+	if (task->dt_result != 0)
+		return 0;
+
+	if (ks->nr == 0) {
+		*ks->args->nr = 0;
+		ks->args->sgl->sg_nr_out = 0;
+		return 0;
+	}
+
+	ks->room = ks->iov.iov_buf_len;
+	for (i = 0; i < ks->nr; i++)
+		ks->room -= ks->kds[i].kd_key_len;
+	ks->cap = min(ks->room, DAOS_KV_SCAN_INLINE_MAX);
+
+	D_ALLOC_ARRAY(ks->params, ks->nr);
+	D_ALLOC_ARRAY(ks->ios, ks->nr);
+	if (ks->params == NULL || ks->ios == NULL)
+		D_GOTO(err, rc = -DER_NOMEM);
+	if (ks->cap > 0) {
+		D_ALLOC(ks->vals, ks->nr * ks->cap);
+		if (ks->vals == NULL)
+			D_GOTO(err, rc = -DER_NOMEM);
+	}
+
+	for (i = 0; i < ks->nr; ptr += ks->kds[i].kd_key_len, i++) {
+		params = &ks->params[i];
+		kv_params_init_len(params, ptr, ks->kds[i].kd_key_len,
+				   DAOS_REC_ANY);
+		if (ks->cap == 0)
+			continue;
+		d_iov_set(&params->iov, ks->vals + i * ks->cap, ks->cap);
+		params->sgl.sg_nr = 1;
+		params->sgl.sg_iovs = &params->iov;
+	}
+
+	if (ks->cap == 0)
+		rc = kv_scan_fetch(ks, true, kv_scan_size_cb);
+	else
+		rc = kv_scan_fetch(ks, false, kv_scan_data_cb);
+	if (rc != 0)
+		D_GOTO(err, rc);
+	return 0;
+err:
+	ks->err = rc;
+	return 0;
+}
+
+/*
+ * List the keys that match the filter into a scratch buffer as large as the
+ * user buffer, using half of the user key descriptors, one is left for the
+ * value of each key.
+ */
+static int
+kv_scan_values(tse_task_t *task)
+{
+	daos_kv_list_t		*args = daos_task_get_args(task);
+	daos_obj_list_dkey_t	*list_args;
+	struct kv_scan		*ks;
+	tse_task_t		*list_task = NULL;
+	daos_size_t		size = 0;
+	uint32_t		i;
+	int			rc;
+
+	for (i = 0; i < args->sgl->sg_nr; i++)
+		size += args->sgl->sg_iovs[i].iov_buf_len;
+
+	D_ALLOC_PTR(ks);
+	if (ks == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	ks->args = args;
+	ks->task = task;
+	ks->nr = *args->nr / 2;
+	D_ALLOC_ARRAY(ks->kds, ks->nr);
+	D_ALLOC(ks->iov.iov_buf, size);
+	if (ks->kds == NULL || ks->iov.iov_buf == NULL) {
+		kv_scan_free(ks);
+		D_GOTO(err_task, rc = -DER_NOMEM);
+	}
+	ks->iov.iov_buf_len = size;
+	ks->sgl.sg_nr = 1;
+	ks->sgl.sg_iovs = &ks->iov;
+
+	rc = tse_task_register_comp_cb(task, kv_scan_free_cb, &ks,
+				       sizeof(ks));
+	if (rc != 0) {
+		kv_scan_free(ks);
+		D_GOTO(err_task, rc);
+	}
+
+	rc = daos_task_create(DAOS_OPC_OBJ_LIST_DKEY, tse_task2sched(task),
+			      0, NULL, &list_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	list_args = daos_task_get_args(list_task);
+	list_args->oh		= args->oh;
+	list_args->th		= args->th;
+	list_args->nr		= &ks->nr;
+	list_args->sgl		= &ks->sgl;
+	list_args->kds		= ks->kds;
+	list_args->dkey_anchor	= args->anchor;
+	list_args->filter	= args->filter;
+
+	rc = tse_task_register_comp_cb(list_task, kv_scan_list_cb, &ks,
+				       sizeof(ks));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_register_deps(task, 1, &list_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_schedule(list_task, false);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	tse_sched_progress(tse_task2sched(task));
+	return 0;
+
+err_task:
+	if (list_task)
+		tse_task_complete(list_task, rc);
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+int
+dc_kv_scan(tse_task_t *task)
+{
+	daos_kv_list_t		*args = daos_task_get_args(task);
+	daos_kv_filter_t	*filter = args->filter;
+	int			rc;
+
+	if (filter == NULL || args->nr == NULL) {
+		D_ERROR("NULL filter or number of key descriptors\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	if ((filter->ksf_flags & DAOS_KV_SCAN_PREFIX) &&
+	    (filter->ksf_flags & DAOS_KV_SCAN_RANGE)) {
+		D_ERROR("A scan is either by prefix or by range\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	if (!(filter->ksf_flags & DAOS_KV_SCAN_VALUES))
+		return dc_kv_list(task);
+
+	/** a key and its value are returned together */
+	if (*args->nr < 2 || args->sgl == NULL || args->kds == NULL) {
+		D_ERROR("At least 2 key descriptors are needed for values\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	return kv_scan_values(task);
+
+err_task:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+/** dkey I/Os of a multi put/get, one per key */
+struct kv_multi {
+	daos_kv_multi_t		*args;
+	struct io_params	*params;
+	daos_dkey_io_t		*ios;
+};
+
+static void
+kv_multi_free(struct kv_multi *km)
+{
+	if (km->ios)
+		D_FREE(km->ios);
+	if (km->params)
+		D_FREE(km->params);
+	D_FREE(km);
+}
+
+static int
+kv_multi_free_cb(tse_task_t *task, void *data)
+{
+	struct kv_multi	*km = *((struct kv_multi **)data);
+
+	kv_multi_free(km);
+	return 0;
+}
+
+static int
+kv_multi_size_cb(tse_task_t *task, void *data)
+{
+	struct kv_multi	*km = *((struct kv_multi **)data);
+	uint32_t	i;
+
+	if (task->dt_result != 0)
+		return 0;
+
+	for (i = 0; i < km->args->nr; i++)
+		km->args->sizes[i] = km->params[i].iod.iod_size;
+	return 0;
+}
+
+/*
+ * Put or get all the keys with a single multi-dkey update or fetch. The object
+ * layer sends the keys of each redundancy group in the same RPCs.
+ */
+static int
+kv_multi(tse_task_t *task, bool update)
+{
+	daos_kv_multi_t		*args = daos_task_get_args(task);
+	daos_obj_multi_rw_t	*io_args;
+	struct io_params	*params;
+	struct kv_multi		*km = NULL;
+	tse_task_t		*io_task = NULL;
+	void			*buf;
+	uint32_t		i;
+	int			rc;
+
+	if (args->nr == 0) {
+		tse_task_complete(task, 0);
+		return 0;
+	}
+
+	if (args->keys == NULL || args->sizes == NULL ||
+	    (update && args->bufs == NULL)) {
+		D_ERROR("Invalid key, size or buffer array\n");
+		D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	D_ALLOC_PTR(km);
+	if (km == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+	km->args = args;
+
+	D_ALLOC_ARRAY(km->params, args->nr);
+	D_ALLOC_ARRAY(km->ios, args->nr);
+	if (km->params == NULL || km->ios == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	for (i = 0; i < args->nr; i++) {
+		if (args->keys[i] == NULL) {
+			D_ERROR("NULL key %u\n", i);
+			D_GOTO(err_task, rc = -DER_INVAL);
+		}
+
+		params = &km->params[i];
+		kv_params_init(params, args->keys[i], args->sizes[i]);
+		buf = args->bufs ? args->bufs[i] : NULL;
+		if (buf && args->sizes[i]) {
+			d_iov_set(&params->iov, buf, args->sizes[i]);
+			params->sgl.sg_iovs = &params->iov;
+			params->sgl.sg_nr = 1;
+		}
+
+		km->ios[i].dio_dkey = &params->dkey;
+		km->ios[i].dio_nr = 1;
+		km->ios[i].dio_iods = &params->iod;
+		/** the sgls of all the keys are set, or none of them */
+		if (args->bufs)
+			km->ios[i].dio_sgls = &params->sgl;
+	}
+
+	rc = daos_task_create(update ? DAOS_OPC_OBJ_UPDATE_MULTI :
+			      DAOS_OPC_OBJ_FETCH_MULTI, tse_task2sched(task),
+			      0, NULL, &io_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	io_args = daos_task_get_args(io_task);
+	io_args->oh	= args->oh;
+	io_args->th	= args->th;
+	io_args->nr	= args->nr;
+	io_args->ios	= km->ios;
+
+	if (!update) {
+		rc = tse_task_register_comp_cb(io_task, kv_multi_size_cb, &km,
+					       sizeof(km));
+		if (rc != 0)
+			D_GOTO(err_task, rc);
+	}
+
+	rc = tse_task_register_comp_cb(task, kv_multi_free_cb, &km,
+				       sizeof(km));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+	/** km is freed by kv_multi_free_cb from now on */
+	rc = tse_task_register_deps(task, 1, &io_task);
+	if (rc != 0)
+		D_GOTO(err_io, rc);
+
+	rc = tse_task_schedule(io_task, false);
+	if (rc != 0)
+		D_GOTO(err_io, rc);
+
+	tse_sched_progress(tse_task2sched(task));
+	return 0;
+
+err_task:
+	if (km)
+		kv_multi_free(km);
+err_io:
+	if (io_task)
+		tse_task_complete(io_task, rc);
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+int
+dc_kv_put_multi(tse_task_t *task)
+{
+	return kv_multi(task, true);
+}
+
+int
+dc_kv_get_multi(tse_task_t *task)
+{
+	return kv_multi(task, false);
+}
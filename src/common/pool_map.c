@@ -442,6 +442,228 @@ pool_buf_unpack(struct pool_buf *buf)
 	return 0;
 }
 
+/*
+ * Compact encoding of a pool buffer, e.g. to broadcast a pool handle to many
+ * processes. Each field of a component is stored as the zigzag varint of its
+ * difference with the same field of the previous component, and a run of
+ * components with the same differences is stored once with its length. The
+ * targets of a node, and the nodes of a regular pool, differ by the same
+ * steps, so a large map shrinks to a few bytes per node. The encoding is made
+ * of bytes only, it does not depend on the endianness.
+ */
+#define PB_COMP_FIELDS	8
+/* largest number of components of a decoded pool buffer */
+#define PB_DECODE_MAX_NR	(1U << 20)
+
+static void
+pb_comp2fields(struct pool_component *comp, uint64_t *fields)
+{
+	fields[0] = comp->co_type;
+	fields[1] = comp->co_status;
+	fields[2] = comp->co_index;
+	fields[3] = comp->co_id;
+	fields[4] = comp->co_rank;
+	fields[5] = comp->co_ver;
+	fields[6] = comp->co_fseq;
+	fields[7] = comp->co_nr;
+}
+
+static int
+pb_fields2comp(uint64_t *fields, struct pool_component *comp)
+{
+	int	i;
+
+	/* pool_buf_attach() asserts on an unknown type */
+	if ((fields[0] != PO_COMP_TP_TARGET && fields[0] != PO_COMP_TP_NODE &&
+	     fields[0] != PO_COMP_TP_RACK) ||
+	    fields[1] > UINT8_MAX || fields[2] > UINT8_MAX)
+		return -DER_INVAL;
+	for (i = 3; i < PB_COMP_FIELDS; i++) {
+		if (fields[i] > UINT32_MAX)
+			return -DER_INVAL;
+	}
+
+	comp->co_type	= fields[0];
+	comp->co_status	= fields[1];
+	comp->co_index	= fields[2];
+	comp->co_id	= fields[3];
+	comp->co_rank	= fields[4];
+	comp->co_ver	= fields[5];
+	comp->co_fseq	= fields[6];
+	comp->co_nr	= fields[7];
+	return 0;
+}
+
+/* store @val at @p if it is not NULL, return the number of bytes */
+static size_t
+pb_varint_put(uint8_t *p, uint64_t val)
+{
+	size_t	len = 0;
+
+	do {
+		if (p != NULL)
+			p[len] = (val & 0x7f) | (val > 0x7f ? 0x80 : 0);
+		len++;
+		val >>= 7;
+	} while (val != 0);
+
+	return len;
+}
+
+static int
+pb_varint_get(const uint8_t **p, const uint8_t *end, uint64_t *val)
+{
+	unsigned int	shift;
+
+	*val = 0;
+	for (shift = 0; shift < 64; shift += 7) {
+		if (*p == end)
+			return -DER_INVAL;
+		*val |= (uint64_t)(**p & 0x7f) << shift;
+		if ((*(*p)++ & 0x80) == 0)
+			return 0;
+	}
+	return -DER_INVAL;
+}
+
+static inline uint64_t
+pb_zigzag(int64_t val)
+{
+	return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+static inline int64_t
+pb_unzigzag(uint64_t val)
+{
+	return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+}
+
+/**
+ * Encode the pool buffer \a buf in the compact format.
+ *
+ * \param buf		[IN]	pool buffer to encode
+ * \param out		[OUT]	output buffer, NULL to only get the size
+ *
+ * \return		size of the encoded buffer in bytes
+ */
+size_t
+pool_buf_encode(struct pool_buf *buf, void *out)
+{
+	uint8_t		*p = out;
+	uint64_t	 prev[PB_COMP_FIELDS] = { 0 };
+	uint64_t	 cur[PB_COMP_FIELDS];
+	int64_t		 delta[PB_COMP_FIELDS];
+	size_t		 len;
+	unsigned int	 run;
+	unsigned int	 i;
+	int		 f;
+
+	len = pb_varint_put(p, buf->pb_nr);
+	for (i = 0; i < buf->pb_nr; i += run) {
+		pb_comp2fields(&buf->pb_comps[i], cur);
+		for (f = 0; f < PB_COMP_FIELDS; f++)
+			delta[f] = cur[f] - prev[f];
+
+		/* extend the run while the components differ the same way */
+		for (run = 1; i + run < buf->pb_nr; run++) {
+			memcpy(prev, cur, sizeof(cur));
+			pb_comp2fields(&buf->pb_comps[i + run], cur);
+			for (f = 0; f < PB_COMP_FIELDS; f++) {
+				if (cur[f] - prev[f] != delta[f])
+					break;
+			}
+			if (f < PB_COMP_FIELDS)
+				break;
+		}
+
+		len += pb_varint_put(p ? p + len : NULL, run);
+		for (f = 0; f < PB_COMP_FIELDS; f++)
+			len += pb_varint_put(p ? p + len : NULL,
+					     pb_zigzag(delta[f]));
+
+		/* the base of the next run is the last component of this one */
+		pb_comp2fields(&buf->pb_comps[i + run - 1], prev);
+	}
+
+	return len;
+}
+
+/**
+ * Decode a pool buffer encoded by pool_buf_encode(). The number of components
+ * is checked before the pool buffer is allocated, the encoded buffer can come
+ * from anywhere.
+ *
+ * \param in		[IN]	encoded buffer
+ * \param len		[IN]	size of the encoded buffer
+ * \param nr_exp	[IN]	expected number of components
+ * \param buf_pp	[OUT]	the returned pool buffer, should be freed
+ *				by pool_buf_free.
+ */
+int
+pool_buf_decode(const void *in, size_t len, unsigned int nr_exp,
+		struct pool_buf **buf_pp)
+{
+	const uint8_t		*p = in;
+	const uint8_t		*end = p + len;
+	struct pool_buf		*buf;
+	struct pool_component	 comp;
+	uint64_t		 fields[PB_COMP_FIELDS] = { 0 };
+	uint64_t		 delta[PB_COMP_FIELDS];
+	uint64_t		 nr;
+	uint64_t		 run;
+	unsigned int		 i;
+	int			 f;
+	int			 rc;
+
+	rc = pb_varint_get(&p, end, &nr);
+	if (rc != 0)
+		return rc;
+	if (nr == 0 || nr != nr_exp || nr > PB_DECODE_MAX_NR) {
+		D_DEBUG(DB_MGMT, "Invalid number of components "DF_U64"/%u\n",
+			nr, nr_exp);
+		return -DER_INVAL;
+	}
+
+	buf = pool_buf_alloc(nr);
+	if (buf == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < nr; ) {
+		rc = pb_varint_get(&p, end, &run);
+		if (rc != 0)
+			goto failed;
+		if (run == 0 || run > nr - i)
+			D_GOTO(failed, rc = -DER_INVAL);
+
+		for (f = 0; f < PB_COMP_FIELDS; f++) {
+			rc = pb_varint_get(&p, end, &delta[f]);
+			if (rc != 0)
+				goto failed;
+		}
+
+		for (; run > 0; run--, i++) {
+			for (f = 0; f < PB_COMP_FIELDS; f++)
+				fields[f] += pb_unzigzag(delta[f]);
+			rc = pb_fields2comp(fields, &comp);
+			if (rc != 0)
+				goto failed;
+			rc = pool_buf_attach(buf, &comp, 1);
+			if (rc != 0)
+				goto failed;
+		}
+	}
+
+	if (p != end)
+		D_GOTO(failed, rc = -DER_INVAL);
+
+	*buf_pp = buf;
+	return 0;
+failed:
+	D_DEBUG(DB_MGMT, "Invalid encoded pool buffer: %d\n", rc);
+	pool_buf_free(buf);
+	return rc;
+}
+
 /**
  * Parse pool buffer and construct domain+target array (tree) based on
  * the information in pool buffer.
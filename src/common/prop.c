@@ -232,6 +232,14 @@ daos_prop_valid(daos_prop_t *prop, bool pool, bool input)
 				prop->dpp_entries[i].dpe_str))
 				return false;
 			break;
+		case DAOS_PROP_PO_IO_BULK:
+			val = prop->dpp_entries[i].dpe_val;
+			if (val != DAOS_IO_BULK_FIXED &&
+			    val != DAOS_IO_BULK_ADAPTIVE) {
+				D_ERROR("invalid io_bulk "DF_U64".\n", val);
+				return false;
+			}
+			break;
 		/* container properties */
 		case DAOS_PROP_CO_LABEL:
 			if (!daos_prop_label_valid(
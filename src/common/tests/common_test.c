@@ -103,6 +103,7 @@ int main(int argc, char *argv[])
 		}
 		misc_tests_run();
 		daos_checksum_tests_run();
+		pool_map_tests_run();
 	}
 
 	return 0;
@@ -27,5 +27,6 @@
 /** Test Suite Function Declarations */
 int daos_checksum_tests_run(void);
 int misc_tests_run(void);
+int pool_map_tests_run(void);
 
 #endif
@@ -0,0 +1,213 @@
+/**
+ * (C) Copyright 2020 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+#define D_LOGFAC        DD_FAC(tests)
+
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h> /** For cmocka.h */
+#include <cmocka.h>
+#include <daos/common.h>
+#include <daos/pool_map.h>
+
+#define PM_NODES	64
+#define PM_TGTS		8
+#define PM_COMPS	(PM_NODES + PM_NODES * PM_TGTS)
+/** fields of an encoded component, see pool_buf_encode() */
+#define PM_FIELDS	8
+
+/** Pool buffer of PM_NODES nodes of PM_TGTS targets each */
+static struct pool_buf *
+pm_buf_create(void)
+{
+	struct pool_buf		*buf;
+	struct pool_component	 comp;
+	int			 n;
+	int			 t;
+	int			 rc;
+
+	buf = pool_buf_alloc(PM_COMPS);
+	assert_non_null(buf);
+
+	for (n = 0; n < PM_NODES; n++) {
+		memset(&comp, 0, sizeof(comp));
+		comp.co_type = PO_COMP_TP_NODE;
+		comp.co_status = PO_COMP_ST_UPIN;
+		comp.co_id = n;
+		comp.co_rank = n;
+		comp.co_ver = 1;
+		comp.co_fseq = 1;
+		comp.co_nr = PM_TGTS;
+		rc = pool_buf_attach(buf, &comp, 1);
+		assert_int_equal(rc, 0);
+	}
+
+	for (n = 0; n < PM_NODES; n++) {
+		for (t = 0; t < PM_TGTS; t++) {
+			memset(&comp, 0, sizeof(comp));
+			comp.co_type = PO_COMP_TP_TARGET;
+			comp.co_status = PO_COMP_ST_UPIN;
+			comp.co_index = t;
+			comp.co_id = n * PM_TGTS + t;
+			comp.co_rank = n;
+			comp.co_ver = 1;
+			comp.co_fseq = 1;
+			comp.co_nr = 1;
+			rc = pool_buf_attach(buf, &comp, 1);
+			assert_int_equal(rc, 0);
+		}
+	}
+
+	return buf;
+}
+
+/** Encode @buf, decode it and check that the decoded buffer is the same */
+static size_t
+pm_buf_round_trip(struct pool_buf *buf)
+{
+	struct pool_buf	*dec = NULL;
+	void		*enc;
+	size_t		 len;
+	int		 rc;
+
+	len = pool_buf_encode(buf, NULL);
+	assert_true(len > 0);
+	D_ALLOC(enc, len);
+	assert_non_null(enc);
+	assert_int_equal(pool_buf_encode(buf, enc), len);
+
+	rc = pool_buf_decode(enc, len, buf->pb_nr, &dec);
+	assert_int_equal(rc, 0);
+	assert_int_equal(dec->pb_nr, buf->pb_nr);
+	assert_int_equal(dec->pb_domain_nr, buf->pb_domain_nr);
+	assert_int_equal(dec->pb_node_nr, buf->pb_node_nr);
+	assert_int_equal(dec->pb_target_nr, buf->pb_target_nr);
+	assert_memory_equal(dec->pb_comps, buf->pb_comps,
+			    buf->pb_nr * sizeof(struct pool_component));
+
+	pool_buf_free(dec);
+	D_FREE(enc);
+	return len;
+}
+
+static void
+test_pool_buf_encode_regular(void **state)
+{
+	struct pool_buf	*buf = pm_buf_create();
+	size_t		 len;
+
+	len = pm_buf_round_trip(buf);
+	/** the nodes and the targets each make a handful of runs */
+	assert_true(len < 256);
+
+	pool_buf_free(buf);
+}
+
+static void
+test_pool_buf_encode_irregular(void **state)
+{
+	struct pool_buf	*buf = pm_buf_create();
+	int		 i;
+
+	/** some targets are down and out, with a newer version */
+	for (i = PM_NODES; i < PM_COMPS; i += 7) {
+		buf->pb_comps[i].co_status = PO_COMP_ST_DOWNOUT;
+		buf->pb_comps[i].co_ver = 2 + i % 3;
+		buf->pb_comps[i].co_fseq = 2;
+	}
+	/** and the ranks of the last node are not in order */
+	buf->pb_comps[PM_NODES - 1].co_rank = 1000;
+	for (i = PM_COMPS - PM_TGTS; i < PM_COMPS; i++)
+		buf->pb_comps[i].co_rank = 1000;
+
+	pm_buf_round_trip(buf);
+	pool_buf_free(buf);
+}
+
+static void
+test_pool_buf_decode_invalid(void **state)
+{
+	struct pool_buf	*buf = pm_buf_create();
+	struct pool_buf	*dec = NULL;
+	/** varint of UINT32_MAX components and nothing else */
+	uint8_t		 huge[] = { 0xff, 0xff, 0xff, 0xff, 0x0f };
+	/** one component: nr, run, then the zigzag deltas of its fields */
+	uint8_t		 one[2 + PM_FIELDS] = { 1, 1 };
+	uint8_t		*enc;
+	size_t		 len;
+	size_t		 i;
+	int		 rc;
+
+	len = pool_buf_encode(buf, NULL);
+	D_ALLOC(enc, len + 1);
+	assert_non_null(enc);
+	pool_buf_encode(buf, enc);
+
+	/** not the expected number of components */
+	rc = pool_buf_decode(enc, len, PM_COMPS - 1, &dec);
+	assert_int_equal(rc, -DER_INVAL);
+
+	/** a huge number of components is rejected before any allocation */
+	rc = pool_buf_decode(huge, sizeof(huge), UINT32_MAX, &dec);
+	assert_int_equal(rc, -DER_INVAL);
+
+	/** truncated */
+	for (i = 0; i < len; i++) {
+		rc = pool_buf_decode(enc, i, PM_COMPS, &dec);
+		assert_int_equal(rc, -DER_INVAL);
+	}
+
+	/** trailing garbage */
+	enc[len] = 0;
+	rc = pool_buf_decode(enc, len + 1, PM_COMPS, &dec);
+	assert_int_equal(rc, -DER_INVAL);
+
+	/** one run of one component with a valid type, then a root */
+	one[2] = 2 * PO_COMP_TP_NODE;
+	rc = pool_buf_decode(one, sizeof(one), 1, &dec);
+	assert_int_equal(rc, 0);
+	pool_buf_free(dec);
+	one[2] = 2 * PO_COMP_TP_ROOT;
+	rc = pool_buf_decode(one, sizeof(one), 1, &dec);
+	assert_int_equal(rc, -DER_INVAL);
+
+	D_FREE(enc);
+	pool_buf_free(buf);
+}
+
+static const struct CMUnitTest tests[] = {
+	{"PM01: Pool buffer encode/decode, regular map",
+		test_pool_buf_encode_regular,   NULL, NULL},
+	{"PM02: Pool buffer encode/decode, irregular map",
+		test_pool_buf_encode_irregular, NULL, NULL},
+	{"PM03: Pool buffer decode of invalid buffers",
+		test_pool_buf_decode_invalid,   NULL, NULL},
+};
+
+int
+pool_map_tests_run()
+{
+	return cmocka_run_group_tests_name("Pool Map Tests", tests, NULL,
+					   NULL);
+}
@@ -0,0 +1,228 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * Task scheduler microbenchmark, reports the number of tasks created, run and
+ * completed per second, without dependency, with a fan-out (N tasks depending
+ * on one) and a fan-in (one task depending on N).
+ *
+ * common/tests/sched_perf.c
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <daos/common.h>
+#include <daos/tse.h>
+#include <getopt.h>
+
+static int	opt_tasks = 1000000;
+static int	opt_batch = 4096;
+static int	opt_fan = 16;
+
+static int
+perf_task_body(tse_task_t *task)
+{
+	tse_task_complete(task, 0);
+	return 0;
+}
+
+static int
+perf_task_create(tse_sched_t *sched, tse_task_t **taskp)
+{
+	int	rc;
+
+	rc = tse_task_create(perf_task_body, sched, NULL, taskp);
+	if (rc != 0)
+		printf("Failed to create task: %d\n", rc);
+	return rc;
+}
+
+/* @nr tasks without dependency */
+static int
+perf_batch_none(tse_sched_t *sched, int nr)
+{
+	tse_task_t	*task;
+	int		i;
+	int		rc;
+
+	for (i = 0; i < nr; i++) {
+		rc = perf_task_create(sched, &task);
+		if (rc != 0)
+			return rc;
+		tse_task_schedule(task, false);
+	}
+	return nr;
+}
+
+/* groups of opt_fan tasks depending on the same task */
+static int
+perf_batch_fan_out(tse_sched_t *sched, int nr)
+{
+	tse_task_t	*root;
+	tse_task_t	*task;
+	int		i;
+	int		n = 0;
+	int		rc;
+
+	while (n + opt_fan + 1 <= nr) {
+		rc = perf_task_create(sched, &root);
+		if (rc != 0)
+			return rc;
+
+		for (i = 0; i < opt_fan; i++) {
+			rc = perf_task_create(sched, &task);
+			if (rc != 0)
+				return rc;
+			rc = tse_task_register_deps(task, 1, &root);
+			if (rc != 0)
+				return rc;
+			tse_task_schedule(task, false);
+		}
+		tse_task_schedule(root, false);
+		n += opt_fan + 1;
+	}
+	return n;
+}
+
+/* groups of one task depending on opt_fan tasks */
+static int
+perf_batch_fan_in(tse_sched_t *sched, int nr)
+{
+	tse_task_t	*deps[opt_fan];
+	tse_task_t	*task;
+	int		i;
+	int		n = 0;
+	int		rc;
+
+	while (n + opt_fan + 1 <= nr) {
+		for (i = 0; i < opt_fan; i++) {
+			rc = perf_task_create(sched, &deps[i]);
+			if (rc != 0)
+				return rc;
+		}
+
+		rc = perf_task_create(sched, &task);
+		if (rc != 0)
+			return rc;
+		rc = tse_task_register_deps(task, opt_fan, deps);
+		if (rc != 0)
+			return rc;
+		tse_task_schedule(task, false);
+
+		for (i = 0; i < opt_fan; i++)
+			tse_task_schedule(deps[i], false);
+		n += opt_fan + 1;
+	}
+	return n;
+}
+
+static int
+perf_run(const char *name, int (*batch)(tse_sched_t *, int))
+{
+	tse_sched_t	sched;
+	uint64_t	start;
+	uint64_t	ns;
+	long		done = 0;
+	int		rc;
+
+	rc = tse_sched_init(&sched, NULL, NULL);
+	if (rc != 0) {
+		printf("Failed to init scheduler: %d\n", rc);
+		return rc;
+	}
+
+	start = daos_get_ntime();
+	while (done < opt_tasks) {
+		rc = batch(&sched, min(opt_batch, opt_tasks - done));
+		if (rc <= 0)
+			break;
+		done += rc;
+
+		while (!tse_sched_check_complete(&sched))
+			tse_sched_progress(&sched);
+	}
+	ns = daos_get_ntime() - start;
+	tse_sched_complete(&sched, min(rc, 0), rc < 0);
+	if (rc < 0) {
+		printf("%-8s: failed: %d\n", name, rc);
+		return rc;
+	}
+
+	printf("%-8s: %ld tasks in %.3f sec, %.0f tasks/sec\n", name, done,
+	       (double)ns / NSEC_PER_SEC, (double)done * NSEC_PER_SEC / ns);
+	return 0;
+}
+
+static struct option perf_ops[] = {
+	/** total number of tasks of each test */
+	{ "tasks",	required_argument,	NULL,	'n'	},
+	/** number of tasks in flight before progressing the scheduler */
+	{ "batch",	required_argument,	NULL,	'b'	},
+	/** number of dependencies of the fan-in and fan-out tests */
+	{ "fan",	required_argument,	NULL,	'f'	},
+	{ NULL,		0,			NULL,	0	},
+};
+
+int
+main(int argc, char **argv)
+{
+	int	rc;
+
+	while ((rc = getopt_long(argc, argv, "n:b:f:",
+				 perf_ops, NULL)) != -1) {
+		switch (rc) {
+		default:
+			fprintf(stderr, "unknown opc=%c\n", rc);
+			exit(-1);
+		case 'n':
+			opt_tasks = atoi(optarg);
+			break;
+		case 'b':
+			opt_batch = atoi(optarg);
+			break;
+		case 'f':
+			opt_fan = atoi(optarg);
+			break;
+		}
+	}
+
+	if (opt_fan <= 0 || opt_tasks <= opt_fan || opt_batch <= opt_fan) {
+		printf("invalid tasks=%d batch=%d fan=%d\n", opt_tasks,
+		       opt_batch, opt_fan);
+		return -1;
+	}
+
+	rc = daos_debug_init(NULL);
+	if (rc != 0)
+		return rc;
+
+	printf("%d tasks, %d in flight, fan-in/fan-out of %d\n", opt_tasks,
+	       opt_batch, opt_fan);
+
+	rc = perf_run("none", perf_batch_none);
+	if (rc == 0)
+		rc = perf_run("fan-out", perf_batch_fan_out);
+	if (rc == 0)
+		rc = perf_run("fan-in", perf_batch_fan_in);
+
+	daos_debug_fini();
+	return rc;
+}
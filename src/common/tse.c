@@ -46,8 +46,135 @@ struct tse_task_link {
 	tse_task_t		*tl_task;
 };
 
+/* Max number of freed tasks a thread keeps for reuse */
+#define TSE_TASK_CACHE_MAX	64
+
+/*
+ * Freed tasks kept for reuse by the tse_task_create() calls of the same
+ * thread, whatever their scheduler, so that neither side takes a lock. The
+ * tasks left are released when the thread exits.
+ */
+struct tse_task_cache {
+	struct tse_task_private	*tc_head;
+	int			 tc_nr;
+	bool			 tc_registered;
+};
+
+static __thread struct tse_task_cache	tse_task_cache;
+static pthread_key_t			tse_task_cache_key;
+static pthread_once_t			tse_task_cache_once = PTHREAD_ONCE_INIT;
+static bool				tse_task_cache_keyed;
+
 static void tse_sched_decref(struct tse_sched_private *dsp);
 
+static void
+tse_task_cache_free(void *arg)
+{
+	struct tse_task_cache	*tc = arg;
+	struct tse_task_private	*dtp;
+	tse_task_t		*task;
+
+	while (tc->tc_head != NULL) {
+		dtp = tc->tc_head;
+		tc->tc_head = dtp->dtp_next;
+		task = tse_priv2task(dtp);
+		D_FREE(task);
+	}
+	tc->tc_nr = 0;
+	tc->tc_registered = false;
+}
+
+static void
+tse_task_cache_key_init(void)
+{
+	tse_task_cache_keyed = (pthread_key_create(&tse_task_cache_key,
+						   tse_task_cache_free) == 0);
+}
+
+/* Keep the freed task @dtp for reuse, return false if it must be freed */
+static bool
+tse_task_cache_put(struct tse_task_private *dtp)
+{
+	struct tse_task_cache	*tc = &tse_task_cache;
+
+	if (!tc->tc_registered) {
+		/** the key releases the cached tasks when the thread exits */
+		pthread_once(&tse_task_cache_once, tse_task_cache_key_init);
+		if (!tse_task_cache_keyed ||
+		    pthread_setspecific(tse_task_cache_key, tc) != 0)
+			return false;
+		tc->tc_registered = true;
+	}
+
+	if (tc->tc_nr >= TSE_TASK_CACHE_MAX)
+		return false;
+
+	dtp->dtp_next = tc->tc_head;
+	tc->tc_head = dtp;
+	tc->tc_nr++;
+	return true;
+}
+
+static struct tse_task_private *
+tse_task_cache_get(void)
+{
+	struct tse_task_cache	*tc = &tse_task_cache;
+	struct tse_task_private	*dtp = tc->tc_head;
+
+	if (dtp != NULL) {
+		tc->tc_head = dtp->dtp_next;
+		tc->tc_nr--;
+	}
+	return dtp;
+}
+
+/* Push a scheduled task without dependency to the ready queue. */
+static void
+tse_sched_ready_push(struct tse_sched_private *dsp,
+		     struct tse_task_private *dtp)
+{
+	struct tse_task_private	*head;
+
+	D_ASSERT(d_list_empty(&dtp->dtp_list));
+	head = __atomic_load_n(&dsp->dsp_ready, __ATOMIC_RELAXED);
+	do {
+		dtp->dtp_next = head;
+	} while (!__atomic_compare_exchange_n(&dsp->dsp_ready, &head, dtp,
+					      true, __ATOMIC_RELEASE,
+					      __ATOMIC_RELAXED));
+}
+
+static inline bool
+tse_sched_ready_empty(struct tse_sched_private *dsp)
+{
+	return __atomic_load_n(&dsp->dsp_ready, __ATOMIC_RELAXED) == NULL;
+}
+
+/*
+ * Take all the ready tasks, in the order they were pushed. Tasks are never
+ * popped one by one, so the queue is not subject to ABA. Called with dsp_lock
+ * held, so that the caller accounts them as inflight before it is released.
+ */
+static struct tse_task_private *
+tse_sched_ready_take(struct tse_sched_private *dsp)
+{
+	struct tse_task_private	*head;
+	struct tse_task_private	*next;
+	struct tse_task_private	*prev = NULL;
+
+	if (tse_sched_ready_empty(dsp))
+		return NULL;
+
+	head = __atomic_exchange_n(&dsp->dsp_ready, NULL, __ATOMIC_ACQUIRE);
+	while (head != NULL) {
+		next = head->dtp_next;
+		head->dtp_next = prev;
+		prev = head;
+		head = next;
+	}
+	return prev;
+}
+
 int
 tse_sched_init(tse_sched_t *sched, tse_sched_comp_cb_t comp_cb,
 	       void *udata)
@@ -245,6 +372,10 @@ tse_task_decref(tse_task_t *task)
 
 	D_ASSERT(d_list_empty(&dtp->dtp_dep_list));
 
+	/** keep it for the next tse_task_create() of this thread */
+	if (tse_task_cache_put(dtp))
+		return;
+
 	/*
 	 * MSC - since we require user to allocate task, maybe we should have
 	 * user also free it. This now requires task to be on the heap all the
@@ -262,6 +393,7 @@ tse_sched_fini(tse_sched_t *sched)
 	D_ASSERT(d_list_empty(&dsp->dsp_init_list));
 	D_ASSERT(d_list_empty(&dsp->dsp_running_list));
 	D_ASSERT(d_list_empty(&dsp->dsp_complete_list));
+	D_ASSERT(tse_sched_ready_empty(dsp));
 	D_MUTEX_DESTROY(&dsp->dsp_lock);
 }
 
@@ -471,52 +603,97 @@ tse_task_complete_callback(tse_task_t *task)
 }
 
 /*
- * Process the task in the init list of the scheduler. This executes all the
- * body function of all tasks with no dependencies in the scheduler's init
- * list.
+ * Cancel the tasks that have not run yet, whether they are ready or still
+ * waiting for their dependencies.
  */
 static int
-tse_sched_process_init(struct tse_sched_private *dsp)
+tse_sched_cancel_init(struct tse_sched_private *dsp)
 {
 	struct tse_task_private		*dtp;
-	struct tse_task_private		*tmp;
-	d_list_t			list;
+	struct tse_task_private		*next;
 	int				processed = 0;
 
-	D_INIT_LIST_HEAD(&list);
 	D_MUTEX_LOCK(&dsp->dsp_lock);
-	d_list_for_each_entry_safe(dtp, tmp, &dsp->dsp_init_list,
-				      dtp_list) {
-		if (dtp->dtp_dep_cnt == 0 || dsp->dsp_cancelling) {
-			d_list_move_tail(&dtp->dtp_list, &list);
-			dsp->dsp_inflight++;
+	dtp = tse_sched_ready_take(dsp);
+	for (; dtp != NULL; dtp = next) {
+		next = dtp->dtp_next;
+		dtp->dtp_next = NULL;
+		d_list_add_tail(&dtp->dtp_list, &dsp->dsp_init_list);
+	}
+
+	while (!d_list_empty(&dsp->dsp_init_list)) {
+		dtp = d_list_entry(dsp->dsp_init_list.next,
+				   struct tse_task_private, dtp_list);
+		if (dtp->dtp_completed) {
+			d_list_del_init(&dtp->dtp_list);
+			continue;
 		}
+		dsp->dsp_inflight++;
+		/** complete it without running its body */
+		dtp->dtp_running = 1;
+		tse_task_complete_locked(dtp, dsp);
+		processed++;
 	}
 	D_MUTEX_UNLOCK(&dsp->dsp_lock);
 
-	while (!d_list_empty(&list)) {
-		tse_task_t *task;
-		bool bumped = false;
+	return processed;
+}
 
-		dtp = d_list_entry(list.next, struct tse_task_private,
-				   dtp_list);
+/*
+ * Run the body function of the tasks in the ready queue of the scheduler.
+ * The tasks are taken from the queue and moved to the running list all
+ * together under the lock, then executed. Taking them and accounting them in
+ * dsp_inflight at once keeps tse_sched_check_complete() from seeing an idle
+ * scheduler in between.
+ */
+static int
+tse_sched_process_init(struct tse_sched_private *dsp)
+{
+	struct tse_task_private		*dtp;
+	struct tse_task_private		*next;
+	struct tse_task_private		*run = NULL;
+	struct tse_task_private		**tail = &run;
+	int				processed = 0;
 
-		task = tse_priv2task(dtp);
+	if (dsp->dsp_cancelling)
+		return tse_sched_cancel_init(dsp);
+
+	if (tse_sched_ready_empty(dsp))
+		return 0;
+
+	D_MUTEX_LOCK(&dsp->dsp_lock);
+	dtp = tse_sched_ready_take(dsp);
+	for (; dtp != NULL; dtp = next) {
+		next = dtp->dtp_next;
+		dtp->dtp_next = NULL;
+
+		/** a dependency was registered after it was scheduled */
+		if (dtp->dtp_dep_cnt != 0) {
+			d_list_add_tail(&dtp->dtp_list, &dsp->dsp_init_list);
+			continue;
+		}
+
+		dsp->dsp_inflight++;
+		dtp->dtp_running = 1;
+		d_list_add_tail(&dtp->dtp_list, &dsp->dsp_running_list);
+		/** +1 in case prep cb calls task_complete() */
+		tse_task_addref_locked(dtp);
+		*tail = dtp;
+		tail = &dtp->dtp_next;
+	}
+	D_MUTEX_UNLOCK(&dsp->dsp_lock);
+
+	for (dtp = run; dtp != NULL; dtp = next) {
+		tse_task_t *task = tse_priv2task(dtp);
+
+		next = dtp->dtp_next;
+		dtp->dtp_next = NULL;
 
-		D_MUTEX_LOCK(&dsp->dsp_lock);
 		if (dsp->dsp_cancelling) {
+			D_MUTEX_LOCK(&dsp->dsp_lock);
 			tse_task_complete_locked(dtp, dsp);
+			D_MUTEX_UNLOCK(&dsp->dsp_lock);
 		} else {
-			dtp->dtp_running = 1;
-			d_list_move_tail(&dtp->dtp_list,
-					 &dsp->dsp_running_list);
-			/** +1 in case prep cb calls task_complete() */
-			tse_task_addref_locked(dtp);
-			bumped = true;
-		}
-		D_MUTEX_UNLOCK(&dsp->dsp_lock);
-
-		if (!dsp->dsp_cancelling) {
 			/** if task is reinitialized in prep cb, skip over it */
 			if (!tse_task_prep_callback(task)) {
 				tse_task_decref(task);
@@ -526,8 +703,7 @@ tse_sched_process_init(struct tse_sched_private *dsp)
 			if (!dtp->dtp_completed)
 				dtp->dtp_func(task);
 		}
-		if (bumped)
-			tse_task_decref(task);
+		tse_task_decref(task);
 
 		processed++;
 	}
@@ -576,7 +752,13 @@ tse_task_post_process(tse_task_t *task)
 		D_DEBUG(DB_TRACE, "daos task %p dep_cnt %d\n", dtp_tmp,
 			dtp_tmp->dtp_dep_cnt);
 		if (!dsp->dsp_cancelling && dtp_tmp->dtp_dep_cnt == 0 &&
-		    dtp_tmp->dtp_running) {
+		    !dtp_tmp->dtp_running && !dtp_tmp->dtp_completed &&
+		    !d_list_empty(&dtp_tmp->dtp_list)) {
+			/* it was waiting on the init list, now it can run */
+			d_list_del_init(&dtp_tmp->dtp_list);
+			tse_sched_ready_push(dsp, dtp_tmp);
+		} else if (!dsp->dsp_cancelling &&
+			   dtp_tmp->dtp_dep_cnt == 0 && dtp_tmp->dtp_running) {
 			bool done;
 
 			/*
@@ -656,7 +838,7 @@ tse_sched_check_complete(tse_sched_t *sched)
 	/* check if all tasks are done */
 	D_MUTEX_LOCK(&dsp->dsp_lock);
 	completed = (d_list_empty(&dsp->dsp_init_list) &&
-		     dsp->dsp_inflight == 0);
+		     tse_sched_ready_empty(dsp) && dsp->dsp_inflight == 0);
 	D_MUTEX_UNLOCK(&dsp->dsp_lock);
 
 	return completed;
@@ -880,9 +1062,15 @@ tse_task_create(tse_task_func_t task_func, tse_sched_t *sched, void *priv,
 	struct tse_task_private	 *dtp;
 	tse_task_t		 *task;
 
-	D_ALLOC_PTR(task);
-	if (task == NULL)
-		return -DER_NOMEM;
+	dtp = tse_task_cache_get();
+	if (dtp != NULL) {
+		task = tse_priv2task(dtp);
+		memset(task, 0, sizeof(*task));
+	} else {
+		D_ALLOC_PTR(task);
+		if (task == NULL)
+			return -DER_NOMEM;
+	}
 
 	dtp = tse_task2priv(task);
 	D_CASSERT(sizeof(task->dt_private) >= sizeof(*dtp));
@@ -922,8 +1110,11 @@ tse_task_schedule(tse_task_t *task, bool instant)
 		/** +1 in case task is completed in body function */
 		if (instant)
 			tse_task_addref_locked(dtp);
+	} else if (dtp->dtp_dep_cnt == 0) {
+		/** Otherwise, scheduler will run it from the ready queue */
+		tse_sched_ready_push(dsp, dtp);
 	} else {
-		/** Otherwise, scheduler will process it from init list */
+		/** or once its dependencies are completed */
 		d_list_add_tail(&dtp->dtp_list, &dsp->dsp_init_list);
 	}
 	tse_sched_addref_locked(dsp);
@@ -984,8 +1175,12 @@ tse_task_reinit(tse_task_t *task)
 	dtp->dtp_running = 0;
 	dtp->dtp_completing = 0;
 	dtp->dtp_completed = 0;
-	/** Move back to init list */
-	d_list_move_tail(&dtp->dtp_list, &dsp->dsp_init_list);
+	/** Move back to the ready queue or to the init list */
+	d_list_del_init(&dtp->dtp_list);
+	if (dtp->dtp_dep_cnt == 0)
+		tse_sched_ready_push(dsp, dtp);
+	else
+		d_list_add_tail(&dtp->dtp_list, &dsp->dsp_init_list);
 
 	D_MUTEX_UNLOCK(&dsp->dsp_lock);
 
@@ -39,6 +39,9 @@
 struct tse_task_private {
 	struct tse_sched_private	*dtp_sched;
 
+	/* next task in the ready queue, or in the task cache of a thread */
+	struct tse_task_private		*dtp_next;
+
 	/* function for the task */
 	tse_task_func_t			 dtp_func;
 
@@ -106,7 +109,7 @@ struct tse_sched_private {
 	pthread_mutex_t dsp_lock;
 
 	/* The task will be added to init list when it is initially
-	 * added to scheduler.
+	 * added to scheduler with dependencies, until they are completed.
 	 **/
 	d_list_t	dsp_init_list;
 
@@ -123,6 +126,14 @@ struct tse_sched_private {
 	/* the list for complete callback */
 	d_list_t	dsp_comp_cb_list;
 
+	/**
+	 * Tasks without dependencies to run. They are pushed when they are
+	 * scheduled or when their last dependency completes, and all taken at
+	 * once by tse_sched_process_init(), both under dsp_lock. It can be
+	 * checked for emptiness without the lock.
+	 **/
+	struct tse_task_private	*dsp_ready;
+
 	int		dsp_refcount;
 
 	/* number of tasks being executed */
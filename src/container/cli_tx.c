@@ -181,6 +181,29 @@ dc_tx_check(daos_handle_t th, bool check_write, daos_epoch_t *epoch)
 	return 0;
 }
 
+/**
+ * Return the epoch of the read-only transaction @th. Nothing can change at
+ * that epoch, so what is read through it can be cached by the caller.
+ */
+int
+dc_tx_rdonly_epoch(daos_handle_t th, daos_epoch_t *epoch)
+{
+	struct dc_tx	*tx;
+	int		rc = 0;
+
+	tx = tx_hdl2ptr(th);
+	if (tx == NULL)
+		return -DER_NO_HDL;
+
+	if (tx->tx_mode != TX_RDONLY || tx->tx_status == TX_FAILED)
+		rc = -DER_NO_PERM;
+	else
+		*epoch = tx->tx_epoch;
+
+	tx_decref(tx);
+	return rc;
+}
+
 int
 daos_tx_hdl2epoch(daos_handle_t th, daos_epoch_t *epoch)
 {
@@ -197,34 +197,6 @@ check:
 	}
 }
 
-/**
- * Init local dth handle.
- */
-static void
-dtx_handle_init(struct dtx_id *dti, daos_unit_oid_t *oid, daos_handle_t coh,
-		daos_epoch_t epoch, uint64_t dkey_hash, uint32_t pm_ver,
-		uint32_t intent, struct dtx_conflict_entry *conflict,
-		struct dtx_id *dti_cos, int dti_cos_count, bool leader,
-		bool no_rep, struct dtx_handle *dth)
-{
-	dth->dth_xid = *dti;
-	dth->dth_oid = *oid;
-	dth->dth_coh = coh;
-	dth->dth_epoch = epoch;
-	D_INIT_LIST_HEAD(&dth->dth_shares);
-	dth->dth_dkey_hash = dkey_hash;
-	dth->dth_ver = pm_ver;
-	dth->dth_intent = intent;
-	dth->dth_leader = leader ? 1 : 0;
-	dth->dth_non_rep = no_rep ? 1 : 0;
-	dth->dth_dti_cos = dti_cos;
-	dth->dth_dti_cos_count = dti_cos_count;
-	dth->dth_conflict = conflict;
-	dth->dth_ent = UMOFF_NULL;
-	dth->dth_obj = UMOFF_NULL;
-	dth->dth_sync = 0;
-}
-
 static inline void
 dtx_clean_shares(struct dtx_handle *dth)
 {
@@ -235,6 +207,66 @@ dtx_clean_shares(struct dtx_handle *dth)
 		D_FREE(dts);
 }
 
+/**
+ * Append the committable DTXs against the same object shard to the CoS list,
+ * then they will be piggybacked on the modification RPC to the non-leaders
+ * and committed together with current modification on all the replicas via
+ * the IO PMDK transaction. That saves the dedicated DTX_COMMIT RPCs by the
+ * DTX batched commit ULT that only handles the left ones when IO is idle.
+ */
+static int
+dtx_piggyback_committable(daos_handle_t coh, daos_unit_oid_t *oid,
+			  daos_epoch_t epoch, struct dtx_id **dti_cos,
+			  int *dti_cos_count)
+{
+	struct dtx_entry	*dtes = NULL;
+	struct dtx_id		*dtis;
+	int			 count = *dti_cos_count;
+	int			 max;
+	int			 rc;
+	int			 i;
+	int			 j;
+
+	if (count >= DTX_PIGGYBACK_MAX_COUNT)
+		return 0;
+
+	max = DTX_PIGGYBACK_MAX_COUNT - count;
+	rc = vos_dtx_fetch_committable(coh, max, oid, epoch, &dtes);
+	if (rc <= 0)
+		return rc;
+
+	D_ALLOC_ARRAY(dtis, count + rc);
+	if (dtis == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	if (*dti_cos != NULL)
+		memcpy(dtis, *dti_cos, sizeof(*dtis) * count);
+
+	for (i = 0; i < rc; i++) {
+		/* Skip the ones that have been listed for CoS conflict. */
+		for (j = 0; j < *dti_cos_count; j++) {
+			if (daos_dti_equal(&dtes[i].dte_xid, &dtis[j]))
+				break;
+		}
+
+		if (j == *dti_cos_count)
+			dtis[count++] = dtes[i].dte_xid;
+	}
+
+	D_DEBUG(DB_TRACE, "Piggyback %d committable DTXs for "DF_UOID"\n",
+		count - *dti_cos_count, DP_UOID(*oid));
+
+	if (*dti_cos != NULL)
+		D_FREE(*dti_cos);
+	*dti_cos = dtis;
+	*dti_cos_count = count;
+	rc = 0;
+
+out:
+	D_FREE(dtes);
+	return rc;
+}
+
 /**
  * Prepare the leader DTX handle in DRAM.
  *
@@ -316,6 +348,11 @@ dtx_leader_begin(struct dtx_id *dti, daos_unit_oid_t *oid, daos_handle_t coh,
 		return -DER_INPROGRESS;
 	}
 
+	/* Piggyback committable DTXs is an optimization, it is not fatal
+	 * if failed, they will be committed by the batched commit ULT.
+	 */
+	dtx_piggyback_committable(coh, oid, epoch, &dti_cos, &dti_cos_count);
+
 init:
 	dtx_handle_init(dti, oid, coh, epoch, dkey_hash, pm_ver, intent,
 			NULL, dti_cos, dti_cos_count, true,
@@ -54,6 +54,7 @@ int dc_cont_local_open(uuid_t cont_uuid, uuid_t cont_hdl_uuid,
 int dc_cont_local_close(daos_handle_t ph, daos_handle_t coh);
 
 int dc_tx_check(daos_handle_t th, bool check_write, daos_epoch_t *epoch);
+int dc_tx_rdonly_epoch(daos_handle_t th, daos_epoch_t *epoch);
 
 int dc_cont_create(tse_task_t *task);
 int dc_cont_open(tse_task_t *task);
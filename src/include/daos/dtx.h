@@ -37,6 +37,12 @@
 /* The time (in second) threshould for batched DTX commit. */
 #define DTX_COMMIT_THRESHOLD_AGE	60
 
+/* The max count of committable DTXs (against the same object shard) that
+ * the leader piggybacks on the subsequent modification RPC, then the non-
+ * leader replicas can commit them without dedicated DTX_COMMIT RPC.
+ */
+#define DTX_PIGGYBACK_MAX_COUNT		(1 << 6)
+
 /**
  * DAOS two-phase commit transaction identifier,
  * generated by client, globally unique.
@@ -353,10 +353,17 @@ int dc_obj_sync(tse_task_t *task);
 int dc_obj_fetch_shard(tse_task_t *task);
 int dc_obj_fetch(tse_task_t *task);
 int dc_obj_update(tse_task_t *task);
+int dc_obj_fetch_multi(tse_task_t *task);
+int dc_obj_update_multi(tse_task_t *task);
 int dc_obj_list_dkey(tse_task_t *task);
 int dc_obj_list_akey(tse_task_t *task);
 int dc_obj_list_rec(tse_task_t *task);
 int dc_obj_list_obj(tse_task_t *task);
+int dc_obj_enum_open(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
+		     uint32_t flags, daos_handle_t *eh);
+int dc_obj_enum_next(daos_handle_t eh, uint32_t *nr, daos_key_desc_t *kds,
+		     d_sg_list_t *sgl);
+int dc_obj_enum_close(daos_handle_t eh);
 int dc_obj_fetch_md(daos_obj_id_t oid, struct daos_obj_md *md);
 int dc_obj_layout_get(daos_handle_t oh, struct daos_obj_layout **p_layout);
 int dc_obj_layout_refresh(daos_handle_t oh);
@@ -400,6 +407,17 @@ enum {
 	OBJ_ITER_AKEY_EPOCH,
 };
 
+/**
+ * Filter of the dkeys of an enumeration, applied by the servers while they
+ * pack the keys. The bounds are the oei_key_lo and oei_key_hi keys of the RPC.
+ */
+enum {
+	/** only the dkeys starting with the low key */
+	OBJ_ENUM_KEY_PREFIX	= (1 << 0),
+	/** only the dkeys in [low, high), an empty high key is no bound */
+	OBJ_ENUM_KEY_RANGE	= (1 << 1),
+};
+
 #define RECX_INLINE	(1U << 0)
 
 struct obj_enum_rec {
@@ -61,6 +61,16 @@ struct dc_pool {
 				dp_slave:1; /* generated via g2l */
 	/* required/allocated pool map size */
 	size_t			dp_map_sz;
+	/* inline/bulk transfer mode, DAOS_PROP_PO_IO_BULK */
+	uint32_t		dp_io_bulk;
+	/*
+	 * Pool map encoded by pool_buf_encode() for local2global, reused
+	 * until the map version changes. Protected by dp_map_lock.
+	 */
+	void		       *dp_map_enc;
+	size_t			dp_map_enc_len;
+	uint32_t		dp_map_enc_ver;
+	uint32_t		dp_map_enc_nr;
 };
 
 struct dc_pool *dc_hdl2pool(daos_handle_t hdl);
@@ -174,6 +174,9 @@ void pool_buf_free(struct pool_buf *buf);
 int  pool_buf_extract(struct pool_map *map, struct pool_buf **buf_pp);
 int  pool_buf_attach(struct pool_buf *buf, struct pool_component *comps,
 		     unsigned int comp_nr);
+size_t pool_buf_encode(struct pool_buf *buf, void *out);
+int  pool_buf_decode(const void *in, size_t len, unsigned int nr,
+		     struct pool_buf **buf_pp);
 
 int pool_map_comp_cnt(struct pool_map *map);
 
@@ -97,6 +97,16 @@ dc_obj_update_task_create(daos_handle_t oh, daos_handle_t th,
 			  daos_iod_t *iods, d_sg_list_t *sgls,
 			  daos_event_t *ev, tse_sched_t *tse,
 			  tse_task_t **task);
+int
+dc_obj_fetch_multi_task_create(daos_handle_t oh, daos_handle_t th,
+			       unsigned int nr, daos_dkey_io_t *ios,
+			       daos_event_t *ev, tse_sched_t *tse,
+			       tse_task_t **task);
+int
+dc_obj_update_multi_task_create(daos_handle_t oh, daos_handle_t th,
+				unsigned int nr, daos_dkey_io_t *ios,
+				daos_event_t *ev, tse_sched_t *tse,
+				tse_task_t **task);
 
 int
 dc_obj_list_dkey_task_create(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
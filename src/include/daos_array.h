@@ -52,6 +52,17 @@ typedef struct {
 	daos_range_t	       *arr_rgs;
 } daos_array_iod_t;
 
+/** Max number of dimensions of a strided access pattern */
+#define DAOS_ARRAY_STRIDE_MAX	8
+
+/** One dimension of a strided access pattern */
+typedef struct {
+	/** Number of repetitions in this dimension */
+	daos_size_t		as_count;
+	/** Distance in records between two consecutive repetitions */
+	daos_size_t		as_stride;
+} daos_array_stride_t;
+
 /**
  * Convenience function to generate a DAOS object ID by encoding the private
  * DAOS bits of the object address space.
@@ -339,9 +350,74 @@ daos_array_write(daos_handle_t oh, daos_handle_t th,
 		 daos_array_iod_t *iod, d_sg_list_t *sgl,
 		 daos_csum_buf_t *csums, daos_event_t *ev);
 
+/**
+ * Read data from an array object with a strided access pattern. The ranges of
+ * \a iod are accessed at every position of a (nested) strided pattern, so a
+ * hyperslab is described by one range per contiguous block of its fastest
+ * varying dimension and one stride per other dimension, instead of one range
+ * per block. The pattern is expanded one chunk at a time while the I/O is
+ * issued.
+ *
+ * For instance, a 2D slab of R rows and C columns starting at row r and
+ * column c of a row-major array of M columns is the range {r * M + c, C}
+ * repeated with the stride {R, M}. At each position of the pattern, the
+ * ranges are accessed in order and the data is laid out in the sgl in that
+ * order, with the first stride varying the fastest.
+ *
+ * \param[in]	oh	Array object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	iod	IO descriptor of the ranges at the origin of the
+ *			pattern.
+ * \param[in]	stride_nr
+ *			Number of dimensions of the pattern, at most
+ *			DAOS_ARRAY_STRIDE_MAX.
+ * \param[in]	strides	Dimensions of the pattern, fastest varying first.
+ * \param[in]	sgl	A scatter/gather list (sgl) to the store array data.
+ *			Its total size must be the size of all the ranges
+ *			times the number of positions of the pattern.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_array_read().
+ */
+int
+daos_array_read_strided(daos_handle_t oh, daos_handle_t th,
+			daos_array_iod_t *iod, unsigned int stride_nr,
+			daos_array_stride_t *strides, d_sg_list_t *sgl,
+			daos_event_t *ev);
+
+/**
+ * Write data to an array object with a strided access pattern, see
+ * daos_array_read_strided().
+ *
+ * \param[in]	oh	Array object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	iod	IO descriptor of the ranges at the origin of the
+ *			pattern.
+ * \param[in]	stride_nr
+ *			Number of dimensions of the pattern, at most
+ *			DAOS_ARRAY_STRIDE_MAX.
+ * \param[in]	strides	Dimensions of the pattern, fastest varying first.
+ * \param[in]	sgl	A scatter/gather list (sgl) to the store array data.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_array_write().
+ */
+int
+daos_array_write_strided(daos_handle_t oh, daos_handle_t th,
+			 daos_array_iod_t *iod, unsigned int stride_nr,
+			 daos_array_stride_t *strides, d_sg_list_t *sgl,
+			 daos_event_t *ev);
+
 /**
  * Query the number of records in the array object.
  *
+ * The size is cached by handles opened with DAOS_OO_EXCL, which are kept up to
+ * date by the writes, punches and set_size done through the same handle, so
+ * no other handle must modify the array while it is open. The size at the
+ * epoch of a read-only transaction (e.g. a snapshot) is cached as well.
+ *
  * \param[in]	oh	Array object open handle.
  * \param[in]	th	Transaction handle.
  * \param[out]	size	Returned array size (number of records).
@@ -69,6 +69,23 @@ extern "C" {
 int
 daos_eq_create(daos_handle_t *eqh);
 
+/**
+ * Create an Event Queue that can be polled concurrently by several threads.
+ * The EQ is split into \a nshards shards, each with its own lock, scheduler
+ * and completion list, all sharing the network context of the other EQs.
+ * Events are spread over the shards when they are initialized, and each call
+ * to daos_eq_poll() harvests the completions of the shards in batches, taking
+ * the lock of each shard once per batch.
+ *
+ * \param eqh [OUT]	Returned EQ handle
+ * \param nshards [IN]	Number of shards, between 1 and 64. One shard is the
+ *			same as daos_eq_create().
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+daos_eq_create_mt(daos_handle_t *eqh, unsigned int nshards);
+
 #define DAOS_EQ_DESTROY_FORCE	1
 /**
  * Destroy an Event Queue, it waits on -EBUSY if EQ is not empty.
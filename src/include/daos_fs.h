@@ -247,6 +247,12 @@ dfs_read(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
 /**
  * Write data to the file object.
  *
+ * If the DFS_WRITE_BACK environment variable is set, small contiguous writes
+ * are buffered per file handle and written asynchronously. The buffered data
+ * is visible to the reads and queries of this process, and is written at the
+ * latest by dfs_sync() or dfs_release(). The error of a failed asynchronous
+ * write is returned by the next call on the file.
+ *
  * \param[in]	dfs	Pointer to the mounted file system.
  * \param[in]	obj	Opened file object.
  * \param[in]	sgl	Scatter/Gather list for data buffer.
@@ -340,6 +346,47 @@ int
 dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
 	    uint32_t *nr, size_t size, dfs_filler_cb_t op, void *udata);
 
+/**
+ * User callback defined for dfs_readdirplus. \a obj is the entry opened
+ * read-only, it is owned by the callback and must be released with
+ * dfs_release().
+ */
+typedef int (*dfs_filler_plus_cb_t)(dfs_t *dfs, dfs_obj_t *dir,
+				    const char name[], dfs_obj_t *obj,
+				    struct stat *stbuf, void *udata);
+
+/**
+ * Same as dfs_iterate, but the entries are reported with their attributes
+ * and opened. The attributes of the listed entries are fetched concurrently,
+ * only the size of the regular files is queried separately, which saves a
+ * round trip per entry compared to dfs_iterate + dfs_lookup_rel.
+ *
+ * If \a op fails, the enumeration stops and its error is returned. \a anchor
+ * is then left at the failed entry, so that the next call starts with it,
+ * e.g. after \a op has returned E2BIG because its buffer is full.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Opened directory object.
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, it should be set to
+ *			zeroes for the first call, it should not be changed
+ *			by caller between calls. It is the same as the anchor
+ *			of dfs_readdir and dfs_iterate.
+ * \param[in,out]
+ *		nr	[in]: MAX number of entries to list.
+ *			[out]: Actual number of entries reported, 0 on success
+ *			only if the end of the directory is reached.
+ * \param[in]	size	Max size of the entry names listed in one batch.
+ * \param[in]	op	Callback to be issued on every entry.
+ * \param[in]	udata	Pointer to user data to be passed to \a op.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_readdirplus(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
+		uint32_t *nr, size_t size, dfs_filler_plus_cb_t op,
+		void *udata);
+
 /**
  * Create a directory.
  *
@@ -418,7 +465,8 @@ dfs_get_mode(dfs_obj_t *obj, mode_t *mode);
  * Retrieve the DAOS open handle of a DFS file object. User should not close
  * this handle. This is used in cases like MPI-IO where 1 rank creates the file
  * with dfs, but wants to access the file with the array API directly rather
- * than the DFS API.
+ * than the DFS API. A file whose data is inlined in its directory entry is
+ * moved to its array object first.
  *
  * \param[in]	obj	Open object.
  * \param[out]	oh	DAOS object open handle.
@@ -567,7 +615,8 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode);
 
 /**
  * Sync to commit the latest epoch on the container. This applies to the entire
- * namespace and not to a particular file/directory.
+ * namespace and not to a particular file/directory. The buffered data of all
+ * the open files is written first.
  *
  * TODO: This should take a persistent snapshot at current timestamp.
  *
@@ -36,6 +36,25 @@
 extern "C" {
 #endif
 
+/** Only scan the keys that start with daos_kv_filter_t::ksf_lo */
+#define DAOS_KV_SCAN_PREFIX	(1U << 0)
+/** Only scan the keys in [ksf_lo, ksf_hi), in byte order */
+#define DAOS_KV_SCAN_RANGE	(1U << 1)
+/** Return the value of each key after the key */
+#define DAOS_KV_SCAN_VALUES	(1U << 2)
+/** Largest value returned inline by a scan with DAOS_KV_SCAN_VALUES */
+#define DAOS_KV_SCAN_INLINE_MAX	2048
+
+/** Filter of the keys returned by daos_kv_scan() */
+typedef struct {
+	/** DAOS_KV_SCAN_* flags */
+	uint32_t		ksf_flags;
+	/** Key prefix, or inclusive lower bound of the range */
+	d_iov_t			ksf_lo;
+	/** Exclusive upper bound of the range, no bound if empty */
+	d_iov_t			ksf_hi;
+} daos_kv_filter_t;
+
 /**
  * Insert or update a single object KV pair. The key specified will be mapped to
  * a dkey in DAOS. The object akey will be the same as the dkey. If a value
@@ -146,6 +165,97 @@ daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 	     daos_key_desc_t *kds, d_sg_list_t *sgl, daos_anchor_t *anchor,
 	     daos_event_t *ev);
 
+/**
+ * Scan the keys of an object that match a filter. The keys are filtered by
+ * the servers while they are enumerated, so only the matching keys are
+ * transferred. Like daos_kv_list(), the scan is resumed with the anchor until
+ * it reaches the end. A batch can be empty if no key matches in the part of
+ * the object that was scanned, and a large \a sgl and \a nr let the servers
+ * return large batches in bulk.
+ *
+ * With DAOS_KV_SCAN_VALUES, the values of the keys of a batch are fetched
+ * after the keys with one multi-key fetch, and their sizes are only fetched
+ * apart when a value is too large to be returned. Each key descriptor is
+ * followed by a value descriptor, and each key in \a sgl is followed by its
+ * value. The size of the value is in kd_key_len. Values larger than
+ * DAOS_KV_SCAN_INLINE_MAX, or that do not fit in \a sgl after the keys of the
+ * batch, are not returned: their descriptor has kd_val_type DAOS_IOD_NONE
+ * instead of DAOS_IOD_SINGLE and they can be fetched with daos_kv_get().
+ * Keys removed between the listing and the fetch are not returned.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	filter	Keys to return, see daos_kv_filter_t.
+ * \param[in,out]
+ *		nr	[in]: number of key descriptors in \a kds, at least 2
+ *			with DAOS_KV_SCAN_VALUES. [out]: number of returned key
+ *			(and value) descriptors.
+ * \param[in,out]
+ *		kds	[in]: preallocated array of \nr key descriptors. [out]:
+ *			size of each individual key (and value).
+ * \param[in]	sgl	Scatter/gather list to store the keys (and values).
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, it should be set to
+ *			zeroes for the first call, it should not be changed
+ *			by caller between calls.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_kv_list(), and -DER_INVAL for an invalid
+ *			filter.
+ */
+int
+daos_kv_scan(daos_handle_t oh, daos_handle_t th, daos_kv_filter_t *filter,
+	     uint32_t *nr, daos_key_desc_t *kds, d_sg_list_t *sgl,
+	     daos_anchor_t *anchor, daos_event_t *ev);
+
+/**
+ * Insert or update several KV pairs at once, each one as by daos_kv_put().
+ * The keys are grouped by the redundancy group of the object they belong to,
+ * and the keys of each group are updated by the same RPCs, see
+ * daos_obj_update_multi(), so that a large batch of small values costs much
+ * less than the same number of daos_kv_put() calls.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	nr	Number of keys.
+ * \param[in]	keys	Array of \a nr keys.
+ * \param[in]	sizes	Array of the \a nr value sizes.
+ * \param[in]	bufs	Array of the \a nr value buffers.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_kv_put(), the first error of the batch.
+ */
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		  const char **keys, const daos_size_t *sizes, void **bufs,
+		  daos_event_t *ev);
+
+/**
+ * Fetch the values of several keys at once, each one as by daos_kv_get().
+ * The fetches are batched the same way as by daos_kv_put_multi().
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	nr	Number of keys.
+ * \param[in]	keys	Array of \a nr keys.
+ * \param[in,out]
+ *		sizes	[in]: Array of the \a nr buffer sizes, an entry can be
+ *			DAOS_REC_ANY if the size is unknown. [out]: The actual
+ *			size of each value, 0 if the key does not exist.
+ * \param[in]	bufs	Array of the \a nr user buffers. If NULL, or for its
+ *			NULL entries, only the size is returned.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_kv_get(), the first error of the batch.
+ */
+int
+daos_kv_get_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		  const char **keys, daos_size_t *sizes, void **bufs,
+		  daos_event_t *ev);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -253,6 +253,21 @@ typedef struct {
 	daos_recx_t		*iom_recxs;
 } daos_iom_t;
 
+/**
+ * The I/O against one dkey of a multi-dkey update or fetch, see
+ * daos_obj_update_multi() and daos_obj_fetch_multi().
+ */
+typedef struct {
+	/** distribution key */
+	daos_key_t		*dio_dkey;
+	/** number of descriptors and sgls in \a dio_iods and \a dio_sgls */
+	unsigned int		 dio_nr;
+	/** I/O descriptors against the dkey */
+	daos_iod_t		*dio_iods;
+	/** sgls of the data, one per I/O descriptor */
+	d_sg_list_t		*dio_sgls;
+} daos_dkey_io_t;
+
 /** record status */
 enum {
 	/** Any record size, it is used by fetch */
@@ -536,6 +551,31 @@ daos_obj_fetch(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
 	       unsigned int nr, daos_iod_t *iods, d_sg_list_t *sgls,
 	       daos_iom_t *maps, daos_event_t *ev);
 
+/**
+ * Fetch several dkeys of an object, the dkeys stored on the same targets are
+ * fetched by a single RPC. Each element of \a ios is the same as the
+ * arguments of daos_obj_fetch(), the record sizes and the returned data
+ * lengths are set in the iods and sgls of each dkey I/O.
+ *
+ * \param[in]	oh	Object open handle.
+ *
+ * \param[in]	th	Optional transaction handle to fetch with.
+ *			Use DAOS_TX_NONE for an independent transaction.
+ *
+ * \param[in]	nr	Number of dkey I/Os in \a ios.
+ *
+ * \param[in,out]
+ *		ios	Array of dkey I/Os.
+ *
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_obj_fetch().
+ */
+int
+daos_obj_fetch_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		     daos_dkey_io_t *ios, daos_event_t *ev);
+
 /**
  * Insert or update object records stored in co-located arrays.
  *
@@ -590,6 +630,33 @@ daos_obj_update(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
 		unsigned int nr, daos_iod_t *iods, d_sg_list_t *sgls,
 		daos_event_t *ev);
 
+/**
+ * Update several dkeys of an object. The dkeys that are stored on the same
+ * targets are sent in a single RPC and applied by the server in a single
+ * local transaction, so updating many small dkeys costs one RPC per
+ * redundancy group (up to 128 dkeys per RPC) instead of one RPC per dkey.
+ * Each element of \a ios is the same as the arguments of daos_obj_update().
+ * The same dkey should not appear twice in \a ios.
+ *
+ * \param[in]	oh	Object open handle.
+ *
+ * \param[in]	th	Optional transaction handle to update with.
+ *			Use DAOS_TX_NONE for an independent transaction.
+ *
+ * \param[in]	nr	Number of dkey I/Os in \a ios.
+ *
+ * \param[in]	ios	Array of dkey I/Os.
+ *
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		Same as daos_obj_update(). If it fails, some of the
+ *			dkeys may have been updated.
+ */
+int
+daos_obj_update_multi(daos_handle_t oh, daos_handle_t th, unsigned int nr,
+		      daos_dkey_io_t *ios, daos_event_t *ev);
+
 /**
  * Distribution key enumeration.
  *
@@ -747,6 +814,81 @@ daos_obj_list_recx(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
 		   daos_anchor_t *anchor, bool incr_order,
 		   daos_event_t *ev);
 
+/** Flags of daos_obj_enum_open() */
+enum {
+	/** enumerate the dkeys of several redundancy groups in parallel */
+	DAOS_OBJ_ENUM_PARALLEL	= (1 << 0),
+};
+
+/**
+ * Open a stream of the dkeys of an object, or of the akeys of a dkey. Unlike
+ * daos_obj_list_dkey() and daos_obj_list_akey(), the stream keeps the next
+ * batch of keys in flight while the current one is consumed, and adapts the
+ * number of keys per request to the response time. The stream is not
+ * thread-safe.
+ *
+ * \param[in]	oh	Object open handle.
+ *
+ * \param[in]	th	Optional transaction handle to enumerate with.
+ *			Use DAOS_TX_NONE for an independent transaction.
+ *
+ * \param[in]	dkey	The dkey to enumerate the akeys of, NULL to enumerate
+ *			the dkeys of the object.
+ *
+ * \param[in]	flags	With DAOS_OBJ_ENUM_PARALLEL, the dkeys of several
+ *			redundancy groups are enumerated at the same time, and
+ *			returned in no particular order.
+ *
+ * \param[out]	eh	Returned stream handle.
+ *
+ * \return		0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NOMEM	Out of memory
+ */
+int
+daos_obj_enum_open(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
+		   uint32_t flags, daos_handle_t *eh);
+
+/**
+ * Get the next keys of a stream, it waits only if no key has been received
+ * yet. The keys are packed in the iovs of \a sgl like daos_obj_list_dkey()
+ * does, a key is never split between two iovs. When a request fails, the keys
+ * received before are returned first, and the error by the next call.
+ *
+ * \param[in]	eh	Stream handle.
+ *
+ * \param[in,out]
+ *		nr	[in]: number of key descriptors in \a kds.
+ *			[out]: number of returned keys, 0 at the end of the
+ *			stream.
+ *
+ * \param[out]	kds	Key descriptors.
+ *
+ * \param[out]	sgl	Buffers of the keys.
+ *
+ * \return		0		Success
+ *			-DER_NO_HDL	Invalid stream handle
+ *			-DER_KEY2BIG	The next key does not fit in \a sgl,
+ *					its size is returned in kds[0]
+ *			-DER_INVAL	Invalid parameter
+ *			Any error of daos_obj_list_dkey()
+ */
+int
+daos_obj_enum_next(daos_handle_t eh, uint32_t *nr, daos_key_desc_t *kds,
+		   d_sg_list_t *sgl);
+
+/**
+ * Close a stream, the requests in flight are waited for.
+ *
+ * \param[in]	eh	Stream handle.
+ *
+ * \return		0		Success
+ *			-DER_NO_HDL	Invalid stream handle
+ */
+int
+daos_obj_enum_close(daos_handle_t eh);
+
 /**
  * Retrieve the largest or smallest integer DKEY, AKEY, and array offset from an
  * object. If object does not have an array value, 0 is returned in extent. User
@@ -79,6 +79,13 @@ enum daos_pool_props {
 	 * Format: group@[domain]
 	 */
 	DAOS_PROP_PO_OWNER_GROUP,
+	/**
+	 * How the client chooses between inline and bulk transfer for the
+	 * object I/O payload = fixed|adaptive. default = fixed
+	 * fixed threshold
+	 * adaptive per target, based on the measured latency of both paths
+	 */
+	DAOS_PROP_PO_IO_BULK,
 	DAOS_PROP_PO_MAX,
 };
 
@@ -94,6 +101,12 @@ enum {
 	DAOS_RECLAIM_TIME,
 };
 
+/** DAOS object I/O payload transfer mode */
+enum {
+	DAOS_IO_BULK_FIXED,
+	DAOS_IO_BULK_ADAPTIVE,
+};
+
 /** self headling strategy bits */
 #define DAOS_SELF_HEAL_AUTO_EXCLUDE	(1U << 0)
 #define DAOS_SELF_HEAL_AUTO_REBUILD	(1U << 1)
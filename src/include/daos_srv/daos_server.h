@@ -556,6 +556,10 @@ struct dss_enum_arg {
 	int			rnum;		/* records num (type == S||R) */
 	daos_size_t		rsize;		/* record size (type == S||R) */
 	daos_unit_oid_t		oid;		/* for unpack */
+	/* OBJ_ENUM_KEY_* filter of the keys (type == D) */
+	uint32_t		key_flags;
+	daos_key_t		key_lo;
+	daos_key_t		key_hi;
 };
 
 int
@@ -74,7 +74,13 @@ struct dtx_handle {
 					 dth_leader:1, /* leader replica. */
 					 dth_non_rep:1, /* non-replicated. */
 					 /* dti_cos has been committed. */
-					 dth_dti_cos_done:1;
+					 dth_dti_cos_done:1,
+					 /* Single replica, the modification is
+					  * committed directly without DTX
+					  * records, only the DTX ID is kept
+					  * for resend detection.
+					  */
+					 dth_solo:1;
 	/* The count the DTXs in the dth_dti_cos array. */
 	uint32_t			 dth_dti_cos_count;
 	/* The array of the DTXs for Commit on Share (conflcit). */
@@ -142,6 +148,36 @@ enum dtx_status {
 	DTX_ST_COMMITTED	= 2,
 };
 
+/**
+ * Init local dth handle.
+ */
+static inline void
+dtx_handle_init(struct dtx_id *dti, daos_unit_oid_t *oid, daos_handle_t coh,
+		daos_epoch_t epoch, uint64_t dkey_hash, uint32_t pm_ver,
+		uint32_t intent, struct dtx_conflict_entry *conflict,
+		struct dtx_id *dti_cos, int dti_cos_count, bool leader,
+		bool no_rep, struct dtx_handle *dth)
+{
+	dth->dth_xid = *dti;
+	dth->dth_oid = *oid;
+	dth->dth_coh = coh;
+	dth->dth_epoch = epoch;
+	D_INIT_LIST_HEAD(&dth->dth_shares);
+	dth->dth_dkey_hash = dkey_hash;
+	dth->dth_ver = pm_ver;
+	dth->dth_intent = intent;
+	dth->dth_leader = leader ? 1 : 0;
+	dth->dth_non_rep = no_rep ? 1 : 0;
+	dth->dth_dti_cos = dti_cos;
+	dth->dth_dti_cos_count = dti_cos_count;
+	dth->dth_conflict = conflict;
+	dth->dth_ent = UMOFF_NULL;
+	dth->dth_obj = UMOFF_NULL;
+	dth->dth_sync = 0;
+	dth->dth_dti_cos_done = 0;
+	dth->dth_solo = 0;
+}
+
 int
 dtx_leader_begin(struct dtx_id *dti, daos_unit_oid_t *oid, daos_handle_t coh,
 		 daos_epoch_t epoch, uint64_t dkey_hash, uint32_t pm_ver,
@@ -152,6 +152,19 @@ vos_dtx_check_resend(daos_handle_t coh, daos_unit_oid_t *oid,
 int
 vos_dtx_check(daos_handle_t coh, struct dtx_id *dti);
 
+/**
+ * Record the DTX of a modification that has been applied as committed without
+ * DTX records, see dtx_handle::dth_solo. Only the committed DTX entry is
+ * created, so that the resent RPC can be detected. The caller has started the
+ * PMDK transaction.
+ *
+ * \param dth	[IN]	The DTX handle.
+ *
+ * \return		Zero on success, negative value if error.
+ */
+int
+vos_dtx_add_committed(struct dtx_handle *dth);
+
 /**
  * Commit the specified DTXs.
  *
@@ -612,6 +625,59 @@ int
 vos_update_end(daos_handle_t ioh, uint32_t pm_ver, daos_key_t *dkey, int err,
 	       struct dtx_handle *dth);
 
+/**
+ * Multi-dkey version of \a vos_fetch_begin. The I/O descriptors of all the
+ * dkeys are in the same array \a iods, the first \a dkey_iods[0] ones are for
+ * \a dkeys[0], the next \a dkey_iods[1] ones for \a dkeys[1], and so on.
+ * The returned handle is finalised by \a vos_fetch_end.
+ *
+ * \param coh	[IN]	Container open handle
+ * \param oid	[IN]	Object ID
+ * \param epoch	[IN]	Epoch for the fetch.
+ * \param dkey_nr [IN]	Number of dkeys in \a dkeys.
+ * \param dkeys	[IN]	Array of distribution keys.
+ * \param dkey_iods [IN] Number of I/O descriptors of each dkey.
+ * \param iod_nr [IN]	Total number of I/O descriptors in \a iods.
+ * \param iods	[IN/OUT]
+ *			Array of I/O descriptors of all the dkeys.
+ * \param size_fetch[IN]
+ *			Fetch size only
+ * \param ioh	[OUT]	The returned handle for the I/O.
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+vos_fetch_begin_multi(daos_handle_t coh, daos_unit_oid_t oid,
+		      daos_epoch_t epoch, unsigned int dkey_nr,
+		      daos_key_t *dkeys, unsigned int *dkey_iods,
+		      unsigned int iod_nr, daos_iod_t *iods, bool size_fetch,
+		      daos_handle_t *ioh);
+
+/**
+ * Multi-dkey version of \a vos_update_begin, the I/O descriptors are laid out
+ * as for \a vos_fetch_begin_multi. \a vos_update_end updates the trees of all
+ * the dkeys in a single transaction, its \a dkey parameter is ignored.
+ *
+ * \param coh	[IN]	Container open handle
+ * \param oid	[IN]	object ID
+ * \param epoch	[IN]	Epoch for the update.
+ * \param dkey_nr [IN]	Number of dkeys in \a dkeys.
+ * \param dkeys	[IN]	Array of distribution keys.
+ * \param dkey_iods [IN] Number of I/O descriptors of each dkey.
+ * \param iod_nr [IN]	Total number of I/O descriptors in \a iods.
+ * \param iods	[IN]	Array of I/O descriptors of all the dkeys.
+ * \param ioh	[OUT]	The returned handle for the I/O.
+ * \param dth	[IN]	Pointer to the DTX handle.
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+vos_update_begin_multi(daos_handle_t coh, daos_unit_oid_t oid,
+		       daos_epoch_t epoch, unsigned int dkey_nr,
+		       daos_key_t *dkeys, unsigned int *dkey_iods,
+		       unsigned int iod_nr, daos_iod_t *iods,
+		       daos_handle_t *ioh, struct dtx_handle *dth);
+
 /**
  * Get the I/O descriptor.
  *
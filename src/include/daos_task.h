@@ -110,6 +110,8 @@ typedef enum {
 	DAOS_OPC_OBJ_LIST_AKEY,
 	DAOS_OPC_OBJ_LIST_RECX,
 	DAOS_OPC_OBJ_LIST_OBJ,
+	DAOS_OPC_OBJ_UPDATE_MULTI,
+	DAOS_OPC_OBJ_FETCH_MULTI,
 
 	/** Array APIs */
 	DAOS_OPC_ARRAY_CREATE,
@@ -127,6 +129,9 @@ typedef enum {
 	DAOS_OPC_KV_PUT,
 	DAOS_OPC_KV_REMOVE,
 	DAOS_OPC_KV_LIST,
+	DAOS_OPC_KV_PUT_MULTI,
+	DAOS_OPC_KV_GET_MULTI,
+	DAOS_OPC_KV_SCAN,
 
 	DAOS_OPC_MAX
 } daos_opc_t;
@@ -439,6 +444,13 @@ typedef struct {
 typedef daos_obj_rw_t		daos_obj_fetch_t;
 typedef daos_obj_rw_t		daos_obj_update_t;
 
+typedef struct {
+	daos_handle_t		oh;
+	daos_handle_t		th;
+	unsigned int		nr;
+	daos_dkey_io_t		*ios;
+} daos_obj_multi_rw_t;
+
 struct daos_obj_fetch_shard {
 	daos_obj_fetch_t	base;
 	unsigned int		flags;
@@ -477,6 +489,8 @@ typedef struct {
 	daos_anchor_t		*akey_anchor;
 	uint32_t		*versions;
 	bool			incr_order;
+	/* optional filter of list_dkey, for the KV scan */
+	daos_kv_filter_t	*filter;
 } daos_obj_list_t;
 
 /**
@@ -569,6 +583,9 @@ typedef struct {
 	daos_array_iod_t	*iod;
 	d_sg_list_t		*sgl;
 	daos_csum_buf_t		*csums;
+	/** optional strided pattern the ranges of iod are repeated with */
+	unsigned int		stride_nr;
+	daos_array_stride_t	*strides;
 } daos_array_io_t;
 
 typedef struct {
@@ -617,8 +634,19 @@ typedef struct {
 	daos_key_desc_t		*kds;
 	d_sg_list_t		*sgl;
 	daos_anchor_t		*anchor;
+	/* only set by daos_kv_scan() */
+	daos_kv_filter_t	*filter;
 } daos_kv_list_t;
 
+typedef struct {
+	daos_handle_t		oh;
+	daos_handle_t		th;
+	unsigned int		nr;
+	const char		**keys;
+	daos_size_t		*sizes;
+	void			**bufs;
+} daos_kv_multi_t;
+
 /**
  * Create an asynchronous task and associate it with a daos client operation.
  * For synchronous operations please use the specific API for that operation.
@@ -31,6 +31,7 @@
 #include <daos_srv/daos_server.h>
 #include <daos_srv/vos.h>
 #include <daos/object.h>
+
 static int
 fill_recxs(daos_handle_t ih, vos_iter_entry_t *key_ent,
 	   struct dss_enum_arg *arg, vos_iter_type_t type)
@@ -137,6 +138,39 @@ fill_obj(daos_handle_t ih, vos_iter_entry_t *entry, struct dss_enum_arg *arg,
 	return 0;
 }
 
+/* Compare two keys in byte order, a key is before the longer keys it starts */
+static int
+key_cmp(daos_key_t *key, daos_key_t *bound)
+{
+	int	rc;
+
+	rc = memcmp(key->iov_buf, bound->iov_buf,
+		    min(key->iov_len, bound->iov_len));
+	if (rc != 0)
+		return rc;
+
+	return (key->iov_len > bound->iov_len) -
+	       (key->iov_len < bound->iov_len);
+}
+
+/* Does @key pass the OBJ_ENUM_KEY_* filter of the enumeration? */
+static bool
+key_match(struct dss_enum_arg *arg, daos_key_t *key)
+{
+	if (arg->key_flags & OBJ_ENUM_KEY_PREFIX)
+		return key->iov_len >= arg->key_lo.iov_len &&
+		       (arg->key_lo.iov_len == 0 ||
+			memcmp(key->iov_buf, arg->key_lo.iov_buf,
+			       arg->key_lo.iov_len) == 0);
+
+	if (arg->key_flags & OBJ_ENUM_KEY_RANGE)
+		return key_cmp(key, &arg->key_lo) >= 0 &&
+		       (arg->key_hi.iov_len == 0 ||
+			key_cmp(key, &arg->key_hi) < 0);
+
+	return true;
+}
+
 static int
 fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct dss_enum_arg *arg,
 	 vos_iter_type_t vos_type)
@@ -147,6 +181,10 @@ fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct dss_enum_arg *arg,
 
 	D_ASSERT(vos_type == VOS_ITER_DKEY || vos_type == VOS_ITER_AKEY);
 
+	/* The dkeys filtered out are skipped, not transferred */
+	if (vos_type == VOS_ITER_DKEY && !key_match(arg, &key_ent->ie_key))
+		return 0;
+
 	total_size = key_ent->ie_key.iov_len;
 	if (key_ent->ie_key_punch)
 		total_size += sizeof(key_ent->ie_key_punch);
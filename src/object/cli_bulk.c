@@ -0,0 +1,229 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of daos_sr
+ *
+ * src/object/cli_bulk.c
+ *
+ * Adaptive inline/bulk selection for the object update/fetch RPCs. For pools
+ * with DAOS_PROP_PO_IO_BULK set to DAOS_IO_BULK_ADAPTIVE, the client keeps
+ * the latency of both transfer paths per target and per size bucket, and sends
+ * the payloads in the ambiguous size range through the faster one. The
+ * statistics are updated without lock, a sample lost in a race only makes
+ * the moving average a little less accurate.
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/common.h>
+#include "obj_internal.h"
+
+/*
+ * Inline payloads cannot exceed OBJ_BULK_LIMIT, the RPC must fit in the
+ * unexpected message of the transport. So only the payloads in [1K,
+ * OBJ_BULK_LIMIT) are adaptive, in log2 buckets, the larger ones always use
+ * bulk and the smaller ones are always inline.
+ */
+#define OBJ_IO_BKT_MIN_SHIFT	10
+#define OBJ_IO_BKT_MAX_SHIFT	11
+#define OBJ_IO_BKT_NR	(OBJ_IO_BKT_MAX_SHIFT - OBJ_IO_BKT_MIN_SHIFT + 1)
+/* Number of samples of each path before trusting the latency. */
+#define OBJ_IO_WARMUP		8
+/* Send one request through the slower path every OBJ_IO_PROBE requests. */
+#define OBJ_IO_PROBE		64
+/* EWMA weight of a new sample is 1/2^OBJ_IO_EWMA_SHIFT */
+#define OBJ_IO_EWMA_SHIFT	3
+
+enum {
+	OBJ_IO_INLINE,
+	OBJ_IO_BULK,
+	OBJ_IO_PATH_NR,
+};
+
+struct obj_io_path {
+	/* moving average of the RPC latency in nanoseconds */
+	uint64_t		ip_lat;
+	uint64_t		ip_cnt;
+};
+
+struct obj_io_bucket {
+	struct obj_io_path	ib_path[OBJ_IO_PATH_NR];
+	uint32_t		ib_reqs;
+};
+
+struct obj_io_stat {
+	d_list_t		ios_link;
+	uuid_t			ios_pool;
+	/*
+	 * per target buckets, indexed by the pool map target id, sized by the
+	 * pool map of the first handle, the targets added later keep the
+	 * fixed threshold
+	 */
+	struct obj_io_bucket  (*ios_tgts)[OBJ_IO_BKT_NR];
+	unsigned int		ios_tgt_nr;
+	/* number of adaptive decisions of each path, per size bucket */
+	uint64_t		ios_choices[OBJ_IO_BKT_NR][OBJ_IO_PATH_NR];
+};
+
+/* Statistics of all the adaptive pools, released by dc_obj_fini(). */
+static D_LIST_HEAD(obj_io_stat_list);
+static pthread_mutex_t	obj_io_stat_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Find or create the statistics of the pool @pool of @tgt_nr targets. NULL
+ * is returned if it cannot be allocated, then the caller falls back to the
+ * fixed threshold.
+ */
+struct obj_io_stat *
+obj_io_stat_get(uuid_t pool, unsigned int tgt_nr)
+{
+	struct obj_io_stat	*ios;
+
+	D_MUTEX_LOCK(&obj_io_stat_lock);
+	d_list_for_each_entry(ios, &obj_io_stat_list, ios_link) {
+		if (uuid_compare(ios->ios_pool, pool) == 0)
+			goto out;
+	}
+
+	D_ALLOC_PTR(ios);
+	if (ios == NULL)
+		goto out;
+
+	D_ALLOC_ARRAY(ios->ios_tgts, tgt_nr);
+	if (ios->ios_tgts == NULL) {
+		D_FREE(ios);
+		ios = NULL;
+		goto out;
+	}
+	ios->ios_tgt_nr = tgt_nr;
+	uuid_copy(ios->ios_pool, pool);
+	d_list_add(&ios->ios_link, &obj_io_stat_list);
+out:
+	D_MUTEX_UNLOCK(&obj_io_stat_lock);
+	return ios;
+}
+
+void
+obj_io_stat_fini(void)
+{
+	struct obj_io_stat	*ios;
+	struct obj_io_stat	*tmp;
+	int			 i;
+
+	d_list_for_each_entry_safe(ios, tmp, &obj_io_stat_list, ios_link) {
+		for (i = 0; i < OBJ_IO_BKT_NR; i++)
+			D_INFO(DF_UUID": adaptive I/O of %lu+ bytes: inline "
+			       DF_U64" bulk "DF_U64"\n",
+			       DP_UUID(ios->ios_pool),
+			       1UL << (i + OBJ_IO_BKT_MIN_SHIFT),
+			       ios->ios_choices[i][OBJ_IO_INLINE],
+			       ios->ios_choices[i][OBJ_IO_BULK]);
+		d_list_del(&ios->ios_link);
+		D_FREE(ios->ios_tgts);
+		D_FREE(ios);
+	}
+}
+
+static int
+obj_io_size2bkt(daos_size_t size)
+{
+	int	shift = OBJ_IO_BKT_MIN_SHIFT;
+
+	while (shift < OBJ_IO_BKT_MAX_SHIFT && (size >> (shift + 1)) != 0)
+		shift++;
+
+	return shift - OBJ_IO_BKT_MIN_SHIFT;
+}
+
+/* Is the payload of @size bytes in the adaptive range? */
+static bool
+obj_io_adaptive(daos_size_t size)
+{
+	return size >= (1UL << OBJ_IO_BKT_MIN_SHIFT) && size < OBJ_BULK_LIMIT;
+}
+
+/**
+ * Decide if the payload of @size bytes sent to the target @tgt should be
+ * transferred by bulk. Payloads from OBJ_BULK_LIMIT are always bulk and the
+ * small ones are always inline. In between, both paths are sampled until
+ * warmed up, then the faster one is chosen and the slower one is still probed
+ * from time to time to follow the load changes.
+ */
+bool
+obj_io_stat_bulk(struct obj_io_stat *ios, uint32_t tgt, daos_size_t size)
+{
+	struct obj_io_path	*path;
+	uint64_t		 cnt[OBJ_IO_PATH_NR];
+	uint32_t		 reqs;
+	int			 bkt;
+	bool			 bulk;
+
+	if (!obj_io_adaptive(size) || tgt >= ios->ios_tgt_nr)
+		return size >= OBJ_BULK_LIMIT;
+
+	bkt = obj_io_size2bkt(size);
+	path = ios->ios_tgts[tgt][bkt].ib_path;
+	reqs = __atomic_add_fetch(&ios->ios_tgts[tgt][bkt].ib_reqs, 1,
+				  __ATOMIC_RELAXED);
+	cnt[OBJ_IO_INLINE] = __atomic_load_n(&path[OBJ_IO_INLINE].ip_cnt,
+					     __ATOMIC_RELAXED);
+	cnt[OBJ_IO_BULK] = __atomic_load_n(&path[OBJ_IO_BULK].ip_cnt,
+					   __ATOMIC_RELAXED);
+	if (cnt[OBJ_IO_INLINE] < OBJ_IO_WARMUP ||
+	    cnt[OBJ_IO_BULK] < OBJ_IO_WARMUP) {
+		/* explore the path with fewer samples */
+		bulk = cnt[OBJ_IO_BULK] < cnt[OBJ_IO_INLINE];
+	} else {
+		bulk = __atomic_load_n(&path[OBJ_IO_BULK].ip_lat,
+				       __ATOMIC_RELAXED) <
+		       __atomic_load_n(&path[OBJ_IO_INLINE].ip_lat,
+				       __ATOMIC_RELAXED);
+		if (reqs % OBJ_IO_PROBE == 0)
+			bulk = !bulk;
+	}
+	__atomic_add_fetch(&ios->ios_choices[bkt][bulk ? OBJ_IO_BULK :
+						    OBJ_IO_INLINE], 1,
+			   __ATOMIC_RELAXED);
+
+	return bulk;
+}
+
+/** Record the latency @lat (in nanoseconds) of a completed RPC. */
+void
+obj_io_stat_record(struct obj_io_stat *ios, uint32_t tgt, daos_size_t size,
+		   bool bulk, uint64_t lat)
+{
+	struct obj_io_path	*path;
+	uint64_t		 avg;
+
+	if (!obj_io_adaptive(size) || tgt >= ios->ios_tgt_nr)
+		return;
+
+	path = &ios->ios_tgts[tgt][obj_io_size2bkt(size)].ib_path[bulk ?
+						OBJ_IO_BULK : OBJ_IO_INLINE];
+	if (__atomic_fetch_add(&path->ip_cnt, 1, __ATOMIC_RELAXED) != 0) {
+		avg = __atomic_load_n(&path->ip_lat, __ATOMIC_RELAXED);
+		lat = avg + (lat >> OBJ_IO_EWMA_SHIFT) -
+		      (avg >> OBJ_IO_EWMA_SHIFT);
+	}
+	__atomic_store_n(&path->ip_lat, lat, __ATOMIC_RELAXED);
+}
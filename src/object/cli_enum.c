@@ -0,0 +1,578 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of daos_sr
+ *
+ * src/object/cli_enum.c
+ *
+ * Enumeration streams. A stream keeps the next batch of keys in flight while
+ * the caller consumes the current one, so a large enumeration is not one round
+ * trip per batch. The number of keys per request follows the response time,
+ * and the dkeys of the redundancy groups can be enumerated in parallel, up to
+ * ENUM_LANE_MAX lanes of batches, each lane takes the next group once its
+ * group is done.
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/common.h>
+#include <daos/event.h>
+#include <daos/task.h>
+#include <daos_task.h>
+#include "obj_internal.h"
+
+/* Number of keys per request, adapted between MIN and MAX. */
+#define ENUM_BATCH_MIN		32
+#define ENUM_BATCH_INIT		128
+#define ENUM_BATCH_MAX		4096
+/* Initial buffer size per key, the buffer grows if it limits the batch. */
+#define ENUM_KEY_SIZE		64
+#define ENUM_BUF_MAX		(4UL << 20)
+/* Grow the batches answered faster than this, shrink the 4x slower ones. */
+#define ENUM_LAT_TARGET		(1000ULL * 1000)
+/* Number of groups enumerated at the same time by a parallel stream. */
+#define ENUM_LANE_MAX		8
+
+struct enum_batch {
+	daos_event_t		 eb_ev;
+	bool			 eb_inflight;
+	/* start time of the request, in nanoseconds */
+	uint64_t		 eb_start;
+	/* number of keys requested, and returned by the request */
+	uint32_t		 eb_req;
+	uint32_t		 eb_nr;
+	uint32_t		 eb_kds_cap;
+	daos_key_desc_t		*eb_kds;
+	d_iov_t			 eb_iov;
+	d_sg_list_t		 eb_sgl;
+	/* next key to consume and its offset in the buffer */
+	uint32_t		 eb_next;
+	size_t			 eb_off;
+};
+
+struct enum_lane {
+	daos_anchor_t		 el_anchor;
+	/* group of the lane, only for a parallel stream */
+	uint32_t		 el_grp;
+	/* no more request to send */
+	bool			 el_eof;
+	/* the batch consumed by the caller, the other one is prefetched */
+	int			 el_cur;
+	struct enum_batch	 el_batch[2];
+};
+
+struct dc_obj_enum {
+	struct d_hlink		 oe_hlink;
+	daos_handle_t		 oe_oh;
+	daos_handle_t		 oe_th;
+	/* dkey of an akey stream, empty for a dkey stream */
+	daos_key_t		 oe_dkey;
+	/* the batches of all the lanes complete in this event queue */
+	daos_handle_t		 oe_eqh;
+	bool			 oe_parallel;
+	uint32_t		 oe_grp_size;
+	/* number of groups, and next group to take by a lane */
+	uint32_t		 oe_grp_nr;
+	uint32_t		 oe_grp_next;
+	/* current number of keys and buffer size per request */
+	uint32_t		 oe_batch;
+	size_t			 oe_buf_size;
+	/* first failure, returned by all the following calls */
+	int			 oe_err;
+	/* lane the keys are consumed from */
+	unsigned int		 oe_lane;
+	unsigned int		 oe_lane_nr;
+	struct enum_lane	 oe_lanes[0];
+};
+
+static void
+enum_free(struct d_hlink *hlink)
+{
+	struct dc_obj_enum	*oe;
+	struct enum_batch	*b;
+	unsigned int		 i;
+	int			 j;
+
+	oe = container_of(hlink, struct dc_obj_enum, oe_hlink);
+	D_ASSERT(daos_hhash_link_empty(&oe->oe_hlink));
+	for (i = 0; i < oe->oe_lane_nr; i++) {
+		for (j = 0; j < 2; j++) {
+			b = &oe->oe_lanes[i].el_batch[j];
+			D_ASSERT(!b->eb_inflight);
+			daos_event_fini(&b->eb_ev);
+			if (b->eb_kds != NULL)
+				D_FREE(b->eb_kds);
+			if (b->eb_iov.iov_buf != NULL)
+				D_FREE(b->eb_iov.iov_buf);
+		}
+	}
+	if (!daos_handle_is_inval(oe->oe_eqh))
+		daos_eq_destroy(oe->oe_eqh, 0);
+	daos_iov_free(&oe->oe_dkey);
+	D_FREE(oe);
+}
+
+static struct d_hlink_ops enum_h_ops = {
+	.hop_free	= enum_free,
+};
+
+static struct dc_obj_enum *
+enum_hdl2ptr(daos_handle_t eh)
+{
+	struct d_hlink	*hlink;
+
+	hlink = daos_hhash_link_lookup(eh.cookie);
+	if (hlink == NULL)
+		return NULL;
+
+	return container_of(hlink, struct dc_obj_enum, oe_hlink);
+}
+
+static void
+enum_decref(struct dc_obj_enum *oe)
+{
+	daos_hhash_link_putref(&oe->oe_hlink);
+}
+
+/* the lane @lane takes the next group, from its first dkey */
+static void
+enum_lane_next_grp(struct dc_obj_enum *oe, struct enum_lane *lane)
+{
+	lane->el_grp = oe->oe_grp_next++;
+	memset(&lane->el_anchor, 0, sizeof(lane->el_anchor));
+	dc_obj_shard2anchor(&lane->el_anchor, lane->el_grp * oe->oe_grp_size);
+}
+
+/* send the next request of the lane @lane in the batch @b */
+static int
+enum_batch_issue(struct dc_obj_enum *oe, struct enum_lane *lane,
+		 struct enum_batch *b)
+{
+	tse_task_t	*task;
+	int		 rc;
+
+	if (b->eb_kds_cap < oe->oe_batch) {
+		if (b->eb_kds != NULL)
+			D_FREE(b->eb_kds);
+		b->eb_kds_cap = 0;
+		D_ALLOC_ARRAY(b->eb_kds, oe->oe_batch);
+		if (b->eb_kds == NULL)
+			return -DER_NOMEM;
+		b->eb_kds_cap = oe->oe_batch;
+	}
+	if (b->eb_iov.iov_buf_len < oe->oe_buf_size) {
+		if (b->eb_iov.iov_buf != NULL)
+			D_FREE(b->eb_iov.iov_buf);
+		b->eb_iov.iov_buf_len = 0;
+		D_ALLOC(b->eb_iov.iov_buf, oe->oe_buf_size);
+		if (b->eb_iov.iov_buf == NULL)
+			return -DER_NOMEM;
+		b->eb_iov.iov_buf_len = oe->oe_buf_size;
+	}
+	b->eb_iov.iov_len = 0;
+	b->eb_sgl.sg_nr = 1;
+	b->eb_sgl.sg_nr_out = 0;
+	b->eb_sgl.sg_iovs = &b->eb_iov;
+	b->eb_req = oe->oe_batch;
+	b->eb_nr = b->eb_req;
+	b->eb_next = 0;
+	b->eb_off = 0;
+
+	if (oe->oe_dkey.iov_buf == NULL)
+		rc = dc_obj_list_dkey_task_create(oe->oe_oh, oe->oe_th,
+						  &b->eb_nr, b->eb_kds,
+						  &b->eb_sgl, &lane->el_anchor,
+						  &b->eb_ev, NULL, &task);
+	else
+		rc = dc_obj_list_akey_task_create(oe->oe_oh, oe->oe_th,
+						  &oe->oe_dkey, &b->eb_nr,
+						  b->eb_kds, &b->eb_sgl,
+						  &lane->el_anchor, &b->eb_ev,
+						  NULL, &task);
+	if (rc != 0)
+		return rc;
+
+	b->eb_start = daos_get_ntime();
+	b->eb_inflight = true;
+	/* the failures are reported through the event */
+	return dc_task_schedule(task, true);
+}
+
+/*
+ * The request of the batch @b has completed: adapt the size of the next
+ * requests and check if the lane has more keys.
+ */
+static int
+enum_batch_done(struct dc_obj_enum *oe, struct enum_lane *lane,
+		struct enum_batch *b)
+{
+	daos_anchor_t	*anchor = &lane->el_anchor;
+	uint64_t	 lat;
+	int		 rc = b->eb_ev.ev_error;
+
+	b->eb_inflight = false;
+	if (rc == -DER_KEY2BIG) {
+		/*
+		 * The anchor has not moved, retry with a buffer large enough
+		 * for the oversized key, up to ENUM_BUF_MAX.
+		 */
+		if (b->eb_kds[0].kd_key_len > ENUM_BUF_MAX ||
+		    oe->oe_buf_size >= ENUM_BUF_MAX) {
+			D_ERROR("key of "DF_U64" bytes, buffer size %zu\n",
+				b->eb_kds[0].kd_key_len, oe->oe_buf_size);
+			b->eb_nr = 0;
+			return rc;
+		}
+		oe->oe_buf_size = min(max(oe->oe_buf_size * 2,
+					  b->eb_kds[0].kd_key_len),
+				      ENUM_BUF_MAX);
+		D_DEBUG(DB_IO, "key of "DF_U64" bytes, buffer size %zu\n",
+			b->eb_kds[0].kd_key_len, oe->oe_buf_size);
+		return enum_batch_issue(oe, lane, b);
+	}
+	if (rc != 0) {
+		b->eb_nr = 0;
+		return rc;
+	}
+
+	lat = daos_get_ntime() - b->eb_start;
+	if (b->eb_nr == b->eb_req) {
+		if (lat < ENUM_LAT_TARGET && oe->oe_batch < ENUM_BATCH_MAX)
+			oe->oe_batch *= 2;
+	} else if (!daos_anchor_is_eof(anchor) &&
+		   !daos_anchor_is_zero(anchor) &&
+		   oe->oe_buf_size < ENUM_BUF_MAX) {
+		/* not the end of a group, the keys did not fit in the buffer */
+		oe->oe_buf_size *= 2;
+	}
+	if (lat > 4 * ENUM_LAT_TARGET && oe->oe_batch > ENUM_BATCH_MIN)
+		oe->oe_batch /= 2;
+
+	/*
+	 * The anchor moves to the next group once a group is done, a lane of
+	 * a parallel stream takes the next group no lane has taken yet.
+	 */
+	if (!daos_anchor_is_eof(anchor) &&
+	    (!oe->oe_parallel ||
+	     dc_obj_anchor2shard(anchor) / oe->oe_grp_size == lane->el_grp))
+		return 0;
+
+	if (oe->oe_parallel && oe->oe_grp_next < oe->oe_grp_nr)
+		enum_lane_next_grp(oe, lane);
+	else
+		lane->el_eof = true;
+
+	return 0;
+}
+
+/*
+ * Return true if the caller can consume keys from the lane @lane. Once the
+ * current batch is consumed, the prefetched one is taken if it has completed,
+ * and the next request is sent in the buffers of the consumed batch.
+ */
+static bool
+enum_lane_ready(struct dc_obj_enum *oe, struct enum_lane *lane, int *rc)
+{
+	struct enum_batch	*cur = &lane->el_batch[lane->el_cur];
+	struct enum_batch	*next = &lane->el_batch[!lane->el_cur];
+	bool			 done;
+
+	while (cur->eb_next == cur->eb_nr) {
+		if (!next->eb_inflight)
+			return false;
+
+		*rc = daos_event_test(&next->eb_ev, DAOS_EQ_NOWAIT, &done);
+		if (*rc != 0 || !done)
+			return false;
+
+		*rc = enum_batch_done(oe, lane, next);
+		if (*rc != 0)
+			return false;
+		/* retried with a larger buffer */
+		if (next->eb_inflight)
+			continue;
+
+		lane->el_cur = !lane->el_cur;
+		cur = next;
+		next = &lane->el_batch[!lane->el_cur];
+		if (!lane->el_eof) {
+			*rc = enum_batch_issue(oe, lane, next);
+			if (*rc != 0)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/* The lane has no key to consume and no request in flight. */
+static bool
+enum_lane_done(struct enum_lane *lane)
+{
+	struct enum_batch	*cur = &lane->el_batch[lane->el_cur];
+
+	return cur->eb_next == cur->eb_nr &&
+	       !lane->el_batch[!lane->el_cur].eb_inflight;
+}
+
+/* Wait for the requests in flight, for an error or a close. */
+static void
+enum_drain(struct dc_obj_enum *oe)
+{
+	struct enum_batch	*b;
+	unsigned int		 i;
+	int			 j;
+	bool			 done;
+	int			 rc;
+
+	for (i = 0; i < oe->oe_lane_nr; i++) {
+		for (j = 0; j < 2; j++) {
+			b = &oe->oe_lanes[i].el_batch[j];
+			while (b->eb_inflight) {
+				rc = daos_event_test(&b->eb_ev, DAOS_EQ_WAIT,
+						     &done);
+				if (rc != 0 || done)
+					b->eb_inflight = false;
+			}
+		}
+	}
+}
+
+/**
+ * Open a stream of the dkeys of the object @oh, or of the akeys of @dkey if
+ * it is not NULL. With DAOS_OBJ_ENUM_PARALLEL, the dkeys of up to
+ * ENUM_LANE_MAX redundancy groups are enumerated at the same time, and
+ * returned in no particular order.
+ */
+int
+dc_obj_enum_open(daos_handle_t oh, daos_handle_t th, daos_key_t *dkey,
+		 uint32_t flags, daos_handle_t *eh)
+{
+	struct dc_object	*obj;
+	struct dc_obj_enum	*oe;
+	struct enum_lane	*lane;
+	unsigned int		 lane_nr = 1;
+	unsigned int		 grp_nr = 1;
+	unsigned int		 grp_size;
+	unsigned int		 i;
+	int			 rc;
+
+	if (eh == NULL || (dkey != NULL && dkey->iov_buf == NULL) ||
+	    (flags & ~DAOS_OBJ_ENUM_PARALLEL) != 0)
+		return -DER_INVAL;
+
+	obj = obj_hdl2ptr(oh);
+	if (obj == NULL)
+		return -DER_NO_HDL;
+
+	grp_size = obj_get_grp_size(obj);
+	D_ASSERT(grp_size > 0);
+	D_RWLOCK_RDLOCK(&obj->cob_lock);
+	if (dkey == NULL && (flags & DAOS_OBJ_ENUM_PARALLEL))
+		grp_nr = obj->cob_shards_nr / grp_size;
+	D_RWLOCK_UNLOCK(&obj->cob_lock);
+	obj_decref(obj);
+	lane_nr = min(grp_nr, ENUM_LANE_MAX);
+
+	D_ALLOC(oe, offsetof(struct dc_obj_enum, oe_lanes[lane_nr]));
+	if (oe == NULL)
+		return -DER_NOMEM;
+
+	daos_hhash_hlink_init(&oe->oe_hlink, &enum_h_ops);
+	oe->oe_oh = oh;
+	oe->oe_th = th;
+	oe->oe_parallel = grp_nr > 1;
+	oe->oe_grp_size = grp_size;
+	oe->oe_grp_nr = grp_nr;
+	oe->oe_batch = ENUM_BATCH_INIT;
+	oe->oe_buf_size = ENUM_BATCH_INIT * ENUM_KEY_SIZE;
+	oe->oe_lane_nr = lane_nr;
+	rc = daos_eq_create(&oe->oe_eqh);
+	if (rc != 0) {
+		D_FREE(oe);
+		return rc;
+	}
+	for (i = 0; i < lane_nr * 2; i++) {
+		rc = daos_event_init(&oe->oe_lanes[i / 2].el_batch[i % 2].eb_ev,
+				     oe->oe_eqh, NULL);
+		if (rc != 0) {
+			while (i-- > 0)
+				daos_event_fini(
+				    &oe->oe_lanes[i / 2].el_batch[i % 2].eb_ev);
+			daos_eq_destroy(oe->oe_eqh, 0);
+			D_FREE(oe);
+			return rc;
+		}
+	}
+
+	if (dkey != NULL) {
+		rc = daos_iov_copy(&oe->oe_dkey, dkey);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	/* the first request of each lane */
+	for (i = 0; i < lane_nr; i++) {
+		lane = &oe->oe_lanes[i];
+		if (oe->oe_parallel)
+			enum_lane_next_grp(oe, lane);
+		lane->el_cur = 1;
+		rc = enum_batch_issue(oe, lane, &lane->el_batch[0]);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	daos_hhash_link_insert(&oe->oe_hlink, DAOS_HTYPE_ENUM);
+	daos_hhash_link_key(&oe->oe_hlink, &eh->cookie);
+	return 0;
+out:
+	enum_drain(oe);
+	enum_free(&oe->oe_hlink);
+	return rc;
+}
+
+/**
+ * Return the next keys of the stream @eh, as many as fit in @nr and @sgl. The
+ * keys are packed in the iovs of @sgl like daos_obj_list_dkey() does, a key
+ * is never split between two iovs. Zero key is returned at the end of the
+ * stream. If a request fails, the keys already returned by the other requests
+ * are returned first, and the failure by the next call.
+ */
+int
+dc_obj_enum_next(daos_handle_t eh, uint32_t *nr, daos_key_desc_t *kds,
+		 d_sg_list_t *sgl)
+{
+	struct dc_obj_enum	*oe;
+	struct enum_lane	*lane = NULL;
+	struct enum_batch	*b;
+	daos_event_t		*ev;
+	daos_key_desc_t		*kd;
+	unsigned int		 iov = 0;
+	size_t			 off = 0;
+	uint32_t		 key_nr = 0;
+	unsigned int		 i;
+	bool			 full = false;
+	int			 rc = 0;
+
+	if (nr == NULL || *nr == 0 || kds == NULL || sgl == NULL ||
+	    sgl->sg_nr == 0 || sgl->sg_iovs == NULL)
+		return -DER_INVAL;
+
+	oe = enum_hdl2ptr(eh);
+	if (oe == NULL)
+		return -DER_NO_HDL;
+
+	if (oe->oe_err != 0)
+		D_GOTO(out, rc = oe->oe_err);
+
+	for (i = 0; i < sgl->sg_nr; i++)
+		sgl->sg_iovs[i].iov_len = 0;
+
+	while (!full) {
+		for (i = 0; i < oe->oe_lane_nr; i++) {
+			lane = &oe->oe_lanes[(oe->oe_lane + i) %
+					     oe->oe_lane_nr];
+			if (enum_lane_ready(oe, lane, &rc) || rc != 0)
+				break;
+		}
+		if (rc != 0) {
+			oe->oe_err = rc;
+			if (key_nr == 0)
+				D_GOTO(out, rc);
+			rc = 0;
+			break;
+		}
+		if (i == oe->oe_lane_nr) {
+			for (i = 0; i < oe->oe_lane_nr; i++) {
+				if (!enum_lane_done(&oe->oe_lanes[i]))
+					break;
+			}
+			/* the end of the stream, or keys to return */
+			if (i == oe->oe_lane_nr || key_nr > 0)
+				break;
+			/* wait for the request of any lane */
+			rc = daos_eq_poll(oe->oe_eqh, 1, DAOS_EQ_WAIT, 1, &ev);
+			if (rc < 0) {
+				oe->oe_err = rc;
+				D_GOTO(out, rc);
+			}
+			rc = 0;
+			continue;
+		}
+		oe->oe_lane = (oe->oe_lane + i) % oe->oe_lane_nr;
+
+		b = &lane->el_batch[lane->el_cur];
+		while (b->eb_next < b->eb_nr) {
+			kd = &b->eb_kds[b->eb_next];
+			while (iov < sgl->sg_nr && off + kd->kd_key_len >
+			       sgl->sg_iovs[iov].iov_buf_len) {
+				iov++;
+				off = 0;
+			}
+			if (iov == sgl->sg_nr || key_nr == *nr) {
+				if (key_nr == 0) {
+					/* the same as daos_obj_list_dkey() */
+					kds[0].kd_key_len = kd->kd_key_len;
+					D_GOTO(out, rc = -DER_KEY2BIG);
+				}
+				full = true;
+				break;
+			}
+
+			memcpy(sgl->sg_iovs[iov].iov_buf + off,
+			       b->eb_iov.iov_buf + b->eb_off, kd->kd_key_len);
+			off += kd->kd_key_len;
+			sgl->sg_iovs[iov].iov_len = off;
+			b->eb_off += kd->kd_key_len;
+			kds[key_nr++] = *kd;
+			b->eb_next++;
+		}
+		/* take the next lane once this batch is consumed */
+		if (b->eb_next == b->eb_nr)
+			oe->oe_lane = (oe->oe_lane + 1) % oe->oe_lane_nr;
+	}
+
+	*nr = key_nr;
+	sgl->sg_nr_out = key_nr == 0 ? 0 : iov + 1;
+out:
+	enum_decref(oe);
+	return rc;
+}
+
+int
+dc_obj_enum_close(daos_handle_t eh)
+{
+	struct dc_obj_enum	*oe;
+
+	oe = enum_hdl2ptr(eh);
+	if (oe == NULL)
+		return -DER_NO_HDL;
+
+	/* the prefetched batches are dropped */
+	enum_drain(oe);
+	daos_hhash_link_delete(&oe->oe_hlink);
+	/* -1 for hdl2ptr */
+	enum_decref(oe);
+	/* -1 for open */
+	enum_decref(oe);
+	return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of daos_sr
+ *
+ * src/object/cli_layout.c
+ *
+ * Client side object layout cache. The layout generated by pl_obj_place() only
+ * depends on the pool, the pool map version and the object metadata, so it can
+ * be shared by all the opens of the same object until the pool map changes.
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/common.h>
+#include <daos/lru.h>
+#include <daos/placement.h>
+#include "obj_internal.h"
+
+/* Default size of the layout cache, 2^14 entries. */
+#define OBJ_LAYOUT_CACHE_BITS	14
+
+struct obj_layout_key {
+	/* the pool the object belongs to */
+	uuid_t			olk_pool;
+	/* pool map version the layout is generated with */
+	uint32_t		olk_map_ver;
+	uint32_t		olk_padding;
+	/* object metadata */
+	struct daos_obj_md	olk_md;
+};
+
+struct obj_layout_entry {
+	struct daos_llink	ole_llink;
+	struct obj_layout_key	ole_key;
+	/* The layout is embedded, the shards array is owned by the entry. */
+	struct pl_obj_layout	ole_layout;
+};
+
+/* Global LRU shared by all pools, the pool UUID is part of the key. */
+static struct daos_lru_cache	*obj_layout_cache;
+/* The LRU itself is not thread-safe. */
+static pthread_mutex_t		 obj_layout_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int
+layout_lop_alloc(void *key, unsigned int ksize, void *args,
+		 struct daos_llink **llink_p)
+{
+	struct obj_layout_key	*lkey = key;
+	struct pl_map		*map = args;
+	struct obj_layout_entry	*ole;
+	struct pl_obj_layout	*layout = NULL;
+	int			 rc;
+
+	rc = pl_obj_place(map, &lkey->olk_md, NULL, &layout);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_PTR(ole);
+	if (ole == NULL) {
+		pl_obj_layout_free(layout);
+		return -DER_NOMEM;
+	}
+
+	ole->ole_key = *lkey;
+	/* take over the shards array, then drop the header */
+	ole->ole_layout = *layout;
+	D_FREE(layout);
+
+	*llink_p = &ole->ole_llink;
+	return 0;
+}
+
+static bool
+layout_lop_cmp_key(const void *key, unsigned int ksize,
+		   struct daos_llink *llink)
+{
+	struct obj_layout_entry	*ole;
+
+	D_ASSERT(ksize == sizeof(struct obj_layout_key));
+
+	ole = container_of(llink, struct obj_layout_entry, ole_llink);
+	return memcmp(key, &ole->ole_key, ksize) == 0;
+}
+
+static void
+layout_lop_free(struct daos_llink *llink)
+{
+	struct obj_layout_entry	*ole;
+
+	ole = container_of(llink, struct obj_layout_entry, ole_llink);
+	if (ole->ole_layout.ol_shards != NULL)
+		D_FREE(ole->ole_layout.ol_shards);
+	D_FREE(ole);
+}
+
+static void
+layout_lop_print_key(void *key, unsigned int ksize)
+{
+	struct obj_layout_key	*lkey = key;
+
+	D_DEBUG(DB_TRACE, "pool="DF_UUID" ver=%u obj="DF_OID"\n",
+		DP_UUID(lkey->olk_pool), lkey->olk_map_ver,
+		DP_OID(lkey->olk_md.omd_id));
+}
+
+static struct daos_llink_ops obj_layout_lru_ops = {
+	.lop_free_ref	= layout_lop_free,
+	.lop_alloc_ref	= layout_lop_alloc,
+	.lop_cmp_keys	= layout_lop_cmp_key,
+	.lop_print_key	= layout_lop_print_key,
+};
+
+/**
+ * Create the client layout cache, its size can be changed by the environment
+ * variable DAOS_OBJ_LAYOUT_CACHE_BITS, zero disables the cache.
+ */
+int
+obj_layout_cache_init(void)
+{
+	unsigned int	bits = OBJ_LAYOUT_CACHE_BITS;
+	int		rc;
+
+	d_getenv_int("DAOS_OBJ_LAYOUT_CACHE_BITS", &bits);
+	if (bits == 0) {
+		D_DEBUG(DB_PL, "Object layout cache is disabled\n");
+		return 0;
+	}
+
+	rc = daos_lru_cache_create(bits, D_HASH_FT_NOLOCK,
+				   &obj_layout_lru_ops, &obj_layout_cache);
+	if (rc != 0)
+		D_ERROR("Failed to create object layout cache: %d\n", rc);
+	else
+		D_DEBUG(DB_PL, "Object layout cache size %u\n", 1U << bits);
+
+	return rc;
+}
+
+void
+obj_layout_cache_fini(void)
+{
+	if (obj_layout_cache == NULL)
+		return;
+
+	daos_lru_cache_destroy(obj_layout_cache);
+	obj_layout_cache = NULL;
+}
+
+/**
+ * Get the layout of the object described by @md against the placement map
+ * @map, either from the cache or generated by pl_obj_place(). The returned
+ * layout must be released via obj_layout_release().
+ */
+int
+obj_layout_hold(struct pl_map *map, struct daos_obj_md *md,
+		struct pl_obj_layout **layout_pp)
+{
+	struct obj_layout_key	 key;
+	struct obj_layout_entry	*ole;
+	struct daos_llink	*llink;
+	int			 rc;
+
+	if (obj_layout_cache == NULL)
+		return pl_obj_place(map, md, NULL, layout_pp);
+
+	/* the whole key is hashed, the padding must be zeroed */
+	memset(&key, 0, sizeof(key));
+	uuid_copy(key.olk_pool, map->pl_uuid);
+	key.olk_map_ver = pl_map_version(map);
+	key.olk_md = *md;
+
+	D_MUTEX_LOCK(&obj_layout_lock);
+	rc = daos_lru_ref_hold(obj_layout_cache, &key, sizeof(key), map,
+			       &llink);
+	D_MUTEX_UNLOCK(&obj_layout_lock);
+	if (rc != 0)
+		return rc;
+
+	ole = container_of(llink, struct obj_layout_entry, ole_llink);
+	*layout_pp = &ole->ole_layout;
+	return 0;
+}
+
+void
+obj_layout_release(struct pl_obj_layout *layout)
+{
+	struct obj_layout_entry	*ole;
+
+	if (obj_layout_cache == NULL) {
+		pl_obj_layout_free(layout);
+		return;
+	}
+
+	ole = container_of(layout, struct obj_layout_entry, ole_layout);
+	D_MUTEX_LOCK(&obj_layout_lock);
+	daos_lru_ref_release(obj_layout_cache, &ole->ole_llink);
+	D_MUTEX_UNLOCK(&obj_layout_lock);
+}
+
+struct obj_layout_evict_args {
+	uuid_t		pool;
+	uint32_t	map_ver;
+};
+
+static bool
+obj_layout_evict_cond(struct daos_llink *llink, void *args)
+{
+	struct obj_layout_evict_args	*arg = args;
+	struct obj_layout_entry		*ole;
+
+	ole = container_of(llink, struct obj_layout_entry, ole_llink);
+	return uuid_compare(ole->ole_key.olk_pool, arg->pool) == 0 &&
+	       ole->ole_key.olk_map_ver < arg->map_ver;
+}
+
+/**
+ * Evict the cached layouts of the pool @pool that were generated against
+ * pool map versions older than @map_ver.
+ */
+void
+obj_layout_cache_evict(uuid_t pool, uint32_t map_ver)
+{
+	struct obj_layout_evict_args	arg;
+
+	if (obj_layout_cache == NULL)
+		return;
+
+	uuid_copy(arg.pool, pool);
+	arg.map_ver = map_ver;
+
+	D_MUTEX_LOCK(&obj_layout_lock);
+	daos_lru_cache_evict(obj_layout_cache, obj_layout_evict_cond, &arg);
+	D_MUTEX_UNLOCK(&obj_layout_lock);
+}
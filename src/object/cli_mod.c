@@ -33,6 +33,7 @@
 #include "obj_internal.h"
 
 unsigned int	srv_io_mode = DIM_DTX_FULL_ENABLED;
+unsigned int	obj_combine_size;
 
 /**
  * Initialize object interface
@@ -52,21 +53,39 @@ dc_obj_init(void)
 		D_DEBUG(DB_IO, "Full dtx mode by default\n");
 	}
 
+	d_getenv_int("DAOS_OBJ_UPDATE_COMBINE", &obj_combine_size);
+	if (obj_combine_size != 0)
+		D_DEBUG(DB_IO, "Combine small updates up to %u bytes\n",
+			obj_combine_size);
+
 	rc = obj_utils_init();
 	if (rc)
 		goto out;
 
+	rc = obj_layout_cache_init();
+	if (rc)
+		goto out_utils;
+
 	rc = daos_rpc_register(&obj_proto_fmt, OBJ_PROTO_CLI_COUNT,
 				NULL, DAOS_OBJ_MODULE);
 	if (rc != 0) {
 		D_ERROR("failed to register daos obj RPCs: %d\n", rc);
-		D_GOTO(out, rc);
+		D_GOTO(out_layout, rc);
 	}
 
 	rc = obj_ec_codec_init();
-	if (rc != 0)
+	if (rc != 0) {
 		D_ERROR("failed to obj_ec_codec_init: %d\n", rc);
+		daos_rpc_unregister(&obj_proto_fmt);
+		D_GOTO(out_layout, rc);
+	}
+
+	return 0;
 
+out_layout:
+	obj_layout_cache_fini();
+out_utils:
+	obj_utils_fini();
 out:
 	return rc;
 }
@@ -79,5 +98,7 @@ dc_obj_fini(void)
 {
 	daos_rpc_unregister(&obj_proto_fmt);
 	obj_ec_codec_fini();
+	obj_layout_cache_fini();
+	obj_io_stat_fini();
 	obj_utils_fini();
 }
@@ -166,6 +166,7 @@ obj_alloc(void)
 		return NULL;
 
 	daos_hhash_hlink_init(&obj->cob_hlink, &obj_h_ops);
+	D_INIT_LIST_HEAD(&obj->cob_batches);
 	return obj;
 }
 
@@ -241,6 +242,14 @@ obj_layout_create(struct dc_object *obj, bool refresh)
 	pool = dc_hdl2pool(dc_cont_hdl2pool_hdl(obj->cob_coh));
 	D_ASSERT(pool != NULL);
 
+	if (pool->dp_io_bulk == DAOS_IO_BULK_ADAPTIVE &&
+	    obj->cob_io_stat == NULL) {
+		D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+		obj->cob_io_stat = obj_io_stat_get(pool->dp_pool,
+					pool_map_target_nr(pool->dp_map));
+		D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+	}
+
 	map = pl_map_find(pool->dp_pool, obj->cob_md.omd_id);
 	dc_pool_put(pool);
 
@@ -249,7 +258,11 @@ obj_layout_create(struct dc_object *obj, bool refresh)
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
-	rc = pl_obj_place(map, &obj->cob_md, NULL, &layout);
+	/* drop the layouts generated against the stale pool map */
+	if (refresh)
+		obj_layout_cache_evict(map->pl_uuid, pl_map_version(map));
+
+	rc = obj_layout_hold(map, &obj->cob_md, &layout);
 	pl_map_decref(map);
 	if (rc != 0) {
 		D_DEBUG(DB_PL, "Failed to generate object layout\n");
@@ -295,7 +308,7 @@ obj_layout_create(struct dc_object *obj, bool refresh)
 	}
 out:
 	if (layout)
-		pl_obj_layout_free(layout);
+		obj_layout_release(layout);
 	return rc;
 }
 
@@ -1027,6 +1040,8 @@ struct obj_auxi_args {
 	struct obj_req_tgts		 req_tgts;
 	crt_bulk_t			*bulks;
 	uint32_t			 bulk_nr;
+	/* dkeys of a multi-dkey update/fetch */
+	struct obj_multi_req		*multi;
 	d_list_t			 shard_task_head;
 	/* one shard_args embedded to save one memory allocation if the obj
 	 * request only targets for one shard.
@@ -1196,6 +1211,7 @@ obj_rw_bulk_prep(struct dc_object *obj, daos_iod_t *iods, d_sg_list_t *sgls,
 	daos_size_t		buf_size;
 	daos_size_t		sgls_size;
 	crt_bulk_perm_t		bulk_perm;
+	bool			bulk;
 	int			rc = 0;
 
 	if (obj_auxi->io_retry)
@@ -1219,9 +1235,17 @@ obj_rw_bulk_prep(struct dc_object *obj, daos_iod_t *iods, d_sg_list_t *sgls,
 	 */
 	data_size = sgls_size;
 
-	if (data_size >= OBJ_BULK_LIMIT ||
-		ec_mult_data_targets(obj_auxi->req_tgts.ort_grp_size,
-				     obj->cob_md.omd_id)) {
+	if (ec_mult_data_targets(obj_auxi->req_tgts.ort_grp_size,
+				 obj->cob_md.omd_id))
+		bulk = true;
+	else if (obj->cob_io_stat != NULL)
+		bulk = obj_io_stat_bulk(obj->cob_io_stat,
+				obj_auxi->req_tgts.ort_shard_tgts[0].st_tgt_id,
+				data_size);
+	else
+		bulk = data_size >= OBJ_BULK_LIMIT;
+
+	if (bulk) {
 		bulk_perm = update ? CRT_BULK_RO : CRT_BULK_RW;
 		rc = obj_bulk_prep(sgls, nr, bulk_bind, bulk_perm, task,
 				   obj_auxi);
@@ -2158,6 +2182,7 @@ shard_rw_prep(struct shard_auxi_args *shard_auxi, struct dc_object *obj,
 			     srv_io_mode != DIM_DTX_FULL_ENABLED);
 	shard_arg->dkey_hash		= dkey_hash;
 	shard_arg->bulks		= obj_auxi->bulks;
+	shard_arg->multi		= obj_auxi->multi;
 
 	return 0;
 }
@@ -2197,7 +2222,7 @@ obj_update_csums(const struct dc_object *obj, const daos_obj_update_t *args) {
 
 static int
 do_dc_obj_fetch(tse_task_t *task, daos_obj_fetch_t *args,
-		uint32_t flags, uint32_t shard)
+		uint32_t flags, uint32_t shard, struct obj_multi_req *multi)
 {
 	struct obj_auxi_args	*obj_auxi;
 	struct dc_object	*obj;
@@ -2236,6 +2261,7 @@ do_dc_obj_fetch(tse_task_t *task, daos_obj_fetch_t *args,
 		D_GOTO(out_task, rc);
 	}
 
+	obj_auxi->multi = multi;
 	dkey_hash = obj_dkey2hash(args->dkey);
 	obj_auxi->spec_shard = (flags & DIOF_TO_SPEC_SHARD) != 0;
 	if (obj_auxi->spec_shard)
@@ -2271,19 +2297,308 @@ dc_obj_fetch_shard(tse_task_t *task)
 {
 	struct daos_obj_fetch_shard	*args = dc_task_get_args(task);
 
-	return do_dc_obj_fetch(task, &args->base, args->flags, args->shard);
+	return do_dc_obj_fetch(task, &args->base, args->flags, args->shard,
+			       NULL);
 }
 
 int
 dc_obj_fetch(tse_task_t *task)
 {
-	return do_dc_obj_fetch(task, dc_task_get_args(task), 0, 0);
+	return do_dc_obj_fetch(task, dc_task_get_args(task), 0, 0, NULL);
+}
+
+/**
+ * Pending small updates against the same dkey of the same object, they are
+ * merged into a single update RPC. The batches of a dkey are chained: the
+ * first one is sent immediately, the next one collects the updates issued
+ * meanwhile and is sent once the previous one is done. So combining adds no
+ * latency to an isolated update, and the merged updates are applied in the
+ * order of the batches.
+ */
+struct obj_update_batch {
+	/* link on dc_object::cob_batches until the merged update is done */
+	d_list_t		 ob_link;
+	struct dc_object	*ob_obj;
+	tse_sched_t		*ob_sched;
+	/* task to send the merged update */
+	tse_task_t		*ob_task;
+	/* the next batch of the same dkey, sent once this one is done */
+	struct obj_update_batch	*ob_next;
+	/* the dkey of the first update, all updates share the same dkey */
+	daos_key_t		 ob_dkey;
+	daos_size_t		 ob_size;
+	unsigned int		 ob_nr;
+	unsigned int		 ob_task_nr;
+	unsigned int		 ob_cb_registered:1,
+				 /* no more updates can join the batch */
+				 ob_sealed:1;
+	daos_iod_t		 ob_iods[OBJ_COMBINE_MAX_IODS];
+	d_sg_list_t		 ob_sgls[OBJ_COMBINE_MAX_IODS];
+	/* the tasks of the merged updates, completed with the merged one */
+	tse_task_t		*ob_tasks[OBJ_COMBINE_MAX_IODS];
+};
+
+static int obj_update_internal(tse_task_t *task, daos_obj_update_t *args,
+			       struct obj_multi_req *multi, bool combine);
+
+static void
+obj_update_batch_seal(struct obj_update_batch *batch)
+{
+	D_SPIN_LOCK(&batch->ob_obj->cob_spin);
+	batch->ob_sealed = 1;
+	D_SPIN_UNLOCK(&batch->ob_obj->cob_spin);
+}
+
+/* The merged update is done, send the next batch of the dkey. */
+static void
+obj_update_batch_done(struct obj_update_batch *batch, int rc)
+{
+	struct dc_object	*obj = batch->ob_obj;
+	struct obj_update_batch	*next;
+	int			 i;
+
+	/* unlink first, the dkey of the batch is the one of its first task */
+	D_SPIN_LOCK(&obj->cob_spin);
+	d_list_del(&batch->ob_link);
+	next = batch->ob_next;
+	D_SPIN_UNLOCK(&obj->cob_spin);
+
+	if (next != NULL)
+		dc_task_schedule(next->ob_task, false);
+
+	for (i = 0; i < batch->ob_task_nr; i++)
+		tse_task_complete(batch->ob_tasks[i], rc);
+
+	obj_decref(obj);
+	D_FREE(batch);
+}
+
+static int
+obj_update_batch_comp(tse_task_t *task, void *data)
+{
+	struct obj_update_batch	*batch = *((struct obj_update_batch **)data);
+
+	obj_update_batch_done(batch, task->dt_result);
+	return 0;
+}
+
+static int
+obj_update_batch_send(tse_task_t *task)
+{
+	struct obj_update_batch	*batch = tse_task_get_priv(task);
+	daos_obj_update_t	*args = dc_task_get_args(task);
+	int			 rc;
+
+	/* no more updates can join the batch after this point */
+	obj_update_batch_seal(batch);
+	args->nr = batch->ob_nr;
+
+	/* the body is called again on retry, only register once */
+	if (!batch->ob_cb_registered) {
+		rc = tse_task_register_comp_cb(task, obj_update_batch_comp,
+					       &batch, sizeof(batch));
+		if (rc != 0) {
+			obj_update_batch_done(batch, rc);
+			tse_task_complete(task, rc);
+			return rc;
+		}
+		batch->ob_cb_registered = 1;
+	}
+
+	D_DEBUG(DB_IO, "send %u combined updates, %u iods "DF_U64" bytes\n",
+		batch->ob_task_nr, batch->ob_nr, batch->ob_size);
+
+	return obj_update_internal(task, args, NULL, false);
+}
+
+static struct obj_update_batch *
+obj_update_batch_create(tse_task_t *task, struct dc_object *obj,
+			daos_obj_update_t *args)
+{
+	struct obj_update_batch	*batch;
+	daos_obj_update_t	*b_args;
+	int			 rc;
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		return NULL;
+
+	D_INIT_LIST_HEAD(&batch->ob_link);
+	batch->ob_sched = tse_task2sched(task);
+	batch->ob_dkey = *args->dkey;
+
+	rc = dc_task_create(obj_update_batch_send, batch->ob_sched, NULL,
+			    &batch->ob_task);
+	if (rc != 0) {
+		D_FREE(batch);
+		return NULL;
+	}
+
+	b_args = dc_task_get_args(batch->ob_task);
+	b_args->oh = args->oh;
+	b_args->th = DAOS_TX_NONE;
+	b_args->dkey = &batch->ob_dkey;
+	b_args->iods = batch->ob_iods;
+	b_args->sgls = batch->ob_sgls;
+	tse_task_set_priv(batch->ob_task, batch);
+
+	obj_addref(obj);
+	batch->ob_obj = obj;
+	return batch;
+}
+
+/* Check whether two iods against the same akey can be in the same RPC. */
+static bool
+obj_update_iod_conflict(daos_iod_t *iod1, daos_iod_t *iod2)
+{
+	daos_recx_t	*rx1;
+	daos_recx_t	*rx2;
+	int		 i;
+	int		 j;
+
+	if (!daos_key_match(&iod1->iod_name, &iod2->iod_name))
+		return false;
+
+	/* Multiple updates against the same single value or the overlapped
+	 * extents in one RPC can not be ordered, leave them to different RPCs.
+	 */
+	if (iod1->iod_type != DAOS_IOD_ARRAY ||
+	    iod2->iod_type != DAOS_IOD_ARRAY ||
+	    iod1->iod_size != iod2->iod_size)
+		return true;
+
+	for (i = 0; i < iod1->iod_nr; i++) {
+		rx1 = &iod1->iod_recxs[i];
+		for (j = 0; j < iod2->iod_nr; j++) {
+			rx2 = &iod2->iod_recxs[j];
+			if (rx1->rx_idx < rx2->rx_idx + rx2->rx_nr &&
+			    rx2->rx_idx < rx1->rx_idx + rx1->rx_nr)
+				return true;
+		}
+	}
+	return false;
+}
+
+/* Check whether the update can join the open batch of its dkey. */
+static bool
+obj_update_batch_match(struct obj_update_batch *batch,
+		       daos_obj_update_t *args, daos_size_t size)
+{
+	int	i;
+	int	j;
+
+	if (batch->ob_nr + args->nr > OBJ_COMBINE_MAX_IODS ||
+	    batch->ob_size + size > obj_combine_size)
+		return false;
+
+	for (i = 0; i < args->nr; i++) {
+		for (j = 0; j < batch->ob_nr; j++) {
+			if (obj_update_iod_conflict(&batch->ob_iods[j],
+						    &args->iods[i]))
+				return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Try to merge the update into the open batch of its dkey, or to start a new
+ * batch. Returns 1 if the update has been taken by a batch, then the task
+ * will be completed when the merged update is done, 0 if the update cannot
+ * be combined, or a negative error.
+ */
+static int
+obj_update_combine(tse_task_t *task, struct dc_object *obj,
+		   daos_obj_update_t *args)
+{
+	struct obj_update_batch	*batch;
+	struct obj_update_batch	*prev;
+	struct obj_update_batch	*new = NULL;
+	tse_sched_t		*sched = tse_task2sched(task);
+	daos_size_t		 size;
+	bool			 created = false;
+
+	if (!daos_handle_is_inval(args->th) ||
+	    daos_oclass_is_ec(obj->cob_md.omd_id, NULL) ||
+	    args->nr > OBJ_COMBINE_MAX_IODS)
+		return 0;
+
+	size = daos_iods_len(args->iods, args->nr);
+	if (size == (daos_size_t)-1 || size > obj_combine_size / 2)
+		return 0;
+
+again:
+	D_SPIN_LOCK(&obj->cob_spin);
+	/* the last batch of the dkey, only that one can be open */
+	prev = NULL;
+	d_list_for_each_entry(batch, &obj->cob_batches, ob_link) {
+		if (batch->ob_sched == sched &&
+		    daos_key_match(&batch->ob_dkey, args->dkey))
+			prev = batch;
+	}
+
+	if (prev != NULL && !prev->ob_sealed) {
+		if (obj_update_batch_match(prev, args, size)) {
+			batch = prev;
+			goto join;
+		}
+		/* a conflicting or full batch is flushed before the update */
+		prev->ob_sealed = 1;
+	}
+
+	if (new == NULL) {
+		D_SPIN_UNLOCK(&obj->cob_spin);
+		new = obj_update_batch_create(task, obj, args);
+		if (new == NULL)
+			return -DER_NOMEM;
+		goto again;
+	}
+
+	batch = new;
+	new = NULL;
+	created = true;
+	d_list_add_tail(&batch->ob_link, &obj->cob_batches);
+	/* sent once the previous batch of the dkey is done */
+	if (prev != NULL)
+		prev->ob_next = batch;
+join:
+	memcpy(&batch->ob_iods[batch->ob_nr], args->iods,
+	       sizeof(*args->iods) * args->nr);
+	memcpy(&batch->ob_sgls[batch->ob_nr], args->sgls,
+	       sizeof(*args->sgls) * args->nr);
+	batch->ob_nr += args->nr;
+	batch->ob_size += size;
+	batch->ob_tasks[batch->ob_task_nr++] = task;
+
+	if (batch->ob_nr == OBJ_COMBINE_MAX_IODS ||
+	    batch->ob_size >= obj_combine_size)
+		batch->ob_sealed = 1;
+	D_SPIN_UNLOCK(&obj->cob_spin);
+
+	/* nothing in flight for the dkey, do not delay the update */
+	if (created && prev == NULL)
+		dc_task_schedule(batch->ob_task, true);
+
+	if (new != NULL) {
+		/* raced with others, the new batch is unused */
+		tse_task_decref(new->ob_task);
+		obj_decref(new->ob_obj);
+		D_FREE(new);
+	}
+	return 1;
 }
 
 int
 dc_obj_update(tse_task_t *task)
 {
-	daos_obj_update_t	*args = dc_task_get_args(task);
+	return obj_update_internal(task, dc_task_get_args(task), NULL,
+				   obj_combine_size != 0);
+}
+
+static int
+obj_update_internal(tse_task_t *task, daos_obj_update_t *args,
+		    struct obj_multi_req *multi, bool combine)
+{
 	struct obj_auxi_args	*obj_auxi;
 	struct dc_object	*obj;
 	struct daos_oclass_attr	*oca;
@@ -2305,6 +2620,17 @@ dc_obj_update(tse_task_t *task)
 		rc = -DER_NO_HDL;
 		goto out_task;
 	}
+
+	if (combine) {
+		rc = obj_update_combine(task, obj, args);
+		if (rc != 0) {
+			obj_decref(obj);
+			if (rc < 0)
+				goto out_task;
+			return 0;
+		}
+	}
+
 	rc = obj_ptr2pm_ver(obj, &map_ver);
 	if (rc) {
 		obj_decref(obj);
@@ -2328,6 +2654,7 @@ dc_obj_update(tse_task_t *task)
 		goto out_task;
 	}
 
+	obj_auxi->multi = multi;
 	dkey_hash = obj_dkey2hash(args->dkey);
 	rc = obj_req_get_tgts(obj, DAOS_OBJ_RPC_UPDATE, NULL, dkey_hash,
 			      tgt_set, map_ver, false, false,
@@ -2338,6 +2665,11 @@ dc_obj_update(tse_task_t *task)
 	if (rc)
 		goto out_task;
 
+	/* The DTX of a multi-dkey update is only in the CoS of its first dkey,
+	 * but it is still committed with the next update of the object, that
+	 * piggybacks the committable DTXs of the object, or by the batched
+	 * commit, so it is not committed synchronously.
+	 */
 	if (is_ec || DAOS_FAIL_CHECK(DAOS_DTX_COMMIT_SYNC))
 		obj_auxi->flags |= ORF_DTX_SYNC;
 
@@ -2361,6 +2693,278 @@ out_task:
 	return rc;
 }
 
+/*
+ * Multi-dkey update/fetch. The dkey I/Os are sorted by redundancy group, the
+ * dkeys of a group are stored on the same shards, so they are sent in RPCs of
+ * up to OBJ_MULTI_MAX_DKEYS dkeys. Each RPC is a sub-task of the API task and
+ * is applied by the server in a single VOS transaction.
+ */
+static void
+obj_multi_req_free(struct obj_multi_req *req)
+{
+	D_FREE(req->omr_dkeys);
+	D_FREE(req->omr_dkey_iods);
+	D_FREE(req->omr_iods);
+	D_FREE(req->omr_sgls);
+	D_FREE(req->omr_ios);
+	D_FREE(req);
+}
+
+/* Build the RPC of the @nr dkey I/Os of @ios indexed by @order. */
+static struct obj_multi_req *
+obj_multi_req_alloc(daos_dkey_io_t *ios, uint32_t *order, unsigned int nr,
+		    bool update)
+{
+	struct obj_multi_req	*req;
+	daos_dkey_io_t		*io;
+	unsigned int		 iod_nr = 0;
+	unsigned int		 i;
+
+	for (i = 0; i < nr; i++)
+		iod_nr += ios[order[i]].dio_nr;
+
+	D_ALLOC_PTR(req);
+	if (req == NULL)
+		return NULL;
+
+	D_ALLOC_ARRAY(req->omr_dkeys, nr);
+	D_ALLOC_ARRAY(req->omr_dkey_iods, nr);
+	D_ALLOC_ARRAY(req->omr_ios, nr);
+	D_ALLOC_ARRAY(req->omr_iods, iod_nr);
+	D_ALLOC_ARRAY(req->omr_sgls, iod_nr);
+	if (req->omr_dkeys == NULL || req->omr_dkey_iods == NULL ||
+	    req->omr_ios == NULL || req->omr_iods == NULL ||
+	    req->omr_sgls == NULL) {
+		obj_multi_req_free(req);
+		return NULL;
+	}
+
+	req->omr_update = update;
+	req->omr_dkey_nr = nr;
+	req->omr_iod_nr = iod_nr;
+	for (iod_nr = 0, i = 0; i < nr; i++) {
+		io = &ios[order[i]];
+		req->omr_ios[i] = io;
+		req->omr_dkeys[i] = *io->dio_dkey;
+		req->omr_dkey_iods[i] = io->dio_nr;
+		memcpy(&req->omr_iods[iod_nr], io->dio_iods,
+		       sizeof(*io->dio_iods) * io->dio_nr);
+		if (io->dio_sgls != NULL)
+			memcpy(&req->omr_sgls[iod_nr], io->dio_sgls,
+			       sizeof(*io->dio_sgls) * io->dio_nr);
+		iod_nr += io->dio_nr;
+	}
+	return req;
+}
+
+static int
+obj_multi_req_comp(tse_task_t *task, void *data)
+{
+	struct obj_multi_req	*req = *((struct obj_multi_req **)data);
+	daos_dkey_io_t		*io;
+	unsigned int		 at = 0;
+	unsigned int		 i;
+	unsigned int		 j;
+
+	/* return the record sizes and the number of filled iovs of fetch */
+	for (i = 0; !req->omr_update && task->dt_result == 0 &&
+		    i < req->omr_dkey_nr; i++) {
+		io = req->omr_ios[i];
+		for (j = 0; j < io->dio_nr; j++, at++) {
+			io->dio_iods[j].iod_size = req->omr_iods[at].iod_size;
+			if (io->dio_sgls != NULL)
+				io->dio_sgls[j].sg_nr_out =
+					req->omr_sgls[at].sg_nr_out;
+		}
+	}
+
+	obj_multi_req_free(req);
+	return 0;
+}
+
+static int
+obj_multi_req_send(tse_task_t *task)
+{
+	struct obj_multi_req	*req = tse_task_get_priv(task);
+	struct obj_multi_req	*multi;
+
+	/* a single dkey is sent as a regular update/fetch */
+	multi = req->omr_dkey_nr > 1 ? req : NULL;
+	if (req->omr_update)
+		return obj_update_internal(task, dc_task_get_args(task), multi,
+					   false);
+
+	return do_dc_obj_fetch(task, dc_task_get_args(task), 0, 0, multi);
+}
+
+static int
+obj_multi_req_create(tse_task_t *task, daos_obj_multi_rw_t *args,
+		     uint32_t *order, unsigned int nr, bool update,
+		     tse_task_t **sub_task)
+{
+	struct obj_multi_req	*req;
+	daos_obj_rw_t		*rw_args;
+	tse_task_t		*sub;
+	int			 rc;
+
+	req = obj_multi_req_alloc(args->ios, order, nr, update);
+	if (req == NULL)
+		return -DER_NOMEM;
+
+	rc = dc_task_create(obj_multi_req_send, tse_task2sched(task), NULL,
+			    &sub);
+	if (rc != 0) {
+		obj_multi_req_free(req);
+		return rc;
+	}
+
+	rw_args = dc_task_get_args(sub);
+	rw_args->oh	= args->oh;
+	rw_args->th	= args->th;
+	rw_args->dkey	= &req->omr_dkeys[0];
+	rw_args->nr	= req->omr_iod_nr;
+	rw_args->iods	= req->omr_iods;
+	if (args->ios[0].dio_sgls != NULL)
+		rw_args->sgls = req->omr_sgls;
+	tse_task_set_priv(sub, req);
+
+	rc = tse_task_register_comp_cb(sub, obj_multi_req_comp, &req,
+				       sizeof(req));
+	if (rc != 0) {
+		tse_task_decref(sub);
+		obj_multi_req_free(req);
+		return rc;
+	}
+
+	*sub_task = sub;
+	return 0;
+}
+
+static int
+obj_multi_rw(tse_task_t *task, bool update)
+{
+	daos_obj_multi_rw_t	*args = dc_task_get_args(task);
+	struct dc_object	*obj;
+	daos_dkey_io_t		*io;
+	tse_task_t		**subs = NULL;
+	uint32_t		*grp_of = NULL;
+	uint32_t		*grp_end = NULL;
+	uint32_t		*order = NULL;
+	unsigned int		 max_dkeys;
+	unsigned int		 grp_nr;
+	unsigned int		 sub_nr = 0;
+	unsigned int		 start;
+	unsigned int		 nr;
+	unsigned int		 i;
+	unsigned int		 j;
+	int			 rc = 0;
+
+	if (args->nr == 0) {
+		tse_task_complete(task, 0);
+		return 0;
+	}
+
+	if (args->ios == NULL)
+		D_GOTO(out_task, rc = -DER_INVAL);
+
+	/* the sgls of the dkeys are concatenated, all or none can be NULL */
+	for (i = 0; i < args->nr; i++) {
+		io = &args->ios[i];
+		if (io->dio_dkey == NULL || io->dio_dkey->iov_buf == NULL ||
+		    io->dio_nr == 0 || io->dio_iods == NULL ||
+		    (io->dio_sgls == NULL) != (args->ios[0].dio_sgls == NULL)) {
+			D_ERROR("Invalid dkey I/O %u\n", i);
+			D_GOTO(out_task, rc = -DER_INVAL);
+		}
+	}
+
+	obj = obj_hdl2ptr(args->oh);
+	if (obj == NULL)
+		D_GOTO(out_task, rc = -DER_NO_HDL);
+
+	/* EC I/O is encoded per dkey, do not merge dkeys for EC objects */
+	max_dkeys = daos_oclass_is_ec(obj->cob_md.omd_id, NULL) ?
+		    1 : OBJ_MULTI_MAX_DKEYS;
+	D_RWLOCK_RDLOCK(&obj->cob_lock);
+	grp_nr = obj->cob_shards_nr / obj_get_grp_size(obj);
+	D_RWLOCK_UNLOCK(&obj->cob_lock);
+	obj_decref(obj);
+	D_ASSERT(grp_nr > 0);
+
+	D_ALLOC_ARRAY(grp_of, args->nr);
+	D_ALLOC_ARRAY(order, args->nr);
+	D_ALLOC_ARRAY(grp_end, grp_nr + 1);
+	if (grp_of == NULL || order == NULL || grp_end == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	/* counting sort by group, stable so each group keeps the user order */
+	for (i = 0; i < args->nr; i++) {
+		grp_of[i] = obj_dkey2hash(args->ios[i].dio_dkey) % grp_nr;
+		grp_end[grp_of[i] + 1]++;
+	}
+	for (j = 0; j < grp_nr; j++) {
+		sub_nr += (grp_end[j + 1] + max_dkeys - 1) / max_dkeys;
+		grp_end[j + 1] += grp_end[j];
+	}
+	/* grp_end[j] is the start of group j, then its end once sorted */
+	for (i = 0; i < args->nr; i++)
+		order[grp_end[grp_of[i]]++] = i;
+
+	D_ALLOC_ARRAY(subs, sub_nr);
+	if (subs == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (start = 0, sub_nr = 0, j = 0; j < grp_nr; j++) {
+		for (i = start; i < grp_end[j]; i += nr) {
+			nr = min(grp_end[j] - i, max_dkeys);
+			rc = obj_multi_req_create(task, args, &order[i], nr,
+						  update, &subs[sub_nr]);
+			if (rc != 0)
+				D_GOTO(out_subs, rc);
+			sub_nr++;
+		}
+		start = grp_end[j];
+	}
+
+	D_DEBUG(DB_IO, "%s %u dkeys in %u RPCs\n", update ? "update" : "fetch",
+		args->nr, sub_nr);
+
+	rc = tse_task_register_deps(task, sub_nr, subs);
+	if (rc != 0)
+		D_GOTO(out_subs, rc);
+
+	/* the API task is completed once all the RPCs are done */
+	for (i = 0; i < sub_nr; i++)
+		dc_task_schedule(subs[i], true);
+	goto out;
+
+out_subs:
+	for (i = 0; i < sub_nr; i++)
+		tse_task_complete(subs[i], rc);
+out:
+	D_FREE(subs);
+	D_FREE(grp_end);
+	D_FREE(order);
+	D_FREE(grp_of);
+	if (rc == 0)
+		return 0;
+out_task:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+int
+dc_obj_update_multi(tse_task_t *task)
+{
+	return obj_multi_rw(task, true);
+}
+
+int
+dc_obj_fetch_multi(tse_task_t *task)
+{
+	return obj_multi_rw(task, false);
+}
+
 static int
 shard_list_prep(struct shard_auxi_args *shard_auxi, struct dc_object *obj,
 		struct obj_auxi_args *obj_auxi, uint64_t dkey_hash,
@@ -118,6 +118,10 @@ struct rw_cb_args {
 	d_sg_list_t		*rwaa_sgls;
 	struct dc_obj_shard	*dobj;
 	unsigned int		*map_ver;
+	/* for the adaptive inline/bulk selection */
+	struct obj_io_stat	*io_stat;
+	daos_size_t		 io_size;
+	uint64_t		 io_start;
 };
 
 int dc_rw_cb_csum_verify(const struct rw_cb_args *rw_args)
@@ -214,6 +218,12 @@ dc_rw_cb(tse_task_t *task, void *arg)
 	}
 	*rw_args->map_ver = obj_reply_map_version_get(rw_args->rpc);
 
+	if (rw_args->io_stat != NULL)
+		obj_io_stat_record(rw_args->io_stat,
+				   rw_args->dobj->do_target_id, rw_args->io_size,
+				   orw->orw_bulks.ca_count > 0,
+				   daos_get_ntime() - rw_args->io_start);
+
 	orwo = crt_reply_get(rw_args->rpc);
 	if (opc == DAOS_OBJ_RPC_FETCH) {
 		daos_iod_t	*iods;
@@ -417,6 +427,17 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	orw->orw_dkey = *dkey;
 	orw->orw_iods.ca_count = nr;
 	orw->orw_iods.ca_arrays = api_args->iods;
+	if (args->multi != NULL) {
+		orw->orw_dkeys.ca_count = args->multi->omr_dkey_nr;
+		orw->orw_dkeys.ca_arrays = args->multi->omr_dkeys;
+		orw->orw_dkey_iods.ca_count = args->multi->omr_dkey_nr;
+		orw->orw_dkey_iods.ca_arrays = args->multi->omr_dkey_iods;
+	} else {
+		orw->orw_dkeys.ca_count = 0;
+		orw->orw_dkeys.ca_arrays = NULL;
+		orw->orw_dkey_iods.ca_count = 0;
+		orw->orw_dkey_iods.ca_arrays = NULL;
+	}
 
 	D_DEBUG(DB_TRACE, "opc %d "DF_UOID" %d %s rank %d tag %d eph "
 		DF_U64", DTI = "DF_DTI"\n", opc, DP_UOID(shard->do_id),
@@ -448,6 +469,11 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	rw_args.dobj = shard;
 	/* remember the sgl to copyout the data inline for fetch */
 	rw_args.rwaa_sgls = (opc == DAOS_OBJ_RPC_FETCH) ? sgls : NULL;
+	rw_args.io_stat = shard->do_obj->cob_io_stat;
+	if (rw_args.io_stat != NULL) {
+		rw_args.io_size = daos_sgls_packed_size(sgls, nr, NULL);
+		rw_args.io_start = daos_get_ntime();
+	}
 
 	if (DAOS_FAIL_CHECK(DAOS_SHARD_OBJ_RW_CRT_ERROR))
 		D_GOTO(out_args, rc = -DER_HG);
@@ -758,6 +784,15 @@ dc_obj_shard_list(struct dc_obj_shard *obj_shard, enum obj_rpc_opc opc,
 	oei->oei_epoch		= args->la_auxi.epoch;
 	oei->oei_nr		= *obj_args->nr;
 	oei->oei_rec_type	= obj_args->type;
+	/** filter of the dkeys, the values of a KV scan are fetched later */
+	if (opc == DAOS_OBJ_DKEY_RPC_ENUMERATE && obj_args->filter != NULL) {
+		if (obj_args->filter->ksf_flags & DAOS_KV_SCAN_PREFIX)
+			oei->oei_flags = OBJ_ENUM_KEY_PREFIX;
+		else if (obj_args->filter->ksf_flags & DAOS_KV_SCAN_RANGE)
+			oei->oei_flags = OBJ_ENUM_KEY_RANGE;
+		oei->oei_key_lo	= obj_args->filter->ksf_lo;
+		oei->oei_key_hi	= obj_args->filter->ksf_hi;
+	}
 	uuid_copy(oei->oei_pool_uuid, pool->dp_pool);
 	uuid_copy(oei->oei_co_hdl, cont_hdl_uuid);
 	uuid_copy(oei->oei_co_uuid, cont_uuid);
@@ -62,6 +62,34 @@
 extern bool	cli_bypass_rpc;
 /** Switch of server-side IO dispatch */
 extern unsigned int	srv_io_mode;
+/**
+ * Size cap (in bytes) of the client update combining, small updates against
+ * the same dkey are merged into one RPC. Zero means disabled.
+ */
+extern unsigned int	obj_combine_size;
+
+/** Max number of iods in a combined update RPC */
+#define OBJ_COMBINE_MAX_IODS	64
+
+/** Max number of dkeys in a multi-dkey update/fetch RPC */
+#define OBJ_MULTI_MAX_DKEYS	128
+
+/**
+ * One RPC of a multi-dkey update/fetch, all the dkeys belong to the same
+ * redundancy group. The iods and sgls of the dkeys are concatenated.
+ */
+struct obj_multi_req {
+	daos_key_t		*omr_dkeys;
+	/* number of iods of each dkey */
+	uint32_t		*omr_dkey_iods;
+	unsigned int		 omr_dkey_nr;
+	unsigned int		 omr_iod_nr;
+	daos_iod_t		*omr_iods;
+	d_sg_list_t		*omr_sgls;
+	/* dkey I/Os of the user, to return the fetched sizes */
+	daos_dkey_io_t		**omr_ios;
+	bool			 omr_update;
+};
 
 /** client object shard */
 struct dc_obj_shard {
@@ -121,6 +149,10 @@ struct dc_object {
 	uint64_t		*cob_time_fetch_leader;
 	/** shard object ptrs */
 	struct dc_obj_layout	*cob_shards;
+	/** open batches of combined updates, protected by cob_spin */
+	d_list_t		 cob_batches;
+	/** inline/bulk statistics of the pool, NULL for the fixed mode */
+	struct obj_io_stat	*cob_io_stat;
 };
 
 /** EC codec for object EC encoding/decoding */
@@ -196,6 +228,8 @@ struct shard_rw_args {
 	struct dtx_id		 dti;
 	uint64_t		 dkey_hash;
 	crt_bulk_t		*bulks;
+	/* dkeys of a multi-dkey I/O, NULL for a single dkey */
+	struct obj_multi_req	*multi;
 };
 
 struct shard_punch_args {
@@ -325,6 +359,7 @@ void obj_shard_decref(struct dc_obj_shard *shard);
 void obj_shard_addref(struct dc_obj_shard *shard);
 void obj_addref(struct dc_object *obj);
 void obj_decref(struct dc_object *obj);
+struct dc_object *obj_hdl2ptr(daos_handle_t oh);
 int obj_get_grp_size(struct dc_object *obj);
 
 struct ds_obj_exec_arg {
@@ -365,6 +400,22 @@ obj_dkey2hash(daos_key_t *dkey)
 int  obj_utils_init(void);
 void obj_utils_fini(void);
 
+/* cli_layout.c */
+int  obj_layout_cache_init(void);
+void obj_layout_cache_fini(void);
+int  obj_layout_hold(struct pl_map *map, struct daos_obj_md *md,
+		     struct pl_obj_layout **layout_pp);
+void obj_layout_release(struct pl_obj_layout *layout);
+void obj_layout_cache_evict(uuid_t pool, uint32_t map_ver);
+
+/* cli_bulk.c */
+struct obj_io_stat;
+struct obj_io_stat *obj_io_stat_get(uuid_t pool, unsigned int tgt_nr);
+void obj_io_stat_fini(void);
+bool obj_io_stat_bulk(struct obj_io_stat *ios, uint32_t tgt, daos_size_t size);
+void obj_io_stat_record(struct obj_io_stat *ios, uint32_t tgt,
+			daos_size_t size, bool bulk, uint64_t lat);
+
 /* obj_class.c */
 int obj_ec_codec_init(void);
 void obj_ec_codec_fini(void);
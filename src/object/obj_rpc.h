@@ -50,7 +50,7 @@
  * These are for daos_rpc::dr_opc and DAOS_RPC_OPCODE(opc, ...) rather than
  * crt_req_create(..., opc, ...). See daos_rpc.h.
  */
-#define DAOS_OBJ_VERSION 1
+#define DAOS_OBJ_VERSION 3
 /* LIST of internal RPCS in form of:
  * OPCODE, flags, FMT, handler, corpc_hdlr,
  */
@@ -122,7 +122,14 @@ enum obj_rpc_flags {
 	ORF_DTX_SYNC		= (1 << 2),
 };
 
-/* common for update/fetch */
+/*
+ * common for update/fetch
+ *
+ * A multi-dkey update/fetch carries the dkeys in orw_dkeys, the iods, sgls
+ * and bulks of all the dkeys are concatenated and orw_dkey_iods gives the
+ * number of iods of each dkey. orw_dkey is then the first dkey and orw_nr
+ * the total number of iods. orw_dkeys is empty for a single dkey I/O.
+ */
 #define DAOS_ISEQ_OBJ_RW	/* input fields */		 \
 	((struct dtx_id)	(orw_dti)		CRT_VAR) \
 	((daos_unit_oid_t)	(orw_oid)		CRT_VAR) \
@@ -140,7 +147,9 @@ enum obj_rpc_flags {
 	((daos_iod_t)		(orw_iods)		CRT_ARRAY) \
 	((d_sg_list_t)		(orw_sgls)		CRT_ARRAY) \
 	((crt_bulk_t)		(orw_bulks)		CRT_ARRAY) \
-	((struct daos_shard_tgt) (orw_shard_tgts)	CRT_ARRAY)
+	((struct daos_shard_tgt) (orw_shard_tgts)	CRT_ARRAY) \
+	((daos_key_t)		(orw_dkeys)		CRT_ARRAY) \
+	((uint32_t)		(orw_dkey_iods)		CRT_ARRAY)
 
 #define DAOS_OSEQ_OBJ_RW	/* output fields */		 \
 	((int32_t)		(orw_ret)		CRT_VAR) \
@@ -167,9 +176,11 @@ CRT_RPC_DECLARE(obj_fetch,	DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
 	((uint32_t)		(oei_map_ver)		CRT_VAR) \
 	((uint32_t)		(oei_nr)		CRT_VAR) \
 	((uint32_t)		(oei_rec_type)		CRT_VAR) \
-	((uint32_t)		(oei_pad)		CRT_VAR) \
+	((uint32_t)		(oei_flags)		CRT_VAR) \
 	((daos_key_t)		(oei_dkey)		CRT_VAR) \
 	((daos_key_t)		(oei_akey)		CRT_VAR) \
+	((daos_key_t)		(oei_key_lo)		CRT_VAR) \
+	((daos_key_t)		(oei_key_hi)		CRT_VAR) \
 	((daos_anchor_t)	(oei_anchor)		CRT_VAR) \
 	((daos_anchor_t)	(oei_dkey_anchor)	CRT_VAR) \
 	((daos_anchor_t)	(oei_akey_anchor)	CRT_VAR) \
@@ -280,6 +280,54 @@ dc_obj_update_task_create(daos_handle_t oh, daos_handle_t th,
 	return 0;
 }
 
+static int
+dc_obj_multi_task_create(tse_task_func_t func, daos_handle_t oh,
+			 daos_handle_t th, unsigned int nr,
+			 daos_dkey_io_t *ios, daos_event_t *ev,
+			 tse_sched_t *tse, tse_task_t **task)
+{
+	daos_obj_multi_rw_t	*args;
+	int			 rc;
+
+	rc = dc_task_create(func, tse, ev, task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(*task);
+	args->oh	= oh;
+	args->th	= th;
+	args->nr	= nr;
+	args->ios	= ios;
+
+	return 0;
+}
+
+int
+dc_obj_fetch_multi_task_create(daos_handle_t oh, daos_handle_t th,
+			       unsigned int nr, daos_dkey_io_t *ios,
+			       daos_event_t *ev, tse_sched_t *tse,
+			       tse_task_t **task)
+{
+	daos_obj_multi_rw_t	*args;
+
+	DAOS_API_ARG_ASSERT(*args, OBJ_FETCH_MULTI);
+	return dc_obj_multi_task_create(dc_obj_fetch_multi, oh, th, nr, ios,
+					ev, tse, task);
+}
+
+int
+dc_obj_update_multi_task_create(daos_handle_t oh, daos_handle_t th,
+				unsigned int nr, daos_dkey_io_t *ios,
+				daos_event_t *ev, tse_sched_t *tse,
+				tse_task_t **task)
+{
+	daos_obj_multi_rw_t	*args;
+
+	DAOS_API_ARG_ASSERT(*args, OBJ_UPDATE_MULTI);
+	return dc_obj_multi_task_create(dc_obj_update_multi, oh, th, nr, ios,
+					ev, tse, task);
+}
+
 int
 dc_obj_list_dkey_task_create(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 			     daos_key_desc_t *kds, d_sg_list_t *sgl,
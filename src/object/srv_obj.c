@@ -837,6 +837,7 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	bool			bulk_bind;
 	daos_iod_t		*cpy_iods = NULL;
 	daos_iod_t		*tmp_iods = orw->orw_iods.ca_arrays;
+	unsigned int		dkey_nr = orw->orw_dkeys.ca_count;
 	int			i, err, rc = 0;
 
 	D_TIME_START(tls->ot_sp, time_start, OBJ_PF_UPDATE_LOCAL);
@@ -861,6 +862,14 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	       orw->orw_bulks.ca_count != 0);
 	oca = daos_oclass_attr_find(orw->orw_oid.id_pub);
 
+	if (dkey_nr != 0 && (oca->ca_resil == DAOS_RES_EC ||
+			     orw->orw_dkey_iods.ca_count != dkey_nr)) {
+		D_ERROR(DF_UOID" invalid multi-dkey I/O, %u dkeys %u iod nrs\n",
+			DP_UOID(orw->orw_oid), dkey_nr,
+			(unsigned int)orw->orw_dkey_iods.ca_count);
+		D_GOTO(out, rc = -DER_PROTO);
+	}
+
 	if (oca->ca_resil == DAOS_RES_EC) {
 		unsigned int	tgt_idx = orw->orw_oid.id_shard -
 					  orw->orw_start_shard;
@@ -899,9 +908,16 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	/* Prepare IO descriptor */
 	if (obj_rpc_is_update(rpc)) {
 		bulk_op = CRT_BULK_GET;
-		rc = vos_update_begin(cont->sc_hdl, orw->orw_oid,
-				      orw->orw_epoch, dkey, orw->orw_nr,
-				      tmp_iods, &ioh, dth);
+		if (dkey_nr != 0)
+			rc = vos_update_begin_multi(cont->sc_hdl, orw->orw_oid,
+					orw->orw_epoch, dkey_nr,
+					orw->orw_dkeys.ca_arrays,
+					orw->orw_dkey_iods.ca_arrays,
+					orw->orw_nr, tmp_iods, &ioh, dth);
+		else
+			rc = vos_update_begin(cont->sc_hdl, orw->orw_oid,
+					      orw->orw_epoch, dkey, orw->orw_nr,
+					      tmp_iods, &ioh, dth);
 		if (rc) {
 			D_ERROR(DF_UOID" Update begin failed: %d\n",
 				DP_UOID(orw->orw_oid), rc);
@@ -916,9 +932,17 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 			obj_fetch_csum_init(cont_hdl, orw, orwo);
 			obj_fetch_csums_link(orw, orwo);
 		}
-		rc = vos_fetch_begin(cont->sc_hdl, orw->orw_oid, orw->orw_epoch,
-				     dkey, orw->orw_nr, tmp_iods, size_fetch,
-				     &ioh);
+		if (dkey_nr != 0)
+			rc = vos_fetch_begin_multi(cont->sc_hdl, orw->orw_oid,
+					orw->orw_epoch, dkey_nr,
+					orw->orw_dkeys.ca_arrays,
+					orw->orw_dkey_iods.ca_arrays,
+					orw->orw_nr, tmp_iods, size_fetch,
+					&ioh);
+		else
+			rc = vos_fetch_begin(cont->sc_hdl, orw->orw_oid,
+					     orw->orw_epoch, dkey, orw->orw_nr,
+					     tmp_iods, size_fetch, &ioh);
 		if (!size_fetch)
 			obj_fetch_csums_unlink(orw);
 
@@ -1178,6 +1202,19 @@ out:
 		ds_cont_child_put(cont);
 }
 
+/* Whether the object has only one shard in its redundancy group. */
+static bool
+obj_is_single_replica(daos_unit_oid_t *oid)
+{
+	struct daos_oclass_attr	*oca;
+
+	oca = daos_oclass_attr_find(oid->id_pub);
+	if (oca == NULL)
+		return false;
+
+	return daos_oclass_grp_size(oca) == 1;
+}
+
 static int
 obj_tgt_update(struct dtx_leader_handle *dlh, void *arg, int idx,
 		  dtx_sub_comp_cb_t comp_cb)
@@ -1258,6 +1295,49 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 		D_GOTO(out, rc);
 	}
 
+	/* Nobody to coordinate with for single replica object, then update
+	 * it directly as committed, neither the DTX records, the DTX entry in
+	 * the active table nor the CoS cache is needed. Only the committed DTX
+	 * entry is created in the same PMDK transaction, so that the resent
+	 * RPC is not executed again with a new epoch.
+	 */
+	if (orw->orw_shard_tgts.ca_count == 0 &&
+	    obj_is_single_replica(&orw->orw_oid)) {
+		struct dtx_handle	dth = { 0 };
+
+		if (orw->orw_flags & ORF_RESEND) {
+			daos_epoch_t	tmp = 0;
+
+			rc = dtx_handle_resend(cont->sc_hdl, &orw->orw_oid,
+					       &orw->orw_dti,
+					       orw->orw_dkey_hash, false, &tmp);
+			if (rc == -DER_ALREADY)
+				D_GOTO(out, rc = 0);
+			/* Prepared by the DTX path, let the client retry
+			 * until it is committed.
+			 */
+			if (rc == 0)
+				D_GOTO(out, rc = -DER_INPROGRESS);
+			if (rc != -DER_NONEXIST)
+				D_GOTO(out, rc);
+		} else if (DAOS_FAIL_CHECK(DAOS_DTX_LOST_RPC_REQUEST)) {
+			goto cleanup;
+		}
+
+		dtx_handle_init(&orw->orw_dti, &orw->orw_oid, cont->sc_hdl,
+				orw->orw_epoch, orw->orw_dkey_hash,
+				orw->orw_map_ver, DAOS_INTENT_UPDATE, NULL,
+				NULL, 0, true, true, &dth);
+		dth.dth_solo = 1;
+
+		D_TIME_START(tls->ot_sp, time_start, OBJ_PF_UPDATE);
+		rc = obj_local_rw(rpc, cont_hdl, cont, &dth);
+		if (rc != 0)
+			D_ERROR(DF_UOID": error=%d.\n",
+				DP_UOID(orw->orw_oid), rc);
+		D_GOTO(out, rc);
+	}
+
 	/* Handle resend. */
 	if (orw->orw_flags & ORF_RESEND) {
 		daos_epoch_t	tmp = 0;
@@ -1427,6 +1507,9 @@ obj_iter_vos(crt_rpc_t *rpc, struct vos_iter_anchors *anchors,
 		enum_arg->fill_recxs = true;
 	} else if (opc == DAOS_OBJ_DKEY_RPC_ENUMERATE) {
 		type = VOS_ITER_DKEY;
+		enum_arg->key_flags = oei->oei_flags;
+		enum_arg->key_lo = oei->oei_key_lo;
+		enum_arg->key_hi = oei->oei_key_hi;
 	} else if (opc == DAOS_OBJ_AKEY_RPC_ENUMERATE) {
 		type = VOS_ITER_AKEY;
 	} else {
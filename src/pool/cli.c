@@ -89,6 +89,8 @@ pool_free(struct d_hlink *hlink)
 
 	if (pool->dp_map != NULL)
 		pool_map_decref(pool->dp_map);
+	if (pool->dp_map_enc != NULL)
+		D_FREE(pool->dp_map_enc);
 
 	rsvc_client_fini(&pool->dp_client);
 	if (pool->dp_sys != NULL)
@@ -414,6 +416,7 @@ pool_connect_cp(tse_task_t *task, void *data)
 		D_GOTO(out, rc);
 	}
 
+	pool->dp_io_bulk = pco->pco_io_bulk;
 	rc = process_query_reply(pool, map_buf, pco->pco_op.po_map_version,
 				 pco->pco_op.po_hint.sh_rank,
 				 &pco->pco_space, &pco->pco_rebuild_st,
@@ -774,12 +777,15 @@ out_task:
 }
 
 #define DC_POOL_GLOB_MAGIC	(0x16da0386)
+/* the pool map is encoded by pool_buf_encode() */
+#define DC_POOL_GLOB_MAGIC_ENC	(0x16da0387)
 
 /* Structure of global buffer for dc_pool */
 struct dc_pool_glob {
-	/* magic number, DC_POOL_GLOB_MAGIC */
+	/* magic number, DC_POOL_GLOB_MAGIC or DC_POOL_GLOB_MAGIC_ENC */
 	uint32_t	dpg_magic;
-	uint32_t	dpg_padding;
+	/* size of the encoded pool map, only for DC_POOL_GLOB_MAGIC_ENC */
+	uint32_t	dpg_map_len;
 	/* pool UUID, pool handle UUID, and capas */
 	uuid_t		dpg_pool;
 	uuid_t		dpg_pool_hdl;
@@ -788,16 +794,18 @@ struct dc_pool_glob {
 	uint32_t	dpg_map_version;
 	/* number of component of poolbuf, same as pool_buf::pb_nr */
 	uint32_t	dpg_map_pb_nr;
+	/* poolbuf, or dpg_map_len bytes of encoded poolbuf */
 	struct pool_buf	dpg_map_buf[0];
+	/* DAOS_PROP_PO_IO_BULK, one byte, only for DC_POOL_GLOB_MAGIC_ENC */
 	/* rsvc_client */
 	/* dc_mgmt_sys */
 };
 
 static inline daos_size_t
-dc_pool_glob_buf_size(unsigned int pb_nr, size_t client_len, size_t sys_len)
+dc_pool_glob_buf_size(size_t map_len, size_t client_len, size_t sys_len)
 {
 	return offsetof(struct dc_pool_glob, dpg_map_buf) +
-	       pool_buf_size(pb_nr) + client_len + sys_len;
+	       map_len + client_len + sys_len;
 }
 
 static inline void
@@ -832,24 +840,77 @@ swap_pool_glob(struct dc_pool_glob *pool_glob)
 	D_ASSERT(pool_glob != NULL);
 
 	D_SWAP32S(&pool_glob->dpg_magic);
-	/* skip pool_glob->dpg_padding */
+	D_SWAP32S(&pool_glob->dpg_map_len);
 	/* skip pool_glob->dpg_pool (uuid_t) */
 	/* skip pool_glob->dpg_pool_hdl (uuid_t) */
 	D_SWAP64S(&pool_glob->dpg_capas);
 	D_SWAP32S(&pool_glob->dpg_map_version);
 	D_SWAP32S(&pool_glob->dpg_map_pb_nr);
-	swap_pool_buf(pool_glob->dpg_map_buf);
+	/* the encoded poolbuf is made of bytes */
+	if (pool_glob->dpg_magic == DC_POOL_GLOB_MAGIC)
+		swap_pool_buf(pool_glob->dpg_map_buf);
+}
+
+/*
+ * Encode the pool map for local2global, unless it has been encoded at the
+ * current map version already. Every local2global of a handle is called at
+ * least twice, to get the size and to fill the buffer, and a handle is often
+ * shared many times, so the map is only extracted and encoded once.
+ */
+static int
+dc_pool_map_encode(struct dc_pool *pool)
+{
+	struct pool_buf	*map_buf;
+	uint32_t	 map_version;
+	void		*enc;
+	size_t		 len;
+	int		 rc;
+
+	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+	map_version = pool_map_get_version(pool->dp_map);
+	rc = pool->dp_map_enc != NULL &&
+	     pool->dp_map_enc_ver == map_version;
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+	if (rc)
+		return 0;
+
+	D_RWLOCK_WRLOCK(&pool->dp_map_lock);
+	map_version = pool_map_get_version(pool->dp_map);
+	if (pool->dp_map_enc != NULL && pool->dp_map_enc_ver == map_version)
+		D_GOTO(out, rc = 0);
+
+	rc = pool_buf_extract(pool->dp_map, &map_buf);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	len = pool_buf_encode(map_buf, NULL);
+	D_ALLOC(enc, len);
+	if (enc == NULL)
+		D_GOTO(out_map_buf, rc = -DER_NOMEM);
+	pool_buf_encode(map_buf, enc);
+
+	D_DEBUG(DF_DSMC, DF_UUID": pool map v%u of %ld bytes encoded in %zu\n",
+		DP_UUID(pool->dp_pool), map_version,
+		pool_buf_size(map_buf->pb_nr), len);
+	if (pool->dp_map_enc != NULL)
+		D_FREE(pool->dp_map_enc);
+	pool->dp_map_enc = enc;
+	pool->dp_map_enc_len = len;
+	pool->dp_map_enc_ver = map_version;
+	pool->dp_map_enc_nr = map_buf->pb_nr;
+out_map_buf:
+	pool_buf_free(map_buf);
+out:
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+	return rc;
 }
 
 static int
 dc_pool_l2g(daos_handle_t poh, d_iov_t *glob)
 {
 	struct dc_pool		*pool;
-	struct pool_buf		*map_buf;
-	uint32_t		 map_version;
 	struct dc_pool_glob	*pool_glob;
 	daos_size_t		 glob_buf_size;
-	uint32_t		 pb_nr;
 	void			*client_buf;
 	size_t			 client_len;
 	size_t			 sys_len;
@@ -862,10 +923,7 @@ dc_pool_l2g(daos_handle_t poh, d_iov_t *glob)
 	if (pool == NULL)
 		D_GOTO(out, rc = -DER_NO_HDL);
 
-	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
-	map_version = pool_map_get_version(pool->dp_map);
-	rc = pool_buf_extract(pool->dp_map, &map_buf);
-	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+	rc = dc_pool_map_encode(pool);
 	if (rc != 0)
 		D_GOTO(out_pool, rc);
 
@@ -874,39 +932,45 @@ dc_pool_l2g(daos_handle_t poh, d_iov_t *glob)
 	D_ALLOC(client_buf, client_len);
 	if (client_buf == NULL) {
 		D_MUTEX_UNLOCK(&pool->dp_client_lock);
-		D_GOTO(out_map_buf, rc = -DER_NOMEM);
+		D_GOTO(out_pool, rc = -DER_NOMEM);
 	}
 	rsvc_client_encode(&pool->dp_client, client_buf);
 	D_MUTEX_UNLOCK(&pool->dp_client_lock);
 
 	sys_len = dc_mgmt_sys_encode(pool->dp_sys, NULL /* buf */, 0 /* cap */);
 
-	pb_nr = map_buf->pb_nr;
-	glob_buf_size = dc_pool_glob_buf_size(pb_nr, client_len, sys_len);
+	/* the encoded map is not replaced while it is copied */
+	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+	glob_buf_size = dc_pool_glob_buf_size(pool->dp_map_enc_len + 1,
+					      client_len, sys_len);
 	if (glob->iov_buf == NULL) {
 		glob->iov_buf_len = glob_buf_size;
-		D_GOTO(out_client_buf, rc = 0);
+		D_GOTO(out_map, rc = 0);
 	}
 	if (glob->iov_buf_len < glob_buf_size) {
 		D_ERROR("Larger glob buffer needed ("DF_U64" bytes provided, "
 			""DF_U64" required).\n", glob->iov_buf_len,
 			glob_buf_size);
 		glob->iov_buf_len = glob_buf_size;
-		D_GOTO(out_client_buf, rc = -DER_TRUNC);
+		D_GOTO(out_map, rc = -DER_TRUNC);
 	}
 	glob->iov_len = glob_buf_size;
 
 	/* init pool global handle */
 	pool_glob = (struct dc_pool_glob *)glob->iov_buf;
-	pool_glob->dpg_magic = DC_POOL_GLOB_MAGIC;
+	pool_glob->dpg_magic = DC_POOL_GLOB_MAGIC_ENC;
+	pool_glob->dpg_map_len = pool->dp_map_enc_len;
 	uuid_copy(pool_glob->dpg_pool, pool->dp_pool);
 	uuid_copy(pool_glob->dpg_pool_hdl, pool->dp_pool_hdl);
 	pool_glob->dpg_capas = pool->dp_capas;
-	pool_glob->dpg_map_version = map_version;
-	pool_glob->dpg_map_pb_nr = pb_nr;
-	memcpy(pool_glob->dpg_map_buf, map_buf, pool_buf_size(pb_nr));
+	pool_glob->dpg_map_version = pool->dp_map_enc_ver;
+	pool_glob->dpg_map_pb_nr = pool->dp_map_enc_nr;
+	memcpy(pool_glob->dpg_map_buf, pool->dp_map_enc,
+	       pool->dp_map_enc_len);
+	p = (void *)pool_glob->dpg_map_buf + pool->dp_map_enc_len;
+	*(uint8_t *)p = pool->dp_io_bulk;
 	/* rsvc_client */
-	p = (void *)pool_glob->dpg_map_buf + pool_buf_size(pb_nr);
+	p++;
 	memcpy(p, client_buf, client_len);
 	/* dc_mgmt_sys */
 	p += client_len;
@@ -915,10 +979,9 @@ dc_pool_l2g(daos_handle_t poh, d_iov_t *glob)
 	D_ASSERTF(rc == sys_len, "%d == %zu\n", rc, sys_len);
 	rc = 0;
 
-out_client_buf:
+out_map:
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
 	D_FREE(client_buf);
-out_map_buf:
-	pool_buf_free(map_buf);
 out_pool:
 	dc_pool_put(pool);
 out:
@@ -953,15 +1016,36 @@ out:
 static int
 dc_pool_g2l(struct dc_pool_glob *pool_glob, size_t len, daos_handle_t *poh)
 {
-	struct dc_pool		*pool;
+	struct dc_pool		*pool = NULL;
 	struct pool_buf		*map_buf;
+	struct pool_buf		*dec_buf = NULL;
+	uint32_t		 io_bulk = DAOS_IO_BULK_FIXED;
 	void			*p;
 	int			 rc = 0;
 
 	D_ASSERT(pool_glob != NULL);
 	D_ASSERT(poh != NULL);
-	map_buf = pool_glob->dpg_map_buf;
-	D_ASSERT(map_buf != NULL);
+
+	if (pool_glob->dpg_magic == DC_POOL_GLOB_MAGIC_ENC) {
+		if (len < dc_pool_glob_buf_size(pool_glob->dpg_map_len + 1,
+						0, 0))
+			D_GOTO(out, rc = -DER_INVAL);
+		rc = pool_buf_decode(pool_glob->dpg_map_buf,
+				     pool_glob->dpg_map_len,
+				     pool_glob->dpg_map_pb_nr, &dec_buf);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		map_buf = dec_buf;
+		p = (void *)pool_glob->dpg_map_buf + pool_glob->dpg_map_len;
+		io_bulk = *(uint8_t *)p;
+		if (io_bulk != DAOS_IO_BULK_FIXED &&
+		    io_bulk != DAOS_IO_BULK_ADAPTIVE)
+			D_GOTO(out, rc = -DER_INVAL);
+		p++;
+	} else {
+		map_buf = pool_glob->dpg_map_buf;
+		p = (void *)map_buf + pool_buf_size(map_buf->pb_nr);
+	}
 
 	/** allocate and fill in pool connection */
 	pool = pool_alloc(pool_glob->dpg_map_pb_nr);
@@ -971,10 +1055,10 @@ dc_pool_g2l(struct dc_pool_glob *pool_glob, size_t len, daos_handle_t *poh)
 	uuid_copy(pool->dp_pool, pool_glob->dpg_pool);
 	uuid_copy(pool->dp_pool_hdl, pool_glob->dpg_pool_hdl);
 	pool->dp_capas = pool_glob->dpg_capas;
+	pool->dp_io_bulk = io_bulk;
 	/* set slave flag to avoid export it again */
 	pool->dp_slave = 1;
 
-	p = (void *)map_buf + pool_buf_size(map_buf->pb_nr);
 	rc = rsvc_client_decode(p, len - (p - (void *)pool_glob),
 				&pool->dp_client);
 	if (rc < 0)
@@ -998,6 +1082,21 @@ dc_pool_g2l(struct dc_pool_glob *pool_glob, size_t len, daos_handle_t *poh)
 	if (rc != 0)
 		D_GOTO(out, rc);
 
+	/*
+	 * Keep the encoded map, so the handle can be passed on again (e.g.
+	 * along a broadcast tree) without encoding the map. Optional.
+	 */
+	if (dec_buf != NULL) {
+		D_ALLOC(pool->dp_map_enc, pool_glob->dpg_map_len);
+		if (pool->dp_map_enc != NULL) {
+			memcpy(pool->dp_map_enc, pool_glob->dpg_map_buf,
+			       pool_glob->dpg_map_len);
+			pool->dp_map_enc_len = pool_glob->dpg_map_len;
+			pool->dp_map_enc_ver = pool_glob->dpg_map_version;
+			pool->dp_map_enc_nr = pool_glob->dpg_map_pb_nr;
+		}
+	}
+
 	/* add pool to hash */
 	dc_pool_hdl_link(pool);
 	dc_pool2hdl(pool, poh);
@@ -1009,6 +1108,8 @@ dc_pool_g2l(struct dc_pool_glob *pool_glob, size_t len, daos_handle_t *poh)
 out:
 	if (rc != 0)
 		D_ERROR("dc_pool_g2l failed, rc: %d.\n", rc);
+	if (dec_buf != NULL)
+		pool_buf_free(dec_buf);
 	if (pool != NULL)
 		dc_pool_put(pool);
 	return rc;
@@ -1033,10 +1134,13 @@ dc_pool_global2local(d_iov_t glob, daos_handle_t *poh)
 	}
 
 	pool_glob = (struct dc_pool_glob *)glob.iov_buf;
-	if (pool_glob->dpg_magic == D_SWAP32(DC_POOL_GLOB_MAGIC)) {
+	if (pool_glob->dpg_magic == D_SWAP32(DC_POOL_GLOB_MAGIC) ||
+	    pool_glob->dpg_magic == D_SWAP32(DC_POOL_GLOB_MAGIC_ENC)) {
 		swap_pool_glob(pool_glob);
-		D_ASSERT(pool_glob->dpg_magic == DC_POOL_GLOB_MAGIC);
-	} else if (pool_glob->dpg_magic != DC_POOL_GLOB_MAGIC) {
+		D_ASSERT(pool_glob->dpg_magic == DC_POOL_GLOB_MAGIC ||
+			 pool_glob->dpg_magic == DC_POOL_GLOB_MAGIC_ENC);
+	} else if (pool_glob->dpg_magic != DC_POOL_GLOB_MAGIC &&
+		   pool_glob->dpg_magic != DC_POOL_GLOB_MAGIC_ENC) {
 		D_ERROR("Bad dpg_magic: 0x%x.\n", pool_glob->dpg_magic);
 		D_GOTO(out, rc = -DER_INVAL);
 	}
@@ -1351,6 +1455,9 @@ pool_query_bits(daos_pool_info_t *po_info, daos_prop_t *prop)
 		case DAOS_PROP_PO_OWNER_GROUP:
 			bits |= DAOS_PO_QUERY_PROP_OWNER_GROUP;
 			break;
+		case DAOS_PROP_PO_IO_BULK:
+			bits |= DAOS_PO_QUERY_PROP_IO_BULK;
+			break;
 		default:
 			D_ERROR("ignore bad dpt_type %d.\n", entry->dpe_type);
 			break;
@@ -162,7 +162,9 @@ CRT_RPC_DECLARE(pool_create, DAOS_ISEQ_POOL_CREATE, DAOS_OSEQ_POOL_CREATE)
 	((struct daos_pool_space) (pco_space)		CRT_VAR) \
 	((struct daos_rebuild_status) (pco_rebuild_st)	CRT_VAR) \
 	/* only set on -DER_TRUNC */				 \
-	((uint32_t)		(pco_map_buf_size)	CRT_VAR)
+	((uint32_t)		(pco_map_buf_size)	CRT_VAR) \
+	/* DAOS_PROP_PO_IO_BULK of the pool */			 \
+	((uint32_t)		(pco_io_bulk)		CRT_VAR)
 
 CRT_RPC_DECLARE(pool_connect, DAOS_ISEQ_POOL_CONNECT, DAOS_OSEQ_POOL_CONNECT)
 
@@ -186,12 +188,13 @@ CRT_RPC_DECLARE(pool_disconnect, DAOS_ISEQ_POOL_DISCONNECT,
 #define DAOS_PO_QUERY_PROP_ACL		(1ULL << 20)
 #define DAOS_PO_QUERY_PROP_OWNER	(1ULL << 21)
 #define DAOS_PO_QUERY_PROP_OWNER_GROUP	(1ULL << 22)
+#define DAOS_PO_QUERY_PROP_IO_BULK	(1ULL << 23)
 
 #define DAOS_PO_QUERY_PROP_ALL						\
 	(DAOS_PO_QUERY_PROP_LABEL | DAOS_PO_QUERY_PROP_SPACE_RB |	\
 	 DAOS_PO_QUERY_PROP_SELF_HEAL | DAOS_PO_QUERY_PROP_RECLAIM |	\
 	 DAOS_PO_QUERY_PROP_ACL | DAOS_PO_QUERY_PROP_OWNER |		\
-	 DAOS_PO_QUERY_PROP_OWNER_GROUP)
+	 DAOS_PO_QUERY_PROP_OWNER_GROUP | DAOS_PO_QUERY_PROP_IO_BULK)
 
 #define DAOS_ISEQ_POOL_QUERY	/* input fields */		 \
 	((struct pool_op_in)	(pqi_op)		CRT_VAR) \
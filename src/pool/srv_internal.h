@@ -63,6 +63,7 @@ struct pool_iv_prop {
 	uint64_t	pip_space_rb;
 	uint64_t	pip_self_heal;
 	uint64_t	pip_reclaim;
+	uint64_t	pip_io_bulk;
 	struct daos_acl	pip_acl;
 };
 
@@ -462,6 +462,9 @@ pool_iv_prop_l2g(daos_prop_t *prop, struct pool_iv_prop *iv_prop)
 		case DAOS_PROP_PO_RECLAIM:
 			iv_prop->pip_reclaim = prop_entry->dpe_val;
 			break;
+		case DAOS_PROP_PO_IO_BULK:
+			iv_prop->pip_io_bulk = prop_entry->dpe_val;
+			break;
 		case DAOS_PROP_PO_ACL:
 			acl = prop_entry->dpe_val_ptr;
 			if (acl != NULL)
@@ -528,6 +531,9 @@ pool_iv_prop_g2l(struct pool_iv_prop *iv_prop, daos_prop_t *prop)
 		case DAOS_PROP_PO_RECLAIM:
 			prop_entry->dpe_val = iv_prop->pip_reclaim;
 			break;
+		case DAOS_PROP_PO_IO_BULK:
+			prop_entry->dpe_val = iv_prop->pip_io_bulk;
+			break;
 		case DAOS_PROP_PO_ACL:
 			acl = &iv_prop->pip_acl;
 			if (acl->dal_len > 0) {
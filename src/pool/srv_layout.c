@@ -45,6 +45,7 @@ RDB_STRING_KEY(ds_pool_prop_, self_heal);
 RDB_STRING_KEY(ds_pool_prop_, reclaim);
 RDB_STRING_KEY(ds_pool_prop_, owner);
 RDB_STRING_KEY(ds_pool_prop_, owner_group);
+RDB_STRING_KEY(ds_pool_prop_, io_bulk);
 RDB_STRING_KEY(ds_pool_prop_, nhandles);
 
 /** pool handle KVS */
@@ -77,6 +78,9 @@ struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
 	}, {
 		.dpe_type	= DAOS_PROP_PO_OWNER_GROUP,
 		.dpe_str	= "nobody@",
+	}, {
+		.dpe_type	= DAOS_PROP_PO_IO_BULK,
+		.dpe_val	= DAOS_IO_BULK_FIXED,
 	}
 };
 
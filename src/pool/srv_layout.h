@@ -66,6 +66,7 @@ extern d_iov_t ds_pool_prop_self_heal;	/* uint64_t */
 extern d_iov_t ds_pool_prop_reclaim;		/*  uint64_t */
 extern d_iov_t ds_pool_prop_owner;		/* string */
 extern d_iov_t ds_pool_prop_owner_group;	/* string */
+extern d_iov_t ds_pool_prop_io_bulk;		/* uint64_t */
 extern d_iov_t ds_pool_prop_nhandles;	/* uint32_t */
 
 /** pool handle KVS */
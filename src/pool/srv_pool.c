@@ -355,6 +355,7 @@ pool_prop_default_copy(daos_prop_t *prop_def, daos_prop_t *prop)
 		case DAOS_PROP_PO_SPACE_RB:
 		case DAOS_PROP_PO_SELF_HEAL:
 		case DAOS_PROP_PO_RECLAIM:
+		case DAOS_PROP_PO_IO_BULK:
 			entry_def->dpe_val = entry->dpe_val;
 			break;
 		case DAOS_PROP_PO_ACL:
@@ -446,6 +447,14 @@ pool_prop_write(struct rdb_tx *tx, const rdb_path_t *kvs, daos_prop_t *prop)
 			if (rc)
 				return rc;
 			break;
+		case DAOS_PROP_PO_IO_BULK:
+			d_iov_set(&value, &entry->dpe_val,
+				     sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_io_bulk,
+					   &value);
+			if (rc)
+				return rc;
+			break;
 		default:
 			D_ERROR("bad dpe_type %d.\n", entry->dpe_type);
 			return -DER_INVAL;
@@ -1328,6 +1337,8 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 		nr++;
 	if (bits & DAOS_PO_QUERY_PROP_OWNER_GROUP)
 		nr++;
+	if (bits & DAOS_PO_QUERY_PROP_IO_BULK)
+		nr++;
 	if (nr == 0)
 		return 0;
 
@@ -1441,6 +1452,20 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 			return -DER_NOMEM;
 		idx++;
 	}
+	if (bits & DAOS_PO_QUERY_PROP_IO_BULK) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_io_bulk,
+				   &value);
+		/* pool created before this property is fixed mode */
+		if (rc == -DER_NONEXIST)
+			val = DAOS_IO_BULK_FIXED;
+		else if (rc != 0)
+			return rc;
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_IO_BULK;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
 	return 0;
 }
 
@@ -1784,6 +1809,7 @@ ds_pool_connect_handler(crt_rpc_t *rpc)
 	struct pool_owner		owner;
 	struct daos_prop_entry	       *owner_entry;
 	struct daos_prop_entry	       *owner_grp_entry;
+	struct daos_prop_entry	       *io_bulk_entry;
 
 	D_DEBUG(DF_DSMS, DF_UUID": processing rpc %p: hdl="DF_UUID"\n",
 		DP_UUID(in->pci_op.pi_uuid), rpc, DP_UUID(in->pci_op.pi_hdl));
@@ -1869,6 +1895,10 @@ ds_pool_connect_handler(crt_rpc_t *rpc)
 	owner.user = owner_entry->dpe_str;
 	owner.group = owner_grp_entry->dpe_str;
 
+	io_bulk_entry = daos_prop_entry_get(prop, DAOS_PROP_PO_IO_BULK);
+	D_ASSERT(io_bulk_entry != NULL);
+	out->pco_io_bulk = io_bulk_entry->dpe_val;
+
 	rc = ds_sec_check_pool_access(acl_entry->dpe_val_ptr, &owner,
 			&in->pci_cred, in->pci_capas);
 	if (rc != 0) {
@@ -2266,6 +2296,7 @@ ds_pool_query_handler(crt_rpc_t *rpc)
 			case DAOS_PROP_PO_SPACE_RB:
 			case DAOS_PROP_PO_SELF_HEAL:
 			case DAOS_PROP_PO_RECLAIM:
+			case DAOS_PROP_PO_IO_BULK:
 				if (entry->dpe_val != iv_entry->dpe_val) {
 					D_ERROR("type %d mismatch "DF_U64" - "
 						DF_U64".\n", entry->dpe_type,
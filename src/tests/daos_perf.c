@@ -38,6 +38,7 @@
 #include <daos/common.h>
 #include <daos/tests_lib.h>
 #include <daos_srv/vos.h>
+#include <daos_srv/dtx_srv.h>
 #include <daos_test.h>
 #include "dts_common.h"
 
@@ -76,8 +77,18 @@ bool			 ts_zero_copy;
 bool			 ts_verify_fetch;
 /* shuffle the offsets of the array */
 bool			 ts_shuffle	= false;
+/* DTX handle of the VOS updates, only for 'vos' with zero-copy */
+enum {
+	TS_DTX_NONE,
+	/* non-replicated DTX, committed when the modification is done */
+	TS_DTX_NON_REP,
+	/* solo DTX of the single replica fast path */
+	TS_DTX_SOLO,
+};
+int			 ts_dtx = TS_DTX_NONE;
 
 daos_handle_t		*ts_ohs;		/* all opened objects */
+daos_obj_id_t		*ts_oids;		/* IDs of all objects */
 daos_obj_id_t		 ts_oid;		/* object ID */
 daos_unit_oid_t		 ts_uoid;		/* object shard ID (for VOS) */
 
@@ -89,11 +100,39 @@ bool			ts_rebuild_only_iteration = false;
 /* rebuild without update */
 bool			ts_rebuild_no_update = false;
 
+/* integer dkeys and akeys, required by query_key */
+bool			ts_int_keys;
+/* last epoch used by objects_update(), for the VOS punch */
+daos_epoch_t		ts_epoch;
+/* append the results to this file in JSON */
+char			*ts_json_file;
+
+/* Prepare the DTX handle as the server does for the single replica object:
+ * the solo handle of the fast path only creates the committed DTX entry for
+ * resend detection, the non-replicated one creates the DTX entry in the
+ * active table and commits it immediately when the modification is done.
+ */
+static void
+ts_dtx_init(struct dtx_handle *dth, struct dts_io_credit *cred,
+	    daos_epoch_t epoch)
+{
+	struct dtx_id	dti;
+
+	daos_dti_gen(&dti, false);
+	dtx_handle_init(&dti, &ts_uoid, ts_ctx.tsc_coh, epoch,
+			d_hash_murmur64(cred->tc_dkey.iov_buf,
+					cred->tc_dkey.iov_len, 5731),
+			0, DAOS_INTENT_UPDATE, NULL, NULL, 0, true, true, dth);
+	dth->dth_solo = ts_dtx == TS_DTX_SOLO;
+}
+
 static int
 vos_update_or_fetch(enum ts_op_type op_type, struct dts_io_credit *cred,
 		    daos_epoch_t epoch)
 {
-	int	rc = 0;
+	struct dtx_handle	 dth;
+	struct dtx_handle	*dthp = NULL;
+	int			 rc = 0;
 
 	if (!ts_zero_copy) {
 		if (op_type == TS_DO_UPDATE)
@@ -108,10 +147,15 @@ vos_update_or_fetch(enum ts_op_type op_type, struct dts_io_credit *cred,
 		struct bio_sglist	*bsgl;
 		daos_handle_t		 ioh;
 
+		if (op_type == TS_DO_UPDATE && ts_dtx != TS_DTX_NONE) {
+			ts_dtx_init(&dth, cred, epoch);
+			dthp = &dth;
+		}
+
 		if (op_type == TS_DO_UPDATE)
 			rc = vos_update_begin(ts_ctx.tsc_coh, ts_uoid, epoch,
 					      &cred->tc_dkey, 1, &cred->tc_iod,
-					      &ioh, NULL);
+					      &ioh, dthp);
 		else
 			rc = vos_fetch_begin(ts_ctx.tsc_coh, ts_uoid, epoch,
 					     &cred->tc_dkey, 1, &cred->tc_iod,
@@ -141,7 +185,7 @@ vos_update_or_fetch(enum ts_op_type op_type, struct dts_io_credit *cred,
 		rc = bio_iod_post(vos_ioh2desc(ioh));
 end:
 		if (op_type == TS_DO_UPDATE)
-			rc = vos_update_end(ioh, 0, &cred->tc_dkey, rc, NULL);
+			rc = vos_update_end(ioh, 0, &cred->tc_dkey, rc, dthp);
 		else
 			rc = vos_fetch_end(ioh, rc);
 	}
@@ -167,6 +211,18 @@ daos_update_or_fetch(daos_handle_t oh, enum ts_op_type op_type,
 	return rc;
 }
 
+static void
+ts_key_gen(char *key, const char *prefix)
+{
+	dts_key_gen(key, DTS_KEY_LEN, ts_int_keys ? NULL : prefix);
+}
+
+static size_t
+ts_key_len(char *key)
+{
+	return ts_int_keys ? sizeof(uint64_t) : strlen(key);
+}
+
 static void
 set_value_buffer(char *buffer, int idx)
 {
@@ -206,12 +262,12 @@ akey_update_or_fetch(daos_handle_t oh, enum ts_op_type op_type,
 	/* setup dkey */
 	memcpy(cred->tc_dbuf, dkey, DTS_KEY_LEN);
 	d_iov_set(&cred->tc_dkey, cred->tc_dbuf,
-			strlen(cred->tc_dbuf));
+			ts_key_len(cred->tc_dbuf));
 
 	/* setup I/O descriptor */
 	memcpy(cred->tc_abuf, akey, DTS_KEY_LEN);
 	d_iov_set(&iod->iod_name, cred->tc_abuf,
-			strlen(cred->tc_abuf));
+			ts_key_len(cred->tc_abuf));
 	iod->iod_size = vsize;
 	recx->rx_nr  = 1;
 	if (ts_single) {
@@ -276,7 +332,7 @@ dkey_update_or_fetch(daos_handle_t oh, enum ts_op_type op_type, char *dkey,
 	D_ASSERT(indices != NULL);
 
 	for (i = 0; i < ts_akey_p_dkey; i++) {
-		dts_key_gen(akey, DTS_KEY_LEN, "walker");
+		ts_key_gen(akey, "walker");
 		for (j = 0; j < ts_recx_p_akey; j++) {
 			rc = akey_update_or_fetch(oh, op_type, dkey, akey,
 						  epoch, indices, j, NULL);
@@ -304,9 +360,12 @@ objects_update(d_rank_t rank)
 		++epoch;
 
 	for (i = 0; i < ts_obj_p_cont; i++) {
-		ts_oid = dts_oid_gen(ts_class, 0, ts_ctx.tsc_mpi_rank);
+		ts_oid = dts_oid_gen(ts_class, ts_int_keys ?
+				     DAOS_OF_DKEY_UINT64 | DAOS_OF_AKEY_UINT64 :
+				     0, ts_ctx.tsc_mpi_rank);
 		if (ts_class == DAOS_OC_R2S_SPEC_RANK)
 			ts_oid = dts_oid_set_rank(ts_oid, rank);
+		ts_oids[i] = ts_oid;
 
 		if (ts_mode == TS_MODE_DAOS || ts_mode == TS_MODE_ECHO) {
 			rc = daos_obj_open(ts_ctx.tsc_coh, ts_oid,
@@ -323,13 +382,14 @@ objects_update(d_rank_t rank)
 		for (j = 0; j < ts_dkey_p_obj; j++) {
 			char	 dkey[DTS_KEY_LEN];
 
-			dts_key_gen(dkey, DTS_KEY_LEN, "blade");
+			ts_key_gen(dkey, "blade");
 			rc = dkey_update_or_fetch(ts_ohs[i], TS_DO_UPDATE, dkey,
 						  &epoch);
 			if (rc)
 				return rc;
 		}
 	}
+	ts_epoch = epoch;
 	rc = dts_credit_drain(&ts_ctx);
 
 	return rc;
@@ -347,7 +407,7 @@ dkey_verify(daos_handle_t oh, char *dkey, daos_epoch_t *epoch)
 
 	indices = dts_rand_iarr_alloc(ts_recx_p_akey, 0, ts_shuffle);
 	D_ASSERT(indices != NULL);
-	dts_key_gen(akey, DTS_KEY_LEN, "walker");
+	ts_key_gen(akey, "walker");
 
 	for (i = 0; i < ts_recx_p_akey; i++) {
 		set_value_buffer(ground_truth, i);
@@ -382,7 +442,7 @@ objects_verify(void)
 		++epoch;
 	for (i = 0; i < ts_obj_p_cont; i++) {
 		for (j = 0; j < ts_dkey_p_obj; j++) {
-			dts_key_gen(dkey, DTS_KEY_LEN, "blade");
+			ts_key_gen(dkey, "blade");
 			for (k = 0; k < ts_akey_p_dkey; k++) {
 				rc = dkey_verify(ts_ohs[i], dkey, &epoch);
 				if (rc != 0)
@@ -428,7 +488,7 @@ objects_fetch(d_rank_t rank)
 		for (j = 0; j < ts_dkey_p_obj; j++) {
 			char	 dkey[DTS_KEY_LEN];
 
-			dts_key_gen(dkey, DTS_KEY_LEN, "blade");
+			ts_key_gen(dkey, "blade");
 			rc = dkey_update_or_fetch(ts_ohs[i], TS_DO_FETCH, dkey,
 						  &epoch);
 			if (rc != 0)
@@ -610,6 +670,45 @@ ts_update_fetch_perf(double *start_time, double *end_time)
 	return rc;
 }
 
+/* Open and close the objects repeatedly, the open handles are not used for any
+ * I/O, so this measures the client side cost of object open, i.e. the layout
+ * calculation. Set DAOS_OBJ_LAYOUT_CACHE_BITS=0 to compare with the result
+ * without the client layout cache.
+ */
+static int
+ts_open_perf(double *start_time, double *end_time)
+{
+	daos_handle_t	oh;
+	unsigned long	opens;
+	unsigned long	j;
+	int		i;
+	int		rc = 0;
+
+	opens = (unsigned long)ts_dkey_p_obj * ts_akey_p_dkey *
+		ts_recx_p_akey;
+
+	*start_time = dts_time_now();
+	for (i = 0; i < ts_obj_p_cont; i++) {
+		ts_oid = dts_oid_gen(ts_class, 0, ts_ctx.tsc_mpi_rank);
+		for (j = 0; j < opens; j++) {
+			rc = daos_obj_open(ts_ctx.tsc_coh, ts_oid, DAOS_OO_RW,
+					   &oh, NULL);
+			if (rc) {
+				fprintf(stderr, "object open failed\n");
+				return rc;
+			}
+
+			rc = daos_obj_close(oh, NULL);
+			if (rc) {
+				fprintf(stderr, "object close failed\n");
+				return rc;
+			}
+		}
+	}
+	*end_time = dts_time_now();
+	return rc;
+}
+
 static int
 ts_exclude_server(d_rank_t rank)
 {
@@ -698,6 +797,538 @@ ts_rebuild_perf(double *start_time, double *end_time)
 	return rc;
 }
 
+/* Latency histogram, 16 linear buckets per power of 2 nanoseconds (~6%). */
+#define TS_LAT_SUB_BITS	4
+#define TS_LAT_SUB_NR	(1 << TS_LAT_SUB_BITS)
+#define TS_LAT_BKT_NR	((64 - TS_LAT_SUB_BITS + 1) * TS_LAT_SUB_NR)
+
+/* Latencies of the dkey and akey operations of the current test */
+enum {
+	TS_LAT_DKEY,
+	TS_LAT_AKEY,
+	TS_LAT_MAX,
+};
+
+struct ts_lat {
+	const char	*tl_name;
+	uint64_t	 tl_cnt;
+	uint64_t	 tl_sum;
+	uint64_t	 tl_min;
+	uint64_t	 tl_max;
+	uint64_t	 tl_bkts[TS_LAT_BKT_NR];
+};
+
+/* reset before each test, only the tests timing each operation add some */
+static struct ts_lat	ts_lats[TS_LAT_MAX];
+static int		ts_lat_nr;
+
+static struct ts_lat *
+ts_lat_add(const char *name)
+{
+	struct ts_lat	*lat;
+
+	D_ASSERT(ts_lat_nr < TS_LAT_MAX);
+	lat = &ts_lats[ts_lat_nr++];
+	memset(lat, 0, sizeof(*lat));
+	lat->tl_name = name;
+	lat->tl_min = UINT64_MAX;
+	return lat;
+}
+
+static int
+ts_lat_bkt(uint64_t ns)
+{
+	int	shift;
+
+	if (ns < TS_LAT_SUB_NR)
+		return ns;
+
+	shift = 63 - __builtin_clzll(ns) - TS_LAT_SUB_BITS;
+	return (shift + 1) * TS_LAT_SUB_NR +
+	       ((ns >> shift) & (TS_LAT_SUB_NR - 1));
+}
+
+/* the highest latency of the bucket @bkt */
+static uint64_t
+ts_lat_bkt_max(int bkt)
+{
+	int	shift;
+
+	if (bkt < TS_LAT_SUB_NR)
+		return bkt;
+
+	shift = bkt / TS_LAT_SUB_NR - 1;
+	return ((uint64_t)(TS_LAT_SUB_NR + bkt % TS_LAT_SUB_NR) << shift) +
+	       (1ULL << shift) - 1;
+}
+
+/* record the latency of an operation started at @start (nanoseconds) */
+static void
+ts_lat_record(struct ts_lat *lat, uint64_t start)
+{
+	uint64_t	ns = daos_get_ntime() - start;
+
+	lat->tl_cnt++;
+	lat->tl_sum += ns;
+	lat->tl_min = min(lat->tl_min, ns);
+	lat->tl_max = max(lat->tl_max, ns);
+	lat->tl_bkts[ts_lat_bkt(ns)]++;
+}
+
+/* the percentile @pml (per mille) in microseconds */
+static double
+ts_lat_pct(struct ts_lat *lat, int pml)
+{
+	uint64_t	target;
+	uint64_t	cnt = 0;
+	int		i;
+
+	if (lat->tl_cnt == 0)
+		return 0;
+
+	target = (lat->tl_cnt * pml + 999) / 1000;
+	for (i = 0; i < TS_LAT_BKT_NR; i++) {
+		cnt += lat->tl_bkts[i];
+		if (cnt >= target)
+			break;
+	}
+	return min(ts_lat_bkt_max(i), lat->tl_max) / 1000.0;
+}
+
+/* aggregate the latencies of all the processes to @agg of rank 0 */
+static void
+ts_lat_reduce(struct ts_lat *lat, struct ts_lat *agg)
+{
+	if (ts_ctx.tsc_mpi_size == 1) {
+		*agg = *lat;
+		return;
+	}
+
+	agg->tl_name = lat->tl_name;
+	MPI_Reduce(&lat->tl_cnt, &agg->tl_cnt, 1, MPI_UINT64_T, MPI_SUM, 0,
+		   MPI_COMM_WORLD);
+	MPI_Reduce(&lat->tl_sum, &agg->tl_sum, 1, MPI_UINT64_T, MPI_SUM, 0,
+		   MPI_COMM_WORLD);
+	MPI_Reduce(&lat->tl_min, &agg->tl_min, 1, MPI_UINT64_T, MPI_MIN, 0,
+		   MPI_COMM_WORLD);
+	MPI_Reduce(&lat->tl_max, &agg->tl_max, 1, MPI_UINT64_T, MPI_MAX, 0,
+		   MPI_COMM_WORLD);
+	MPI_Reduce(lat->tl_bkts, agg->tl_bkts, TS_LAT_BKT_NR, MPI_UINT64_T,
+		   MPI_SUM, 0, MPI_COMM_WORLD);
+}
+
+static int
+objects_close(void)
+{
+	int	i;
+	int	rc;
+
+	for (i = 0; ts_mode != TS_MODE_VOS && i < ts_obj_p_cont; i++) {
+		rc = daos_obj_close(ts_ohs[i], NULL);
+		if (rc)
+			return rc;
+	}
+	return 0;
+}
+
+/* select the object @i for the VOS calls */
+static void
+ts_uoid_set(int i)
+{
+	memset(&ts_uoid, 0, sizeof(ts_uoid));
+	ts_uoid.id_pub = ts_oids[i];
+}
+
+/*
+ * Replay the keys generated by objects_update(). @obj_cb is called for each
+ * object, then @dkey_cb for each dkey of the object, with all its akeys.
+ */
+static int
+ts_key_walk(int (*obj_cb)(int obj),
+	    int (*dkey_cb)(int obj, daos_key_t *dkey, daos_key_t *akeys))
+{
+	char		 dkey[DTS_KEY_LEN];
+	char		*akey_bufs;
+	daos_key_t	 dkey_iov;
+	daos_key_t	*akeys;
+	int		 i;
+	int		 j;
+	int		 k;
+	int		 rc = 0;
+
+	D_ALLOC(akey_bufs, ts_akey_p_dkey * DTS_KEY_LEN);
+	D_ALLOC_ARRAY(akeys, ts_akey_p_dkey);
+	if (akey_bufs == NULL || akeys == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	dts_reset_key();
+	for (i = 0; i < ts_obj_p_cont; i++) {
+		ts_uoid_set(i);
+		if (obj_cb != NULL) {
+			rc = obj_cb(i);
+			if (rc)
+				D_GOTO(out, rc);
+		}
+
+		for (j = 0; j < ts_dkey_p_obj; j++) {
+			ts_key_gen(dkey, "blade");
+			d_iov_set(&dkey_iov, dkey, ts_key_len(dkey));
+			for (k = 0; k < ts_akey_p_dkey; k++) {
+				char	*akey = &akey_bufs[k * DTS_KEY_LEN];
+
+				ts_key_gen(akey, "walker");
+				d_iov_set(&akeys[k], akey, ts_key_len(akey));
+			}
+
+			if (dkey_cb != NULL) {
+				rc = dkey_cb(i, &dkey_iov, akeys);
+				if (rc)
+					D_GOTO(out, rc);
+			}
+		}
+	}
+out:
+	if (akey_bufs != NULL)
+		D_FREE(akey_bufs);
+	if (akeys != NULL)
+		D_FREE(akeys);
+	return rc;
+}
+
+/* number of keys per enumeration call */
+#define TS_ENUM_NR	64
+
+static unsigned long	ts_enum_dkeys;
+static unsigned long	ts_enum_akeys;
+
+/*
+ * List up to @nr keys from @anchor, in the same way as the server handles
+ * an enumeration RPC: the anchor of the first key not returned is kept.
+ */
+static int
+vos_list_keys(vos_iter_type_t type, vos_iter_param_t *param, uint32_t *nr,
+	      daos_anchor_t *anchor)
+{
+	vos_iter_entry_t	ent;
+	daos_handle_t		ih;
+	uint32_t		cnt = 0;
+	int			rc;
+
+	rc = vos_iter_prepare(type, param, &ih);
+	if (rc == -DER_NONEXIST) {
+		daos_anchor_set_eof(anchor);
+		*nr = 0;
+		return 0;
+	}
+	if (rc)
+		return rc;
+
+	rc = vos_iter_probe(ih, daos_anchor_is_zero(anchor) ? NULL : anchor);
+	while (rc == 0) {
+		rc = vos_iter_fetch(ih, &ent, anchor);
+		if (rc != 0 || cnt == *nr)
+			break;
+		cnt++;
+		rc = vos_iter_next(ih);
+	}
+	if (rc == -DER_NONEXIST) {
+		daos_anchor_set_eof(anchor);
+		rc = 0;
+	}
+	vos_iter_finish(ih);
+	*nr = cnt;
+	return rc;
+}
+
+/* list all the dkeys of the object @obj, or the akeys of @dkey */
+static int
+ts_list_keys(int obj, daos_key_t *dkey, struct ts_lat *lat,
+	     unsigned long *key_nr)
+{
+	vos_iter_param_t	param = {};
+	daos_key_desc_t		kds[TS_ENUM_NR];
+	char			buf[TS_ENUM_NR * DTS_KEY_LEN];
+	daos_anchor_t		anchor;
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	uint64_t		start;
+	uint32_t		nr;
+	int			rc = 0;
+
+	param.ip_hdl = ts_ctx.tsc_coh;
+	param.ip_oid = ts_uoid;
+	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
+	param.ip_epc_expr = VOS_IT_EPC_RE;
+	if (dkey != NULL)
+		param.ip_dkey = *dkey;
+
+	d_iov_set(&iov, buf, sizeof(buf));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	memset(&anchor, 0, sizeof(anchor));
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = TS_ENUM_NR;
+		start = daos_get_ntime();
+		if (ts_mode == TS_MODE_VOS)
+			rc = vos_list_keys(dkey == NULL ? VOS_ITER_DKEY :
+					   VOS_ITER_AKEY, &param, &nr, &anchor);
+		else if (dkey == NULL)
+			rc = daos_obj_list_dkey(ts_ohs[obj], DAOS_TX_NONE, &nr,
+						kds, &sgl, &anchor, NULL);
+		else
+			rc = daos_obj_list_akey(ts_ohs[obj], DAOS_TX_NONE, dkey,
+						&nr, kds, &sgl, &anchor, NULL);
+		if (rc) {
+			fprintf(stderr, "%s enumeration failed: %d\n",
+				dkey == NULL ? "dkey" : "akey", rc);
+			return rc;
+		}
+		ts_lat_record(lat, start);
+		*key_nr += nr;
+	}
+	return 0;
+}
+
+static int
+enum_obj_cb(int obj)
+{
+	return ts_list_keys(obj, NULL, &ts_lats[TS_LAT_DKEY], &ts_enum_dkeys);
+}
+
+static int
+enum_dkey_cb(int obj, daos_key_t *dkey, daos_key_t *akeys)
+{
+	return ts_list_keys(obj, dkey, &ts_lats[TS_LAT_AKEY], &ts_enum_akeys);
+}
+
+/* Enumerate the dkeys of each object and the akeys of each dkey. */
+static int
+ts_enum_perf(double *start_time, double *end_time)
+{
+	unsigned long	dkey_nr = ts_obj_p_cont * ts_dkey_p_obj;
+	unsigned long	akey_nr = dkey_nr * ts_akey_p_dkey;
+	int		rc;
+
+	rc = objects_update(RANK_ZERO);
+	if (rc)
+		return rc;
+
+	ts_lat_add("dkey enumerate");
+	ts_lat_add("akey enumerate");
+	ts_enum_dkeys = ts_enum_akeys = 0;
+	*start_time = dts_time_now();
+	rc = ts_key_walk(enum_obj_cb, enum_dkey_cb);
+	*end_time = dts_time_now();
+	if (rc)
+		return rc;
+
+	/* nothing is stored in echo mode */
+	if (ts_mode != TS_MODE_ECHO &&
+	    (ts_enum_dkeys != dkey_nr || ts_enum_akeys != akey_nr)) {
+		fprintf(stderr, "enumerated %lu/%lu dkeys, %lu/%lu akeys\n",
+			ts_enum_dkeys, dkey_nr, ts_enum_akeys, akey_nr);
+		return -1;
+	}
+
+	return objects_close();
+}
+
+/* punch the akeys of @dkey one by one, then @dkey */
+static int
+punch_dkey_cb(int obj, daos_key_t *dkey, daos_key_t *akeys)
+{
+	uint64_t	start;
+	int		i;
+	int		rc;
+
+	for (i = 0; i < ts_akey_p_dkey; i++) {
+		start = daos_get_ntime();
+		if (ts_mode == TS_MODE_VOS)
+			rc = vos_obj_punch(ts_ctx.tsc_coh, ts_uoid, ++ts_epoch,
+					   0, 0, dkey, 1, &akeys[i], NULL);
+		else
+			rc = daos_obj_punch_akeys(ts_ohs[obj], DAOS_TX_NONE,
+						  dkey, 1, &akeys[i], NULL);
+		if (rc) {
+			fprintf(stderr, "akey punch failed: %d\n", rc);
+			return rc;
+		}
+		ts_lat_record(&ts_lats[TS_LAT_AKEY], start);
+	}
+
+	start = daos_get_ntime();
+	if (ts_mode == TS_MODE_VOS)
+		rc = vos_obj_punch(ts_ctx.tsc_coh, ts_uoid, ++ts_epoch, 0, 0,
+				   dkey, 0, NULL, NULL);
+	else
+		rc = daos_obj_punch_dkeys(ts_ohs[obj], DAOS_TX_NONE, 1, dkey,
+					  NULL);
+	if (rc) {
+		fprintf(stderr, "dkey punch failed: %d\n", rc);
+		return rc;
+	}
+	ts_lat_record(&ts_lats[TS_LAT_DKEY], start);
+	return 0;
+}
+
+static int
+ts_punch_perf(double *start_time, double *end_time)
+{
+	int	rc;
+
+	rc = objects_update(RANK_ZERO);
+	if (rc)
+		return rc;
+
+	ts_lat_add("dkey punch");
+	ts_lat_add("akey punch");
+	*start_time = dts_time_now();
+	rc = ts_key_walk(NULL, punch_dkey_cb);
+	*end_time = dts_time_now();
+	if (rc)
+		return rc;
+
+	return objects_close();
+}
+
+/* query the max dkey of the object @obj */
+static int
+query_obj_cb(int obj)
+{
+	daos_key_t	dkey;
+	uint64_t	dkey_val;
+	uint64_t	start;
+	uint32_t	flags = DAOS_GET_DKEY | DAOS_GET_MAX;
+	int		rc;
+
+	d_iov_set(&dkey, &dkey_val, sizeof(dkey_val));
+	start = daos_get_ntime();
+	if (ts_mode == TS_MODE_VOS)
+		rc = vos_obj_query_key(ts_ctx.tsc_coh, ts_uoid, flags,
+				       DAOS_EPOCH_MAX, &dkey, NULL, NULL);
+	else
+		rc = daos_obj_query_key(ts_ohs[obj], DAOS_TX_NONE, flags,
+					&dkey, NULL, NULL, NULL);
+	/* nothing is stored in echo mode */
+	if (rc == -DER_NONEXIST && ts_mode == TS_MODE_ECHO)
+		rc = 0;
+	if (rc) {
+		fprintf(stderr, "dkey query failed: %d\n", rc);
+		return rc;
+	}
+	ts_lat_record(&ts_lats[TS_LAT_DKEY], start);
+	return 0;
+}
+
+/* query the max akey of @dkey, and its max extent for array values */
+static int
+query_dkey_cb(int obj, daos_key_t *dkey, daos_key_t *akeys)
+{
+	daos_key_t	akey;
+	daos_recx_t	recx;
+	uint64_t	akey_val;
+	uint64_t	start;
+	uint32_t	flags = DAOS_GET_AKEY | DAOS_GET_MAX;
+	int		rc;
+
+	if (!ts_single)
+		flags |= DAOS_GET_RECX;
+
+	d_iov_set(&akey, &akey_val, sizeof(akey_val));
+	start = daos_get_ntime();
+	if (ts_mode == TS_MODE_VOS)
+		rc = vos_obj_query_key(ts_ctx.tsc_coh, ts_uoid, flags,
+				       DAOS_EPOCH_MAX, dkey, &akey, &recx);
+	else
+		rc = daos_obj_query_key(ts_ohs[obj], DAOS_TX_NONE, flags,
+					dkey, &akey, &recx, NULL);
+	if (rc == -DER_NONEXIST && ts_mode == TS_MODE_ECHO)
+		rc = 0;
+	if (rc) {
+		fprintf(stderr, "akey query failed: %d\n", rc);
+		return rc;
+	}
+	ts_lat_record(&ts_lats[TS_LAT_AKEY], start);
+	return 0;
+}
+
+static int
+ts_query_perf(double *start_time, double *end_time)
+{
+	int	rc;
+
+	/* only integer keys can be queried */
+	ts_int_keys = true;
+	rc = objects_update(RANK_ZERO);
+	if (rc)
+		goto out;
+
+	ts_lat_add("dkey query");
+	ts_lat_add("akey query");
+	*start_time = dts_time_now();
+	rc = ts_key_walk(query_obj_cb, query_dkey_cb);
+	*end_time = dts_time_now();
+	if (rc)
+		goto out;
+
+	rc = objects_close();
+out:
+	ts_int_keys = false;
+	return rc;
+}
+
+/*
+ * Each object is an array of ts_dkey_p_obj chunks, its size is set
+ * ts_akey_p_dkey times, alternately truncated to half a chunk and extended
+ * to the full size again.
+ */
+static int
+ts_set_size_perf(double *start_time, double *end_time)
+{
+	struct ts_lat	*lat;
+	daos_handle_t	 oh;
+	daos_size_t	 chunk;
+	daos_size_t	 size;
+	uint64_t	 start;
+	int		 i;
+	int		 j;
+	int		 rc = 0;
+
+	chunk = (daos_size_t)ts_recx_p_akey * ts_ctx.tsc_cred_vsize;
+	lat = ts_lat_add("set_size");
+	*start_time = dts_time_now();
+	for (i = 0; i < ts_obj_p_cont; i++) {
+		ts_oid = dts_oid_gen(ts_class, 0, ts_ctx.tsc_mpi_rank);
+		daos_array_generate_id(&ts_oid, ts_class, true, 0);
+		rc = daos_array_create(ts_ctx.tsc_coh, ts_oid, DAOS_TX_NONE, 1,
+				       chunk, &oh, NULL);
+		if (rc) {
+			fprintf(stderr, "array create failed: %d\n", rc);
+			return rc;
+		}
+
+		for (j = 0; j < ts_akey_p_dkey; j++) {
+			size = j % 2 == 0 ? ts_dkey_p_obj * chunk : chunk / 2;
+			start = daos_get_ntime();
+			rc = daos_array_set_size(oh, DAOS_TX_NONE, size, NULL);
+			if (rc) {
+				fprintf(stderr, "array set_size failed: %d\n",
+					rc);
+				break;
+			}
+			ts_lat_record(lat, start);
+		}
+
+		daos_array_close(oh, NULL);
+		if (rc)
+			return rc;
+	}
+	*end_time = dts_time_now();
+	return rc;
+}
+
 static uint64_t
 ts_val_factor(uint64_t val, char factor)
 {
@@ -754,12 +1385,40 @@ ts_class_name(void)
 	}
 }
 
+static const char *
+ts_mode_name(void)
+{
+	switch (ts_mode) {
+	default:
+		return "unknown";
+	case TS_MODE_VOS:
+		return "vos";
+	case TS_MODE_ECHO:
+		return "echo";
+	case TS_MODE_DAOS:
+		return "daos";
+	}
+}
+
 static const char *
 ts_val_type(void)
 {
 	return ts_single ? "single" : "array";
 }
 
+static const char *
+ts_dtx_name(void)
+{
+	switch (ts_dtx) {
+	default:
+		return "no";
+	case TS_DTX_NON_REP:
+		return "non-replicated";
+	case TS_DTX_SOLO:
+		return "solo";
+	}
+}
+
 static const char *
 ts_yes_or_no(bool value)
 {
@@ -825,6 +1484,13 @@ The options are as follows:\n\
 \n\
 -z	Use zero copy API, this option is only valid for 'vos'\n\
 \n\
+-x solo|dtx\n\
+	Update under a DTX handle, this option is only valid for 'vos' with\n\
+	zero copy API. 'solo' is the single replica fast path, which only\n\
+	keeps the committed DTX entry for resend detection. 'dtx' is the\n\
+	non-replicated DTX the server used before. Compare both to evaluate\n\
+	the cost saved by the fast path.\n\
+\n\
 -t	Instead of using different indices and epochs, all I/Os land to the\n\
 	same extent in the same epoch. This option can reduce usage of\n\
 	storage space.\n\
@@ -840,16 +1506,43 @@ The options are as follows:\n\
 \n\
 -R	Only run rebuild performance test.\n\
 \n\
+-O	Only run object open performance test, which opens and closes each\n\
+	object (dkeys x akeys x records) times. Only runs in daos mode.\n\
+	Set DAOS_OBJ_LAYOUT_CACHE_BITS=0 to disable the client layout cache.\n\
+\n\
 -B	Profile performance of both update and fetch.\n\
 \n\
 -I	Only run iterate performance test. Only runs in vos mode.\n\
 \n\
+-E	Only run enumeration performance test, which lists the dkeys of\n\
+	each object and the akeys of each dkey, 64 keys per call.\n\
+\n\
+-D	Only run punch performance test, which punches the akeys of each\n\
+	dkey one by one, then the dkey.\n\
+\n\
+-Q	Only run query_key performance test, which queries the max dkey of\n\
+	each object and the max akey of each dkey, and the max extent with\n\
+	-A. The keys of this test are integers.\n\
+\n\
+-Z	Only run array set_size performance test. Only runs in daos mode.\n\
+	Each object is an array of (dkeys) chunks of (records x size)\n\
+	bytes, its size is set (akeys) times, alternately truncated to half\n\
+	a chunk and extended to the full size.\n\
+\n\
+	The operations of -E, -D, -Q and -Z are synchronous, the percentiles\n\
+	of their latency are reported. In echo mode, the update does not\n\
+	store anything, so they measure the round trip of empty operations.\n\
+\n\
 -n	Only run iterate performance test but with nesting iterator\n\
 	enable.  This can only run in vos mode.\n\
 \n\
 -f pathname\n\
 	Full path name of the VOS file.\n\
 \n\
+-j pathname\n\
+	Append the result of each test to this file, as one JSON object\n\
+	per line.\n\
+\n\
 -w	Pause after initialization for attaching debugger or analysis\n\
 	tool.\n");
 }
@@ -866,23 +1559,72 @@ static struct option ts_ops[] = {
 	{ "array",	no_argument,		NULL,	'A' },
 	{ "size",	required_argument,	NULL,	's' },
 	{ "zcopy",	no_argument,		NULL,	'z' },
+	{ "dtx",	required_argument,	NULL,	'x' },
 	{ "overwrite",	no_argument,		NULL,	't' },
 	{ "nest_iter",	no_argument,		NULL,	'n' },
 	{ "file",	required_argument,	NULL,	'f' },
 	{ "help",	no_argument,		NULL,	'h' },
 	{ "verify",	no_argument,		NULL,	'v' },
+	{ "open",	no_argument,		NULL,	'O' },
+	{ "enum",	no_argument,		NULL,	'E' },
+	{ "punch",	no_argument,		NULL,	'D' },
+	{ "query",	no_argument,		NULL,	'Q' },
+	{ "set_size",	no_argument,		NULL,	'Z' },
+	{ "json",	required_argument,	NULL,	'j' },
 	{ "wait",	no_argument,		NULL,	'w' },
 	{ NULL,		0,			NULL,	0   },
 };
 
+static void
+ts_json_write(char *test_name, double duration, unsigned long total,
+	      double rate, double latency, struct ts_lat *lats)
+{
+	FILE	*fp;
+	int	 i;
+
+	fp = fopen(ts_json_file, "a");
+	if (fp == NULL) {
+		fprintf(stderr, "failed to open %s: %s\n", ts_json_file,
+			strerror(errno));
+		return;
+	}
+
+	fprintf(fp, "{\"test\": \"%s\", \"type\": \"%s\", "
+		"\"class\": \"%s\", \"procs\": %d, \"credits\": %d, "
+		"\"objects\": %u, \"dkeys\": %u, \"akeys\": %u, "
+		"\"recxs\": %u, \"value_type\": \"%s\", "
+		"\"value_size\": %d, \"ops\": %lu, \"duration\": %.6f, "
+		"\"rate\": %.2f, \"latency\": %.3f, \"percentiles\": [",
+		test_name, ts_mode_name(), ts_class_name(),
+		ts_ctx.tsc_mpi_size, ts_ctx.tsc_cred_nr, ts_obj_p_cont,
+		ts_dkey_p_obj, ts_akey_p_dkey, ts_recx_p_akey, ts_val_type(),
+		ts_ctx.tsc_cred_vsize, total, duration, rate, latency);
+	for (i = 0; i < ts_lat_nr; i++) {
+		fprintf(fp, "%s{\"name\": \"%s\", \"ops\": "DF_U64", "
+			"\"min\": %.3f, \"avg\": %.3f, \"p50\": %.3f, "
+			"\"p90\": %.3f, \"p99\": %.3f, \"p999\": %.3f, "
+			"\"max\": %.3f}", i == 0 ? "" : ", ",
+			lats[i].tl_name, lats[i].tl_cnt,
+			lats[i].tl_min / 1000.0,
+			lats[i].tl_sum / 1000.0 / lats[i].tl_cnt,
+			ts_lat_pct(&lats[i], 500), ts_lat_pct(&lats[i], 900),
+			ts_lat_pct(&lats[i], 990), ts_lat_pct(&lats[i], 999),
+			lats[i].tl_max / 1000.0);
+	}
+	fprintf(fp, "]}\n");
+	fclose(fp);
+}
+
 void show_result(double now, double then, int vsize, char *test_name)
 {
+	static struct ts_lat	lats[TS_LAT_MAX];
 	double		duration, agg_duration;
 	double		first_start;
 	double		last_end;
 	double		duration_max;
 	double		duration_min;
 	double		duration_sum;
+	int		i;
 
 	duration = now - then;
 
@@ -909,6 +1651,9 @@ void show_result(double now, double then, int vsize, char *test_name)
 		duration_max = duration_min = duration_sum = duration;
 	}
 
+	for (i = 0; i < ts_lat_nr; i++)
+		ts_lat_reduce(&ts_lats[i], &lats[i]);
+
 	if (ts_ctx.tsc_mpi_rank == 0) {
 		unsigned long	total;
 		double		bandwidth;
@@ -918,6 +1663,11 @@ void show_result(double now, double then, int vsize, char *test_name)
 		total = ts_ctx.tsc_mpi_size *
 			ts_obj_p_cont * ts_dkey_p_obj *
 			ts_akey_p_dkey * ts_recx_p_akey;
+		/* the tests timing each operation know the number of them */
+		if (ts_lat_nr > 0) {
+			for (i = 0, total = 0; i < ts_lat_nr; i++)
+				total += lats[i].tl_cnt;
+		}
 
 		rate = total / agg_duration;
 		latency = (agg_duration * 1000 * 1000) / total;
@@ -938,6 +1688,26 @@ void show_result(double now, double then, int vsize, char *test_name)
 			duration_min);
 		fprintf(stdout, "\tAverage duration : %-10.6f sec\n",
 			duration_sum / ts_ctx.tsc_mpi_size);
+
+		for (i = 0; i < ts_lat_nr; i++) {
+			if (lats[i].tl_cnt == 0)
+				continue;
+			fprintf(stdout, "Latency of %s ("DF_U64" ops):\n"
+				"\tmin %-10.3f avg %-10.3f max %-10.3f us\n"
+				"\tp50 %-10.3f p90 %-10.3f p99 %-10.3f "
+				"p99.9 %-10.3f us\n", lats[i].tl_name,
+				lats[i].tl_cnt, lats[i].tl_min / 1000.0,
+				lats[i].tl_sum / 1000.0 / lats[i].tl_cnt,
+				lats[i].tl_max / 1000.0,
+				ts_lat_pct(&lats[i], 500),
+				ts_lat_pct(&lats[i], 900),
+				ts_lat_pct(&lats[i], 990),
+				ts_lat_pct(&lats[i], 999));
+		}
+
+		if (ts_json_file != NULL)
+			ts_json_write(test_name, agg_duration, total, rate,
+				      latency, lats);
 	}
 }
 enum {
@@ -946,6 +1716,11 @@ enum {
 	ITERATE_TEST,
 	REBUILD_TEST,
 	UPDATE_FETCH_TEST,
+	OPEN_TEST,
+	ENUM_TEST,
+	PUNCH_TEST,
+	QUERY_TEST,
+	SET_SIZE_TEST,
 	TEST_SIZE,
 };
 
@@ -956,7 +1731,12 @@ char	*perf_tests_name[] = {
 	"fetch",
 	"iterate",
 	"rebuild",
-	"update and fetch"
+	"update and fetch",
+	"open",
+	"enumerate",
+	"punch",
+	"query_key",
+	"set_size"
 };
 
 int
@@ -981,7 +1761,8 @@ main(int argc, char **argv)
 
 	memset(ts_pmem_file, 0, sizeof(ts_pmem_file));
 	while ((rc = getopt_long(argc, argv,
-				 "P:N:T:C:c:o:d:a:r:nASG:s:ztf:hUFRBvIiuw",
+				 "P:N:T:C:c:o:d:a:r:nASG:s:ztx:f:hUFRBvIiuwO"
+				 "EDQZj:",
 				 ts_ops, NULL)) != -1) {
 		char	*endp;
 
@@ -1087,6 +1868,17 @@ main(int argc, char **argv)
 		case 'z':
 			ts_zero_copy = true;
 			break;
+		case 'x':
+			if (!strcasecmp(optarg, "solo")) {
+				ts_dtx = TS_DTX_SOLO;
+			} else if (!strcasecmp(optarg, "dtx")) {
+				ts_dtx = TS_DTX_NON_REP;
+			} else {
+				if (ts_ctx.tsc_mpi_rank == 0)
+					ts_print_usage();
+				return -1;
+			}
+			break;
 		case 'f':
 			strncpy(ts_pmem_file, optarg, PATH_MAX - 1);
 			break;
@@ -1111,6 +1903,24 @@ main(int argc, char **argv)
 		case 'v':
 			ts_verify_fetch = true;
 			break;
+		case 'O':
+			perf_tests[OPEN_TEST] = ts_open_perf;
+			break;
+		case 'E':
+			perf_tests[ENUM_TEST] = ts_enum_perf;
+			break;
+		case 'D':
+			perf_tests[PUNCH_TEST] = ts_punch_perf;
+			break;
+		case 'Q':
+			perf_tests[QUERY_TEST] = ts_query_perf;
+			break;
+		case 'Z':
+			perf_tests[SET_SIZE_TEST] = ts_set_size_perf;
+			break;
+		case 'j':
+			ts_json_file = optarg;
+			break;
 		case 'n':
 			ts_nest_iterator = true;
 		case 'I':
@@ -1144,10 +1954,11 @@ main(int argc, char **argv)
 	}
 
 	/* It will run write tests by default */
-	if (perf_tests[REBUILD_TEST] == NULL &&
-	    perf_tests[FETCH_TEST] == NULL && perf_tests[UPDATE_TEST] == NULL &&
-	    perf_tests[UPDATE_FETCH_TEST] == NULL &&
-	    perf_tests[ITERATE_TEST] == NULL)
+	for (i = 0; i < TEST_SIZE; i++) {
+		if (perf_tests[i] != NULL)
+			break;
+	}
+	if (i == TEST_SIZE)
 		perf_tests[UPDATE_TEST] = ts_write_perf;
 
 	if ((perf_tests[FETCH_TEST] != NULL ||
@@ -1165,6 +1976,28 @@ main(int argc, char **argv)
 		return -1;
 	}
 
+	if (ts_dtx != TS_DTX_NONE &&
+	    (ts_mode != TS_MODE_VOS || !ts_zero_copy)) {
+		fprintf(stderr, "DTX can only run with -T \"vos\" and -z\n");
+		if (ts_ctx.tsc_mpi_rank == 0)
+			ts_print_usage();
+		return -1;
+	}
+
+	if (perf_tests[OPEN_TEST] && ts_mode != TS_MODE_DAOS) {
+		fprintf(stderr, "open can only run with -T \"daos\"\n");
+		if (ts_ctx.tsc_mpi_rank == 0)
+			ts_print_usage();
+		return -1;
+	}
+
+	if (perf_tests[SET_SIZE_TEST] && ts_mode != TS_MODE_DAOS) {
+		fprintf(stderr, "set_size can only run with -T \"daos\"\n");
+		if (ts_ctx.tsc_mpi_rank == 0)
+			ts_print_usage();
+		return -1;
+	}
+
 	if (perf_tests[ITERATE_TEST] && ts_class != DAOS_OC_RAW) {
 		fprintf(stderr, "iterate can only run with -T \"vos\"\n");
 		if (ts_ctx.tsc_mpi_rank == 0)
@@ -1218,6 +2051,7 @@ main(int argc, char **argv)
 			"\tvalue type    : %s\n"
 			"\tvalue size    : %u\n"
 			"\tzero copy     : %s\n"
+			"\tDTX           : %s\n"
 			"\toverwrite     : %s\n"
 			"\tverify fetch  : %s\n"
 			"\tVOS file      : %s\n",
@@ -1233,6 +2067,7 @@ main(int argc, char **argv)
 			ts_val_type(),
 			vsize,
 			ts_yes_or_no(ts_zero_copy),
+			ts_dtx_name(),
 			ts_yes_or_no(ts_overwrite),
 			ts_yes_or_no(ts_verify_fetch),
 			ts_mode == TS_MODE_VOS ? ts_pmem_file : "<NULL>");
@@ -1245,6 +2080,13 @@ main(int argc, char **argv)
 		return -1;
 	}
 
+	ts_oids = calloc(ts_obj_p_cont, sizeof(*ts_oids));
+	if (!ts_oids) {
+		fprintf(stderr, "failed to allocate %u object IDs\n",
+			ts_obj_p_cont);
+		return -1;
+	}
+
 	rc = dts_ctx_init(&ts_ctx);
 	if (rc)
 		return -1;
@@ -1267,6 +2109,7 @@ main(int argc, char **argv)
 
 		srand(seed);
 
+		ts_lat_nr = 0;
 		rc = perf_tests[i](&then, &now);
 		if (ts_ctx.tsc_mpi_size > 1) {
 			int rc_g;
@@ -1287,6 +2130,7 @@ main(int argc, char **argv)
 	dts_ctx_fini(&ts_ctx);
 	MPI_Finalize();
 	free(ts_ohs);
+	free(ts_oids);
 
 	return 0;
 }
@@ -1074,6 +1074,473 @@ truncate_array(void **state)
 	MPI_Barrier(MPI_COMM_WORLD);
 } /* End str_mem_str_arr_io */
 
+#define DEPTH_CHUNK	(64 * 1024)
+#define DEPTH_SIZE	(64 * 1024 * 1024)
+
+/* write then check the array with at most @depth chunk I/Os in flight */
+static void
+array_io_depth(test_arg_t *arg, char *buf, int depth)
+{
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	daos_array_iod_t iod;
+	daos_range_t	rg;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		str[16];
+	size_t		i;
+	int		rc;
+
+	sprintf(str, "%d", depth);
+	setenv("DAOS_ARRAY_IO_DEPTH", str, 1);
+
+	oid = dts_oid_gen(OC_SX, feat, arg->myrank);
+	rc = daos_array_create(arg->coh, oid, DAOS_TX_NONE, 1, DEPTH_CHUNK, &oh,
+			       NULL);
+	unsetenv("DAOS_ARRAY_IO_DEPTH");
+	assert_int_equal(rc, 0);
+
+	iod.arr_nr = 1;
+	rg.rg_len = DEPTH_SIZE;
+	rg.rg_idx = 0;
+	iod.arr_rgs = &rg;
+	d_iov_set(&iov, buf, DEPTH_SIZE);
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &iov;
+
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	memset(buf, 0, DEPTH_SIZE);
+	rc = daos_array_read(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < DEPTH_SIZE; i++)
+		if (buf[i] != (char)i)
+			break;
+	assert_int_equal(i, DEPTH_SIZE);
+
+	rc = daos_array_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static void
+io_depth(void **state)
+{
+	test_arg_t	*arg = *state;
+	char		*buf;
+	int		depths[] = {1, 4, 16, 64};
+	int		i;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	D_ALLOC(buf, DEPTH_SIZE);
+	assert_non_null(buf);
+
+	for (i = 0; i < ARRAY_SIZE(depths); i++) {
+		size_t	j;
+
+		for (j = 0; j < DEPTH_SIZE; j++)
+			buf[j] = j;
+		array_io_depth(arg, buf, depths[i]);
+	}
+
+	D_FREE(buf);
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/* cube of SLAB_DIM^3 int cells, also seen as a 2D array of SLAB_2D columns */
+#define SLAB_DIM	64
+#define SLAB_2D		512
+#define SLAB_CELLS	(SLAB_DIM * SLAB_DIM * SLAB_DIM)
+#define SLAB_CHUNK	4096
+#define SLAB_REPS	20
+
+static void
+slab_sgl(d_sg_list_t *sgl, d_iov_t *iov, int *buf, daos_size_t nr)
+{
+	d_iov_set(iov, buf, nr * sizeof(int));
+	sgl->sg_nr = 1;
+	sgl->sg_iovs = iov;
+}
+
+static void
+strided_slab_io(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_obj_id_t		oid;
+	daos_handle_t		oh;
+	daos_array_iod_t	iod;
+	daos_array_stride_t	st[2];
+	daos_range_t		rg;
+	daos_range_t		*rgs;
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	int			*cube;
+	int			*buf;
+	daos_size_t		x, y, z, idx;
+	daos_size_t		nerrors = 0;
+	uint64_t		t_st, t_rg;
+	int			i;
+	int			rc;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	oid = dts_oid_gen(OC_SX, feat, arg->myrank);
+
+	rc = daos_array_create(arg->coh, oid, DAOS_TX_NONE, sizeof(int),
+			       SLAB_CHUNK, &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	D_ALLOC_ARRAY(cube, SLAB_CELLS);
+	assert_non_null(cube);
+	D_ALLOC_ARRAY(buf, SLAB_CELLS);
+	assert_non_null(buf);
+
+	for (idx = 0; idx < SLAB_CELLS; idx++)
+		cube[idx] = idx;
+
+	iod.arr_nr = 1;
+	iod.arr_rgs = &rg;
+	rg.rg_idx = 0;
+	rg.rg_len = SLAB_CELLS;
+	slab_sgl(&sgl, &iov, cube, SLAB_CELLS);
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	/** 2D: rows [100, 300), columns [30, 180) */
+	rg.rg_idx = 100 * SLAB_2D + 30;
+	rg.rg_len = 150;
+	st[0].as_count = 200;
+	st[0].as_stride = SLAB_2D;
+	slab_sgl(&sgl, &iov, buf, 200 * 150);
+	rc = daos_array_read_strided(oh, DAOS_TX_NONE, &iod, 1, st, &sgl,
+				     NULL);
+	assert_int_equal(rc, 0);
+
+	for (y = 0; y < 200; y++)
+		for (x = 0; x < 150; x++)
+			if (buf[y * 150 + x] != (100 + y) * SLAB_2D + 30 + x)
+				nerrors++;
+	if (nerrors)
+		print_message("2D slab: %zu errors\n", nerrors);
+	assert_int_equal(nerrors, 0);
+
+	/** rows of 150 cells 100 cells apart overlap */
+	st[0].as_stride = 100;
+	rc = daos_array_read_strided(oh, DAOS_TX_NONE, &iod, 1, st, &sgl,
+				     NULL);
+	assert_int_equal(rc, -DER_INVAL);
+
+	/** the pattern does not fit in the array index space */
+	st[0].as_count = 4;
+	st[0].as_stride = UINT64_MAX / 2;
+	slab_sgl(&sgl, &iov, buf, 4 * 150);
+	rc = daos_array_read_strided(oh, DAOS_TX_NONE, &iod, 1, st, &sgl,
+				     NULL);
+	assert_int_equal(rc, -DER_INVAL);
+
+	/** 3D: z in [8, 40), y in [4, 44), x in [2, 52) */
+	rg.rg_idx = 8 * SLAB_DIM * SLAB_DIM + 4 * SLAB_DIM + 2;
+	rg.rg_len = 50;
+	st[0].as_count = 40;
+	st[0].as_stride = SLAB_DIM;
+	st[1].as_count = 32;
+	st[1].as_stride = SLAB_DIM * SLAB_DIM;
+	slab_sgl(&sgl, &iov, buf, 32 * 40 * 50);
+	rc = daos_array_read_strided(oh, DAOS_TX_NONE, &iod, 2, st, &sgl,
+				     NULL);
+	assert_int_equal(rc, 0);
+
+	for (z = 0; z < 32; z++)
+		for (y = 0; y < 40; y++)
+			for (x = 0; x < 50; x++) {
+				idx = (8 + z) * SLAB_DIM * SLAB_DIM +
+				      (4 + y) * SLAB_DIM + 2 + x;
+				if (buf[(z * 40 + y) * 50 + x] != idx)
+					nerrors++;
+			}
+	if (nerrors)
+		print_message("3D slab read: %zu errors\n", nerrors);
+	assert_int_equal(nerrors, 0);
+
+	/** overwrite the 3D slab with negated values */
+	for (i = 0; i < 32 * 40 * 50; i++)
+		buf[i] = -buf[i];
+	rc = daos_array_write_strided(oh, DAOS_TX_NONE, &iod, 2, st, &sgl,
+				      NULL);
+	assert_int_equal(rc, 0);
+
+	rg.rg_idx = 0;
+	rg.rg_len = SLAB_CELLS;
+	slab_sgl(&sgl, &iov, buf, SLAB_CELLS);
+	rc = daos_array_read(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	for (idx = 0; idx < SLAB_CELLS; idx++) {
+		z = idx / (SLAB_DIM * SLAB_DIM);
+		y = (idx / SLAB_DIM) % SLAB_DIM;
+		x = idx % SLAB_DIM;
+		if (z >= 8 && z < 40 && y >= 4 && y < 44 && x >= 2 && x < 52)
+			nerrors += (buf[idx] != -(int)idx);
+		else
+			nerrors += (buf[idx] != (int)idx);
+	}
+	if (nerrors)
+		print_message("3D slab write: %zu errors\n", nerrors);
+	assert_int_equal(nerrors, 0);
+
+	/** same 3D slab as one strided range and as a list of ranges */
+	D_ALLOC_ARRAY(rgs, 32 * 40);
+	assert_non_null(rgs);
+	for (z = 0; z < 32; z++)
+		for (y = 0; y < 40; y++) {
+			rgs[z * 40 + y].rg_idx = (8 + z) * SLAB_DIM * SLAB_DIM +
+						 (4 + y) * SLAB_DIM + 2;
+			rgs[z * 40 + y].rg_len = 50;
+		}
+
+	rg.rg_idx = 8 * SLAB_DIM * SLAB_DIM + 4 * SLAB_DIM + 2;
+	rg.rg_len = 50;
+	slab_sgl(&sgl, &iov, buf, 32 * 40 * 50);
+
+	t_st = daos_get_ntime();
+	for (i = 0; i < SLAB_REPS; i++) {
+		rc = daos_array_read_strided(oh, DAOS_TX_NONE, &iod, 2, st,
+					     &sgl, NULL);
+		assert_int_equal(rc, 0);
+	}
+	t_st = daos_get_ntime() - t_st;
+
+	iod.arr_nr = 32 * 40;
+	iod.arr_rgs = rgs;
+	t_rg = daos_get_ntime();
+	for (i = 0; i < SLAB_REPS; i++) {
+		rc = daos_array_read(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+		assert_int_equal(rc, 0);
+	}
+	t_rg = daos_get_ntime() - t_rg;
+
+	print_message("3D slab of %d cells: strided %8.2f MB/s, "
+		      "%d ranges %8.2f MB/s\n", 32 * 40 * 50,
+		      (double)SLAB_REPS * 32 * 40 * 50 * sizeof(int) * 1000 /
+		      t_st, 32 * 40,
+		      (double)SLAB_REPS * 32 * 40 * 50 * sizeof(int) * 1000 /
+		      t_rg);
+
+	D_FREE(rgs);
+	D_FREE(buf);
+	D_FREE(cube);
+
+	rc = daos_array_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_int_equal(rc, 0);
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/* array of SIZE_CHUNKS chunks of SIZE_CHUNK cells */
+#define SIZE_CHUNK	16
+#define SIZE_CHUNKS	10000
+#define SIZE_REPS	100
+
+/* return the average latency of @reps get_size on @oh, in microseconds */
+static double
+get_size_lat(daos_handle_t oh, daos_size_t expected, int reps)
+{
+	daos_size_t	size;
+	uint64_t	t;
+	int		i;
+	int		rc;
+
+	t = daos_get_ntime();
+	for (i = 0; i < reps; i++) {
+		rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+		assert_int_equal(rc, 0);
+		assert_int_equal(size, expected);
+	}
+	t = daos_get_ntime() - t;
+
+	return (double)t / reps / 1000;
+}
+
+static void
+cached_size(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	daos_handle_t	oh, excl_oh;
+	daos_array_iod_t iod;
+	daos_range_t	rg;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	daos_size_t	cell_size, chunk_size;
+	daos_size_t	size;
+	char		*buf;
+	double		lat, excl_lat;
+	int		rc;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	oid = dts_oid_gen(OC_SX, feat, arg->myrank);
+
+	rc = daos_array_create(arg->coh, oid, DAOS_TX_NONE, 1, SIZE_CHUNK,
+			       &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	D_ALLOC(buf, SIZE_CHUNK * SIZE_CHUNKS);
+	assert_non_null(buf);
+	memset(buf, 'a', SIZE_CHUNK * SIZE_CHUNKS);
+
+	iod.arr_nr = 1;
+	iod.arr_rgs = &rg;
+	rg.rg_idx = 0;
+	rg.rg_len = SIZE_CHUNK * SIZE_CHUNKS;
+	d_iov_set(&iov, buf, SIZE_CHUNK * SIZE_CHUNKS);
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &iov;
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_int_equal(rc, 0);
+
+	rc = daos_array_open(arg->coh, oid, DAOS_TX_NONE, DAOS_OO_RW,
+			     &cell_size, &chunk_size, &oh, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_open(arg->coh, oid, DAOS_TX_NONE,
+			     DAOS_OO_RW | DAOS_OO_EXCL, &cell_size,
+			     &chunk_size, &excl_oh, NULL);
+	assert_int_equal(rc, 0);
+
+	size = SIZE_CHUNK * SIZE_CHUNKS;
+	lat = get_size_lat(oh, size, SIZE_REPS);
+	excl_lat = get_size_lat(excl_oh, size, SIZE_REPS);
+	print_message("get_size of %d chunks: %8.2f us, cached %8.2f us\n",
+		      SIZE_CHUNKS, lat, excl_lat);
+
+	/** extend through the exclusive handle, in one chunk and past it */
+	rg.rg_idx = size + 3;
+	rg.rg_len = 1;
+	d_iov_set(&iov, buf, 1);
+	rc = daos_array_write(excl_oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	size += 4;
+	get_size_lat(excl_oh, size, 1);
+	get_size_lat(oh, size, 1);
+
+	/** a write below the end does not change the size */
+	rg.rg_idx = 5;
+	rc = daos_array_write(excl_oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	get_size_lat(excl_oh, size, 1);
+
+	/** shrink, then expand */
+	size = SIZE_CHUNK * 10 + 7;
+	rc = daos_array_set_size(excl_oh, DAOS_TX_NONE, size, NULL);
+	assert_int_equal(rc, 0);
+	get_size_lat(excl_oh, size, 1);
+	get_size_lat(oh, size, 1);
+
+	size = SIZE_CHUNK * SIZE_CHUNKS * 2;
+	rc = daos_array_set_size(excl_oh, DAOS_TX_NONE, size, NULL);
+	assert_int_equal(rc, 0);
+	get_size_lat(excl_oh, size, 1);
+	get_size_lat(oh, size, 1);
+
+	/** punching the last record drops the cached size */
+	rg.rg_idx = size - 1;
+	rc = daos_array_punch(excl_oh, DAOS_TX_NONE, &iod, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+	assert_int_equal(rc, 0);
+	get_size_lat(excl_oh, size, 1);
+
+	D_FREE(buf);
+	rc = daos_array_close(excl_oh, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_int_equal(rc, 0);
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+#define BATCH_CHUNK	4096
+#define BATCH_SIZE	(16 * 1024 * 1024)
+
+/*
+ * Write then check an array of small chunks with up to @batch dkeys per I/O.
+ * The object has a single redundancy group, so each I/O is one RPC.
+ */
+static void
+array_io_batch(test_arg_t *arg, char *buf, int batch)
+{
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	daos_array_iod_t iod;
+	daos_range_t	rg;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		str[16];
+	size_t		i;
+	int		rc;
+
+	sprintf(str, "%d", batch);
+	setenv("DAOS_ARRAY_IO_BATCH", str, 1);
+
+	oid = dts_oid_gen(OC_S1, feat, arg->myrank);
+	rc = daos_array_create(arg->coh, oid, DAOS_TX_NONE, 1, BATCH_CHUNK,
+			       &oh, NULL);
+	unsetenv("DAOS_ARRAY_IO_BATCH");
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < BATCH_SIZE; i++)
+		buf[i] = i % 251;
+
+	iod.arr_nr = 1;
+	rg.rg_len = BATCH_SIZE;
+	rg.rg_idx = 0;
+	iod.arr_rgs = &rg;
+	d_iov_set(&iov, buf, BATCH_SIZE);
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &iov;
+
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	memset(buf, 0, BATCH_SIZE);
+	rc = daos_array_read(oh, DAOS_TX_NONE, &iod, &sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < BATCH_SIZE; i++)
+		if (buf[i] != (char)(i % 251))
+			break;
+	assert_int_equal(i, BATCH_SIZE);
+
+	rc = daos_array_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static void
+multi_dkey_batch(void **state)
+{
+	test_arg_t	*arg = *state;
+	char		*buf;
+	int		batches[] = {1, 8, 32, 128};
+	int		i;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	D_ALLOC(buf, BATCH_SIZE);
+	assert_non_null(buf);
+
+	for (i = 0; i < ARRAY_SIZE(batches); i++)
+		array_io_batch(arg, buf, batches[i]);
+
+	D_FREE(buf);
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
 static const struct CMUnitTest array_api_tests[] = {
 	{"Array API: create/open/close (blocking)",
 	 simple_array_mgmt, async_disable, NULL},
@@ -1097,6 +1564,14 @@ static const struct CMUnitTest array_api_tests[] = {
 	 strided_array, async_disable, NULL},
 	{"Array API: write after truncate",
 	 truncate_array, async_disable, NULL},
+	{"Array API: chunk I/O depth (blocking)",
+	 io_depth, async_disable, NULL},
+	{"Array API: strided 2D/3D slab access (blocking)",
+	 strided_slab_io, async_disable, NULL},
+	{"Array API: cached array size (blocking)",
+	 cached_size, async_disable, NULL},
+	{"Array API: multi-dkey I/O of small chunks (blocking)",
+	 multi_dkey_batch, async_disable, NULL},
 };
 
 static int
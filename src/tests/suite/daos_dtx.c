@@ -673,6 +673,57 @@ dtx_17(void **state)
 	ioreq_fini(&req);
 }
 
+static void
+dtx_18(void **state)
+{
+	test_arg_t	*arg = *state;
+	char		*update_buf;
+	char		*ptr;
+	const char	*dkey = dts_dtx_dkey;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	int		 count = DTX_PIGGYBACK_MAX_COUNT / 2;
+	int		 rc;
+	int		 i;
+
+	print_message("piggyback committable DTXs on the next update\n");
+
+	if (!test_runable(arg, dts_dtx_replica_cnt))
+		return;
+
+	D_ALLOC(update_buf, (count + 1) * 8);
+	assert_non_null(update_buf);
+
+	oid = dts_oid_gen(dts_dtx_class, 0, arg->myrank);
+	arg->async = 0;
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	/* Far below the batched commit thresholds, each update only leaves
+	 * its DTX committable on the leader, the next update piggybacks it.
+	 */
+	for (i = 0; i <= count; i++) {
+		ptr = &update_buf[i * 8];
+		dts_buf_render(ptr, 8);
+
+		insert_single(dkey, ptr, 0, ptr, 8, DAOS_TX_NONE, &req);
+	}
+
+	/* Without waiting for the batched commit, all but the last update
+	 * are committed on every replica.
+	 */
+	daos_fail_loc_set(DAOS_OBJ_SPECIAL_SHARD | DAOS_FAIL_ALWAYS);
+	for (i = 0; i < count; i++) {
+		ptr = &update_buf[i * 8];
+		rc = dtx_check_replicas_v2(dkey, ptr, "piggyback_commit",
+					   ptr, 8, false, &req);
+		assert_int_equal(rc, dts_dtx_replica_cnt);
+	}
+	daos_fail_loc_set(0);
+
+	D_FREE(update_buf);
+	ioreq_fini(&req);
+}
+
 static const struct CMUnitTest dtx_tests[] = {
 	{"DTX1: update/punch single value with DTX successfully",
 	 dtx_1, NULL, test_case_teardown},
@@ -708,6 +759,8 @@ static const struct CMUnitTest dtx_tests[] = {
 	 dtx_16, NULL, test_case_teardown},
 	{"DTX17: DTX resync during open-close",
 	 dtx_17, NULL, test_case_teardown},
+	{"DTX18: Piggyback committable DTXs on the next update",
+	 dtx_18, NULL, test_case_teardown},
 };
 
 int
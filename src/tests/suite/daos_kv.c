@@ -227,11 +227,333 @@ simple_put_get(void **state)
 	print_message("all good\n");
 } /* End simple_put_get */
 
+#define MULTI_KEYS	4096
+#define MULTI_VAL	64
+
+/* return the time to put or get MULTI_KEYS keys in batches of @batch keys */
+static uint64_t
+multi_io(daos_handle_t oh, bool put, int batch, const char **keys,
+	 daos_size_t *sizes, void **bufs)
+{
+	uint64_t	t;
+	int		i;
+	int		rc;
+
+	t = daos_get_ntime();
+	for (i = 0; i < MULTI_KEYS; i += batch) {
+		if (put)
+			rc = daos_kv_put_multi(oh, DAOS_TX_NONE, batch,
+					       &keys[i], &sizes[i], &bufs[i],
+					       NULL);
+		else
+			rc = daos_kv_get_multi(oh, DAOS_TX_NONE, batch,
+					       &keys[i], &sizes[i], &bufs[i],
+					       NULL);
+		assert_int_equal(rc, 0);
+	}
+	return daos_get_ntime() - t;
+}
+
+static void
+multi_put_get(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	const char	*keys[MULTI_KEYS];
+	daos_size_t	sizes[MULTI_KEYS];
+	void		*bufs[MULTI_KEYS];
+	char		*key_buf;
+	char		*val_buf;
+	char		*out_buf;
+	const char	*missing = "missing";
+	daos_size_t	size;
+	uint64_t	t_put, t_get;
+	int		batch;
+	int		i;
+	int		rc;
+
+	D_ALLOC(key_buf, MULTI_KEYS * 16);
+	assert_non_null(key_buf);
+	D_ALLOC(val_buf, MULTI_KEYS * MULTI_VAL);
+	assert_non_null(val_buf);
+	D_ALLOC(out_buf, MULTI_KEYS * MULTI_VAL);
+	assert_non_null(out_buf);
+	dts_buf_render(val_buf, MULTI_KEYS * MULTI_VAL);
+
+	for (i = 0; i < MULTI_KEYS; i++) {
+		sprintf(&key_buf[i * 16], "mkey%d", i);
+		keys[i] = &key_buf[i * 16];
+	}
+
+	oid = dts_oid_gen(OC_SX, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, 0, &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	print_message("%d keys of %d bytes\n", MULTI_KEYS, MULTI_VAL);
+	for (batch = 1; batch <= 1024; batch *= 4) {
+		for (i = 0; i < MULTI_KEYS; i++) {
+			sizes[i] = MULTI_VAL;
+			bufs[i] = &val_buf[i * MULTI_VAL];
+		}
+		t_put = multi_io(oh, true, batch, keys, sizes, bufs);
+
+		memset(out_buf, 0, MULTI_KEYS * MULTI_VAL);
+		for (i = 0; i < MULTI_KEYS; i++) {
+			sizes[i] = MULTI_VAL;
+			bufs[i] = &out_buf[i * MULTI_VAL];
+		}
+		t_get = multi_io(oh, false, batch, keys, sizes, bufs);
+
+		for (i = 0; i < MULTI_KEYS; i++)
+			assert_int_equal(sizes[i], MULTI_VAL);
+		assert_memory_equal(out_buf, val_buf, MULTI_KEYS * MULTI_VAL);
+
+		print_message("batch %4d: put %10.0f keys/s, get %10.0f "
+			      "keys/s\n", batch,
+			      (double)MULTI_KEYS * 1e9 / t_put,
+			      (double)MULTI_KEYS * 1e9 / t_get);
+	}
+
+	/** sizes only, and a key that does not exist */
+	keys[0] = missing;
+	for (i = 0; i < 16; i++)
+		sizes[i] = DAOS_REC_ANY;
+	rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 16, keys, sizes, NULL, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(sizes[0], 0);
+	for (i = 1; i < 16; i++)
+		assert_int_equal(sizes[i], MULTI_VAL);
+
+	/** the batch is the same as single gets */
+	size = MULTI_VAL;
+	rc = daos_kv_get(oh, DAOS_TX_NONE, keys[1], &size, out_buf, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, MULTI_VAL);
+	assert_memory_equal(out_buf, &val_buf[MULTI_VAL], MULTI_VAL);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+
+	D_FREE(out_buf);
+	D_FREE(val_buf);
+	D_FREE(key_buf);
+}
+
+#define SCAN_KEYS	1000
+#define SCAN_BUF	(64 * 1024)
+#define SCAN_KDS	1024
+
+/*
+ * Scan the whole object with @filter, or list it if NULL. Return the number
+ * of keys. Values are checked.
+ */
+static int
+scan_keys(daos_handle_t oh, daos_kv_filter_t *filter)
+{
+	daos_key_desc_t	*kds;
+	daos_anchor_t	 anchor = {0};
+	d_sg_list_t	 sgl;
+	d_iov_t		 sg_iov;
+	char		*buf;
+	char		 key[32];
+	bool		 values;
+	int		 key_nr = 0;
+	int		 rc;
+
+	values = filter != NULL && (filter->ksf_flags & DAOS_KV_SCAN_VALUES);
+	D_ALLOC(buf, SCAN_BUF);
+	assert_non_null(buf);
+	D_ALLOC_ARRAY(kds, SCAN_KDS);
+	assert_non_null(kds);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &sg_iov;
+
+	while (!daos_anchor_is_eof(&anchor)) {
+		uint32_t	nr = SCAN_KDS;
+		uint32_t	i;
+		char		*ptr;
+
+		d_iov_set(&sg_iov, buf, SCAN_BUF);
+		if (filter)
+			rc = daos_kv_scan(oh, DAOS_TX_NONE, filter, &nr, kds,
+					  &sgl, &anchor, NULL);
+		else
+			rc = daos_kv_list(oh, DAOS_TX_NONE, &nr, kds, &sgl,
+					  &anchor, NULL);
+		assert_int_equal(rc, 0);
+
+		for (ptr = buf, i = 0; i < nr; i++) {
+			if (!values || i % 2 == 0) {
+				assert_true(kds[i].kd_key_len < sizeof(key));
+				memcpy(key, ptr, kds[i].kd_key_len);
+				key[kds[i].kd_key_len] = '\0';
+				ptr += kds[i].kd_key_len;
+				key_nr++;
+				continue;
+			}
+			/** the value of "<prefix>/<n>" is n */
+			assert_int_equal(kds[i].kd_val_type, DAOS_IOD_SINGLE);
+			assert_int_equal(kds[i].kd_key_len, sizeof(int));
+			assert_int_equal(*(int *)ptr,
+					 atoi(strchr(key, '/') + 1));
+			ptr += kds[i].kd_key_len;
+		}
+		if (filter == NULL || nr == 0)
+			continue;
+		/** only the matching keys are returned */
+		if (filter->ksf_flags & DAOS_KV_SCAN_PREFIX)
+			assert_memory_equal(buf, filter->ksf_lo.iov_buf,
+					    filter->ksf_lo.iov_len);
+	}
+
+	D_FREE(kds);
+	D_FREE(buf);
+	return key_nr;
+}
+
+/*
+ * Scan "big/0", with a value too large to be returned, and "big/1", with the
+ * value 1. The first value fails the fetch of the values, which is retried.
+ */
+static void
+scan_large_value(daos_handle_t oh)
+{
+	daos_kv_filter_t	filter;
+	daos_key_desc_t		kds[4];
+	daos_anchor_t		anchor = {0};
+	d_sg_list_t		sgl;
+	d_iov_t			sg_iov;
+	char			*big;
+	char			*buf;
+	char			*ptr;
+	int			val = 1;
+	int			found = 0;
+	uint32_t		nr;
+	uint32_t		i;
+	int			rc;
+
+	D_ALLOC(big, DAOS_KV_SCAN_INLINE_MAX + 1);
+	assert_non_null(big);
+	D_ALLOC(buf, SCAN_BUF);
+	assert_non_null(buf);
+
+	rc = daos_kv_put(oh, DAOS_TX_NONE, "big/0", DAOS_KV_SCAN_INLINE_MAX + 1,
+			 big, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_kv_put(oh, DAOS_TX_NONE, "big/1", sizeof(int), &val, NULL);
+	assert_int_equal(rc, 0);
+
+	memset(&filter, 0, sizeof(filter));
+	filter.ksf_flags = DAOS_KV_SCAN_PREFIX | DAOS_KV_SCAN_VALUES;
+	d_iov_set(&filter.ksf_lo, "big/", strlen("big/"));
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &sg_iov;
+
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = ARRAY_SIZE(kds);
+		d_iov_set(&sg_iov, buf, SCAN_BUF);
+		rc = daos_kv_scan(oh, DAOS_TX_NONE, &filter, &nr, kds, &sgl,
+				  &anchor, NULL);
+		assert_int_equal(rc, 0);
+
+		for (ptr = buf, i = 0; i < nr; i += 2) {
+			assert_int_equal(kds[i].kd_key_len, strlen("big/0"));
+			if (ptr[strlen("big/")] == '0') {
+				assert_int_equal(kds[i + 1].kd_val_type,
+						 DAOS_IOD_NONE);
+				assert_int_equal(kds[i + 1].kd_key_len,
+						 DAOS_KV_SCAN_INLINE_MAX + 1);
+				ptr += kds[i].kd_key_len;
+			} else {
+				assert_int_equal(kds[i + 1].kd_val_type,
+						 DAOS_IOD_SINGLE);
+				ptr += kds[i].kd_key_len;
+				assert_int_equal(*(int *)ptr, 1);
+				ptr += kds[i + 1].kd_key_len;
+			}
+			found++;
+		}
+	}
+	assert_int_equal(found, 2);
+
+	D_FREE(buf);
+	D_FREE(big);
+}
+
+static void
+scan_filter(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_obj_id_t		oid;
+	daos_handle_t		oh;
+	daos_kv_filter_t	filter;
+	char			key[32];
+	int			i, nr, in_range;
+	int			rc;
+
+	oid = dts_oid_gen(OC_SX, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, 0, &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	/** SCAN_KEYS "user/<n>" and 10 "grp/<n>" keys, value n */
+	in_range = 0;
+	for (i = 0; i < SCAN_KEYS + 10; i++) {
+		if (i < SCAN_KEYS)
+			sprintf(key, "user/%d", i);
+		else
+			sprintf(key, "grp/%d", i - SCAN_KEYS);
+		/** "user/1" <= key < "user/2" in byte order */
+		if (strcmp(key, "user/1") >= 0 && strcmp(key, "user/2") < 0)
+			in_range++;
+		nr = i < SCAN_KEYS ? i : i - SCAN_KEYS;
+		rc = daos_kv_put(oh, DAOS_TX_NONE, key, sizeof(int), &nr,
+				 NULL);
+		assert_int_equal(rc, 0);
+	}
+
+	nr = scan_keys(oh, NULL);
+	assert_int_equal(nr, SCAN_KEYS + 10);
+
+	memset(&filter, 0, sizeof(filter));
+	filter.ksf_flags = DAOS_KV_SCAN_PREFIX;
+	d_iov_set(&filter.ksf_lo, "grp/", strlen("grp/"));
+	nr = scan_keys(oh, &filter);
+	assert_int_equal(nr, 10);
+
+	filter.ksf_flags |= DAOS_KV_SCAN_VALUES;
+	nr = scan_keys(oh, &filter);
+	assert_int_equal(nr, 10);
+
+	filter.ksf_flags = DAOS_KV_SCAN_RANGE | DAOS_KV_SCAN_VALUES;
+	d_iov_set(&filter.ksf_lo, "user/1", strlen("user/1"));
+	d_iov_set(&filter.ksf_hi, "user/2", strlen("user/2"));
+	nr = scan_keys(oh, &filter);
+	assert_int_equal(nr, in_range);
+
+	/** no upper bound */
+	filter.ksf_flags = DAOS_KV_SCAN_RANGE;
+	d_iov_set(&filter.ksf_lo, "user/", strlen("user/"));
+	d_iov_set(&filter.ksf_hi, NULL, 0);
+	nr = scan_keys(oh, &filter);
+	assert_int_equal(nr, SCAN_KEYS);
+
+	scan_large_value(oh);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+}
+
 static const struct CMUnitTest kv_tests[] = {
 	{"KV: Object Put/GET (blocking)",
 	 simple_put_get, async_disable, NULL},
 	{"KV: Object Put/GET (non-blocking)",
 	 simple_put_get, async_enable, NULL},
+	{"KV: Object multi Put/GET with batch sizes (blocking)",
+	 multi_put_get, async_disable, NULL},
+	{"KV: Object scan with key filter (blocking)",
+	 scan_filter, async_disable, NULL},
 };
 
 int
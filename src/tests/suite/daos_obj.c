@@ -3641,6 +3641,88 @@ io_capa_iv_fetch(void **state)
 	ioreq_fini(&req);
 }
 
+/* stream the dkeys of @oh, return the number of keys, each one seen once */
+static int
+enum_stream_dkeys(daos_handle_t oh, uint32_t flags, int key_max)
+{
+	daos_key_desc_t	 kds[ENUM_DESC_NR];
+	d_sg_list_t	 sgl;
+	d_iov_t		 iov;
+	daos_handle_t	 eh;
+	char		 buf[ENUM_DESC_BUF];
+	char		 key[ENUM_KEY_BUF];
+	char		*seen;
+	char		*ptr;
+	uint32_t	 number;
+	int		 key_nr = 0;
+	int		 i;
+	int		 rc;
+
+	D_ALLOC(seen, key_max);
+	assert_non_null(seen);
+
+	rc = daos_obj_enum_open(oh, DAOS_TX_NONE, NULL, flags, &eh);
+	assert_int_equal(rc, 0);
+
+	d_iov_set(&iov, buf, sizeof(buf));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+	do {
+		number = ENUM_DESC_NR;
+		rc = daos_obj_enum_next(eh, &number, kds, &sgl);
+		assert_int_equal(rc, 0);
+
+		for (ptr = buf, i = 0; i < number; i++) {
+			assert_true(kds[i].kd_key_len < ENUM_KEY_BUF);
+			snprintf(key, kds[i].kd_key_len + 1, "%s", ptr);
+			ptr += kds[i].kd_key_len;
+			rc = atoi(key);
+			assert_true(rc >= 0 && rc < key_max);
+			assert_int_equal(seen[rc], 0);
+			seen[rc] = 1;
+		}
+		key_nr += number;
+	} while (number > 0);
+
+	rc = daos_obj_enum_close(eh);
+	assert_int_equal(rc, 0);
+	D_FREE(seen);
+	return key_nr;
+}
+
+/** enumeration stream, sequential and one lane per redundancy group */
+static void
+io_enum_stream(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	char		 key[ENUM_KEY_BUF];
+	int		 key_nr;
+	int		 i;
+
+	oid = dts_oid_gen(OC_SX, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+
+	print_message("Insert %d dkeys (obj:"DF_OID")\n", ENUM_KEY_REC_NR,
+		      DP_OID(oid));
+	for (i = 0; i < ENUM_KEY_REC_NR; i++) {
+		sprintf(key, "%d", i);
+		insert_single(key, "a_key", 0, "data", strlen("data") + 1,
+			      DAOS_TX_NONE, &req);
+	}
+
+	key_nr = enum_stream_dkeys(req.oh, 0, ENUM_KEY_REC_NR);
+	assert_int_equal(key_nr, ENUM_KEY_REC_NR);
+
+	key_nr = enum_stream_dkeys(req.oh, DAOS_OBJ_ENUM_PARALLEL,
+				   ENUM_KEY_REC_NR);
+	assert_int_equal(key_nr, ENUM_KEY_REC_NR);
+
+	ioreq_fini(&req);
+}
+
 static const struct CMUnitTest io_tests[] = {
 	{ "IO1: simple update/fetch/verify",
 	  io_simple, async_disable, test_case_teardown},
@@ -3717,6 +3799,8 @@ static const struct CMUnitTest io_tests[] = {
 	  fetch_mixed_keys, async_disable, test_case_teardown},
 	{ "IO38: force capablity IV fetch",
 	  io_capa_iv_fetch, async_disable, test_case_teardown},
+	{ "IO39: enumeration stream",
+	  io_enum_stream, async_disable, test_case_teardown},
 };
 
 int
@@ -522,6 +522,11 @@ pool_properties(void **state)
 		print_message("reclaim verification filed.\n");
 		assert_int_equal(rc, 1); /* fail the test */
 	}
+	entry = daos_prop_entry_get(prop_query, DAOS_PROP_PO_IO_BULK);
+	if (entry == NULL || entry->dpe_val != DAOS_IO_BULK_FIXED) {
+		print_message("io_bulk verification failed.\n");
+		assert_int_equal(rc, 1); /* fail the test */
+	}
 
 	entry = daos_prop_entry_get(prop_query, DAOS_PROP_PO_ACL);
 	if (entry == NULL || entry->dpe_val_ptr == NULL ||
@@ -562,6 +567,97 @@ pool_properties(void **state)
 	test_teardown((void **)&arg);
 }
 
+/* number of handles shared with each rank */
+#define SHARE_CLIENTS	16
+
+/**
+ * Share a pool connection with SHARE_CLIENTS handles per rank through
+ * local2global/global2local. Each handle is queried, and exported again to
+ * check that the decoded pool map is the one of the original handle.
+ */
+static void
+pool_share_map(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_handle_t		 pohs[SHARE_CLIENTS];
+	daos_handle_t		 poh = DAOS_HDL_INVAL;
+	daos_pool_info_t	 info;
+	daos_pool_info_t	 sinfo;
+	d_iov_t			 ghdl = { NULL, 0, 0 };
+	d_iov_t			 shdl = { NULL, 0, 0 };
+	int			 i;
+	int			 rc;
+
+	/** rank 0 connects once and broadcasts the handle */
+	MPI_Barrier(MPI_COMM_WORLD);
+	memset(&info, 0, sizeof(info));
+	if (arg->myrank == 0) {
+		rc = daos_pool_connect(arg->pool.pool_uuid, arg->group,
+				       &arg->pool.svc, DAOS_PC_RW, &poh,
+				       NULL /* info */, NULL /* ev */);
+		assert_int_equal(rc, 0);
+		info.pi_bits = DPI_ALL;
+		rc = daos_pool_query(poh, NULL /* tgts */, &info, NULL, NULL);
+		assert_int_equal(rc, 0);
+		rc = daos_pool_local2global(poh, &ghdl);
+		assert_int_equal(rc, 0);
+	}
+	rc = MPI_Bcast(&info, sizeof(info), MPI_BYTE, 0, MPI_COMM_WORLD);
+	assert_int_equal(rc, MPI_SUCCESS);
+	rc = MPI_Bcast(&ghdl.iov_buf_len, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+	assert_int_equal(rc, MPI_SUCCESS);
+	D_ALLOC(ghdl.iov_buf, ghdl.iov_buf_len);
+	assert_non_null(ghdl.iov_buf);
+	ghdl.iov_len = ghdl.iov_buf_len;
+	if (arg->myrank == 0) {
+		rc = daos_pool_local2global(poh, &ghdl);
+		assert_int_equal(rc, 0);
+	}
+	rc = MPI_Bcast(ghdl.iov_buf, ghdl.iov_len, MPI_BYTE, 0,
+		       MPI_COMM_WORLD);
+	assert_int_equal(rc, MPI_SUCCESS);
+
+	D_ALLOC(shdl.iov_buf, ghdl.iov_len);
+	assert_non_null(shdl.iov_buf);
+	for (i = 0; i < SHARE_CLIENTS; i++) {
+		rc = daos_pool_global2local(ghdl, &pohs[i]);
+		assert_int_equal(rc, 0);
+
+		/** the decoded map is encoded again to the same bytes */
+		shdl.iov_buf_len = ghdl.iov_len;
+		shdl.iov_len = 0;
+		rc = daos_pool_local2global(pohs[i], &shdl);
+		assert_int_equal(rc, 0);
+		assert_int_equal(shdl.iov_len, ghdl.iov_len);
+		assert_memory_equal(shdl.iov_buf, ghdl.iov_buf, ghdl.iov_len);
+
+		memset(&sinfo, 0, sizeof(sinfo));
+		sinfo.pi_bits = DPI_ALL;
+		rc = daos_pool_query(pohs[i], NULL /* tgts */, &sinfo, NULL,
+				     NULL);
+		assert_int_equal(rc, 0);
+		assert_memory_equal(sinfo.pi_uuid, info.pi_uuid,
+				    sizeof(uuid_t));
+		assert_int_equal(sinfo.pi_ntargets, info.pi_ntargets);
+		assert_int_equal(sinfo.pi_nnodes, info.pi_nnodes);
+		assert_int_equal(sinfo.pi_ndisabled, info.pi_ndisabled);
+		assert_int_equal(sinfo.pi_map_ver, info.pi_map_ver);
+	}
+	D_FREE(shdl.iov_buf);
+
+	/** the slaves go before the master */
+	for (i = 0; i < SHARE_CLIENTS; i++) {
+		rc = daos_pool_disconnect(pohs[i], NULL);
+		assert_int_equal(rc, 0);
+	}
+	D_FREE(ghdl.iov_buf);
+	MPI_Barrier(MPI_COMM_WORLD);
+	if (arg->myrank == 0) {
+		rc = daos_pool_disconnect(poh, NULL);
+		assert_int_equal(rc, 0);
+	}
+}
+
 static int
 pool_setup_sync(void **state)
 {
@@ -607,6 +703,8 @@ static const struct CMUnitTest pool_tests[] = {
 	  init_fini_conn, NULL, test_case_teardown},
 	{ "POOL10: pool create with properties and query",
 	  pool_properties, NULL, test_case_teardown},
+	{ "POOL11: pool map of shared pool handles",
+	  pool_share_map, NULL, test_case_teardown},
 };
 
 int
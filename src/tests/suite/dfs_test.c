@@ -237,11 +237,975 @@ dfs_test_read_shared_file(void **state)
 	dfs_test_file_del(name);
 }
 
+/** read the whole file sequentially with @buf_size, returns elapsed ns */
+static uint64_t
+dfs_test_seq_read(dfs_t *dfs_mt, const char *name, char *data,
+		  daos_size_t file_size, daos_size_t buf_size)
+{
+	dfs_obj_t	*obj;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	daos_size_t	off = 0;
+	daos_size_t	got_size;
+	uint64_t	start;
+	int		rc;
+
+	rc = dfs_open(dfs_mt, NULL, name, S_IFREG, O_RDONLY, 0, 0, NULL,
+		      &obj);
+	assert_int_equal(rc, 0);
+
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	start = daos_get_ntime();
+	while (off < file_size) {
+		d_iov_set(&iov, data + off, min(buf_size, file_size - off));
+		rc = dfs_read(dfs_mt, obj, &sgl, off, &got_size, NULL);
+		assert_int_equal(rc, 0);
+		assert_int_equal(got_size, iov.iov_len);
+		off += got_size;
+	}
+
+	/** reading at EOF returns nothing */
+	d_iov_set(&iov, data, buf_size);
+	rc = dfs_read(dfs_mt, obj, &sgl, off, &got_size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(got_size, 0);
+
+	start = daos_get_ntime() - start;
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	return start;
+}
+
+static void
+dfs_test_read_ahead(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_size_t	chunk_size = 64 * 1024;
+	daos_size_t	file_size = 8 * 1024 * 1024 + 1000;
+	daos_size_t	buf_size = 4096;
+	char		*name = "RA_file";
+	char		*data, *data_ra;
+	dfs_t		*dfs_ra;
+	uint64_t	ns, ns_ra;
+	int		rc;
+
+	rc = dfs_test_file_gen(name, chunk_size, file_size);
+	assert_int_equal(rc, 0);
+
+	/** mount the same container again, with read-ahead enabled */
+	setenv("DFS_READ_AHEAD", "8", 1);
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDONLY, &dfs_ra);
+	unsetenv("DFS_READ_AHEAD");
+	assert_int_equal(rc, 0);
+
+	D_ALLOC(data, file_size);
+	assert_non_null(data);
+	D_ALLOC(data_ra, file_size);
+	assert_non_null(data_ra);
+
+	ns = dfs_test_seq_read(dfs, name, data, file_size, buf_size);
+	ns_ra = dfs_test_seq_read(dfs_ra, name, data_ra, file_size, buf_size);
+	assert_memory_equal(data, data_ra, file_size);
+
+	print_message("sequential read of "DF_U64" bytes with "DF_U64
+		      " bytes buffer: %.2f MB/s, %.2f MB/s with read-ahead\n",
+		      file_size, buf_size, (double)file_size * 1000 / ns,
+		      (double)file_size * 1000 / ns_ra);
+
+	D_FREE(data_ra);
+	D_FREE(data);
+	rc = dfs_umount(dfs_ra);
+	assert_int_equal(rc, 0);
+	dfs_test_file_del(name);
+}
+
+static void
+dfs_test_write_back(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_size_t	chunk_size = 64 * 1024;
+	daos_size_t	file_size = 1024 * 1024 + 1000;
+	daos_size_t	buf_size = 1000;
+	daos_size_t	off = 0;
+	daos_size_t	size;
+	char		*name = "WB_file";
+	char		*data, *data_read;
+	dfs_obj_t	*obj;
+	dfs_t		*dfs_wb;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	uint64_t	ns;
+	int		rc;
+
+	/** mount the same container again, with write-back enabled */
+	setenv("DFS_WRITE_BACK", "1", 1);
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs_wb);
+	unsetenv("DFS_WRITE_BACK");
+	assert_int_equal(rc, 0);
+
+	D_ALLOC(data, file_size);
+	assert_non_null(data);
+	D_ALLOC(data_read, file_size);
+	assert_non_null(data_read);
+	dts_buf_render(data, file_size);
+
+	rc = dfs_open(dfs_wb, NULL, name, S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT, 0, chunk_size, NULL, &obj);
+	assert_int_equal(rc, 0);
+
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	ns = daos_get_ntime();
+	while (off < file_size) {
+		d_iov_set(&iov, data + off, min(buf_size, file_size - off));
+		rc = dfs_write(dfs_wb, obj, &sgl, off, NULL);
+		assert_int_equal(rc, 0);
+		off += iov.iov_len;
+	}
+	ns = daos_get_ntime() - ns;
+	print_message("sequential write of "DF_U64" bytes with "DF_U64
+		      " bytes buffer: %.2f MB/s with write-back\n",
+		      file_size, buf_size, (double)file_size * 1000 / ns);
+
+	/** the buffered data is visible to the writing process */
+	rc = dfs_get_size(dfs_wb, obj, &size);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, file_size);
+
+	/** rewrite the first bytes and read them back through the handle */
+	d_iov_set(&iov, data + file_size - buf_size, buf_size);
+	rc = dfs_write(dfs_wb, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+	memcpy(data, data + file_size - buf_size, buf_size);
+
+	d_iov_set(&iov, data_read, buf_size);
+	rc = dfs_read(dfs_wb, obj, &sgl, 0, &size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, buf_size);
+	assert_memory_equal(data, data_read, buf_size);
+
+	rc = dfs_sync(dfs_wb);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_umount(dfs_wb);
+	assert_int_equal(rc, 0);
+
+	/** read the file back through the main mount */
+	dfs_test_seq_read(dfs, name, data_read, file_size, 128 * 1024);
+	assert_memory_equal(data, data_read, file_size);
+
+	D_FREE(data_read);
+	D_FREE(data);
+	dfs_test_file_del(name);
+}
+
+#define DFS_TEST_TREE_DEPTH	16
+
+/** look up @path @count times, returns elapsed ns */
+static uint64_t
+dfs_test_lookup_loop(dfs_t *dfs_mt, const char *path, int count)
+{
+	dfs_obj_t	*obj;
+	struct stat	stbuf;
+	uint64_t	start;
+	int		i;
+	int		rc;
+
+	start = daos_get_ntime();
+	for (i = 0; i < count; i++) {
+		rc = dfs_lookup(dfs_mt, path, O_RDONLY, &obj, NULL, &stbuf);
+		assert_int_equal(rc, 0);
+		assert_true(S_ISREG(stbuf.st_mode));
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	return daos_get_ntime() - start;
+}
+
+static void
+dfs_test_dentry_cache(void **state)
+{
+	test_arg_t	*arg = *state;
+	char		path[PATH_MAX];
+	char		name[16];
+	dfs_obj_t	*dir, *parent, *obj;
+	dfs_t		*dfs_dc;
+	struct stat	stbuf;
+	uint64_t	ns, ns_dc;
+	int		count = 100;
+	int		len;
+	int		i;
+	int		rc;
+
+	/** build a deep tree with a file at the bottom */
+	rc = dfs_mkdir(dfs, NULL, "dc_tree", S_IWUSR | S_IRUSR | S_IXUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs, NULL, "dc_tree", O_RDWR, &parent, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+	len = snprintf(path, sizeof(path), "/dc_tree");
+
+	for (i = 0; i < DFS_TEST_TREE_DEPTH; i++) {
+		snprintf(name, sizeof(name), "d%d", i);
+		rc = dfs_mkdir(dfs, parent, name, S_IWUSR | S_IRUSR | S_IXUSR);
+		assert_int_equal(rc, 0);
+		rc = dfs_lookup_rel(dfs, parent, name, O_RDWR, &dir, NULL,
+				    NULL);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(parent);
+		assert_int_equal(rc, 0);
+		parent = dir;
+		len += snprintf(path + len, sizeof(path) - len, "/%s", name);
+	}
+
+	rc = dfs_open(dfs, parent, "file", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	snprintf(path + len, sizeof(path) - len, "/file");
+
+	/** mount the same container again, with the dentry cache enabled */
+	setenv("DFS_DENTRY_CACHE", "60", 1);
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs_dc);
+	unsetenv("DFS_DENTRY_CACHE");
+	assert_int_equal(rc, 0);
+
+	ns = dfs_test_lookup_loop(dfs, path, count);
+	ns_dc = dfs_test_lookup_loop(dfs_dc, path, count);
+	print_message("lookup + stat of a %d deep path: %.1f/s, %.1f/s with "
+		      "dentry cache\n", DFS_TEST_TREE_DEPTH + 2,
+		      (double)count * NSEC_PER_SEC / ns,
+		      (double)count * NSEC_PER_SEC / ns_dc);
+
+	/** a negative entry is dropped when the name is created locally */
+	rc = dfs_stat(dfs_dc, parent, "new_file", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_open(dfs_dc, parent, "new_file", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_dc, parent, "new_file", &stbuf);
+	assert_int_equal(rc, 0);
+
+	/** and a positive one when it is removed or moved locally */
+	rc = dfs_move(dfs_dc, parent, "new_file", parent, "moved_file", NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_dc, parent, "new_file", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_stat(dfs_dc, parent, "moved_file", &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_dc, parent, "moved_file", false, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_dc, parent, "moved_file", &stbuf);
+	assert_int_equal(rc, ENOENT);
+
+	rc = dfs_mkdir(dfs_dc, parent, "moved_file", S_IWUSR | S_IRUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_dc, parent, "moved_file", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_true(S_ISDIR(stbuf.st_mode));
+
+	rc = dfs_release(parent);
+	assert_int_equal(rc, 0);
+	rc = dfs_umount(dfs_dc);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs, NULL, "dc_tree", true, NULL);
+	assert_int_equal(rc, 0);
+}
+
+#define DFS_TEST_DIR_ENTRIES	200
+
+struct dfs_test_plus_arg {
+	int	nr;
+	/** fail every stop_every-th call with E2BIG, as for a full buffer */
+	int	stop_every;
+	int	calls;
+	bool	check;
+	bool	seen[DFS_TEST_DIR_ENTRIES];
+};
+
+static int
+dfs_test_plus_cb(dfs_t *dfs_mt, dfs_obj_t *dir, const char name[],
+		 dfs_obj_t *obj, struct stat *stbuf, void *udata)
+{
+	struct dfs_test_plus_arg	*parg = udata;
+	struct stat			stbuf2;
+	int				i;
+	int				rc;
+
+	parg->calls++;
+	if (parg->stop_every && parg->calls % parg->stop_every == 0) {
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+		return E2BIG;
+	}
+
+	parg->nr++;
+	if (parg->check) {
+		i = atoi(name + 1);
+		assert_true(i >= 0 && i < DFS_TEST_DIR_ENTRIES);
+		assert_false(parg->seen[i]);
+		parg->seen[i] = true;
+
+		/** the attributes match the ones of a lookup */
+		rc = dfs_stat(dfs_mt, dir, name, &stbuf2);
+		assert_int_equal(rc, 0);
+		assert_int_equal(stbuf->st_mode, stbuf2.st_mode);
+		assert_int_equal(stbuf->st_size, stbuf2.st_size);
+		assert_int_equal(stbuf->st_mtim.tv_sec,
+				 stbuf2.st_mtim.tv_sec);
+	}
+
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	return 0;
+}
+
+static int
+dfs_test_iterate_cb(dfs_t *dfs_mt, dfs_obj_t *dir, const char name[],
+		    void *udata)
+{
+	dfs_obj_t	*obj;
+	struct stat	stbuf;
+	int		*nr = udata;
+	int		rc;
+
+	rc = dfs_lookup_rel(dfs_mt, dir, name, O_RDONLY, &obj, NULL, &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	(*nr)++;
+	return 0;
+}
+
+static void
+dfs_test_readdirplus(void **state)
+{
+	dfs_obj_t			*dir, *obj;
+	daos_anchor_t			anchor = {0};
+	struct dfs_test_plus_arg	parg = {0};
+	char				name[16];
+	char				value[64];
+	d_sg_list_t			sgl;
+	d_iov_t				iov;
+	uint64_t			ns, ns_plus;
+	uint32_t			nr;
+	int				count = 0;
+	int				i;
+	int				rc;
+
+	rc = dfs_mkdir(dfs, NULL, "rdp_dir", S_IWUSR | S_IRUSR | S_IXUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs, NULL, "rdp_dir", O_RDWR, &dir, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	/** directories, files of different sizes, short and long symlinks */
+	d_iov_set(&iov, value, sizeof(value));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	memset(value, 'v', sizeof(value));
+
+	for (i = 0; i < DFS_TEST_DIR_ENTRIES; i++) {
+		snprintf(name, sizeof(name), "e%d", i);
+		switch (i % 3) {
+		case 0:
+			rc = dfs_mkdir(dfs, dir, name, S_IWUSR | S_IRUSR);
+			assert_int_equal(rc, 0);
+			break;
+		case 1:
+			rc = dfs_open(dfs, dir, name, S_IFREG | S_IWUSR |
+				      S_IRUSR, O_RDWR | O_CREAT, 0, 0, NULL,
+				      &obj);
+			assert_int_equal(rc, 0);
+			iov.iov_len = i % sizeof(value);
+			rc = dfs_write(dfs, obj, &sgl, 0, NULL);
+			assert_int_equal(rc, 0);
+			rc = dfs_release(obj);
+			assert_int_equal(rc, 0);
+			break;
+		default:
+			snprintf(value, sizeof(value), "%s_%0*d", "target",
+				 i % 2 ? 8 : 48, i);
+			rc = dfs_open(dfs, dir, name, S_IFLNK | S_IWUSR |
+				      S_IRUSR, O_RDWR | O_CREAT, 0, 0, value,
+				      &obj);
+			assert_int_equal(rc, 0);
+			rc = dfs_release(obj);
+			assert_int_equal(rc, 0);
+			memset(value, 'v', sizeof(value));
+			break;
+		}
+	}
+
+	/** removed entries are not listed, even if their records remain */
+	for (i = 5; i < DFS_TEST_DIR_ENTRIES; i += 10) {
+		snprintf(name, sizeof(name), "e%d", i);
+		rc = dfs_remove(dfs, dir, name, false, NULL);
+		assert_int_equal(rc, 0);
+	}
+	rc = dfs_mkdir(dfs, dir, "e5", S_IWUSR | S_IRUSR);
+	assert_int_equal(rc, 0);
+
+	ns = daos_get_ntime();
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = 64;
+		rc = dfs_iterate(dfs, dir, &anchor, &nr, 64 * DFS_MAX_PATH,
+				 dfs_test_iterate_cb, &count);
+		assert_int_equal(rc, 0);
+	}
+	ns = daos_get_ntime() - ns;
+
+	memset(&anchor, 0, sizeof(anchor));
+	ns_plus = daos_get_ntime();
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = 64;
+		rc = dfs_readdirplus(dfs, dir, &anchor, &nr,
+				     nr * DFS_MAX_PATH, dfs_test_plus_cb,
+				     &parg);
+		assert_int_equal(rc, 0);
+		assert_true(nr > 0 || daos_anchor_is_eof(&anchor));
+	}
+	ns_plus = daos_get_ntime() - ns_plus;
+
+	print_message("listing of %d entries: %.1f ms with iterate + lookup, "
+		      "%.1f ms with readdirplus\n", count, ns / 1e6,
+		      ns_plus / 1e6);
+	assert_int_equal(parg.nr, count);
+
+	/** list again, checking the attributes of every entry */
+	memset(&anchor, 0, sizeof(anchor));
+	parg.nr = 0;
+	parg.check = true;
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = 16;
+		rc = dfs_readdirplus(dfs, dir, &anchor, &nr,
+				     nr * DFS_MAX_PATH, dfs_test_plus_cb,
+				     &parg);
+		assert_int_equal(rc, 0);
+	}
+
+	assert_int_equal(parg.nr, count);
+	assert_int_equal(count, DFS_TEST_DIR_ENTRIES -
+			 DFS_TEST_DIR_ENTRIES / 10 + 1);
+	for (i = 0; i < DFS_TEST_DIR_ENTRIES; i++)
+		assert_int_equal(parg.seen[i], i % 10 != 5 || i == 5);
+
+	/** a listing started by dfs_iterate is continued by dfs_readdirplus */
+	memset(&anchor, 0, sizeof(anchor));
+	parg.nr = 0;
+	parg.check = false;
+	nr = 10;
+	rc = dfs_iterate(dfs, dir, &anchor, &nr, 10 * DFS_MAX_PATH, NULL,
+			 NULL);
+	assert_int_equal(rc, 0);
+	while (!daos_anchor_is_eof(&anchor)) {
+		uint32_t plus_nr = 16;
+
+		rc = dfs_readdirplus(dfs, dir, &anchor, &plus_nr,
+				     plus_nr * DFS_MAX_PATH,
+				     dfs_test_plus_cb, &parg);
+		assert_int_equal(rc, 0);
+	}
+	assert_int_equal(nr + parg.nr, count);
+
+	/**
+	 * An entry refused by the callback is the first one of the next call,
+	 * none is lost or listed twice. The names are also bounded by size.
+	 */
+	memset(&anchor, 0, sizeof(anchor));
+	memset(parg.seen, 0, sizeof(parg.seen));
+	parg.nr = 0;
+	parg.check = true;
+	parg.stop_every = 7;
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = 16;
+		rc = dfs_readdirplus(dfs, dir, &anchor, &nr, 8,
+				     dfs_test_plus_cb, &parg);
+		assert_true(rc == 0 || rc == E2BIG);
+	}
+	assert_int_equal(parg.nr, count);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs, NULL, "rdp_dir", true, NULL);
+	assert_int_equal(rc, 0);
+}
+
+#define DFS_TEST_RM_FANOUT	4
+#define DFS_TEST_RM_DEPTH	3
+#define DFS_TEST_RM_FILES	16
+/** directories of the tree, each one with a non-inlined file */
+#define DFS_TEST_RM_DIRS	(1 + 4 + 16 + 64)
+#define DFS_TEST_RM_DATA	8192
+
+/** objects of the tree checked after its removal */
+struct dfs_test_rm_objs {
+	daos_obj_id_t	oids[DFS_TEST_RM_DIRS * 2];
+	int		nr;
+};
+
+static void
+dfs_test_rm_add(struct dfs_test_rm_objs *objs, dfs_obj_t *obj)
+{
+	int	rc;
+
+	assert_true(objs->nr < DFS_TEST_RM_DIRS * 2);
+	rc = dfs_obj2id(obj, &objs->oids[objs->nr]);
+	assert_int_equal(rc, 0);
+	objs->nr++;
+}
+
+/**
+ * Create a tree of @depth levels under @parent, return the number of entries
+ * created. The directories and the first file of each, which has data in its
+ * array, are added to @objs.
+ */
+static int
+dfs_test_rm_tree(dfs_obj_t *parent, int depth, struct dfs_test_rm_objs *objs)
+{
+	char		name[16];
+	char		*buf;
+	dfs_obj_t	*obj;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	int		count = 0;
+	int		i;
+	int		rc;
+
+	D_ALLOC(buf, DFS_TEST_RM_DATA);
+	assert_non_null(buf);
+	memset(buf, 'r', DFS_TEST_RM_DATA);
+	d_iov_set(&iov, buf, DFS_TEST_RM_DATA);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	dfs_test_rm_add(objs, parent);
+
+	for (i = 0; i < DFS_TEST_RM_FILES; i++) {
+		snprintf(name, sizeof(name), "f%d", i);
+		rc = dfs_open(dfs, parent, name, S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR | O_CREAT, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		if (i == 0) {
+			rc = dfs_write(dfs, obj, &sgl, 0, NULL);
+			assert_int_equal(rc, 0);
+			dfs_test_rm_add(objs, obj);
+		}
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+		count++;
+	}
+	D_FREE(buf);
+
+	rc = dfs_open(dfs, parent, "link", S_IFLNK | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT, 0, 0, "f0", &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	count++;
+
+	if (depth == 0)
+		return count;
+
+	for (i = 0; i < DFS_TEST_RM_FANOUT; i++) {
+		snprintf(name, sizeof(name), "d%d", i);
+		rc = dfs_mkdir(dfs, parent, name, S_IWUSR | S_IRUSR | S_IXUSR);
+		assert_int_equal(rc, 0);
+		rc = dfs_lookup_rel(dfs, parent, name, O_RDWR, &obj, NULL,
+				    NULL);
+		assert_int_equal(rc, 0);
+		count += dfs_test_rm_tree(obj, depth - 1, objs) + 1;
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+
+	return count;
+}
+
+/** check that the object @oid has been punched, no d-key is left */
+static void
+dfs_test_rm_check(daos_obj_id_t oid)
+{
+	daos_handle_t	oh;
+	daos_anchor_t	anchor = {0};
+	daos_key_desc_t	kds[8];
+	char		buf[8 * DFS_MAX_PATH];
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	uint32_t	nr;
+	int		rc;
+
+	rc = daos_obj_open(co_hdl, oid, DAOS_OO_RO, &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &iov;
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = 8;
+		d_iov_set(&iov, buf, sizeof(buf));
+		sgl.sg_nr_out = 0;
+		rc = daos_obj_list_dkey(oh, DAOS_TX_NONE, &nr, kds, &sgl,
+					&anchor, NULL);
+		assert_int_equal(rc, 0);
+		assert_int_equal(nr, 0);
+	}
+
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static void
+dfs_test_remove_tree(void **state)
+{
+	struct dfs_test_rm_objs	*objs;
+	dfs_obj_t		*top;
+	struct stat		stbuf;
+	int			count;
+	int			i;
+	int			rc;
+
+	D_ALLOC_PTR(objs);
+	assert_non_null(objs);
+
+	rc = dfs_mkdir(dfs, NULL, "rm_tree", S_IWUSR | S_IRUSR | S_IXUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs, NULL, "rm_tree", O_RDWR, &top, NULL, NULL);
+	assert_int_equal(rc, 0);
+	count = dfs_test_rm_tree(top, DFS_TEST_RM_DEPTH, objs);
+	rc = dfs_release(top);
+	assert_int_equal(rc, 0);
+	assert_int_equal(objs->nr, DFS_TEST_RM_DIRS * 2);
+
+	/** a non-empty directory is only removed with force */
+	rc = dfs_remove(dfs, NULL, "rm_tree", false, NULL);
+	assert_int_equal(rc, ENOTEMPTY);
+
+	rc = dfs_remove(dfs, NULL, "rm_tree", true, NULL);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_stat(dfs, NULL, "rm_tree", &stbuf);
+	assert_int_equal(rc, ENOENT);
+
+	/** the entries of every directory and the file data are punched */
+	for (i = 0; i < objs->nr; i++)
+		dfs_test_rm_check(objs->oids[i]);
+
+	D_FREE(objs);
+}
+
+#define DFS_TEST_SMALL_FILES	100
+#define DFS_TEST_SMALL_SIZE	2048
+
+/** Read @name of @dir and check that it holds @len bytes of @c */
+static void
+dfs_test_check_file(dfs_t *dfs_mt, dfs_obj_t *dir, const char *name,
+		    char *buf, daos_size_t len, char c)
+{
+	dfs_obj_t	*obj;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	daos_size_t	read_size;
+	daos_size_t	i;
+	int		rc;
+
+	rc = dfs_open(dfs_mt, dir, name, S_IFREG, O_RDONLY, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+
+	d_iov_set(&iov, buf, DFS_TEST_SMALL_SIZE * 4);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	memset(buf, 0, DFS_TEST_SMALL_SIZE * 4);
+	rc = dfs_read(dfs_mt, obj, &sgl, 0, &read_size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(read_size, len);
+	for (i = 0; i < len; i++)
+		assert_int_equal(buf[i], c);
+
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+}
+
+/** Create, then open and read, @nr small files, return the time of each */
+static void
+dfs_test_small_files(dfs_t *dfs_mt, dfs_obj_t *dir, char *buf,
+		     uint64_t *create_ns, uint64_t *read_ns)
+{
+	dfs_obj_t	*obj;
+	char		name[16];
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	uint64_t	start;
+	int		i;
+	int		rc;
+
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	start = daos_get_ntime();
+	for (i = 0; i < DFS_TEST_SMALL_FILES; i++) {
+		snprintf(name, sizeof(name), "f%d", i);
+		rc = dfs_open(dfs_mt, dir, name, S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR | O_CREAT, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		memset(buf, 'a' + i % 26, DFS_TEST_SMALL_SIZE);
+		d_iov_set(&iov, buf, DFS_TEST_SMALL_SIZE);
+		rc = dfs_write(dfs_mt, obj, &sgl, 0, NULL);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	*create_ns = daos_get_ntime() - start;
+
+	start = daos_get_ntime();
+	for (i = 0; i < DFS_TEST_SMALL_FILES; i++) {
+		snprintf(name, sizeof(name), "f%d", i);
+		dfs_test_check_file(dfs_mt, dir, name, buf,
+				    DFS_TEST_SMALL_SIZE, 'a' + i % 26);
+	}
+	*read_ns = daos_get_ntime() - start;
+}
+
+#define DFS_TEST_INL_WRITERS	2
+#define DFS_TEST_INL_REC	64
+
+struct dfs_test_inl_arg {
+	dfs_t			*dfs;
+	dfs_obj_t		*dir;
+	pthread_barrier_t	*barrier;
+	int			idx;
+};
+
+/** Write records of 'a' + idx to f5, interleaved with the other writers */
+static void *
+dfs_test_inl_write_thread(void *arg)
+{
+	struct dfs_test_inl_arg	*targ = arg;
+	dfs_obj_t		*obj;
+	char			rec[DFS_TEST_INL_REC];
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	daos_off_t		off;
+	int			rc;
+
+	rc = dfs_open(targ->dfs, targ->dir, "f5", S_IFREG, O_RDWR, 0, 0, NULL,
+		      &obj);
+	assert_int_equal(rc, 0);
+
+	memset(rec, 'a' + targ->idx, sizeof(rec));
+	d_iov_set(&iov, rec, sizeof(rec));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	pthread_barrier_wait(targ->barrier);
+	for (off = targ->idx * DFS_TEST_INL_REC; off < DFS_TEST_SMALL_SIZE;
+	     off += DFS_TEST_INL_REC * DFS_TEST_INL_WRITERS) {
+		rc = dfs_write(targ->dfs, obj, &sgl, off, NULL);
+		assert_int_equal(rc, 0);
+	}
+
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	pthread_exit(NULL);
+}
+
+static void
+dfs_test_inline(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_t		*dfs_in;
+	dfs_obj_t	*dir, *dir_in, *obj, *obj2;
+	struct stat	stbuf;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		*buf;
+	uint64_t	create_ns, read_ns;
+	uint64_t	create_in_ns, read_in_ns;
+	daos_size_t	size;
+	struct dfs_test_inl_arg	targs[DFS_TEST_INL_WRITERS];
+	pthread_t	tids[DFS_TEST_INL_WRITERS];
+	pthread_barrier_t	barrier;
+	int		i;
+	int		rc;
+
+	D_ALLOC(buf, DFS_TEST_SMALL_SIZE * 4);
+	assert_non_null(buf);
+
+	/** mount the same container again, with small files inlined */
+	setenv("DFS_INLINE_SIZE", "4096", 1);
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs_in);
+	unsetenv("DFS_INLINE_SIZE");
+	assert_int_equal(rc, 0);
+
+	rc = dfs_mkdir(dfs, NULL, "small", S_IWUSR | S_IRUSR | S_IXUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_mkdir(dfs, NULL, "small_in", S_IWUSR | S_IRUSR | S_IXUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs, NULL, "small", O_RDWR, &dir, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_in, NULL, "small_in", O_RDWR, &dir_in, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+
+	dfs_test_small_files(dfs, dir, buf, &create_ns, &read_ns);
+	dfs_test_small_files(dfs_in, dir_in, buf, &create_in_ns, &read_in_ns);
+	print_message("%d byte files: create %.1f/s, %.1f/s inlined\n",
+		      DFS_TEST_SMALL_SIZE,
+		      (double)DFS_TEST_SMALL_FILES * NSEC_PER_SEC / create_ns,
+		      (double)DFS_TEST_SMALL_FILES * NSEC_PER_SEC /
+		      create_in_ns);
+	print_message("%d byte files: open + read %.1f/s, %.1f/s inlined\n",
+		      DFS_TEST_SMALL_SIZE,
+		      (double)DFS_TEST_SMALL_FILES * NSEC_PER_SEC / read_ns,
+		      (double)DFS_TEST_SMALL_FILES * NSEC_PER_SEC /
+		      read_in_ns);
+
+	/** inlined files are seen by a mount without the option */
+	dfs_test_check_file(dfs, dir_in, "f1", buf, DFS_TEST_SMALL_SIZE, 'b');
+	rc = dfs_stat(dfs, dir_in, "f1", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, DFS_TEST_SMALL_SIZE);
+
+	/** growing beyond the inline size moves the data to the array */
+	rc = dfs_open(dfs_in, dir_in, "f2", S_IFREG, O_RDWR, 0, 0, NULL,
+		      &obj);
+	assert_int_equal(rc, 0);
+	memset(buf, 'c', DFS_TEST_SMALL_SIZE * 2);
+	d_iov_set(&iov, buf, DFS_TEST_SMALL_SIZE * 2);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	rc = dfs_write(dfs_in, obj, &sgl, DFS_TEST_SMALL_SIZE, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_get_size(dfs_in, obj, &size);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, DFS_TEST_SMALL_SIZE * 3);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	dfs_test_check_file(dfs, dir_in, "f2", buf, DFS_TEST_SMALL_SIZE * 3,
+			    'c');
+
+	/** truncate, then rename, an inlined file */
+	rc = dfs_open(dfs_in, dir_in, "f3", S_IFREG, O_RDWR, 0, 0, NULL,
+		      &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_punch(dfs_in, obj, 100, DFS_MAX_FSIZE);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_move(dfs_in, dir_in, "f3", dir, "f3_in", NULL);
+	assert_int_equal(rc, 0);
+	dfs_test_check_file(dfs, dir, "f3_in", buf, 100, 'd');
+
+	/**
+	 * the writes of two handles are not lost, and once the first one has
+	 * migrated the file the second one writes to the array
+	 */
+	rc = dfs_open(dfs_in, dir_in, "f4", S_IFREG, O_RDWR, 0, 0, NULL,
+		      &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_open(dfs_in, dir_in, "f4", S_IFREG, O_RDWR, 0, 0, NULL,
+		      &obj2);
+	assert_int_equal(rc, 0);
+	memset(buf, 'x', 100);
+	d_iov_set(&iov, buf, 100);
+	rc = dfs_write(dfs_in, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+	memset(buf, 'y', 100);
+	rc = dfs_write(dfs_in, obj2, &sgl, 100, NULL);
+	assert_int_equal(rc, 0);
+	memset(buf, 'z', DFS_TEST_SMALL_SIZE * 2);
+	d_iov_set(&iov, buf, DFS_TEST_SMALL_SIZE * 2);
+	rc = dfs_write(dfs_in, obj, &sgl, DFS_TEST_SMALL_SIZE, NULL);
+	assert_int_equal(rc, 0);
+	memset(buf, 'w', 10);
+	d_iov_set(&iov, buf, 10);
+	rc = dfs_write(dfs_in, obj2, &sgl, 200, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj2);
+	assert_int_equal(rc, 0);
+
+	d_iov_set(&iov, buf, DFS_TEST_SMALL_SIZE * 4);
+	memset(buf, 0, DFS_TEST_SMALL_SIZE * 4);
+	rc = dfs_read(dfs_in, obj, &sgl, 0, &size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, DFS_TEST_SMALL_SIZE * 3);
+	assert_int_equal(buf[0], 'x');
+	assert_int_equal(buf[100], 'y');
+	assert_int_equal(buf[200], 'w');
+	assert_int_equal(buf[210], 'e');
+	assert_int_equal(buf[DFS_TEST_SMALL_SIZE], 'z');
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	/** the concurrent writes of two handles to an inlined file all land */
+	pthread_barrier_init(&barrier, NULL, DFS_TEST_INL_WRITERS);
+	for (i = 0; i < DFS_TEST_INL_WRITERS; i++) {
+		targs[i].dfs = dfs_in;
+		targs[i].dir = dir_in;
+		targs[i].barrier = &barrier;
+		targs[i].idx = i;
+		rc = pthread_create(&tids[i], NULL, dfs_test_inl_write_thread,
+				    &targs[i]);
+		assert_int_equal(rc, 0);
+	}
+	for (i = 0; i < DFS_TEST_INL_WRITERS; i++) {
+		rc = pthread_join(tids[i], NULL);
+		assert_int_equal(rc, 0);
+	}
+	pthread_barrier_destroy(&barrier);
+
+	rc = dfs_open(dfs, dir_in, "f5", S_IFREG, O_RDONLY, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	d_iov_set(&iov, buf, DFS_TEST_SMALL_SIZE * 4);
+	memset(buf, 0, DFS_TEST_SMALL_SIZE * 4);
+	rc = dfs_read(dfs, obj, &sgl, 0, &size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, DFS_TEST_SMALL_SIZE);
+	for (i = 0; i < DFS_TEST_SMALL_SIZE; i++)
+		assert_int_equal(buf[i], 'a' + (i / DFS_TEST_INL_REC) %
+				 DFS_TEST_INL_WRITERS);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(dir_in);
+	assert_int_equal(rc, 0);
+	rc = dfs_umount(dfs_in);
+	assert_int_equal(rc, 0);
+	D_FREE(buf);
+}
+
 static const struct CMUnitTest dfs_tests[] = {
 	{ "DFS_TEST1: DFS mount / umount",
 	  dfs_test_mount, async_disable, test_case_teardown},
 	{ "DFS_TEST2: multi-threads read shared file",
 	  dfs_test_read_shared_file, async_disable, test_case_teardown},
+	{ "DFS_TEST3: sequential read with small buffers",
+	  dfs_test_read_ahead, async_disable, test_case_teardown},
+	{ "DFS_TEST4: write-back of small sequential writes",
+	  dfs_test_write_back, async_disable, test_case_teardown},
+	{ "DFS_TEST5: dentry cache on a deep tree",
+	  dfs_test_dentry_cache, async_disable, test_case_teardown},
+	{ "DFS_TEST6: readdirplus",
+	  dfs_test_readdirplus, async_disable, test_case_teardown},
+	{ "DFS_TEST7: remove a directory tree",
+	  dfs_test_remove_tree, async_disable, test_case_teardown},
+	{ "DFS_TEST8: small files inlined in their entry",
+	  dfs_test_inline, async_disable, test_case_teardown},
 };
 
 static int
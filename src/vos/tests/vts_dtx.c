@@ -1516,6 +1516,154 @@ dtx_30(void **state)
 	vts_dtx_shares_with_punch(*state, false, true);
 }
 
+/* solo update is committed directly and its resend is detected */
+static void
+dtx_31(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct dtx_handle		*dth = NULL;
+	struct dtx_id			 xid;
+	struct dtx_id			 xid2;
+	struct dtx_stat			 stat = { 0 };
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 dkey_iov;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	uint64_t			 dkey_hash;
+	uint64_t			 saved_committable;
+	uint64_t			 saved_committed;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_BUF_SIZE];
+	char				 fetch_buf[UPDATE_BUF_SIZE];
+	int				 rc;
+
+	vts_dtx_prep_update(args, &xid, &val_iov, &dkey_iov, &dkey, dkey_buf,
+			    &akey, akey_buf, &iod, &sgl, &rex, update_buf,
+			    UPDATE_BUF_SIZE, UPDATE_REC_SIZE, &dkey_hash,
+			    &epoch, false);
+
+	vos_dtx_stat(args->ctx.tc_co_hdl, &stat);
+	saved_committable = stat.dtx_committable_count;
+	saved_committed = stat.dtx_committed_count;
+
+	/* Single replica, as ds_obj_rw_handler() does on the fast path. */
+	rc = vts_dtx_begin(&xid, &args->oid, args->ctx.tc_co_hdl, epoch,
+			   dkey_hash, NULL, NULL, 0, 1 /* init version */,
+			   DAOS_INTENT_UPDATE, &dth);
+	assert_int_equal(rc, 0);
+	dth->dth_non_rep = 1;
+	dth->dth_solo = 1;
+
+	rc = io_test_obj_update(args, epoch, &dkey, &iod, &sgl, dth, true);
+	assert_int_equal(rc, 0);
+	vts_dtx_end(dth);
+
+	/* Readable without any commit. */
+	memset(fetch_buf, 0, UPDATE_BUF_SIZE);
+	d_iov_set(&val_iov, fetch_buf, UPDATE_BUF_SIZE);
+	iod.iod_size = DAOS_REC_ANY;
+
+	rc = io_test_obj_fetch(args, epoch, &dkey, &iod, &sgl, true);
+	assert_int_equal(rc, 0);
+	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
+
+	/* Only the committed DTX entry, nothing is left to commit. */
+	vos_dtx_stat(args->ctx.tc_co_hdl, &stat);
+	assert_true(saved_committable == stat.dtx_committable_count);
+	assert_true(saved_committed == stat.dtx_committed_count - 1);
+
+	/* The resent update is detected. */
+	rc = vos_dtx_check_resend(args->ctx.tc_co_hdl, &args->oid, &xid,
+				  dkey_hash, false, NULL);
+	assert_int_equal(rc, DTX_ST_COMMITTED);
+
+	/* And another update is not taken for a resent one. */
+	daos_dti_gen(&xid2, false);
+	rc = vos_dtx_check_resend(args->ctx.tc_co_hdl, &args->oid, &xid2,
+				  dkey_hash, false, NULL);
+	assert_int_equal(rc, -DER_NONEXIST);
+}
+
+/* multi-dkey update DTX commit visibility */
+static void
+dtx_32(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct dtx_handle		*dth = NULL;
+	struct dtx_id			 xid;
+	struct dtx_conflict_entry	 conflict = { 0 };
+	struct vts_multi		*vm;
+	uint64_t			 epoch;
+	uint64_t			 dkey_hash;
+	int				 rc;
+	int				 i;
+
+	D_ALLOC_PTR(vm);
+	assert_non_null(vm);
+
+	io_multi_prep(args, vm);
+	daos_dti_gen(&xid, false);
+	epoch = crt_hlc_get();
+	/* The DTX of a multi-dkey update is keyed by its first dkey. */
+	dkey_hash = d_hash_murmur64(vm->vm_dkeys[0].iov_buf,
+				    vm->vm_dkeys[0].iov_len, 5731);
+
+	/* Assume I am the leader. */
+	rc = vts_dtx_begin(&xid, &args->oid, args->ctx.tc_co_hdl, epoch,
+			   dkey_hash, &conflict, NULL, 0, 1 /* init version */,
+			   DAOS_INTENT_UPDATE, &dth);
+	assert_int_equal(rc, 0);
+
+	rc = io_test_obj_update_multi(args, epoch, vm, 0, dth);
+	assert_int_equal(rc, 0);
+
+	/* The DTX covers all the dkeys and is 'prepared'. */
+	vts_dtx_end(dth);
+
+	rc = io_test_obj_fetch_multi(args, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		assert_memory_not_equal(vm->vm_update_bufs[i],
+					vm->vm_fetch_bufs[i], UPDATE_BUF_SIZE);
+
+	/* Committing the DTX makes all the dkeys readable at once. */
+	rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid, 1);
+	assert_int_equal(rc, 0);
+
+	rc = io_test_obj_fetch_multi(args, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		assert_memory_equal(vm->vm_update_bufs[i],
+				    vm->vm_fetch_bufs[i], UPDATE_BUF_SIZE);
+
+	/* An aborted multi-dkey DTX leaves none of its dkeys. */
+	io_multi_prep(args, vm);
+	daos_dti_gen(&xid, false);
+	rc = vts_dtx_begin(&xid, &args->oid, args->ctx.tc_co_hdl, ++epoch,
+			   dkey_hash, &conflict, NULL, 0, 1 /* init version */,
+			   DAOS_INTENT_UPDATE, &dth);
+	assert_int_equal(rc, 0);
+
+	rc = io_test_obj_update_multi(args, epoch, vm, 0, dth);
+	assert_int_equal(rc, 0);
+	vts_dtx_end(dth);
+
+	rc = vos_dtx_abort(args->ctx.tc_co_hdl, epoch, &xid, 1, false);
+	assert_int_equal(rc, 0);
+
+	rc = io_test_obj_fetch_multi(args, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		assert_int_equal(vm->vm_iods[i].iod_size, 0);
+
+	D_FREE(vm);
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -1588,6 +1736,10 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_29, NULL, dtx_tst_teardown },
 	{ "VOS530: punch key during some shared DTXs, the punch is aborted",
 	  dtx_30, NULL, dtx_tst_teardown },
+	{ "VOS531: solo DTX update and resend detection",
+	  dtx_31, NULL, dtx_tst_teardown },
+	{ "VOS532: multi-dkey update DTX commit and abort visibility",
+	  dtx_32, NULL, dtx_tst_teardown },
 };
 
 int
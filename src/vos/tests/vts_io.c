@@ -600,6 +600,134 @@ end:
 	return rc;
 }
 
+/* Generate new dkeys, a shared akey and new values for @vm */
+void
+io_multi_prep(struct io_test_args *arg, struct vts_multi *vm)
+{
+	daos_key_t	akey;
+	int		i;
+
+	memset(vm, 0, sizeof(*vm));
+	/* The multi-dkey I/O is only zero copy */
+	arg->ta_flags = TF_ZERO_COPY;
+
+	vts_key_gen(vm->vm_akey_buf, arg->akey_size, false, arg);
+	set_iov(&akey, vm->vm_akey_buf, arg->ofeat & DAOS_OF_AKEY_UINT64);
+
+	for (i = 0; i < VTS_MULTI_DKEYS; i++) {
+		vts_key_gen(vm->vm_dkey_bufs[i], arg->dkey_size, true, arg);
+		set_iov(&vm->vm_dkeys[i], vm->vm_dkey_bufs[i],
+			arg->ofeat & DAOS_OF_DKEY_UINT64);
+		vm->vm_dkey_iods[i] = 1;
+
+		dts_buf_render(vm->vm_update_bufs[i], UPDATE_BUF_SIZE);
+		vm->vm_rexs[i].rx_nr = 1;
+		vm->vm_iods[i].iod_name = akey;
+		vm->vm_iods[i].iod_type = DAOS_IOD_SINGLE;
+		vm->vm_iods[i].iod_size = UPDATE_BUF_SIZE;
+		vm->vm_iods[i].iod_recxs = &vm->vm_rexs[i];
+		vm->vm_iods[i].iod_nr = 1;
+	}
+}
+
+/*
+ * Update all the dkeys of @vm in one I/O. A non-zero @err fails the I/O after
+ * the data was written, as a failure of one of the dkeys would.
+ */
+int
+io_test_obj_update_multi(struct io_test_args *arg, daos_epoch_t epoch,
+			 struct vts_multi *vm, int err, struct dtx_handle *dth)
+{
+	struct bio_sglist	*bsgl;
+	struct bio_iov		*biov;
+	daos_handle_t		 ioh;
+	unsigned int		 off;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		vm->vm_iods[i].iod_size = UPDATE_BUF_SIZE;
+
+	rc = vos_update_begin_multi(arg->ctx.tc_co_hdl, arg->oid, epoch,
+				    VTS_MULTI_DKEYS, vm->vm_dkeys,
+				    vm->vm_dkey_iods, VTS_MULTI_DKEYS,
+				    vm->vm_iods, &ioh, dth);
+	if (rc != 0)
+		return rc;
+
+	rc = bio_iod_prep(vos_ioh2desc(ioh));
+	if (rc)
+		goto end;
+
+	for (i = 0; i < VTS_MULTI_DKEYS; i++) {
+		bsgl = vos_iod_sgl_at(ioh, i);
+		assert_true(bsgl != NULL);
+
+		for (j = off = 0; j < bsgl->bs_nr_out; j++) {
+			biov = &bsgl->bs_iovs[j];
+			memcpy(biov->bi_buf, vm->vm_update_bufs[i] + off,
+			       biov->bi_data_len);
+			off += biov->bi_data_len;
+		}
+		assert_int_equal(off, UPDATE_BUF_SIZE);
+	}
+
+	rc = bio_iod_post(vos_ioh2desc(ioh));
+end:
+	return vos_update_end(ioh, 0, &vm->vm_dkeys[0], rc ? rc : err, dth);
+}
+
+/* Fetch all the dkeys of @vm in one I/O into vm_fetch_bufs/vm_fetch_lens */
+int
+io_test_obj_fetch_multi(struct io_test_args *arg, daos_epoch_t epoch,
+			struct vts_multi *vm)
+{
+	struct bio_sglist	*bsgl;
+	struct bio_iov		*biov;
+	daos_handle_t		 ioh;
+	unsigned int		 off;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	memset(vm->vm_fetch_bufs, 0, sizeof(vm->vm_fetch_bufs));
+	for (i = 0; i < VTS_MULTI_DKEYS; i++) {
+		vm->vm_iods[i].iod_size = DAOS_REC_ANY;
+		vm->vm_fetch_lens[i] = 0;
+	}
+
+	rc = vos_fetch_begin_multi(arg->ctx.tc_co_hdl, arg->oid, epoch,
+				   VTS_MULTI_DKEYS, vm->vm_dkeys,
+				   vm->vm_dkey_iods, VTS_MULTI_DKEYS,
+				   vm->vm_iods, false, &ioh);
+	if (rc != 0)
+		return rc;
+
+	rc = bio_iod_prep(vos_ioh2desc(ioh));
+	if (rc)
+		goto end;
+
+	for (i = 0; i < VTS_MULTI_DKEYS; i++) {
+		bsgl = vos_iod_sgl_at(ioh, i);
+		assert_true(bsgl != NULL);
+
+		for (j = off = 0; j < bsgl->bs_nr_out; j++) {
+			biov = &bsgl->bs_iovs[j];
+			assert_true(off + biov->bi_data_len <= UPDATE_BUF_SIZE);
+			if (!bio_addr_is_hole(&biov->bi_addr))
+				memcpy(vm->vm_fetch_bufs[i] + off,
+				       biov->bi_buf, biov->bi_data_len);
+			off += biov->bi_data_len;
+		}
+		vm->vm_fetch_lens[i] = off;
+	}
+
+	rc = bio_iod_post(vos_ioh2desc(ioh));
+end:
+	return vos_fetch_end(ioh, rc);
+}
+
 static int
 io_update_and_fetch_dkey(struct io_test_args *arg, daos_epoch_t update_epoch,
 			 daos_epoch_t fetch_epoch)
@@ -1450,6 +1578,76 @@ io_fetch_no_exist_object_zc(void **state)
 	io_fetch_no_exist_object_base(state, TF_ZERO_COPY);
 }
 
+/*
+ * Update and fetch several dkeys in one I/O, fetch existing and nonexistent
+ * dkeys together, and check that a failed or invalid multi-dkey update does
+ * not leave any of its dkeys behind.
+ */
+static void
+io_multi_dkey_update_fetch(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct vts_multi	*vm;
+	daos_epoch_t		 epoch = gen_rand_epoch();
+	int			 last = VTS_MULTI_DKEYS - 1;
+	int			 i;
+	int			 rc;
+
+	D_ALLOC_PTR(vm);
+	assert_non_null(vm);
+
+	io_multi_prep(arg, vm);
+	rc = io_test_obj_update_multi(arg, epoch, vm, 0, NULL);
+	assert_int_equal(rc, 0);
+
+	rc = io_test_obj_fetch_multi(arg, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++) {
+		assert_int_equal(vm->vm_iods[i].iod_size, UPDATE_BUF_SIZE);
+		assert_int_equal(vm->vm_fetch_lens[i], UPDATE_BUF_SIZE);
+		assert_memory_equal(vm->vm_update_bufs[i],
+				    vm->vm_fetch_bufs[i], UPDATE_BUF_SIZE);
+	}
+
+	/* Not written yet at an earlier epoch */
+	rc = io_test_obj_fetch_multi(arg, epoch - 1, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		assert_int_equal(vm->vm_iods[i].iod_size, 0);
+
+	/* The other dkeys are still returned along a nonexistent one */
+	vts_key_gen(vm->vm_dkey_bufs[last], arg->dkey_size, true, arg);
+	rc = io_test_obj_fetch_multi(arg, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < last; i++)
+		assert_memory_equal(vm->vm_update_bufs[i],
+				    vm->vm_fetch_bufs[i], UPDATE_BUF_SIZE);
+	assert_int_equal(vm->vm_iods[last].iod_size, 0);
+
+	/* A failed update drops all its dkeys */
+	io_multi_prep(arg, vm);
+	rc = io_test_obj_update_multi(arg, epoch, vm, -DER_IO, NULL);
+	assert_int_equal(rc, -DER_IO);
+
+	rc = io_test_obj_fetch_multi(arg, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		assert_int_equal(vm->vm_iods[i].iod_size, 0);
+
+	/* The iods of the dkeys must add up to the number of iods */
+	vm->vm_dkey_iods[0] = 2;
+	rc = io_test_obj_update_multi(arg, epoch, vm, 0, NULL);
+	assert_int_equal(rc, -DER_IO_INVAL);
+	vm->vm_dkey_iods[0] = 1;
+
+	rc = io_test_obj_fetch_multi(arg, epoch, vm);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < VTS_MULTI_DKEYS; i++)
+		assert_int_equal(vm->vm_iods[i].iod_size, 0);
+
+	D_FREE(vm);
+}
+
 static void
 io_simple_one_key_test(void **state, unsigned int flags)
 {
@@ -2442,6 +2640,8 @@ static const struct CMUnitTest io_tests[] = {
 		io_fetch_no_exist_dkey_zc, NULL, NULL},
 	{ "VOS282.2: Accessing pool, container with same UUID",
 		pool_cont_same_uuid, NULL, NULL},
+	{ "VOS283: Multi-dkey update/fetch",
+		io_multi_dkey_update_fetch, NULL, NULL},
 	{ "VOS299: Space overflow negative error test",
 		io_pool_overflow_test, NULL, io_pool_overflow_teardown},
 	{ "VOS300: Extent checksums with multiple extents requested",
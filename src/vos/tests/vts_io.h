@@ -119,6 +119,33 @@ int			io_test_obj_fetch(struct io_test_args *arg,
 					  daos_iod_t *iod,
 					  d_sg_list_t *sgl,
 					  bool verbose);
+
+/** Number of dkeys of a multi-dkey I/O */
+#define VTS_MULTI_DKEYS		4
+
+/** Multi-dkey I/O with a single value iod of the same akey per dkey */
+struct vts_multi {
+	daos_key_t	vm_dkeys[VTS_MULTI_DKEYS];
+	unsigned int	vm_dkey_iods[VTS_MULTI_DKEYS];
+	daos_iod_t	vm_iods[VTS_MULTI_DKEYS];
+	daos_recx_t	vm_rexs[VTS_MULTI_DKEYS];
+	char		vm_dkey_bufs[VTS_MULTI_DKEYS][UPDATE_DKEY_SIZE];
+	char		vm_akey_buf[UPDATE_AKEY_SIZE];
+	char		vm_update_bufs[VTS_MULTI_DKEYS][UPDATE_BUF_SIZE];
+	char		vm_fetch_bufs[VTS_MULTI_DKEYS][UPDATE_BUF_SIZE];
+	daos_size_t	vm_fetch_lens[VTS_MULTI_DKEYS];
+};
+
+void			io_multi_prep(struct io_test_args *arg,
+				      struct vts_multi *vm);
+int			io_test_obj_update_multi(struct io_test_args *arg,
+						 daos_epoch_t epoch,
+						 struct vts_multi *vm,
+						 int err,
+						 struct dtx_handle *dth);
+int			io_test_obj_fetch_multi(struct io_test_args *arg,
+						daos_epoch_t epoch,
+						struct vts_multi *vm);
 int			setup_io(void **state);
 int			teardown_io(void **state);
 void			set_iov(d_iov_t *iov, char *buf, int int_flag);
@@ -599,41 +599,26 @@ vos_dtx_unlink_entry(struct umem_instance *umm, struct vos_dtx_table_df *tab,
 	}
 }
 
+/* Insert the committed DTX @dtx into the committed table and list. */
 static int
-vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti)
+vos_dtx_insert_committed(struct vos_container *cont,
+			 struct vos_dtx_entry_df *dtx, umem_off_t umoff)
 {
 	struct umem_instance		*umm = &cont->vc_pool->vp_umm;
-	struct vos_dtx_entry_df		*dtx;
 	struct vos_dtx_entry_df		*ent;
 	struct vos_dtx_table_df		*tab;
 	struct dtx_rec_bundle		 rbund;
-	d_iov_t			 kiov;
-	d_iov_t			 riov;
-	umem_off_t			 umoff;
-	int				 rc = 0;
-
-	d_iov_set(&kiov, dti, sizeof(*dti));
-	rc = dbtree_delete(cont->vc_dtx_active_hdl, BTR_PROBE_EQ,
-			   &kiov, &umoff);
-	if (rc == -DER_NONEXIST) {
-		d_iov_set(&riov, NULL, 0);
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
-		goto out;
-	}
-
-	if (rc != 0)
-		goto out;
-
-	dtx = umem_off2ptr(umm, umoff);
-	umem_tx_add_ptr(umm, dtx, sizeof(*dtx));
+	d_iov_t				 kiov;
+	d_iov_t				 riov;
+	int				 rc;
 
-	dtx->te_state = DTX_ST_COMMITTED;
+	d_iov_set(&kiov, &dtx->te_xid, sizeof(dtx->te_xid));
 	rbund.trb_umoff = umoff;
 	d_iov_set(&riov, &rbund, sizeof(rbund));
 	rc = dbtree_upsert(cont->vc_dtx_committed_hdl, BTR_PROBE_EQ,
 			   DAOS_INTENT_UPDATE, &kiov, &riov);
 	if (rc != 0)
-		goto out;
+		return rc;
 
 	tab = &cont->vc_cont_df->cd_dtx_table_df;
 	umem_tx_add_ptr(umm, tab, sizeof(*tab));
@@ -653,6 +638,39 @@ vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti)
 		tab->tt_entry_tail = ent->te_next;
 	}
 
+	return 0;
+}
+
+static int
+vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti)
+{
+	struct umem_instance		*umm = &cont->vc_pool->vp_umm;
+	struct vos_dtx_entry_df		*dtx;
+	d_iov_t			 kiov;
+	d_iov_t			 riov;
+	umem_off_t			 umoff;
+	int				 rc = 0;
+
+	d_iov_set(&kiov, dti, sizeof(*dti));
+	rc = dbtree_delete(cont->vc_dtx_active_hdl, BTR_PROBE_EQ,
+			   &kiov, &umoff);
+	if (rc == -DER_NONEXIST) {
+		d_iov_set(&riov, NULL, 0);
+		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
+		goto out;
+	}
+
+	if (rc != 0)
+		goto out;
+
+	dtx = umem_off2ptr(umm, umoff);
+	umem_tx_add_ptr(umm, dtx, sizeof(*dtx));
+
+	dtx->te_state = DTX_ST_COMMITTED;
+	rc = vos_dtx_insert_committed(cont, dtx, umoff);
+	if (rc != 0)
+		goto out;
+
 	/* XXX: Only mark the DTX as DTX_ST_COMMITTED (when commit) is not
 	 *	enough. Otherwise, some subsequent modification may change
 	 *	related data record's DTX reference or remove related data
@@ -1422,6 +1440,39 @@ vos_dtx_prepared(struct dtx_handle *dth)
 	return rc;
 }
 
+int
+vos_dtx_add_committed(struct dtx_handle *dth)
+{
+	struct vos_container	*cont;
+	struct umem_instance	*umm;
+	struct vos_dtx_entry_df	*dtx;
+	umem_off_t		 umoff;
+
+	cont = vos_hdl2cont(dth->dth_coh);
+	D_ASSERT(cont != NULL);
+
+	umm = &cont->vc_pool->vp_umm;
+	umoff = umem_zalloc(umm, sizeof(struct vos_dtx_entry_df));
+	if (dtx_is_null(umoff))
+		return -DER_NOSPACE;
+
+	dtx = umem_off2ptr(umm, umoff);
+	dtx->te_xid = dth->dth_xid;
+	dtx->te_oid = dth->dth_oid;
+	dtx->te_dkey_hash = dth->dth_dkey_hash;
+	dtx->te_epoch = dth->dth_epoch;
+	dtx->te_ver = dth->dth_ver;
+	dtx->te_state = DTX_ST_COMMITTED;
+	dtx->te_flags = dth->dth_leader ? DTX_EF_LEADER : 0;
+	dtx->te_intent = dth->dth_intent;
+	dtx->te_time = crt_hlc_get();
+	dtx->te_records = UMOFF_NULL;
+	dtx->te_next = UMOFF_NULL;
+	dtx->te_prev = UMOFF_NULL;
+
+	return vos_dtx_insert_committed(cont, dtx, umoff);
+}
+
 static int
 do_vos_dtx_check(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t *epoch)
 {
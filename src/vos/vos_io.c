@@ -65,6 +65,13 @@ struct vos_io_context {
 	d_list_t		 ic_blk_exts;
 	/** number DAOS IO descriptors */
 	unsigned int		 ic_iod_nr;
+	/**
+	 * dkeys of a multi-dkey I/O, ic_dkey_iods[i] consecutive iods belong
+	 * to ic_dkeys[i]. ic_dkey_nr is zero for a single dkey I/O.
+	 */
+	daos_key_t		*ic_dkeys;
+	unsigned int		*ic_dkey_iods;
+	unsigned int		 ic_dkey_nr;
 	/** flags */
 	unsigned int		 ic_update:1,
 				 ic_size_fetch:1;
@@ -731,7 +738,8 @@ iod_set_cursor(struct vos_io_context *ioc, unsigned int sgl_at)
 }
 
 static int
-dkey_fetch(struct vos_io_context *ioc, daos_key_t *dkey)
+dkey_fetch(struct vos_io_context *ioc, daos_key_t *dkey, unsigned int start,
+	   unsigned int nr)
 {
 	struct vos_object	*obj = ioc->ic_obj;
 	daos_handle_t		 toh = DAOS_HDL_INVAL;
@@ -751,7 +759,7 @@ dkey_fetch(struct vos_io_context *ioc, daos_key_t *dkey)
 				    ioc->ic_dkey_krec, &ioc->ic_dkey_entries);
 
 	if (rc == -DER_NONEXIST) {
-		for (i = 0; i < ioc->ic_iod_nr; i++)
+		for (i = start; i < start + nr; i++)
 			iod_empty_sgl(ioc, i);
 		D_DEBUG(DB_IO, "Nonexistent dkey\n");
 		rc = 0;
@@ -763,7 +771,7 @@ dkey_fetch(struct vos_io_context *ioc, daos_key_t *dkey)
 		goto out;
 	}
 
-	for (i = 0; i < ioc->ic_iod_nr; i++) {
+	for (i = start; i < start + nr; i++) {
 		iod_set_cursor(ioc, i);
 		rc = akey_fetch(ioc, &epr, toh);
 		if (rc != 0)
@@ -776,6 +784,55 @@ out:
 	return rc;
 }
 
+/* Fetch all the dkeys of the I/O context, or the single dkey @dkey. */
+static int
+ioc_dkeys_fetch(struct vos_io_context *ioc, daos_key_t *dkey)
+{
+	unsigned int	start = 0;
+	int		i;
+	int		rc;
+
+	if (ioc->ic_dkey_nr == 0)
+		return dkey_fetch(ioc, dkey, 0, ioc->ic_iod_nr);
+
+	for (i = 0; i < ioc->ic_dkey_nr; i++) {
+		rc = dkey_fetch(ioc, &ioc->ic_dkeys[i], start,
+				ioc->ic_dkey_iods[i]);
+		if (rc != 0)
+			return rc;
+		start += ioc->ic_dkey_iods[i];
+	}
+	return 0;
+}
+
+/* Attach the dkeys of a multi-dkey I/O to the I/O context. */
+static int
+ioc_dkeys_set(struct vos_io_context *ioc, unsigned int dkey_nr,
+	      daos_key_t *dkeys, unsigned int *dkey_iods)
+{
+	unsigned int	iod_nr = 0;
+	int		i;
+
+	for (i = 0; i < dkey_nr; i++) {
+		if (dkey_iods[i] == 0) {
+			D_ERROR("No iod for dkey %d\n", i);
+			return -DER_IO_INVAL;
+		}
+		iod_nr += dkey_iods[i];
+	}
+
+	if (iod_nr != ioc->ic_iod_nr) {
+		D_ERROR("Invalid iod_nr %u of %u dkeys, expect %u\n",
+			iod_nr, dkey_nr, ioc->ic_iod_nr);
+		return -DER_IO_INVAL;
+	}
+
+	ioc->ic_dkeys = dkeys;
+	ioc->ic_dkey_iods = dkey_iods;
+	ioc->ic_dkey_nr = dkey_nr;
+	return 0;
+}
+
 int
 vos_fetch_end(daos_handle_t ioh, int err)
 {
@@ -787,10 +844,11 @@ vos_fetch_end(daos_handle_t ioh, int err)
 	return err;
 }
 
-int
-vos_fetch_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
-		daos_key_t *dkey, unsigned int iod_nr, daos_iod_t *iods,
-		bool size_fetch, daos_handle_t *ioh)
+static int
+fetch_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
+	    daos_key_t *dkey, unsigned int dkey_nr, unsigned int *dkey_iods,
+	    unsigned int iod_nr, daos_iod_t *iods, bool size_fetch,
+	    daos_handle_t *ioh)
 {
 	struct vos_io_context *ioc;
 	int i, rc;
@@ -800,6 +858,12 @@ vos_fetch_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
 	if (rc != 0)
 		return rc;
 
+	if (dkey_nr != 0) {
+		rc = ioc_dkeys_set(ioc, dkey_nr, dkey, dkey_iods);
+		if (rc != 0)
+			goto error;
+	}
+
 	rc = vos_obj_hold(vos_obj_cache_current(), ioc->ic_cont, oid, epoch,
 			  true, DAOS_INTENT_DEFAULT, &ioc->ic_obj);
 	if (rc != 0)
@@ -809,7 +873,7 @@ vos_fetch_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
 		for (i = 0; i < iod_nr; i++)
 			iod_empty_sgl(ioc, i);
 	} else {
-		rc = dkey_fetch(ioc, dkey);
+		rc = ioc_dkeys_fetch(ioc, dkey);
 		if (rc != 0)
 			goto error;
 	}
@@ -821,6 +885,29 @@ error:
 	return vos_fetch_end(vos_ioc2ioh(ioc), rc);
 }
 
+int
+vos_fetch_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
+		daos_key_t *dkey, unsigned int iod_nr, daos_iod_t *iods,
+		bool size_fetch, daos_handle_t *ioh)
+{
+	return fetch_begin(coh, oid, epoch, dkey, 0, NULL, iod_nr, iods,
+			   size_fetch, ioh);
+}
+
+int
+vos_fetch_begin_multi(daos_handle_t coh, daos_unit_oid_t oid,
+		      daos_epoch_t epoch, unsigned int dkey_nr,
+		      daos_key_t *dkeys, unsigned int *dkey_iods,
+		      unsigned int iod_nr, daos_iod_t *iods, bool size_fetch,
+		      daos_handle_t *ioh)
+{
+	if (dkey_nr == 0 || dkeys == NULL || dkey_iods == NULL)
+		return -DER_INVAL;
+
+	return fetch_begin(coh, oid, epoch, dkeys, dkey_nr, dkey_iods,
+			   iod_nr, iods, size_fetch, ioh);
+}
+
 static umem_off_t
 iod_update_umoff(struct vos_io_context *ioc)
 {
@@ -1057,7 +1144,8 @@ failed:
 }
 
 static int
-dkey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_key_t *dkey)
+dkey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_key_t *dkey,
+	    unsigned int start, unsigned int nr)
 {
 	struct vos_object	*obj = ioc->ic_obj;
 	struct vos_obj_df	*obj_df;
@@ -1088,7 +1176,7 @@ dkey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_key_t *dkey)
 		goto out;
 	}
 
-	for (i = 0; i < ioc->ic_iod_nr; i++) {
+	for (i = start; i < start + nr; i++) {
 		iod_set_cursor(ioc, i);
 
 		rc = akey_update(ioc, pm_ver, ak_toh, &dkey_epr);
@@ -1115,6 +1203,28 @@ release:
 	return rc;
 }
 
+/* Update all the dkeys of the I/O context, or the single dkey @dkey. */
+static int
+ioc_dkeys_update(struct vos_io_context *ioc, uint32_t pm_ver,
+		 daos_key_t *dkey)
+{
+	unsigned int	start = 0;
+	int		i;
+	int		rc;
+
+	if (ioc->ic_dkey_nr == 0)
+		return dkey_update(ioc, pm_ver, dkey, 0, ioc->ic_iod_nr);
+
+	for (i = 0; i < ioc->ic_dkey_nr; i++) {
+		rc = dkey_update(ioc, pm_ver, &ioc->ic_dkeys[i], start,
+				 ioc->ic_dkey_iods[i]);
+		if (rc != 0)
+			return rc;
+		start += ioc->ic_dkey_iods[i];
+	}
+	return 0;
+}
+
 static daos_size_t
 vos_recx2irec_size(daos_size_t rsize, daos_csum_buf_t *csum)
 {
@@ -1435,7 +1545,8 @@ vos_update_end(daos_handle_t ioh, uint32_t pm_ver, daos_key_t *dkey, int err,
 	if (err)
 		goto out;
 
-	vos_dth_set(dth);
+	/* A solo DTX does not register any record. */
+	vos_dth_set(dth != NULL && dth->dth_solo ? NULL : dth);
 
 	err = vos_obj_hold(vos_obj_cache_current(), ioc->ic_cont, ioc->ic_oid,
 			   ioc->ic_epoch, false, DAOS_INTENT_UPDATE,
@@ -1461,8 +1572,8 @@ vos_update_end(daos_handle_t ioh, uint32_t pm_ver, daos_key_t *dkey, int err,
 			goto abort;
 	}
 
-	/* Update tree index */
-	err = dkey_update(ioc, pm_ver, dkey);
+	/* Update tree index, all the dkeys in the same transaction */
+	err = ioc_dkeys_update(ioc, pm_ver, dkey);
 	if (err) {
 		D_ERROR("Failed to update tree index: %d\n", err);
 		goto abort;
@@ -1473,7 +1584,8 @@ vos_update_end(daos_handle_t ioh, uint32_t pm_ver, daos_key_t *dkey, int err,
 				 VOS_IOS_GENERIC);
 
 	if (dth != NULL && err == 0)
-		err = vos_dtx_prepared(dth);
+		err = dth->dth_solo ? vos_dtx_add_committed(dth) :
+				      vos_dtx_prepared(dth);
 
 abort:
 	err = err ? umem_tx_abort(umem, err) : umem_tx_commit(umem);
@@ -1486,21 +1598,30 @@ out:
 	return err;
 }
 
-int
-vos_update_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
-		 daos_key_t *dkey, unsigned int iod_nr, daos_iod_t *iods,
-		 daos_handle_t *ioh, struct dtx_handle *dth)
+static int
+update_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
+	     daos_key_t *dkey, unsigned int dkey_nr, unsigned int *dkey_iods,
+	     unsigned int iod_nr, daos_iod_t *iods, daos_handle_t *ioh,
+	     struct dtx_handle *dth)
 {
 	struct vos_io_context	*ioc;
 	int			 rc;
 
-	D_DEBUG(DB_IO, "Prepare IOC for "DF_UOID", iod_nr %d, epc "DF_U64"\n",
-		DP_UOID(oid), iod_nr, epoch);
+	D_DEBUG(DB_IO, "Prepare IOC for "DF_UOID", dkey_nr %u iod_nr %d, epc "
+		DF_U64"\n", DP_UOID(oid), dkey_nr, iod_nr, epoch);
 
 	rc = vos_ioc_create(coh, oid, false, epoch, iod_nr, iods, false, &ioc);
 	if (rc != 0)
 		goto done;
 
+	if (dkey_nr != 0) {
+		rc = ioc_dkeys_set(ioc, dkey_nr, dkey, dkey_iods);
+		if (rc != 0) {
+			vos_update_end(vos_ioc2ioh(ioc), 0, dkey, rc, dth);
+			goto done;
+		}
+	}
+
 	rc = dkey_update_begin(ioc);
 	if (rc != 0) {
 		D_ERROR(DF_UOID"dkey update begin failed. %d\n", DP_UOID(oid),
@@ -1513,6 +1634,29 @@ done:
 	return rc;
 }
 
+int
+vos_update_begin(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
+		 daos_key_t *dkey, unsigned int iod_nr, daos_iod_t *iods,
+		 daos_handle_t *ioh, struct dtx_handle *dth)
+{
+	return update_begin(coh, oid, epoch, dkey, 0, NULL, iod_nr, iods, ioh,
+			    dth);
+}
+
+int
+vos_update_begin_multi(daos_handle_t coh, daos_unit_oid_t oid,
+		       daos_epoch_t epoch, unsigned int dkey_nr,
+		       daos_key_t *dkeys, unsigned int *dkey_iods,
+		       unsigned int iod_nr, daos_iod_t *iods,
+		       daos_handle_t *ioh, struct dtx_handle *dth)
+{
+	if (dkey_nr == 0 || dkeys == NULL || dkey_iods == NULL)
+		return -DER_INVAL;
+
+	return update_begin(coh, oid, epoch, dkeys, dkey_nr, dkey_iods,
+			    iod_nr, iods, ioh, dth);
+}
+
 struct bio_desc *
 vos_ioh2desc(daos_handle_t ioh)
 {